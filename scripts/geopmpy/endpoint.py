@@ -31,6 +31,11 @@ int geopm_endpoint_stop_wait_loop(struct geopm_endpoint_c *endpoint);
 
 int geopm_endpoint_reset_wait_loop(struct geopm_endpoint_c *endpoint);
 
+int geopm_endpoint_wait(size_t num_endpoint,
+                        struct geopm_endpoint_c **endpoint,
+                        double timeout,
+                        int *is_updated);
+
 int geopm_endpoint_profile_name(struct geopm_endpoint_c *endpoint,
                                 size_t profile_name_max,
                                 char *profile_name);
@@ -236,3 +241,27 @@ class Endpoint:
             raise RuntimeError("geopm_endpoint_write_policy() failed: {}".format(
                 error.message(err)))
         return sample_age_p[0], dict(zip(sample_names, sample_array))
+
+
+def wait(endpoints: List[Endpoint], timeout: float) -> List[Endpoint]:
+    """Block until the sample or attach state of any of the endpoints
+    changes or the timeout is reached.
+
+    Args:
+        endpoints (list[Endpoint]): Opened endpoints to wait on.
+        timeout (float): Timeout in seconds, negative to wait without a
+                         limit.
+
+    Returns:
+        list[Endpoint]: The endpoints that changed since they were last
+                        returned, empty if the timeout was reached.
+    """
+    num_endpoint = len(endpoints)
+    endpoint_array = gffi.new("struct geopm_endpoint_c *[]",
+                              [endpoint._endpoint for endpoint in endpoints])
+    is_updated = gffi.new("int[]", num_endpoint)
+    err = _dl.geopm_endpoint_wait(num_endpoint, endpoint_array, timeout, is_updated)
+    if err != 0:
+        raise RuntimeError("geopm_endpoint_wait() failed: {}".format(
+                           error.message(err)))
+    return [endpoint for endpoint, updated in zip(endpoints, is_updated) if updated]
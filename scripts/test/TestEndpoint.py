@@ -11,6 +11,7 @@ from unittest import mock
 mock_libgeopm = mock.Mock()
 with mock.patch('cffi.FFI.dlopen', return_value=mock_libgeopm):
     from geopmpy.endpoint import Endpoint
+    from geopmpy.endpoint import wait
 
 class TestEndpoint(unittest.TestCase):
     def setUp(self):
@@ -71,6 +72,22 @@ class TestEndpoint(unittest.TestCase):
         mock_libgeopm.geopm_endpoint_wait_for_agent_reset_wait_loop.return_value = 0
         self._endpoint.reset_wait_loop()
 
+    def test_wait(self):
+        other_endpoint = Endpoint('other_endpoint')
+
+        def mock_wait(num_endpoint, endpoint_array, timeout, is_updated):
+            is_updated[1] = 1
+            return 0
+        mock_libgeopm.geopm_endpoint_wait.side_effect = mock_wait
+        self.assertEqual([other_endpoint],
+                         wait([self._endpoint, other_endpoint], 1.5))
+        self.assertEqual(2, mock_libgeopm.geopm_endpoint_wait.call_args[0][0])
+        self.assertEqual(1.5, mock_libgeopm.geopm_endpoint_wait.call_args[0][2])
+
+        mock_libgeopm.geopm_endpoint_wait.side_effect = None
+        mock_libgeopm.geopm_endpoint_wait.return_value = 1
+        self.assertRaises(RuntimeError, wait, [self._endpoint], 1.5)
+
     def test_endpoint_profile_name(self):
         test_profile_name = 'my agent'
 
@@ -194,6 +194,7 @@ rst_files = [
     "geopm_pio_profile.7",
     "geopm_pio_service.7",
     "geopm_pio_sst.7",
+    "geopm_pio_sysfs.7",
     "geopm_pio_time.7",
     "geopm_pio_msr.7",
     "geopm_policystore.3",
@@ -7,6 +7,7 @@ from dasbus.connection import SystemMessageBus
 from signal import signal
 from signal import SIGTERM
 import sys
+from . import pio
 from . import service
 from geopmdpy.restorable_file_writer import RestorableFileWriter
 
@@ -40,6 +41,10 @@ def main():
                                               file=sys.stderr)) as writer:
         try:
             writer.backup_and_try_update('on\n')
+            try:
+                pio.create_cache()
+            except RuntimeError as ex:
+                print('Warning <geopm-service>', ex, file=sys.stderr)
             _bus.publish_object("/io/github/geopm", service.GEOPMService())
             _bus.register_service("io.github.geopm")
             _loop.run()
@@ -105,6 +105,17 @@ int geopm_pio_format_signal(double signal,
 
 void geopm_pio_reset(void);
 
+int geopm_pio_create_cache(void);
+
+int geopm_pio_sample_loop(int num_request,
+                          const struct geopm_request_s *request,
+                          double period,
+                          int num_period,
+                          int output_format,
+                          int output_fd,
+                          int *num_missed,
+                          int *num_sample);
+
 """)
 _dl = gffi.get_dl_geopmd()
 
@@ -702,3 +713,82 @@ def reset():
     """
     global _dl
     _dl.geopm_pio_reset()
+
+def create_cache():
+    """Create the PlatformIO cache file.
+
+    The cache records the signals and controls provided by each
+    IOGroup so that PlatformIO objects created afterwards construct
+    only the IOGroups that are used.  The file is only created if it
+    does not exist or was created before the last boot.
+
+    Raises:
+        RuntimeError: Failure to create the cache file.
+
+    """
+    global _dl
+    err = _dl.geopm_pio_create_cache()
+    if err < 0:
+        raise RuntimeError('geopm_pio_create_cache() failed: {}'.format(error.message(err)))
+
+def sample_loop(requests, period, num_period, output_fd, is_binary=False):
+    """Periodically read signals and write each sample to a file descriptor
+
+    Reads the requested signals num_period + 1 times: once immediately
+    and then once at the end of each period.  The reads are scheduled
+    on absolute deadlines by the native implementation, so the time
+    spent reading and writing does not accumulate into drift.  Each
+    read writes one record to the output file descriptor.  The loop
+    stops early if a signal interrupts the wait for a deadline, so that
+    e.g. a KeyboardInterrupt is raised when the call returns.
+
+    The requests are pushed like push_signal() and remain pushed after
+    the loop returns.  The loop fails if read_batch() or adjust() was
+    called since the last call to reset(), including by an earlier
+    call to sample_loop().
+
+    Text records are a comma separated line of the formatted values.
+    Binary records are len(requests) + 1 native doubles: the time in
+    seconds since the first read followed by each value in the order
+    requested.
+
+    Args:
+        requests (list((str, int, int))): List of requested signals
+            where each tuple represents (signal_name, domain_type,
+            domain_idx).
+
+        period (float): Time between reads in seconds.
+
+        num_period (int): Number of periods spanned by the loop.
+
+        output_fd (int): Open file descriptor where records are
+                         written.
+
+        is_binary (bool): Write binary records rather than text.
+
+    Returns:
+        tuple(int, int): The number of records written, which is less
+                         than num_period + 1 if the loop was
+                         interrupted, and the number of deadlines that
+                         had already passed when the loop was ready to
+                         wait for them.
+
+    Raises:
+        RuntimeError: Failure to read the signals or write the output.
+
+    """
+    global _dl
+    num_request = len(requests)
+    request_carr = gffi.gffi.new(f'struct geopm_request_s[{num_request}]')
+    for idx, req in enumerate(requests):
+        request_carr[idx].name = req[0].encode()
+        request_carr[idx].domain = req[1]
+        request_carr[idx].domain_idx = req[2]
+    output_format = 1 if is_binary else 0
+    num_missed = gffi.gffi.new('int *')
+    num_sample = gffi.gffi.new('int *')
+    err = _dl.geopm_pio_sample_loop(num_request, request_carr, period, num_period,
+                                    output_format, output_fd, num_missed, num_sample)
+    if err < 0:
+        raise RuntimeError('geopm_pio_sample_loop() failed: {}'.format(error.message(err)))
+    return num_sample[0], num_missed[0]
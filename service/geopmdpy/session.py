@@ -56,7 +56,7 @@ class Session:
                   zip(signals, signal_format)]
         return '{}\n'.format(','.join(result))
 
-    def run_read(self, requests, duration, period, out_stream):
+    def run_read(self, requests, duration, period, out_stream, is_binary=False):
         """Run a read mode session
 
         Periodically read the requested signals. A line of text will
@@ -71,6 +71,13 @@ class Session:
         These periodic reads are executed and printed until the
         duration of time specified has been met or exceeded.
 
+        When the output stream is backed by a file descriptor the
+        loop is run by pio.sample_loop(), which schedules each read on
+        an absolute deadline and writes directly to the descriptor.
+        A warning is printed to standard error if any deadlines were
+        missed, or if a signal stopped the loop before the duration
+        was met.  Otherwise the reads are paced by loop.TimedLoop.
+
         Args:
             requests (ReadRequestQueue): Request object parsed from
                                          user input.
@@ -85,10 +92,31 @@ class Session:
             out_stream (typing.IO): Object with write() method where output
                                will be printed (typically sys.stdout).
 
+            is_binary (bool): Write records of native doubles rather
+                              than text, see pio.sample_loop().
+
+        Raises:
+            RuntimeError: Binary output was requested and the output
+                          stream has no file descriptor.
+
         """
         num_period = 0
         if period != 0:
             num_period = math.ceil(duration / period)
+        output_fd = self.get_fileno(out_stream)
+        if output_fd is not None:
+            out_stream.flush()
+            num_sample, num_missed = pio.sample_loop(list(requests), period, num_period,
+                                                     output_fd, is_binary)
+            if num_sample != num_period + 1:
+                sys.stderr.write('Warning: <geopm> geopmsession: interrupted after {} of {} samples\n'
+                                 .format(num_sample, num_period + 1))
+            if num_missed != 0:
+                sys.stderr.write('Warning: <geopm> geopmsession: {} of {} sampling deadlines were missed\n'
+                                 .format(num_missed, num_period))
+            return
+        if is_binary:
+            raise RuntimeError('Binary output requires an output stream with a file descriptor')
         signal_handles = []
         for name, dom, dom_idx in requests:
             signal_handles.append(pio.push_signal(name, dom, dom_idx))
@@ -99,6 +127,26 @@ class Session:
             line = self.format_signals(signals, requests.get_formats())
             out_stream.write(line)
 
+    def get_fileno(self, out_stream):
+        """Get the file descriptor that backs an output stream
+
+        Args:
+            out_stream (typing.IO): Stream where output will be
+                                    printed.
+
+        Returns:
+            int: The file descriptor, or None if the stream is not
+                 backed by one (e.g. io.StringIO).
+
+        """
+        try:
+            result = out_stream.fileno()
+        except (AttributeError, OSError, ValueError):
+            result = None
+        if type(result) is not int:
+            result = None
+        return result
+
     def check_read_args(self, run_time, period):
         """Check that the run time and period are valid for a read session
 
@@ -122,7 +170,7 @@ class Session:
             raise RuntimeError('Specified a negative run time or period')
 
     def run(self, run_time, period,
-            request_stream=sys.stdin, out_stream=sys.stdout):
+            request_stream=sys.stdin, out_stream=sys.stdout, is_binary=False):
         """"Create a GEOPM session with values parsed from the command line
 
         The implementation for the geopmsession command line tool.
@@ -142,10 +190,13 @@ class Session:
             out_stream (typing.IO): Stream where output from will be
                                printed.
 
+            is_binary (bool): Write records of native doubles rather
+                              than text.
+
         """
         requests = ReadRequestQueue(request_stream)
         self.check_read_args(run_time, period)
-        self.run_read(requests, run_time, period, out_stream)
+        self.run_read(requests, run_time, period, out_stream, is_binary)
 
 
 class RequestQueue:
@@ -306,10 +357,12 @@ def main():
                         help='Total run time of the session to be opened in seconds')
     parser.add_argument('-p', '--period', dest='period', type=float, default = 0.0,
                         help='When used with a read mode session reads all values out periodically with the specified period in seconds')
+    parser.add_argument('-b', '--binary', dest='binary', action='store_true', default=False,
+                        help='Write each sample as native doubles: the time since the first read followed by each value')
     args = parser.parse_args()
     try:
         sess = Session()
-        sess.run(args.time, args.period)
+        sess.run(args.time, args.period, is_binary=args.binary)
     except RuntimeError as ee:
         if 'GEOPM_DEBUG' in os.environ:
             # Do not handle exception if GEOPM_DEBUG is set
@@ -777,7 +777,11 @@ class ActiveSessions(object):
         self._sessions[client_pid]['client_uid'] = int(uid)
         self._sessions[client_pid]['client_gid'] = int(gid)
         if len(self._profiles) == 0:
-            size = 64 * os.cpu_count()
+            # One cache line per CPU followed by one for the event
+            # counter and one for the dirty bits of every 512 CPUs,
+            # see ApplicationStatus::buffer_size()
+            num_cpu = os.cpu_count()
+            size = 64 * (num_cpu + 1 + (num_cpu + 511) // 512)
             shmem.create_prof('status', size, client_pid, uid, gid)
         if profile_name in self._profiles:
             self._profiles[profile_name].add(client_pid)
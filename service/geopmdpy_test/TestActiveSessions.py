@@ -332,7 +332,9 @@ class TestActiveSessions(unittest.TestCase):
             act_sess.start_profile(client_pid, profile_name)
             calls = [mock.call(client_pid), mock.call().uids(), mock.call().gids()]
             mock_process.assert_has_calls(calls)
-            calls = [mock.call('status', 64 * os.cpu_count(), client_pid, client_uid, client_gid),
+            num_cpu = os.cpu_count()
+            status_size = 64 * (num_cpu + 1 + (num_cpu + 511) // 512)
+            calls = [mock.call('status', status_size, client_pid, client_uid, client_gid),
                      mock.call('record-log', 57384, client_pid, client_uid, client_gid)]
             mock_shmem_create.assert_has_calls(calls)
             self.assertEqual({client_pid}, act_sess.get_profile_pids(profile_name))
@@ -70,6 +70,59 @@ class TestSession(unittest.TestCase):
             calls = num_period * [mock.call(format_return_value)]
             out_stream.write.assert_has_calls(calls)
 
+    def test_run_read_native(self):
+        duration = 2
+        period = 0.5
+        out_stream = mock.MagicMock()
+        out_stream.fileno.return_value = 7
+        user_requests = [('power', 0, 0), ('SERVICE::energy', 1, 1)]
+        mock_requests = mock.MagicMock()
+        mock_requests.__iter__.return_value = user_requests
+
+        with mock.patch('geopmdpy.pio.sample_loop', return_value=(5, 0)) as mock_sample_loop, \
+             mock.patch('geopmdpy.pio.push_signal') as mock_push_signal, \
+             mock.patch('sys.stderr', new_callable=StringIO) as mock_stderr:
+            self._session.run_read(mock_requests, duration, period, out_stream, True)
+            out_stream.flush.assert_called_once_with()
+            mock_sample_loop.assert_called_once_with(user_requests, period, 4, 7, True)
+            mock_push_signal.assert_not_called()
+            out_stream.write.assert_not_called()
+            self.assertEqual('', mock_stderr.getvalue())
+
+        with mock.patch('geopmdpy.pio.sample_loop', return_value=(5, 3)), \
+             mock.patch('sys.stderr', new_callable=StringIO) as mock_stderr:
+            self._session.run_read(mock_requests, duration, period, out_stream)
+            self.assertIn('3 of 4 sampling deadlines were missed', mock_stderr.getvalue())
+
+    def test_run_read_native_interrupted(self):
+        duration = 2
+        period = 0.5
+        out_stream = mock.MagicMock()
+        out_stream.fileno.return_value = 7
+        mock_requests = mock.MagicMock()
+        mock_requests.__iter__.return_value = [('power', 0, 0)]
+
+        # A signal handler that does not raise stops the native loop early
+        with mock.patch('geopmdpy.pio.sample_loop', return_value=(2, 0)), \
+             mock.patch('sys.stderr', new_callable=StringIO) as mock_stderr:
+            self._session.run_read(mock_requests, duration, period, out_stream)
+            self.assertIn('interrupted after 2 of 5 samples', mock_stderr.getvalue())
+            self.assertNotIn('deadlines were missed', mock_stderr.getvalue())
+
+        # SIGINT is raised as KeyboardInterrupt when the native loop returns
+        with mock.patch('geopmdpy.pio.sample_loop', side_effect=KeyboardInterrupt), \
+             mock.patch('sys.stderr', new_callable=StringIO) as mock_stderr:
+            with self.assertRaises(KeyboardInterrupt):
+                self._session.run_read(mock_requests, duration, period, out_stream)
+            out_stream.write.assert_not_called()
+
+    def test_run_read_binary_no_fileno(self):
+        out_stream = StringIO()
+        mock_requests = mock.MagicMock()
+        err_msg = 'Binary output requires an output stream with a file descriptor'
+        with self.assertRaisesRegex(RuntimeError, err_msg):
+            self._session.run_read(mock_requests, 1, 1, out_stream, True)
+
     def test_check_read_args(self):
         err_msg = 'Specified a period that is greater than the total run time'
         with self.assertRaisesRegex(RuntimeError, err_msg):
@@ -105,7 +158,7 @@ class TestSession(unittest.TestCase):
 
             srrq.assert_called_once_with(request_stream)
             scra.assert_called_once_with(runtime, period)
-            srr.assert_called_once_with(rrq_return_value, runtime, period, out_stream)
+            srr.assert_called_once_with(rrq_return_value, runtime, period, out_stream, False)
 
 
 if __name__ == '__main__':
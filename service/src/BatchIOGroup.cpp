@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "geopm/BatchIOGroup.hpp"
+
+#include "geopm/IOGroup.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm/Exception.hpp"
+
+namespace geopm
+{
+    std::vector<double> BatchIOGroup::read_signals(IOGroup &iogroup,
+                                                   const std::vector<geopm_request_s> &request)
+    {
+        BatchIOGroup *batch_iogroup = dynamic_cast<BatchIOGroup *>(&iogroup);
+        if (batch_iogroup != nullptr) {
+            return batch_iogroup->read_signals(request);
+        }
+        std::vector<double> result;
+        result.reserve(request.size());
+        for (const auto &req : request) {
+            result.push_back(iogroup.read_signal(req.name, req.domain_type, req.domain_idx));
+        }
+        return result;
+    }
+
+    void BatchIOGroup::write_controls(IOGroup &iogroup,
+                                      const std::vector<geopm_request_s> &request,
+                                      const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("BatchIOGroup::write_controls(): number of settings does not match the number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        BatchIOGroup *batch_iogroup = dynamic_cast<BatchIOGroup *>(&iogroup);
+        if (batch_iogroup != nullptr) {
+            batch_iogroup->write_controls(request, setting);
+            return;
+        }
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const auto &req = request[req_idx];
+            iogroup.write_control(req.name, req.domain_type, req.domain_idx, setting[req_idx]);
+        }
+    }
+}
@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <fstream>
 #include <functional>
 #include <iterator>
 #include <limits>
@@ -17,6 +16,7 @@
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/PlatformTopo.hpp"
+#include "SysfsIO.hpp"
 
 #include "config.h"
 
@@ -25,10 +25,9 @@ namespace geopm
     static const std::string FRESHNESS_FILE_NAME("freshness");
     static const std::string RAW_SCAN_HZ_FILE_NAME("raw_scan_hz");
 
-    static std::function<double()> get_formatted_file_reader(const std::string &path,
-                                                             const std::string &units)
+    static double file_value(double value)
     {
-        return std::bind(read_double_from_file, path, units);
+        return value;
     }
 
     CNLIOGroup::CNLIOGroup()
@@ -37,11 +36,22 @@ namespace geopm
     }
 
     CNLIOGroup::CNLIOGroup(const std::string &cpu_info_path)
-        : m_signal_available({{"CNL::BOARD_POWER", {
+        : CNLIOGroup(cpu_info_path, SysfsIO::make_unique())
+    {
+    }
+
+    CNLIOGroup::CNLIOGroup(const std::string &cpu_info_path,
+                           std::shared_ptr<SysfsIO> sysfs_io)
+        : m_sysfs_io(std::move(sysfs_io))
+        , m_signal_available({{"CNL::BOARD_POWER", {
                                    "Point in time power",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/power", "W"),
+                                   "power",
+                                   "W",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_WATTS,
@@ -50,7 +60,11 @@ namespace geopm
                                    "Accumulated energy",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/energy", "J"),
+                                   "energy",
+                                   "J",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_JOULES,
@@ -59,7 +73,11 @@ namespace geopm
                                    "Point in time memory power",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/memory_power", "W"),
+                                   "memory_power",
+                                   "W",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_WATTS,
@@ -68,7 +86,11 @@ namespace geopm
                                    "Accumulated memory energy",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/memory_energy", "J"),
+                                   "memory_energy",
+                                   "J",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_JOULES,
@@ -77,7 +99,11 @@ namespace geopm
                                    "Point in time CPU power",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/cpu_power", "W"),
+                                   "cpu_power",
+                                   "W",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_WATTS,
@@ -86,7 +112,11 @@ namespace geopm
                                    "Accumulated CPU energy",
                                    Agg::sum,
                                    string_format_integer,
-                                   get_formatted_file_reader(cpu_info_path + "/cpu_energy", "J"),
+                                   "cpu_energy",
+                                   "J",
+                                   file_value,
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_JOULES,
@@ -95,7 +125,11 @@ namespace geopm
                                    "Sample frequency",
                                    Agg::expect_same,
                                    string_format_integer,
-                                   std::bind(&CNLIOGroup::m_sample_rate, this),
+                                   "",
+                                   "",
+                                   [this](double) { return m_sample_rate; },
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_HERTZ,
@@ -104,7 +138,11 @@ namespace geopm
                                    "Time that the sample was reported, in seconds since this agent initialized",
                                    Agg::max,
                                    string_format_double,
-                                   std::bind(&CNLIOGroup::read_time, this, cpu_info_path + "/" + FRESHNESS_FILE_NAME),
+                                   FRESHNESS_FILE_NAME,
+                                   "",
+                                   std::bind(&CNLIOGroup::freshness_to_time, this, std::placeholders::_1),
+                                   -1,
+                                   -1,
                                    false,
                                    NAN,
                                    M_UNITS_SECONDS,
@@ -112,20 +150,26 @@ namespace geopm
                              })
         , m_time_zero(geopm::time_zero())
     {
-        m_sample_rate = read_double_from_file(
-            cpu_info_path + "/" + RAW_SCAN_HZ_FILE_NAME, "");
+        m_sample_rate = m_sysfs_io->read(
+            m_sysfs_io->open_file(cpu_info_path + "/" + RAW_SCAN_HZ_FILE_NAME, ""));
         if (m_sample_rate <= 0) {
             throw Exception("CNLIOGroup::CNLIOGroup(): Unexpected sample frequency " +
                                 std::to_string(m_sample_rate),
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        m_initial_freshness =
-            read_double_from_file(cpu_info_path + "/" + FRESHNESS_FILE_NAME, "");
+        m_initial_freshness = m_sysfs_io->read(
+            m_sysfs_io->open_file(cpu_info_path + "/" + FRESHNESS_FILE_NAME, ""));
 
-        for (const auto &signal : m_signal_available) {
-            // Attempt to call each of the read functions so we can fail
-            // construction of this IOGroup if it isn't supported.
-            signal.second.m_read_function();
+        for (auto &signal : m_signal_available) {
+            // Open each of the files once and keep them open.  Attempt
+            // to read each signal so we can fail construction of this
+            // IOGroup if it isn't supported.
+            if (!signal.second.m_file_name.empty()) {
+                signal.second.m_file_idx = m_sysfs_io->open_file(
+                    cpu_info_path + "/" + signal.second.m_file_name,
+                    signal.second.m_file_units);
+            }
+            read_value(signal.second);
         }
 
         register_signal_alias("BOARD_POWER", "CNL::BOARD_POWER");
@@ -180,7 +224,11 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
-        m_signal_available[signal_name].m_do_read = true;
+        auto &signal_info = m_signal_available[signal_name];
+        if (!signal_info.m_do_read && signal_info.m_file_idx != -1) {
+            signal_info.m_batch_idx = m_sysfs_io->add_read(signal_info.m_file_idx);
+        }
+        signal_info.m_do_read = true;
         return std::distance(m_signal_available.begin(), m_signal_available.find(signal_name));
     }
 
@@ -193,9 +241,12 @@ namespace geopm
 
     void CNLIOGroup::read_batch(void)
     {
+        m_sysfs_io->read_batch();
         for (auto &signal : m_signal_available) {
             if (signal.second.m_do_read) {
-                signal.second.m_value = signal.second.m_read_function();
+                double file_value = signal.second.m_batch_idx == -1 ?
+                                    NAN : m_sysfs_io->sample(signal.second.m_batch_idx);
+                signal.second.m_value = signal.second.m_convert_function(file_value);
             }
         }
     }
@@ -244,7 +295,7 @@ namespace geopm
                             "not valid for CNLIOGroup",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        return m_signal_available.find(signal_name)->second.m_read_function();
+        return read_value(m_signal_available.find(signal_name)->second);
     }
 
     void CNLIOGroup::write_control(const std::string &control_name,
@@ -354,9 +405,15 @@ namespace geopm
         return geopm::make_unique<CNLIOGroup>();
     }
 
-    double CNLIOGroup::read_time(const std::string &freshness_path) const
+    double CNLIOGroup::read_value(const m_signal_info_s &signal_info)
+    {
+        double file_value = signal_info.m_file_idx == -1 ?
+                            NAN : m_sysfs_io->read(signal_info.m_file_idx);
+        return signal_info.m_convert_function(file_value);
+    }
+
+    double CNLIOGroup::freshness_to_time(double freshness) const
     {
-        auto freshness = read_double_from_file(freshness_path, "");
         return (freshness - m_initial_freshness) / m_sample_rate;
     }
 
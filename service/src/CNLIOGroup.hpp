@@ -7,12 +7,15 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 
 #include "geopm/IOGroup.hpp"
 #include "geopm_time.h"
 
 namespace geopm
 {
+    class SysfsIO;
+
     /// @brief IOGroup that wraps interfaces to Compute Node Linux.
     ///
     /// @details The CNLIOGroup provides board-level energy counters from Compute Node Linux
@@ -22,6 +25,8 @@ namespace geopm
         public:
             CNLIOGroup();
             CNLIOGroup(const std::string &pm_counters_path);
+            CNLIOGroup(const std::string &pm_counters_path,
+                       std::shared_ptr<SysfsIO> sysfs_io);
             virtual ~CNLIOGroup() = default;
             /// @return the list of signal names provided by this IOGroup.
             std::set<std::string> signal_names(void) const override;
@@ -144,15 +149,28 @@ namespace geopm
                 std::string m_description;
                 std::function<double(const std::vector<double> &)> m_agg_function;
                 std::function<std::string(double)> m_format_function;
-                std::function<double()> m_read_function;
+                // File in the pm_counters directory that the signal
+                // is derived from, or empty if it is not read from a
+                // file.
+                std::string m_file_name;
+                std::string m_file_units;
+                // Convert the value read from the file to the signal
+                std::function<double(double)> m_convert_function;
+                int m_file_idx;
+                int m_batch_idx;
                 bool m_do_read;
                 double m_value;
                 int m_units;
                 int m_behavior;
             };
-            std::map<std::string, m_signal_info_s> m_signal_available;
+            /// @brief Read a signal directly from its file.
+            double read_value(const m_signal_info_s &signal_info);
+            /// @brief Convert the freshness counter into seconds
+            ///        since the IOGroup was created.
+            double freshness_to_time(double freshness) const;
 
-            double read_time(const std::string &freshness_path) const;
+            std::shared_ptr<SysfsIO> m_sysfs_io;
+            std::map<std::string, m_signal_info_s> m_signal_available;
 
             geopm_time_s m_time_zero;
             double m_initial_freshness;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "DerivativeBatch.hpp"
+
+#include <cmath>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_debug.hpp"
+#include "Signal.hpp"
+#include "SlidingRegression.hpp"
+
+namespace geopm
+{
+    DerivativeBatch::DerivativeBatch(std::shared_ptr<Signal> time_sig,
+                                     int num_sample_history)
+        : m_time_sig(std::move(time_sig))
+        , M_NUM_SAMPLE_HISTORY(num_sample_history)
+        , m_fit(geopm::make_unique<SlidingRegression>(M_NUM_SAMPLE_HISTORY, 0))
+        , m_is_batch_ready(false)
+        , m_is_sampled(false)
+        , m_last_time(NAN)
+    {
+        GEOPM_DEBUG_ASSERT(m_time_sig, "Signal pointer for time_sig cannot be null.");
+    }
+
+    DerivativeBatch::~DerivativeBatch() = default;
+
+    int DerivativeBatch::push_signal(std::shared_ptr<Signal> y_sig)
+    {
+        GEOPM_DEBUG_ASSERT(y_sig, "Signal pointer for y_sig cannot be null.");
+        if (!m_is_batch_ready) {
+            m_time_sig->setup_batch();
+            m_is_batch_ready = true;
+        }
+        y_sig->setup_batch();
+        m_y_sig.push_back(std::move(y_sig));
+        m_y_sample.push_back(NAN);
+        return m_fit->add_lane();
+    }
+
+    double DerivativeBatch::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_y_sig.size()) {
+            throw Exception("DerivativeBatch::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        double time = m_time_sig->sample();
+        if (!m_is_sampled || time != m_last_time) {
+            for (size_t sig_idx = 0; sig_idx < m_y_sig.size(); ++sig_idx) {
+                m_y_sample[sig_idx] = m_y_sig[sig_idx]->sample();
+            }
+            m_fit->insert(time, m_y_sample.data());
+            m_last_time = time;
+            m_is_sampled = true;
+        }
+        return m_fit->slope(batch_idx);
+    }
+
+    std::shared_ptr<Signal> DerivativeBatch::time_signal(void) const
+    {
+        return m_time_sig;
+    }
+
+    int DerivativeBatch::num_sample_history(void) const
+    {
+        return M_NUM_SAMPLE_HISTORY;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DERIVATIVEBATCH_HPP_INCLUDE
+#define DERIVATIVEBATCH_HPP_INCLUDE
+
+#include <memory>
+#include <vector>
+
+namespace geopm
+{
+    class Signal;
+    class SlidingRegression;
+
+    /// @brief Computes the derivatives of all batch signals that
+    ///        share a time signal and window length together.
+    ///
+    /// An IOGroup creates one DerivativeBatch for each time signal
+    /// and passes it to the DerivativeSignal objects that use that
+    /// time signal.  When a DerivativeSignal is set up for batch
+    /// access it adds its signal to the DerivativeBatch.  The first
+    /// DerivativeSignal sampled after the time signal changes
+    /// samples all of the signals in the batch and updates all of
+    /// their derivatives in one pass; the other DerivativeSignal
+    /// objects then return the stored result.
+    class DerivativeBatch
+    {
+        public:
+            /// @param [in] time_sig Time signal shared by the
+            ///        derivatives in the batch.
+            /// @param [in] num_sample_history Number of samples used
+            ///        in the fit of each derivative.
+            DerivativeBatch(std::shared_ptr<Signal> time_sig,
+                            int num_sample_history);
+            DerivativeBatch(const DerivativeBatch &other) = delete;
+            DerivativeBatch &operator=(const DerivativeBatch &other) = delete;
+            virtual ~DerivativeBatch();
+            /// @brief Set up a signal for batch access and add its
+            ///        derivative to the batch.
+            ///
+            /// @param [in] y_sig Signal to differentiate with respect
+            ///        to the time signal.
+            ///
+            /// @return Index to pass to sample().
+            int push_signal(std::shared_ptr<Signal> y_sig);
+            /// @brief Derivative of a pushed signal, updating all
+            ///        derivatives in the batch if the time signal has
+            ///        changed since the last update.
+            ///
+            /// @param [in] batch_idx Index returned by push_signal().
+            ///
+            /// @return The derivative, or NAN if fewer than two
+            ///         samples have been taken.
+            double sample(int batch_idx);
+            /// @return The time signal shared by the batch.
+            std::shared_ptr<Signal> time_signal(void) const;
+            /// @return Number of samples used in the fit of each
+            ///         derivative.
+            int num_sample_history(void) const;
+        private:
+            std::shared_ptr<Signal> m_time_sig;
+            const int M_NUM_SAMPLE_HISTORY;
+            std::vector<std::shared_ptr<Signal> > m_y_sig;
+            std::vector<double> m_y_sample;
+            std::unique_ptr<SlidingRegression> m_fit;
+            bool m_is_batch_ready;
+            bool m_is_sampled;
+            double m_last_time;
+    };
+}
+
+#endif
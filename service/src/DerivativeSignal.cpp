@@ -8,10 +8,13 @@
 #include "DerivativeSignal.hpp"
 
 #include <cmath>
+#include <map>
 #include <unistd.h>
 
 #include "geopm/Helper.hpp"
 #include "geopm_debug.hpp"
+#include "DerivativeBatch.hpp"
+#include "SlidingRegression.hpp"
 
 namespace geopm
 {
@@ -19,65 +22,50 @@ namespace geopm
                                        std::shared_ptr<Signal> y_sig,
                                        int num_sample_history,
                                        double sleep_time)
+        : DerivativeSignal(std::move(time_sig), std::move(y_sig),
+                           num_sample_history, sleep_time, nullptr)
+    {
+
+    }
+
+    DerivativeSignal::DerivativeSignal(std::shared_ptr<Signal> time_sig,
+                                       std::shared_ptr<Signal> y_sig,
+                                       int num_sample_history,
+                                       double sleep_time,
+                                       std::shared_ptr<DerivativeBatch> batch)
         : m_time_sig(std::move(time_sig))
         , m_y_sig(std::move(y_sig))
         , M_NUM_SAMPLE_HISTORY(num_sample_history)
-        , m_history(M_NUM_SAMPLE_HISTORY)
-        , m_derivative_num_fit(0)
+        , m_fit(geopm::make_unique<SlidingRegression>(M_NUM_SAMPLE_HISTORY, 1))
+        , m_batch(std::move(batch))
+        , m_batch_idx(-1)
         , m_is_batch_ready(false)
+        , m_is_sampled(false)
         , m_sleep_time(sleep_time)
-        , m_last_result(NAN)
+        , m_last_time(NAN)
     {
         GEOPM_DEBUG_ASSERT(m_time_sig && m_y_sig,
                            "Signal pointers for time_sig and y_sig cannot be null.");
+        GEOPM_DEBUG_ASSERT(m_batch == nullptr ||
+                           (m_batch->time_signal() == m_time_sig &&
+                            m_batch->num_sample_history() == M_NUM_SAMPLE_HISTORY),
+                           "DerivativeBatch must use the same time signal and history length.");
     }
 
+    DerivativeSignal::~DerivativeSignal() = default;
+
     void DerivativeSignal::setup_batch(void)
     {
         if (!m_is_batch_ready) {
-            m_time_sig->setup_batch();
-            m_y_sig->setup_batch();
-            m_is_batch_ready = true;
-        }
-    }
-
-    double DerivativeSignal::compute_next(CircularBuffer<m_sample_s> &history,
-                                          int &num_fit,
-                                          double time, double signal)
-    {
-        // insert time and signal
-        history.insert({time, signal});
-        if (num_fit < history.capacity()) {
-            ++num_fit;
-        }
-
-        // Least squares linear regression to approximate the
-        // derivative with noisy data.
-        double result = NAN;
-        if (num_fit >= 2) {
-            size_t buf_size = history.size();
-            double A = 0.0, B = 0.0, C = 0.0, D = 0.0;
-            double E = 1.0 / num_fit;
-            double time_0 = history.value(buf_size - num_fit).time;
-            const double sig_0 = history.value(buf_size - num_fit).sample;
-            for (size_t buf_off = buf_size - num_fit;
-                 buf_off < buf_size; ++buf_off) {
-                double tt = history.value(buf_off).time;
-                double dt = tt - time_0;
-                double sig = history.value(buf_off).sample - sig_0;
-                A += dt * sig;
-                B += dt;
-                C += sig;
-                D += dt * dt;
+            if (m_batch != nullptr) {
+                m_batch_idx = m_batch->push_signal(m_y_sig);
             }
-
-            double ssxx = D - B * B * E;
-            double ssxy = A - B * C * E;
-            if (ssxx != 0) {
-                result = ssxy / ssxx;
+            else {
+                m_time_sig->setup_batch();
+                m_y_sig->setup_batch();
             }
+            m_is_batch_ready = true;
         }
-        return result;
     }
 
     double DerivativeSignal::sample(void)
@@ -86,32 +74,95 @@ namespace geopm
             throw Exception("setup_batch() must be called before sample().",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
+        if (m_batch != nullptr) {
+            return m_batch->sample(m_batch_idx);
+        }
         double time = m_time_sig->sample();
-        size_t history_size = m_history.size();
-        // Check if this is the first call ever to sample() (history_size == 0)
-        // Or check if this is the first call to sample() since the last call to read_batch() (last element of history buffer does not match the sampled time)
-        if (history_size == 0ULL ||
-            time != m_history.value(m_history.size() - 1).time) {
+        // Check if this is the first call ever to sample() or the
+        // first call to sample() since the last call to read_batch()
+        // (the time does not match the last sampled time).
+        if (!m_is_sampled || time != m_last_time) {
             double signal = m_y_sig->sample();
-            m_last_result = compute_next(m_history, m_derivative_num_fit, time, signal);
+            m_fit->insert(time, &signal);
+            m_last_time = time;
+            m_is_sampled = true;
         }
-        return m_last_result;
+        return m_fit->slope(0);
     }
 
     double DerivativeSignal::read(void) const
     {
-        double result = NAN;
-        CircularBuffer<m_sample_s> temp_history(M_NUM_SAMPLE_HISTORY);
-        int num_fit = 0;
+        SlidingRegression fit(M_NUM_SAMPLE_HISTORY, 1);
         for (int ii = 0; ii < M_NUM_SAMPLE_HISTORY; ++ii) {
             double signal = m_y_sig->read();
             double time = m_time_sig->read();
-            result = compute_next(temp_history, num_fit, time, signal);
+            fit.insert(time, &signal);
             if (ii < M_NUM_SAMPLE_HISTORY - 1) {
                 usleep(m_sleep_time * 1e6);
             }
         }
-        return result;
+        return fit.slope(0);
     }
 
+    std::vector<double> DerivativeSignal::read_all(const std::vector<std::shared_ptr<Signal> > &signal)
+    {
+        std::vector<double> result(signal.size(), NAN);
+        // Derivative signals that can share a sampling loop, keyed
+        // by history length and sleep time
+        std::map<std::pair<int, double>, std::vector<size_t> > loop_map;
+        for (size_t sig_idx = 0; sig_idx < signal.size(); ++sig_idx) {
+            auto deriv = std::dynamic_pointer_cast<DerivativeSignal>(signal[sig_idx]);
+            if (deriv != nullptr) {
+                loop_map[{deriv->M_NUM_SAMPLE_HISTORY, deriv->m_sleep_time}].push_back(sig_idx);
+            }
+            else {
+                result[sig_idx] = signal[sig_idx]->read();
+            }
+        }
+        for (const auto &loop : loop_map) {
+            const int num_sample = loop.first.first;
+            const double sleep_time = loop.first.second;
+            // Derivatives that also share a time signal are fit
+            // together with one lane each.
+            std::vector<std::shared_ptr<Signal> > time_sig;
+            std::vector<std::vector<size_t> > time_member;
+            std::map<Signal *, size_t> time_map;
+            for (auto sig_idx : loop.second) {
+                const auto &deriv = static_cast<const DerivativeSignal &>(*signal[sig_idx]);
+                auto ins = time_map.emplace(deriv.m_time_sig.get(), time_sig.size());
+                if (ins.second) {
+                    time_sig.push_back(deriv.m_time_sig);
+                    time_member.emplace_back();
+                }
+                time_member[ins.first->second].push_back(sig_idx);
+            }
+            std::vector<SlidingRegression> fit;
+            std::vector<std::vector<double> > y_sample(time_sig.size());
+            for (size_t time_idx = 0; time_idx < time_sig.size(); ++time_idx) {
+                fit.emplace_back(num_sample, time_member[time_idx].size());
+                y_sample[time_idx].resize(time_member[time_idx].size());
+            }
+            for (int ii = 0; ii < num_sample; ++ii) {
+                for (size_t time_idx = 0; time_idx < time_sig.size(); ++time_idx) {
+                    const auto &member = time_member[time_idx];
+                    for (size_t lane_idx = 0; lane_idx < member.size(); ++lane_idx) {
+                        const auto &deriv = static_cast<const DerivativeSignal &>(*signal[member[lane_idx]]);
+                        y_sample[time_idx][lane_idx] = deriv.m_y_sig->read();
+                    }
+                    double time = time_sig[time_idx]->read();
+                    fit[time_idx].insert(time, y_sample[time_idx].data());
+                }
+                if (ii < num_sample - 1) {
+                    usleep(sleep_time * 1e6);
+                }
+            }
+            for (size_t time_idx = 0; time_idx < time_sig.size(); ++time_idx) {
+                const auto &member = time_member[time_idx];
+                for (size_t lane_idx = 0; lane_idx < member.size(); ++lane_idx) {
+                    result[member[lane_idx]] = fit[time_idx].slope(lane_idx);
+                }
+            }
+        }
+        return result;
+    }
 }
@@ -7,45 +7,63 @@
 #define DERIVATIVESIGNAL_HPP_INCLUDE
 
 #include <memory>
+#include <vector>
 
 #include "Signal.hpp"
-#include "geopm/CircularBuffer.hpp"
 
 namespace geopm
 {
+    class DerivativeBatch;
+    class SlidingRegression;
+
     class DerivativeSignal : public Signal
     {
         public:
             DerivativeSignal(std::shared_ptr<Signal> time_sig,
                              std::shared_ptr<Signal> y_sig,
                              int read_loops, double sleep_time);
+            /// @brief Constructor for a signal that computes its
+            ///        derivative together with the other signals in
+            ///        a DerivativeBatch when sampled.  The batch must
+            ///        use the same time signal and history length.
+            DerivativeSignal(std::shared_ptr<Signal> time_sig,
+                             std::shared_ptr<Signal> y_sig,
+                             int read_loops, double sleep_time,
+                             std::shared_ptr<DerivativeBatch> batch);
             DerivativeSignal(const DerivativeSignal &other) = delete;
             DerivativeSignal &operator=(const DerivativeSignal &other) = delete;
-            virtual ~DerivativeSignal() = default;
+            virtual ~DerivativeSignal();
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Read many signals, sharing the sampling loop
+            ///        between the derivative signals.
+            ///
+            /// Derivative signals with the same history length and
+            /// sleep time are read together: each step of the loop
+            /// reads every underlying signal once and then sleeps
+            /// once, so the cost of the call is that of a single
+            /// derivative read() rather than one per signal.  Any
+            /// signal that is not a DerivativeSignal is read with
+            /// its read() method.
+            ///
+            /// @param [in] signal Signals to read.
+            ///
+            /// @return The values in the same order as the signals.
+            static std::vector<double> read_all(const std::vector<std::shared_ptr<Signal> > &signal);
         private:
-            struct m_sample_s {
-                double time;
-                double sample;
-            };
-
-            /// Update the history buffer and compute the new derivative.
-            /// The read() and sample() methods have separate history.
-            static double compute_next(CircularBuffer<m_sample_s> &history,
-                                       int &num_fit,
-                                       double time, double signal);
-
             std::shared_ptr<Signal> m_time_sig;
             std::shared_ptr<Signal> m_y_sig;
 
             const int M_NUM_SAMPLE_HISTORY;
-            CircularBuffer<m_sample_s> m_history;
-            int m_derivative_num_fit;
+            // The read() and sample() methods have separate history.
+            std::unique_ptr<SlidingRegression> m_fit;
+            std::shared_ptr<DerivativeBatch> m_batch;
+            int m_batch_idx;
             bool m_is_batch_ready;
+            bool m_is_sampled;
             double m_sleep_time;
-            double m_last_result;
+            double m_last_time;
     };
 }
 
@@ -17,6 +17,7 @@
 #include "CpuinfoIOGroup.hpp"
 #include "TimeIOGroup.hpp"
 #include "SSTIOGroup.hpp"
+#include "SysfsIOGroup.hpp"
 #include "geopm/Helper.hpp"
 #ifdef GEOPM_ENABLE_SYSTEMD
 #include "ServiceIOGroup.hpp"
@@ -78,12 +79,21 @@ namespace geopm
 
     IOGroupFactory::IOGroupFactory()
     {
+        // The SysfsIOGroup is loaded before all others so that the
+        // powercap and cpufreq files are only used for signals and
+        // controls that no other IOGroup provides, e.g. when the
+        // msr-safe driver is not loaded.  It only offers the files
+        // that the user is allowed to access.
+        register_plugin(SysfsIOGroup::plugin_name(),
+                        SysfsIOGroup::make_plugin);
         // Unless running as root add the ServiceIOGroup which will go
         // through D-Bus to access geopmd.  Note this IOGroup is
-        // loaded first and provides all signals and controls
-        // available from geopmd.  Any signal or control available
-        // without using the service will be used preferentially
-        // because this IOGroup is loaded first.  Also note that
+        // loaded second, after the SysfsIOGroup, and provides all
+        // signals and controls available from geopmd.  IOGroups
+        // loaded later take priority, so any signal or control
+        // available without using the service will be used
+        // preferentially, while the service is preferred over the
+        // SysfsIOGroup.  Also note that
         // creation of the ServiceIOGroup will open a session with the
         // service enabling save/restore by geopmd.  If the geopm
         // service is not active then loading the ServiceIOGroup will
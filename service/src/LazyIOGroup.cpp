@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "LazyIOGroup.hpp"
+
+#include "geopm/Agg.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_topo.h"
+
+namespace geopm
+{
+    LazyIOGroup::LazyIOGroup(const std::string &iogroup_name,
+                             const std::map<std::string, signal_s> &signal,
+                             const std::map<std::string, int> &control)
+        : LazyIOGroup(iogroup_name, signal, control,
+                      [iogroup_name]() {
+                          return IOGroup::make_unique(iogroup_name);
+                      })
+    {
+
+    }
+
+    LazyIOGroup::LazyIOGroup(const std::string &iogroup_name,
+                             const std::map<std::string, signal_s> &signal,
+                             const std::map<std::string, int> &control,
+                             std::function<std::unique_ptr<IOGroup>(void)> make_iogroup)
+        : m_name(iogroup_name)
+        , m_signal(signal)
+        , m_control(control)
+        , m_make_iogroup(make_iogroup)
+    {
+
+    }
+
+    // An IOGroup that could not be constructed provides nothing, so
+    // that PlatformIO uses the next IOGroup that provides the name
+    std::set<std::string> LazyIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        if (!is_failed()) {
+            for (const auto &sig : m_signal) {
+                result.insert(sig.first);
+            }
+        }
+        return result;
+    }
+
+    std::set<std::string> LazyIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        if (!is_failed()) {
+            for (const auto &con : m_control) {
+                result.insert(con.first);
+            }
+        }
+        return result;
+    }
+
+    bool LazyIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return !is_failed() && m_signal.find(signal_name) != m_signal.end();
+    }
+
+    bool LazyIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return !is_failed() && m_control.find(control_name) != m_control.end();
+    }
+
+    int LazyIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        auto it = m_signal.find(signal_name);
+        if (!is_failed() && it != m_signal.end()) {
+            result = it->second.domain_type;
+        }
+        return result;
+    }
+
+    int LazyIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        auto it = m_control.find(control_name);
+        if (!is_failed() && it != m_control.end()) {
+            result = it->second;
+        }
+        return result;
+    }
+
+    int LazyIOGroup::push_signal(const std::string &signal_name,
+                                 int domain_type,
+                                 int domain_idx)
+    {
+        return iogroup().push_signal(signal_name, domain_type, domain_idx);
+    }
+
+    int LazyIOGroup::push_control(const std::string &control_name,
+                                  int domain_type,
+                                  int domain_idx)
+    {
+        return iogroup().push_control(control_name, domain_type, domain_idx);
+    }
+
+    void LazyIOGroup::read_batch(void)
+    {
+        // Nothing has been pushed if the IOGroup was never needed
+        if (m_iogroup != nullptr) {
+            m_iogroup->read_batch();
+        }
+    }
+
+    void LazyIOGroup::write_batch(void)
+    {
+        if (m_iogroup != nullptr) {
+            m_iogroup->write_batch();
+        }
+    }
+
+    double LazyIOGroup::sample(int sample_idx)
+    {
+        return iogroup().sample(sample_idx);
+    }
+
+    void LazyIOGroup::adjust(int control_idx,
+                             double setting)
+    {
+        iogroup().adjust(control_idx, setting);
+    }
+
+    double LazyIOGroup::read_signal(const std::string &signal_name,
+                                    int domain_type,
+                                    int domain_idx)
+    {
+        return iogroup().read_signal(signal_name, domain_type, domain_idx);
+    }
+
+    std::vector<double> LazyIOGroup::read_signals(const std::vector<geopm_request_s> &request)
+    {
+        return BatchIOGroup::read_signals(iogroup(), request);
+    }
+
+    void LazyIOGroup::write_control(const std::string &control_name,
+                                    int domain_type,
+                                    int domain_idx,
+                                    double setting)
+    {
+        iogroup().write_control(control_name, domain_type, domain_idx, setting);
+    }
+
+    void LazyIOGroup::write_controls(const std::vector<geopm_request_s> &request,
+                                     const std::vector<double> &setting)
+    {
+        BatchIOGroup::write_controls(iogroup(), request, setting);
+    }
+
+    void LazyIOGroup::save_control(void)
+    {
+        // An IOGroup without controls has nothing to save or
+        // restore, so the save and restore methods do not construct
+        // it.  Neither does an IOGroup that cannot be constructed.
+        if (!m_control.empty() && try_load()) {
+            m_iogroup->save_control();
+        }
+    }
+
+    void LazyIOGroup::restore_control(void)
+    {
+        if (!m_control.empty() && try_load()) {
+            m_iogroup->restore_control();
+        }
+    }
+
+    std::function<double(const std::vector<double> &)> LazyIOGroup::agg_function(const std::string &signal_name) const
+    {
+        return Agg::type_to_function(signal(signal_name, "agg_function").agg_type);
+    }
+
+    std::function<std::string(double)> LazyIOGroup::format_function(const std::string &signal_name) const
+    {
+        return string_format_type_to_function(signal(signal_name, "format_function").format_type);
+    }
+
+    std::string LazyIOGroup::signal_description(const std::string &signal_name) const
+    {
+        return iogroup().signal_description(signal_name);
+    }
+
+    std::string LazyIOGroup::control_description(const std::string &control_name) const
+    {
+        return iogroup().control_description(control_name);
+    }
+
+    int LazyIOGroup::signal_behavior(const std::string &signal_name) const
+    {
+        return signal(signal_name, "signal_behavior").behavior;
+    }
+
+    void LazyIOGroup::save_control(const std::string &save_path)
+    {
+        if (!m_control.empty() && try_load()) {
+            m_iogroup->save_control(save_path);
+        }
+    }
+
+    void LazyIOGroup::restore_control(const std::string &save_path)
+    {
+        if (!m_control.empty() && try_load()) {
+            m_iogroup->restore_control(save_path);
+        }
+    }
+
+    std::string LazyIOGroup::name(void) const
+    {
+        return m_name;
+    }
+
+    bool LazyIOGroup::is_loaded(void) const
+    {
+        return m_iogroup != nullptr;
+    }
+
+    IOGroup &LazyIOGroup::iogroup(void) const
+    {
+        if (!try_load()) {
+            std::rethrow_exception(m_load_error);
+        }
+        return *m_iogroup;
+    }
+
+    bool LazyIOGroup::try_load(void) const
+    {
+        if (m_iogroup == nullptr && !is_failed()) {
+            try {
+                m_iogroup = m_make_iogroup();
+            }
+            catch (...) {
+                m_load_error = std::current_exception();
+            }
+        }
+        return m_iogroup != nullptr;
+    }
+
+    bool LazyIOGroup::is_failed(void) const
+    {
+        return m_load_error != nullptr;
+    }
+
+    const LazyIOGroup::signal_s &LazyIOGroup::signal(const std::string &signal_name,
+                                                     const std::string &func) const
+    {
+        auto it = m_signal.find(signal_name);
+        if (it == m_signal.end()) {
+            throw Exception("LazyIOGroup::" + func + "(): signal_name " + signal_name +
+                            " not valid for " + m_name + " IOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef LAZYIOGROUP_HPP_INCLUDE
+#define LAZYIOGROUP_HPP_INCLUDE
+
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "geopm/IOGroup.hpp"
+#include "geopm/BatchIOGroup.hpp"
+
+namespace geopm
+{
+    /// @brief IOGroup that describes the signals and controls of
+    ///        another IOGroup from the PlatformIO cache file and
+    ///        only constructs that IOGroup when it is needed to read,
+    ///        write or describe a signal or control.  If the
+    ///        construction fails it is not attempted again: the
+    ///        error is rethrown and the LazyIOGroup no longer
+    ///        provides any signal or control.
+    class LazyIOGroup : public IOGroup, public BatchIOGroup
+    {
+        public:
+            /// @brief Properties of a signal recorded in the cache.
+            struct signal_s {
+                int domain_type;
+                int behavior;
+                int agg_type;
+                int format_type;
+            };
+            /// @param [in] iogroup_name Name of the IOGroup plugin.
+            ///
+            /// @param [in] signal Map from signal name to the
+            ///        properties recorded in the cache.
+            ///
+            /// @param [in] control Map from control name to its
+            ///        domain type.
+            LazyIOGroup(const std::string &iogroup_name,
+                        const std::map<std::string, signal_s> &signal,
+                        const std::map<std::string, int> &control);
+            LazyIOGroup(const std::string &iogroup_name,
+                        const std::map<std::string, signal_s> &signal,
+                        const std::map<std::string, int> &control,
+                        std::function<std::unique_ptr<IOGroup>(void)> make_iogroup);
+            virtual ~LazyIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name,
+                            int domain_type,
+                            int domain_idx) override;
+            int push_control(const std::string &control_name,
+                             int domain_type,
+                             int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int sample_idx) override;
+            void adjust(int control_idx,
+                        double setting) override;
+            double read_signal(const std::string &signal_name,
+                               int domain_type,
+                               int domain_idx) override;
+            std::vector<double> read_signals(const std::vector<geopm_request_s> &request) override;
+            void write_control(const std::string &control_name,
+                               int domain_type,
+                               int domain_idx,
+                               double setting) override;
+            void write_controls(const std::vector<geopm_request_s> &request,
+                                const std::vector<double> &setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)> format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            int signal_behavior(const std::string &signal_name) const override;
+            void save_control(const std::string &save_path) override;
+            void restore_control(const std::string &save_path) override;
+            std::string name(void) const override;
+            /// @brief True once the cached IOGroup has been
+            ///        constructed.
+            bool is_loaded(void) const;
+        private:
+            /// @brief Construct the IOGroup on first use.  Rethrows
+            ///        the error of a failed construction.
+            IOGroup &iogroup(void) const;
+            /// @brief Construct the IOGroup on first use.
+            ///
+            /// @return False if the construction failed.
+            bool try_load(void) const;
+            /// @brief True if the construction of the IOGroup was
+            ///        attempted and failed.
+            bool is_failed(void) const;
+            const signal_s &signal(const std::string &signal_name,
+                                   const std::string &func) const;
+            const std::string m_name;
+            const std::map<std::string, signal_s> m_signal;
+            const std::map<std::string, int> m_control;
+            const std::function<std::unique_ptr<IOGroup>(void)> m_make_iogroup;
+            mutable std::unique_ptr<IOGroup> m_iogroup;
+            mutable std::exception_ptr m_load_error;
+    };
+}
+
+#endif
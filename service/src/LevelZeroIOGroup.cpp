@@ -17,7 +17,9 @@
 
 #include "geopm/IOGroup.hpp"
 #include "Signal.hpp"
+#include "DerivativeBatch.hpp"
 #include "DerivativeSignal.hpp"
+#include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "LevelZeroDevicePool.hpp"
 #include "LevelZero.hpp"
@@ -45,6 +47,7 @@ namespace geopm
         : m_platform_topo(platform_topo)
         , m_levelzero_device_pool(device_pool)
         , m_is_batch_read(false)
+        , m_is_batch_query(false)
         , m_signal_available({{M_NAME_PREFIX + "GPU_CORE_FREQUENCY_STATUS", {
                                   "The current frequency of the GPU Compute Hardware.",
                                   GEOPM_DOMAIN_GPU_CHIP,
@@ -141,10 +144,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return (this->m_levelzero_device_pool.frequency_range(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_COMPUTE)).second;
+                                      return this->read_frequency_range(domain_idx, true);
                                   },
                                   1e6
                                   }},
@@ -173,10 +173,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.energy(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_energy(GEOPM_DOMAIN_GPU_CHIP, domain_idx, false);
                                   },
                                   1 / 1e6
                                   }},
@@ -189,10 +186,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return (this->m_levelzero_device_pool.frequency_range(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_COMPUTE)).first;
+                                      return this->read_frequency_range(domain_idx, false);
                                   },
                                   1e6
                                   }},
@@ -206,10 +200,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.energy_timestamp(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_energy(GEOPM_DOMAIN_GPU_CHIP, domain_idx, true);
                                   },
                                   1 / 1e6
                                   }},
@@ -222,10 +213,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.energy(
-                                                   GEOPM_DOMAIN_GPU,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_energy(GEOPM_DOMAIN_GPU, domain_idx, false);
                                   },
                                   1 / 1e6
                                   }},
@@ -239,10 +227,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.energy_timestamp(
-                                                   GEOPM_DOMAIN_GPU,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_energy(GEOPM_DOMAIN_GPU, domain_idx, true);
                                   },
                                   1 / 1e6
                                   }},
@@ -352,10 +337,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_ALL, false);
                                   },
                                   1 / 1e6
                                   }},
@@ -370,10 +352,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time_timestamp(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_ALL);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_ALL, true);
                                   },
                                   1 / 1e6
                                   }},
@@ -387,10 +366,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_COMPUTE);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_COMPUTE, false);
                                   },
                                   1 / 1e6
                                   }},
@@ -405,10 +381,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time_timestamp(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_COMPUTE);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_COMPUTE, true);
                                   },
                                   1 / 1e6
                                   }},
@@ -422,10 +395,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_MEMORY);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_MEMORY, false);
                                   },
                                   1 / 1e6
                                   }},
@@ -440,10 +410,7 @@ namespace geopm
                                   {},
                                   [this](unsigned int domain_idx) -> double
                                   {
-                                      return this->m_levelzero_device_pool.active_time_timestamp(
-                                                   GEOPM_DOMAIN_GPU_CHIP,
-                                                   domain_idx,
-                                                   geopm::LevelZero::M_DOMAIN_MEMORY);
+                                      return this->read_active_time(domain_idx, geopm::LevelZero::M_DOMAIN_MEMORY, true);
                                   },
                                   1 / 1e6
                                   }},
@@ -687,6 +654,8 @@ namespace geopm
     void LevelZeroIOGroup::register_derivative_signals(void) {
         int derivative_window = 8;
         double sleep_time = 0.005;
+        // Derivatives that share a time signal are updated together
+        std::map<std::shared_ptr<Signal>, std::shared_ptr<DerivativeBatch> > batch_map;
 
         for (const auto &ds : m_derivative_signal_map) {
             auto read_it = m_signal_available.find(ds.second.m_base_name);
@@ -709,10 +678,15 @@ namespace geopm
                 for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
                     auto read = readings[domain_idx];
                     auto time = time_sig[domain_idx];
+                    auto &batch = batch_map[time];
+                    if (batch == nullptr) {
+                        batch = std::make_shared<DerivativeBatch>(time, derivative_window);
+                    }
                     result[domain_idx] =
                         std::make_shared<DerivativeSignal>(time, read,
                                                            derivative_window,
-                                                           sleep_time);
+                                                           sleep_time,
+                                                           batch);
                 }
                 m_signal_available[ds.first] = {ds.second.m_description + "\n    alias_for: " +
                                                 ds.second.m_base_name + " rate of change",
@@ -923,14 +897,105 @@ namespace geopm
     void LevelZeroIOGroup::read_batch(void)
     {
         m_is_batch_read = true;
-        for (size_t ii = 0; ii < m_signal_pushed.size(); ++ii) {
-            // If the current signal index (ii) is in the derivative_signal_pushed_set do not read().
-            // Derivative signals are comprised of base signals, and thus cannot be read directly.
-            // The base signals are automatically pushed when a derivative signal is requested.
-            if (m_derivative_signal_pushed_set.find(ii) == m_derivative_signal_pushed_set.end()) {
-                m_signal_pushed[ii]->set_sample(m_signal_pushed[ii]->read());
+        // Results of device queries that serve more than one signal are
+        // only valid for the duration of a single batch
+        for (auto &query : m_query_cache) {
+            query.second.is_valid = false;
+        }
+        m_is_batch_query = true;
+        try {
+            for (size_t ii = 0; ii < m_signal_pushed.size(); ++ii) {
+                // If the current signal index (ii) is in the derivative_signal_pushed_set do not read().
+                // Derivative signals are comprised of base signals, and thus cannot be read directly.
+                // The base signals are automatically pushed when a derivative signal is requested.
+                if (m_derivative_signal_pushed_set.find(ii) == m_derivative_signal_pushed_set.end()) {
+                    m_signal_pushed[ii]->set_sample(m_signal_pushed[ii]->read());
+                }
             }
         }
+        catch (...) {
+            m_is_batch_query = false;
+            throw;
+        }
+        m_is_batch_query = false;
+    }
+
+    std::pair<double, double> LevelZeroIOGroup::batch_query(int query, int domain,
+                                                            unsigned int domain_idx,
+                                                            int l0_domain)
+    {
+        query_s &cached = m_query_cache[std::make_tuple(query, domain, domain_idx, l0_domain)];
+        if (!cached.is_valid) {
+            switch (query) {
+                case M_QUERY_ENERGY:
+                    cached.value = m_levelzero_device_pool.energy_pair(domain, domain_idx, l0_domain);
+                    break;
+                case M_QUERY_ACTIVE_TIME:
+                    cached.value = m_levelzero_device_pool.active_time_pair(domain, domain_idx, l0_domain);
+                    break;
+                case M_QUERY_FREQUENCY_RANGE:
+                    cached.value = m_levelzero_device_pool.frequency_range(domain, domain_idx, l0_domain);
+                    break;
+                default:
+                    throw Exception("LevelZeroIOGroup::" + std::string(__func__) +
+                                    ": unknown query type " + std::to_string(query),
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            cached.is_valid = true;
+        }
+        return cached.value;
+    }
+
+    double LevelZeroIOGroup::read_energy(int domain, unsigned int domain_idx, bool is_timestamp)
+    {
+        double result = NAN;
+        if (m_is_batch_query) {
+            auto energy = batch_query(M_QUERY_ENERGY, domain, domain_idx,
+                                      geopm::LevelZero::M_DOMAIN_ALL);
+            result = is_timestamp ? energy.second : energy.first;
+        }
+        else if (is_timestamp) {
+            result = m_levelzero_device_pool.energy_timestamp(domain, domain_idx,
+                                                              geopm::LevelZero::M_DOMAIN_ALL);
+        }
+        else {
+            result = m_levelzero_device_pool.energy(domain, domain_idx,
+                                                    geopm::LevelZero::M_DOMAIN_ALL);
+        }
+        return result;
+    }
+
+    double LevelZeroIOGroup::read_active_time(unsigned int domain_idx, int l0_domain, bool is_timestamp)
+    {
+        double result = NAN;
+        if (m_is_batch_query) {
+            auto active_time = batch_query(M_QUERY_ACTIVE_TIME, GEOPM_DOMAIN_GPU_CHIP,
+                                           domain_idx, l0_domain);
+            result = is_timestamp ? active_time.second : active_time.first;
+        }
+        else if (is_timestamp) {
+            result = m_levelzero_device_pool.active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP,
+                                                                   domain_idx, l0_domain);
+        }
+        else {
+            result = m_levelzero_device_pool.active_time(GEOPM_DOMAIN_GPU_CHIP,
+                                                         domain_idx, l0_domain);
+        }
+        return result;
+    }
+
+    double LevelZeroIOGroup::read_frequency_range(unsigned int domain_idx, bool is_max)
+    {
+        std::pair<double, double> range;
+        if (m_is_batch_query) {
+            range = batch_query(M_QUERY_FREQUENCY_RANGE, GEOPM_DOMAIN_GPU_CHIP,
+                                domain_idx, geopm::LevelZero::M_DOMAIN_COMPUTE);
+        }
+        else {
+            range = m_levelzero_device_pool.frequency_range(GEOPM_DOMAIN_GPU_CHIP, domain_idx,
+                                                            geopm::LevelZero::M_DOMAIN_COMPUTE);
+        }
+        return is_max ? range.second : range.first;
     }
 
     // Write all controls that have been pushed and adjusted
@@ -1008,38 +1073,68 @@ namespace geopm
     // Should not modify m_signal_value
     double LevelZeroIOGroup::read_signal(const std::string &signal_name,
                                          int domain_type, int domain_idx)
+    {
+        double result = NAN;
+        auto signal = check_read_signal(signal_name, domain_type, domain_idx);
+        if (signal != nullptr) {
+            result = signal->read();
+        }
+        return result;
+    }
+
+    // Read all requests, sharing the sampling loop of the derivative
+    // signals, bypassing read_batch()
+    std::vector<double> LevelZeroIOGroup::read_signals(const std::vector<geopm_request_s> &request)
+    {
+        std::vector<double> result(request.size(), NAN);
+        std::vector<std::shared_ptr<Signal> > signal;
+        std::vector<size_t> signal_req_idx;
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const auto &req = request[req_idx];
+            auto sig = check_read_signal(req.name, req.domain_type, req.domain_idx);
+            if (sig != nullptr) {
+                signal.push_back(sig);
+                signal_req_idx.push_back(req_idx);
+            }
+        }
+        std::vector<double> value = DerivativeSignal::read_all(signal);
+        for (size_t sig_idx = 0; sig_idx < value.size(); ++sig_idx) {
+            result[signal_req_idx[sig_idx]] = value[sig_idx];
+        }
+        return result;
+    }
+
+    std::shared_ptr<Signal> LevelZeroIOGroup::check_read_signal(const std::string &signal_name,
+                                                                int domain_type, int domain_idx)
     {
         if (!is_valid_signal(signal_name)) {
-            throw Exception("LevelZeroIOGroup::" + std::string(__func__) +
-                            ": " + signal_name + " not valid for LevelZeroIOGroup",
+            throw Exception("LevelZeroIOGroup::read_signal(): " + signal_name +
+                            " not valid for LevelZeroIOGroup",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         if (domain_type != signal_domain_type(signal_name)) {
-            throw Exception("LevelZeroIOGroup::" + std::string(__func__) + ": "
-                            + signal_name + ": domain_type must be " +
+            throw Exception("LevelZeroIOGroup::read_signal(): " + signal_name +
+                            ": domain_type must be " +
                             std::to_string(signal_domain_type(signal_name)),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         if (domain_idx < 0 ||
             domain_idx >= m_platform_topo.num_domain(signal_domain_type(signal_name))) {
-            throw Exception("LevelZeroIOGroup::" + std::string(__func__) +
-                            ": domain_idx out of range.", GEOPM_ERROR_INVALID,
-                            __FILE__, __LINE__);
+            throw Exception("LevelZeroIOGroup::read_signal(): domain_idx out of range.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         if (string_ends_with(signal_name, "_TIMESTAMP")) {
-            throw Exception("LevelZeroIOGroup::" + std::string(__func__) +
-                            ": TIMESTAMP Signals are for batch use only.",
+            throw Exception("LevelZeroIOGroup::read_signal(): TIMESTAMP Signals are for batch use only.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        double result = NAN;
+        std::shared_ptr<Signal> result;
         auto it = m_signal_available.find(signal_name);
         if (it != m_signal_available.end()) {
-            result = (it->second.m_signals.at(domain_idx))->read();
+            result = it->second.m_signals.at(domain_idx);
         }
         else {
     #ifdef GEOPM_DEBUG
-            throw Exception("LevelZeroIOGroup::" + std::string(__func__) +
-                            ": Handling not defined for " + signal_name,
+            throw Exception("LevelZeroIOGroup::read_signal(): Handling not defined for " + signal_name,
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
     #endif
         }
@@ -1100,6 +1195,20 @@ namespace geopm
         }
     }
 
+    // Write each request immediately in order, bypassing write_batch()
+    void LevelZeroIOGroup::write_controls(const std::vector<geopm_request_s> &request,
+                                          const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("LevelZeroIOGroup::write_controls(): number of settings does not match the number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const auto &req = request[req_idx];
+            write_control(req.name, req.domain_type, req.domain_idx, setting[req_idx]);
+        }
+    }
+
     // Implemented to allow an IOGroup to save platform settings before starting
     // to adjust them
     void LevelZeroIOGroup::save_control(void)
@@ -11,8 +11,10 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <tuple>
 
 #include "geopm/IOGroup.hpp"
+#include "geopm/BatchIOGroup.hpp"
 #include "LevelZeroSignal.hpp"
 
 namespace geopm
@@ -22,7 +24,7 @@ namespace geopm
     class SaveControl;
 
     /// @brief IOGroup that provides signals and controls for GPUs
-    class LevelZeroIOGroup : public IOGroup
+    class LevelZeroIOGroup : public IOGroup, public BatchIOGroup
     {
         public:
             LevelZeroIOGroup();
@@ -46,8 +48,11 @@ namespace geopm
             void adjust(int batch_idx, double setting) override;
             double read_signal(const std::string &signal_name, int domain_type,
                                int domain_idx) override;
+            std::vector<double> read_signals(const std::vector<geopm_request_s> &request) override;
             void write_control(const std::string &control_name, int domain_type,
                                int domain_idx, double setting) override;
+            void write_controls(const std::vector<geopm_request_s> &request,
+                                const std::vector<double> &setting) override;
             void save_control(void) override;
             void restore_control(void) override;
             std::function<double(const std::vector<double> &)> agg_function(
@@ -66,6 +71,20 @@ namespace geopm
             static std::unique_ptr<IOGroup> make_plugin(void);
         private:
             void init(void);
+            /// @brief Check a request made through read_signal() or
+            ///        read_signals() and return the signal to read,
+            ///        or nullptr if the signal has no handling.
+            std::shared_ptr<Signal> check_read_signal(const std::string &signal_name,
+                                                      int domain_type, int domain_idx);
+
+            // Within read_batch() each query is issued once per device and
+            // the result is shared by every signal derived from it
+            std::pair<double, double> batch_query(int query, int domain,
+                                                  unsigned int domain_idx,
+                                                  int l0_domain);
+            double read_energy(int domain, unsigned int domain_idx, bool is_timestamp);
+            double read_active_time(unsigned int domain_idx, int l0_domain, bool is_timestamp);
+            double read_frequency_range(unsigned int domain_idx, bool is_max);
 
             void register_derivative_signals(void);
             void register_signal_alias(const std::string &alias_name,
@@ -97,6 +116,17 @@ namespace geopm
                 std::function<std::string(double)> m_format_function;
             };
 
+            enum m_query_e {
+                M_QUERY_ENERGY,
+                M_QUERY_ACTIVE_TIME,
+                M_QUERY_FREQUENCY_RANGE,
+            };
+
+            struct query_s {
+                bool is_valid;
+                std::pair<double, double> value;
+            };
+
             struct derivative_signal_info
             {
                 std::string m_description;
@@ -111,6 +141,7 @@ namespace geopm
             const PlatformTopo &m_platform_topo;
             const LevelZeroDevicePool &m_levelzero_device_pool;
             bool m_is_batch_read;
+            bool m_is_batch_query;
 
             std::map<std::string, signal_info> m_signal_available;
             std::map<std::string, control_info> m_control_available;
@@ -119,6 +150,8 @@ namespace geopm
             const std::set<std::string> m_special_signal_set;
             std::map<std::string, derivative_signal_info> m_derivative_signal_map;
             std::set<int> m_derivative_signal_pushed_set;
+            // Keyed by query type, domain, domain index and Level Zero domain
+            std::map<std::tuple<int, int, unsigned int, int>, query_s> m_query_cache;
 
             //GEOPM Domain indexed
             std::vector<std::pair<double,double> > m_frequency_range;
@@ -126,6 +126,13 @@ namespace geopm
         m_msrio->write_msr(m_cpu, m_offset, encode(value), m_mask);
     }
 
+    void MSRFieldControl::add_write(double value, int batch_ctx)
+    {
+        GEOPM_DEBUG_ASSERT(m_msrio != nullptr, "null MSRIO");
+        int batch_idx = m_msrio->add_write(m_cpu, m_offset, batch_ctx);
+        m_msrio->adjust(batch_idx, encode(value), m_mask, batch_ctx);
+    }
+
     void MSRFieldControl::save(void)
     {
         GEOPM_DEBUG_ASSERT(m_msrio != nullptr, "null MSRIO");
@@ -39,6 +39,15 @@ namespace geopm
             void write(double value) override;
             void save(void) override;
             void restore(void) override;
+            /// @brief Add a write of the value to one of the batch
+            ///        contexts of the MSRIO object.  The MSR is
+            ///        modified by the next call to
+            ///        MSRIO::write_batch() for the context, combined
+            ///        with any other fields of the same MSR.
+            /// @param [in] value Setting in SI units.
+            /// @param [in] batch_ctx Batch context created with
+            ///        MSRIO::create_batch_context().
+            void add_write(double value, int batch_ctx);
         private:
             uint64_t encode(double value) const;
 
@@ -35,6 +35,11 @@ namespace geopm
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Signal for the raw MSR that contains the field.
+            std::shared_ptr<Signal> raw_msr(void) const;
+            /// @brief Decode the field from a value of the raw MSR
+            ///        signal in the same way as read().
+            double convert(double raw_value) const;
         private:
             double convert_raw_value(double val,
                                      uint64_t &last_field,
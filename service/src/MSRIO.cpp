@@ -12,8 +12,10 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <cstdint>
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 #include "geopm_error.h"
 #include "geopm_sched.h"
@@ -54,6 +56,8 @@ namespace geopm
         , m_path(std::move(path))
         , m_batch_reader(std::move(batch_reader))
         , m_batch_writer(std::move(batch_writer))
+        , m_batch_reader_depth(m_batch_reader == nullptr ? 0 : UINT32_MAX)
+        , m_batch_writer_depth(m_batch_writer == nullptr ? 0 : UINT32_MAX)
     {
         create_batch_context();
         open_all();
@@ -160,11 +164,29 @@ namespace geopm
 
     int MSRIOImp::create_batch_context(void)
     {
+        if (!m_free_batch_context.empty()) {
+            int ctx = m_free_batch_context.back();
+            m_free_batch_context.pop_back();
+            return ctx;
+        }
         int ctx = static_cast<int>(m_batch_context.size());
         m_batch_context.emplace_back(m_num_cpu);
         return ctx;
     }
 
+    void MSRIOImp::release_batch_context(int batch_ctx)
+    {
+        if (batch_ctx <= 0 || (size_t)batch_ctx >= m_batch_context.size() ||
+            std::find(m_free_batch_context.begin(), m_free_batch_context.end(),
+                      batch_ctx) != m_free_batch_context.end()) {
+            throw Exception("MSRIOImp::release_batch_context(): invalid batch context: " +
+                            std::to_string(batch_ctx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_batch_context[batch_ctx] = m_batch_context_s(m_num_cpu);
+        m_free_batch_context.push_back(batch_ctx);
+    }
+
     int MSRIOImp::add_write(int cpu_idx, uint64_t offset)
     {
         return add_write(cpu_idx, offset, 0);
@@ -236,19 +258,27 @@ namespace geopm
 
     int MSRIOImp::add_read(int cpu_idx, uint64_t offset, int batch_ctx)
     {
-        /// @todo return same index for repeated calls with same inputs.
-        m_msr_batch_op_s rd {
-            .cpu = (uint16_t)cpu_idx,
-            .isrdmsr = 1,
-            .err = 0,
-            .msr = (uint32_t)offset,
-            .msrdata = 0,
-            .wmask = 0
-        };
         m_batch_context_s &ctx = m_batch_context.at(batch_ctx);
-        int idx = ctx.m_read_batch_op.size();
-        ctx.m_read_batch_op.push_back(rd);
-        return idx;
+        int result = -1;
+        auto &context = ctx.m_read_batch_idx_map.at(cpu_idx);
+        auto batch_it = context.find(offset);
+        if (batch_it == context.end()) {
+            result = ctx.m_read_batch_op.size();
+            m_msr_batch_op_s rd {
+                .cpu = (uint16_t)cpu_idx,
+                .isrdmsr = 1,
+                .err = 0,
+                .msr = (uint32_t)offset,
+                .msrdata = 0,
+                .wmask = 0
+            };
+            ctx.m_read_batch_op.push_back(rd);
+            context[offset] = result;
+        }
+        else {
+            result = batch_it->second;
+        }
+        return result;
     }
 
     uint64_t MSRIOImp::sample(int batch_idx) const
@@ -344,8 +374,11 @@ namespace geopm
                            "Batch operations not updated prior to calling "
                            "MSRIOImp::msr_read_files()");
 
-        if (!m_batch_reader) {
+        // Batch contexts differ in size, make sure the queue can
+        // hold the largest one that has been read
+        if (m_batch_reader_depth < read_batch.numops) {
             m_batch_reader = IOUring::make_unique(read_batch.numops);
+            m_batch_reader_depth = read_batch.numops;
         }
         msr_batch_io(*m_batch_reader, read_batch);
     }
@@ -403,8 +436,9 @@ namespace geopm
                            "Batch operations not updated prior to calling "
                            "MSRIOImp::msr_rmw_files()");
 
-        if (!m_batch_writer) {
+        if (m_batch_writer_depth < write_batch.numops) {
             m_batch_writer = IOUring::make_unique(write_batch.numops);
+            m_batch_writer_depth = write_batch.numops;
         }
 
         // Read existing MSR values
@@ -44,6 +44,14 @@ namespace geopm
             /// @return The context index that can be passed to future batch
             ///         methods to refer to the added context.
             virtual int create_batch_context(void) = 0;
+            /// @brief Remove all operations from a batch context
+            ///        that was added with create_batch_context().
+            ///        The index may be returned by a later call to
+            ///        create_batch_context().  The default batch
+            ///        context cannot be released.
+            /// @param [in] batch_ctx index of the batch context to
+            ///        release.
+            virtual void release_batch_context(int batch_ctx) = 0;
             /// @brief Extend the set of MSRs for batch read with a single offset.
             ///        Note: uses the default batch context.
             /// @param [in] cpu_idx logical Linux CPU index to read from when
@@ -24,17 +24,20 @@
 #include "geopm/Agg.hpp"
 #include "MSRIOImp.hpp"
 #include "MSR.hpp"
+#include "msr_data.hpp"
 #include "Signal.hpp"
 #include "RawMSRSignal.hpp"
 #include "MSRFieldSignal.hpp"
 #include "DifferenceSignal.hpp"
 #include "TimeSignal.hpp"
+#include "DerivativeBatch.hpp"
 #include "DerivativeSignal.hpp"
 #include "RatioSignal.hpp"
 #include "MultiplicationSignal.hpp"
 #include "Control.hpp"
 #include "MSRFieldControl.hpp"
 #include "DomainControl.hpp"
+#include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm_debug.hpp"
@@ -45,12 +48,6 @@ using json11::Json;
 
 namespace geopm
 {
-    const std::string arch_msr_json(void);
-    const std::string knl_msr_json(void);
-    const std::string hsx_msr_json(void);
-    const std::string snb_msr_json(void);
-    const std::string skx_msr_json(void);
-
     const std::string MSRIOGroup::M_DEFAULT_DESCRIPTION =
         "Refer to the Intel(R) 64 and IA-32 Architectures Software Developer's "
         "Manual for information about this MSR";
@@ -61,6 +58,47 @@ namespace geopm
     // Return true if turbo ratio limits are writable in all domains that
     // report writability.  Return false otherwise. In debug builds, print a
     // warning if there is mixed writability across domains.
+    static bool is_trl_writable_in_all_domains(uint64_t platform_info_offset,
+                                               int domain_type,
+                                               int begin_bit, int end_bit,
+                                               int function, double scalar,
+                                               const PlatformTopo &topo,
+                                               std::shared_ptr<MSRIO> msrio)
+    {
+        bool is_writable = false;
+        int num_domain = topo.num_domain(domain_type);
+        int num_domain_with_writable_trl = 0;
+        for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+            std::set<int> cpus = topo.domain_nested(
+                GEOPM_DOMAIN_CPU, domain_type, domain_idx);
+            int cpu_idx = *(cpus.begin());
+            auto platform_info_msr = std::make_shared<RawMSRSignal>(
+                msrio, cpu_idx, platform_info_offset);
+            auto trl_mode_signal = geopm::make_unique<MSRFieldSignal>(
+                platform_info_msr, begin_bit, end_bit, function, scalar);
+
+            num_domain_with_writable_trl += trl_mode_signal->read() != 0;
+        }
+
+        if (num_domain_with_writable_trl == num_domain) {
+            is_writable = true;
+        }
+        else if (num_domain_with_writable_trl != 0) {
+#ifdef GEOPM_DEBUG
+            std::cerr
+                << "Warning: <geopm> " << num_domain_with_writable_trl
+                << " out of " << num_domain
+                << " entries for PROGRAMMABLE_RATIO_LIMITS_TURBO_MODE "
+                   "indicate writable turbo ratio limits; defaulting "
+                   "to no writable turbo ratio limits"
+                << std::endl;
+#endif
+        }
+        return is_writable;
+    }
+
+    // Check turbo ratio limit writability if the JSON data defines
+    // the PLATFORM_INFO field that reports it.
     static bool is_trl_writable_in_all_domains(const Json &msr_json,
                                                const PlatformTopo &topo,
                                                std::shared_ptr<MSRIO> msrio)
@@ -79,43 +117,39 @@ namespace geopm
             auto trl_mode_it = items.find("PROGRAMMABLE_RATIO_LIMITS_TURBO_MODE");
 
             if (trl_mode_it != items.end()) {
-                auto begin_bit = (int)(trl_mode_it->second["begin_bit"].number_value());
-                auto end_bit = (int)(trl_mode_it->second["end_bit"].number_value());
-                int function = MSR::string_to_function(
-                    trl_mode_it->second["function"].string_value());
-                double scalar = trl_mode_it->second["scalar"].number_value();
-
-                int num_domain = topo.num_domain(domain_type);
-                int num_domain_with_writable_trl = 0;
-                for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
-                    std::set<int> cpus = topo.domain_nested(
-                        GEOPM_DOMAIN_CPU, domain_type, domain_idx);
-                    int cpu_idx = *(cpus.begin());
-                    auto platform_info_msr = std::make_shared<RawMSRSignal>(
-                        msrio, cpu_idx, platform_info_offset);
-                    auto trl_mode_signal = geopm::make_unique<MSRFieldSignal>(
-                        platform_info_msr, begin_bit, end_bit, function, scalar);
-
-                    num_domain_with_writable_trl += trl_mode_signal->read() != 0;
-                }
+                is_writable = is_trl_writable_in_all_domains(
+                    platform_info_offset, domain_type,
+                    (int)(trl_mode_it->second["begin_bit"].number_value()),
+                    (int)(trl_mode_it->second["end_bit"].number_value()),
+                    MSR::string_to_function(trl_mode_it->second["function"].string_value()),
+                    trl_mode_it->second["scalar"].number_value(),
+                    topo, msrio);
+            }
+        }
+        return is_writable;
+    }
 
-                if (num_domain_with_writable_trl == num_domain) {
-                    is_writable = true;
-                }
-                else if (num_domain_with_writable_trl != 0) {
-#ifdef GEOPM_DEBUG
-                    std::cerr
-                        << "Warning: <geopm> " << num_domain_with_writable_trl
-                        << " out of " << num_domain
-                        << " entries for PROGRAMMABLE_RATIO_LIMITS_TURBO_MODE "
-                           "indicate writable turbo ratio limits; defaulting "
-                           "to no writable turbo ratio limits"
-                        << std::endl;
-#endif
+    // Check turbo ratio limit writability if the compiled table
+    // defines the PLATFORM_INFO field that reports it.
+    static bool is_trl_writable_in_all_domains(const msr_table_s &table,
+                                               const PlatformTopo &topo,
+                                               std::shared_ptr<MSRIO> msrio)
+    {
+        bool is_writable = false;
+        for (size_t msr_idx = 0; msr_idx < table.num_msr; ++msr_idx) {
+            const msr_s &msr = table.msr[msr_idx];
+            if (std::string(msr.name) != "PLATFORM_INFO") {
+                continue;
+            }
+            for (size_t field_idx = 0; field_idx < msr.num_field; ++field_idx) {
+                const msr_field_s &field = msr.field[field_idx];
+                if (std::string(field.name) == "PROGRAMMABLE_RATIO_LIMITS_TURBO_MODE") {
+                    is_writable = is_trl_writable_in_all_domains(
+                        msr.offset, msr.domain_type, field.begin_bit, field.end_bit,
+                        field.function, field.scalar, topo, msrio);
                 }
             }
         }
-
         return is_writable;
     }
 
@@ -163,10 +197,10 @@ namespace geopm
         , m_mock_save_ctl(std::move(save_control))
     {
         // Load available signals and controls from files
-        parse_json_msrs(arch_msr_json());
+        parse_msr_table(arch_msr_table());
         try {
             // Try to extend list of MSRs if CPUID is recognized
-            parse_json_msrs(platform_data(m_cpuid));
+            parse_msr_table(platform_table(m_cpuid));
         }
         catch (const Exception &ex) {
             // Only load architectural MSRs
@@ -387,6 +421,7 @@ namespace geopm
         // register time signal; domain board
         std::string time_name = "MSR::TIME";
         std::shared_ptr<Signal> time_sig = std::make_shared<TimeSignal>(m_time_zero, m_time_batch);
+        m_derivative_batch = std::make_shared<DerivativeBatch>(time_sig, m_derivative_window);
         m_signal_available[time_name] = {std::vector<std::shared_ptr<Signal> >({time_sig}),
                                          GEOPM_DOMAIN_BOARD,
                                          IOGroup::M_UNITS_SECONDS,
@@ -432,7 +467,8 @@ namespace geopm
                     result[domain_idx] =
                         std::make_shared<DerivativeSignal>(time_sig, eng,
                                                            m_derivative_window,
-                                                           m_sleep_time);
+                                                           m_sleep_time,
+                                                           m_derivative_batch);
                 }
                 m_signal_available[signal_name] = {std::move(result),
                                                    energy_domain,
@@ -465,9 +501,6 @@ namespace geopm
         }
         std::shared_ptr<Signal> time_sig = time_it->second.signals.at(0);
 
-        int derivative_window = 8;
-        double sleep_time = 0.005;  // 5000 us
-
         // Mapping of high-level signal name to description and
         // underlying CNT MSRs.  The domain will match that of the
         // CNT signals.
@@ -512,8 +545,9 @@ namespace geopm
                     // to the energy signal.
                     result[domain_idx] =
                         std::make_shared<DerivativeSignal>(time_sig, dt_cnt,
-                                                           derivative_window,
-                                                           sleep_time);
+                                                           m_derivative_window,
+                                                           m_sleep_time,
+                                                           m_derivative_batch);
                 }
 
                 // Store the PCNT_RATE and ACNT_RATE in a data structure that is not
@@ -635,7 +669,8 @@ namespace geopm
                 result[domain_idx] =
                     std::make_shared<DerivativeSignal>(time_sig, ctr,
                                                        m_derivative_window,
-                                                       m_sleep_time);
+                                                       m_sleep_time,
+                                                       m_derivative_batch);
             }
             m_signal_available[signal_name] = {std::move(result),
                                                ctr_domain,
@@ -843,6 +878,77 @@ namespace geopm
     }
 
     double MSRIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        return check_read_signal(signal_name, domain_type, domain_idx)->read();
+    }
+
+    std::vector<double> MSRIOGroup::read_signals(const std::vector<geopm_request_s> &request)
+    {
+        std::vector<std::shared_ptr<Signal> > signal;
+        signal.reserve(request.size());
+        for (const auto &req : request) {
+            signal.push_back(check_read_signal(req.name, req.domain_type, req.domain_idx));
+        }
+        // Find the signals that decode a single MSR so that the
+        // MSRs can be read with one batch operation
+        std::vector<std::shared_ptr<MSRFieldSignal> > field(signal.size());
+        std::vector<std::shared_ptr<RawMSRSignal> > raw(signal.size());
+        int num_raw = 0;
+        for (size_t sig_idx = 0; sig_idx < signal.size(); ++sig_idx) {
+            field[sig_idx] = std::dynamic_pointer_cast<MSRFieldSignal>(signal[sig_idx]);
+            raw[sig_idx] = std::dynamic_pointer_cast<RawMSRSignal>(
+                field[sig_idx] != nullptr ? field[sig_idx]->raw_msr() : signal[sig_idx]);
+            if (raw[sig_idx] != nullptr) {
+                ++num_raw;
+            }
+        }
+        if (num_raw < 2) {
+            return DerivativeSignal::read_all(signal);
+        }
+
+        std::vector<double> result(signal.size(), NAN);
+        std::vector<std::shared_ptr<Signal> > other_signal;
+        std::vector<size_t> other_idx;
+        // The batch context is released after the read so that
+        // repeated calls do not grow the MSRIO
+        int batch_ctx = m_msrio->create_batch_context();
+        try {
+            std::vector<int> batch_idx(signal.size(), -1);
+            for (size_t sig_idx = 0; sig_idx < signal.size(); ++sig_idx) {
+                if (raw[sig_idx] != nullptr) {
+                    batch_idx[sig_idx] = raw[sig_idx]->add_read(batch_ctx);
+                }
+                else {
+                    other_signal.push_back(signal[sig_idx]);
+                    other_idx.push_back(sig_idx);
+                }
+            }
+            m_msrio->read_batch(batch_ctx);
+            for (size_t sig_idx = 0; sig_idx < signal.size(); ++sig_idx) {
+                if (raw[sig_idx] != nullptr) {
+                    double value = raw[sig_idx]->sample(batch_idx[sig_idx], batch_ctx);
+                    if (field[sig_idx] != nullptr) {
+                        value = field[sig_idx]->convert(value);
+                    }
+                    result[sig_idx] = value;
+                }
+            }
+        }
+        catch (...) {
+            m_msrio->release_batch_context(batch_ctx);
+            throw;
+        }
+        m_msrio->release_batch_context(batch_ctx);
+        std::vector<double> other_value = DerivativeSignal::read_all(other_signal);
+        for (size_t other_pos = 0; other_pos < other_idx.size(); ++other_pos) {
+            result[other_idx[other_pos]] = other_value[other_pos];
+        }
+        return result;
+    }
+
+    std::shared_ptr<Signal> MSRIOGroup::check_read_signal(const std::string &signal_name,
+                                                          int domain_type,
+                                                          int domain_idx)
     {
         if (!m_is_fixed_enabled) {
             enable_fixed_counters();
@@ -860,11 +966,57 @@ namespace geopm
             throw Exception("MSRIOGroup::read_signal(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        std::shared_ptr<Signal> ref_sig = m_signal_available.at(signal_name).signals[domain_idx];
-        return ref_sig->read();
+        return m_signal_available.at(signal_name).signals[domain_idx];
     }
 
     void MSRIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        std::shared_ptr<Control> control = check_write_control(control_name, domain_type, domain_idx);
+
+        if (control_name == "CPU_POWER_LIMIT_CONTROL") {
+            write_control("MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
+        }
+        else if (control_name == "BOARD_POWER_LIMIT_CONTROL") {
+            write_control("MSR::PLATFORM_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
+        }
+        control->write(setting);
+    }
+
+    void MSRIOGroup::write_controls(const std::vector<geopm_request_s> &request,
+                                    const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("MSRIOGroup::write_controls(): number of settings does not match the number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (request.size() < 2) {
+            for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                const auto &req = request[req_idx];
+                write_control(req.name, req.domain_type, req.domain_idx, setting[req_idx]);
+            }
+            return;
+        }
+        // Fields of the same MSR on the same CPU are combined into
+        // one read-modify-write of the MSR.
+        int batch_ctx = m_msrio->create_batch_context();
+        try {
+            for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                const auto &req = request[req_idx];
+                add_write_control(req.name, req.domain_type, req.domain_idx,
+                                  setting[req_idx], batch_ctx);
+            }
+            m_msrio->write_batch(batch_ctx);
+        }
+        catch (...) {
+            m_msrio->release_batch_context(batch_ctx);
+            throw;
+        }
+        m_msrio->release_batch_context(batch_ctx);
+    }
+
+    std::shared_ptr<Control> MSRIOGroup::check_write_control(const std::string &control_name,
+                                                             int domain_type,
+                                                             int domain_idx)
     {
         check_control(control_name);
 
@@ -881,21 +1033,33 @@ namespace geopm
             throw Exception("MSRIOGroup::write_control(): domain_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        return m_control_available.at(control_name).controls[domain_idx];
+    }
+
+    void MSRIOGroup::add_write_control(const std::string &control_name,
+                                       int domain_type,
+                                       int domain_idx,
+                                       double setting,
+                                       int batch_ctx)
+    {
+        (void)check_write_control(control_name, domain_type, domain_idx);
 
         if (control_name == "CPU_POWER_LIMIT_CONTROL") {
-            write_control("MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
+            add_write_control("MSR::PKG_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0, batch_ctx);
         }
         else if (control_name == "BOARD_POWER_LIMIT_CONTROL") {
-            write_control("MSR::PLATFORM_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0);
+            add_write_control("MSR::PLATFORM_POWER_LIMIT:PL1_LIMIT_ENABLE", domain_type, domain_idx, 1.0, batch_ctx);
+        }
+        for (auto &control : m_control_available.at(control_name).cpu_controls[domain_idx]) {
+            control->add_write(setting, batch_ctx);
         }
-        std::shared_ptr<Control> control = m_control_available.at(control_name).controls[domain_idx];
-        control->write(setting);
     }
 
     void MSRIOGroup::save_control(void)
     {
+        // One batch read covers the MSRs of every control
+        m_msrio->read_batch(m_save_restore_ctx);
         for (auto &ctl : m_control_available) {
-            m_msrio->read_batch(m_save_restore_ctx);
             for (auto &dom_ctl : ctl.second.controls) {
                 dom_ctl->save();
             }
@@ -1239,36 +1403,36 @@ namespace geopm
         save_ctl->restore(*this);
     }
 
-    std::string MSRIOGroup::platform_data(int cpu_id)
+    const msr_table_s &MSRIOGroup::platform_table(int cpu_id)
     {
-        std::string platform_msrs;
+        const msr_table_s *platform_msrs = nullptr;
         if (cpu_id == MSRIOGroup::M_CPUID_KNL) {
-            platform_msrs = knl_msr_json();
+            platform_msrs = &knl_msr_table();
         }
         else if (cpu_id == MSRIOGroup::M_CPUID_HSX ||
                  cpu_id == MSRIOGroup::M_CPUID_BDX) {
-            platform_msrs = hsx_msr_json();
+            platform_msrs = &hsx_msr_table();
         }
         else if (cpu_id == MSRIOGroup::M_CPUID_SNB ||
                  cpu_id == MSRIOGroup::M_CPUID_IVT) {
-            platform_msrs = snb_msr_json();
+            platform_msrs = &snb_msr_table();
         }
         else if (cpu_id == MSRIOGroup::M_CPUID_SKX ||
                  cpu_id == MSRIOGroup::M_CPUID_ICX) {
-            platform_msrs = skx_msr_json();
+            platform_msrs = &skx_msr_table();
         }
         else if (cpu_id >= MSRIOGroup::M_CPUID_ICX) {
 #ifdef GEOPM_DEBUG
             std::cerr << "Warning: <geopm> New/Untested CPUID detected; Defaulting to SKX MSRs"
                       << std::endl;
 #endif
-            platform_msrs = skx_msr_json();
+            platform_msrs = &skx_msr_table();
         }
         else {
             throw Exception("MSRIOGroup: Unsupported CPUID",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        return platform_msrs;
+        return *platform_msrs;
     }
 
     std::set<std::string> MSRIOGroup::msr_data_files(MsrConfigWarningPreference_e warning_preference)
@@ -1587,7 +1751,7 @@ namespace geopm
                                           int domain_type,
                                           int begin_bit, int end_bit,
                                           int function, double scalar, int units,
-                                          const std::string &agg_function,
+                                          const std::function<double(const std::vector<double> &)> &agg_function,
                                           const std::string &description,
                                           int behavior,
                                           const std::function<std::string(double)> &format_function)
@@ -1606,7 +1770,7 @@ namespace geopm
             .signals = result_field_signal,
             .domain = domain_type,
             .units = units,
-            .agg_function = Agg::name_to_function(agg_function),
+            .agg_function = agg_function,
             .description = description,
             .behavior = behavior,
             .format_function = format_function,
@@ -1622,21 +1786,26 @@ namespace geopm
     {
         int num_domain = m_platform_topo.num_domain(domain_type);
         std::vector<std::shared_ptr<Control> > result_field_control;
+        std::vector<std::vector<std::shared_ptr<MSRFieldControl> > > result_cpu_control;
         try {
             for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
                 std::vector<std::shared_ptr<Control> > cpu_controls;
+                std::vector<std::shared_ptr<MSRFieldControl> > field_controls;
                 std::set<int> cpus = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
                                                                    domain_type, domain_idx);
                 for (auto cpu_idx : cpus) {
-                    cpu_controls.push_back(std::make_shared<MSRFieldControl>(
+                    field_controls.push_back(std::make_shared<MSRFieldControl>(
                         m_msrio, m_save_restore_ctx, cpu_idx, msr_offset,
                         begin_bit, end_bit, function,
                         scalar));
+                    cpu_controls.push_back(field_controls.back());
                 }
                 result_field_control.push_back(std::make_shared<DomainControl>(cpu_controls));
+                result_cpu_control.push_back(field_controls);
             }
             m_control_available[msr_field_name] = {
                 .controls = result_field_control,
+                .cpu_controls = result_cpu_control,
                 .domain = domain_type,
                 .units = units,
                 .description = description,
@@ -1688,8 +1857,6 @@ namespace geopm
             for (const auto &field : fields_obj) {
                 std::string field_name = field.first;
                 Json field_root = field.second;
-                std::string msr_field_name = msr_name + ":" + field_name;
-                std::string sig_ctl_name = M_NAME_PREFIX + msr_field_name;
 
                 check_msr_field(field_root, msr_name, field_name);
 
@@ -1702,60 +1869,112 @@ namespace geopm
                 int units = IOGroup::string_to_units(field_data["units"].string_value());
                 bool is_control = field_data["writeable"].bool_value();
                 int behavior = IOGroup::string_to_behavior(field_data["behavior"].string_value());
-                std::string agg_function = field_data["aggregation"].string_value();
+                auto agg_function = Agg::name_to_function(field_data["aggregation"].string_value());
                 // optional fields
                 std::string description = M_DEFAULT_DESCRIPTION;
                 if (field_data.find("description") != field_data.end()) {
                     description = field_data["description"].string_value();
                 }
 
-                if (m_rdt_info.rdt_support && (msr_field_name == "QM_EVTSEL:RMID" || msr_field_name == "PQR_ASSOC:RMID")) {
-                    if((int)m_rdt_info.rmid_bit_width > (end_bit - begin_bit + 1)) {
-                        std::ostringstream except;
-                        except << "MSRIOGroup::" << __func__ << "(): CPUID RMID bit width "
-                               << m_rdt_info.rmid_bit_width << " is greater than the MSR provided RMID bit width "
-                               << (end_bit - begin_bit + 1);
-                        throw Exception(except.str(), GEOPM_ERROR_INVALID, __FILE__,
-                                        __LINE__);
-                    }
-                }
-
-                std::function<std::string(double)> format_function = string_format_double;
-                if (IOGroup::M_UNITS_NONE == units) {
-                    format_function = string_format_integer;
-                }
+                add_msr_field(msr_name, field_name, domain_type, msr_offset,
+                              begin_bit, end_bit, function, scalar, units,
+                              is_control, behavior, agg_function, description,
+                              is_trl_writable);
+            }
+        }
+    }
 
-                if (string_begins_with(msr_field_name, "IA32_PMC") &&
-                    string_ends_with(msr_field_name, ":PERFCTR")) {
-                    if (m_pmc_bit_width > 0) {
-                        end_bit = begin_bit + m_pmc_bit_width - 1;
-                    }
+    void MSRIOGroup::parse_msr_table(const msr_table_s &table)
+    {
+        bool is_trl_writable = false;
+        try {
+            is_trl_writable = is_trl_writable_in_all_domains(table, m_platform_topo, m_msrio);
+        }
+        catch (const Exception &ex) {
 #ifdef GEOPM_DEBUG
-                    else {
-                        std::cerr << "Warning: <geopm> CPUID specified 0 bits for "
-                                  << msr_field_name << "; using the default width: "
-                                  << (end_bit - begin_bit + 1) << std::endl;
-                    }
+            std::cerr << "Warning: <geopm> MSRIOGroup::" << std::string(__func__)
+                      << "(): Unable to check TRL via PLATFORM_INFO: "
+                      << ex.what() << std::endl;
 #endif
-                }
+        }
 
-                if (is_trl_writable &&
-                    string_begins_with(msr_field_name,
-                                       "TURBO_RATIO_LIMIT:MAX_RATIO_LIMIT_")) {
-                    is_control = true;
-                    behavior = IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE;
+        for (size_t msr_idx = 0; msr_idx < table.num_msr; ++msr_idx) {
+            const msr_s &msr = table.msr[msr_idx];
+            add_raw_msr_signal(msr.name, msr.domain_type, msr.offset);
+            for (size_t field_idx = 0; field_idx < msr.num_field; ++field_idx) {
+                const msr_field_s &field = msr.field[field_idx];
+                std::string description = M_DEFAULT_DESCRIPTION;
+                if (field.description != nullptr) {
+                    description = field.description;
                 }
+                add_msr_field(msr.name, field.name, msr.domain_type, msr.offset,
+                              field.begin_bit, field.end_bit, field.function,
+                              field.scalar, field.units, field.is_writeable,
+                              field.behavior, Agg::type_to_function(field.agg_type),
+                              description, is_trl_writable);
+            }
+        }
+    }
 
-                add_msr_field_signal(msr_name, sig_ctl_name, domain_type,
-                                     begin_bit, end_bit, function, scalar, units,
-                                     agg_function, description, behavior, format_function);
-                if (is_control) {
-                    add_msr_field_control(sig_ctl_name, domain_type, msr_offset,
-                                          begin_bit, end_bit, function, scalar, units,
-                                          description);
-                }
+    void MSRIOGroup::add_msr_field(const std::string &msr_name,
+                                   const std::string &field_name,
+                                   int domain_type,
+                                   uint64_t msr_offset,
+                                   int begin_bit, int end_bit,
+                                   int function, double scalar, int units,
+                                   bool is_control, int behavior,
+                                   const std::function<double(const std::vector<double> &)> &agg_function,
+                                   const std::string &description,
+                                   bool is_trl_writable)
+    {
+        std::string msr_field_name = msr_name + ":" + field_name;
+        std::string sig_ctl_name = M_NAME_PREFIX + msr_field_name;
+
+        if (m_rdt_info.rdt_support && (msr_field_name == "QM_EVTSEL:RMID" || msr_field_name == "PQR_ASSOC:RMID")) {
+            if((int)m_rdt_info.rmid_bit_width > (end_bit - begin_bit + 1)) {
+                std::ostringstream except;
+                except << "MSRIOGroup::" << __func__ << "(): CPUID RMID bit width "
+                       << m_rdt_info.rmid_bit_width << " is greater than the MSR provided RMID bit width "
+                       << (end_bit - begin_bit + 1);
+                throw Exception(except.str(), GEOPM_ERROR_INVALID, __FILE__,
+                                __LINE__);
             }
         }
+
+        std::function<std::string(double)> format_function = string_format_double;
+        if (IOGroup::M_UNITS_NONE == units) {
+            format_function = string_format_integer;
+        }
+
+        if (string_begins_with(msr_field_name, "IA32_PMC") &&
+            string_ends_with(msr_field_name, ":PERFCTR")) {
+            if (m_pmc_bit_width > 0) {
+                end_bit = begin_bit + m_pmc_bit_width - 1;
+            }
+#ifdef GEOPM_DEBUG
+            else {
+                std::cerr << "Warning: <geopm> CPUID specified 0 bits for "
+                          << msr_field_name << "; using the default width: "
+                          << (end_bit - begin_bit + 1) << std::endl;
+            }
+#endif
+        }
+
+        if (is_trl_writable &&
+            string_begins_with(msr_field_name,
+                               "TURBO_RATIO_LIMIT:MAX_RATIO_LIMIT_")) {
+            is_control = true;
+            behavior = IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE;
+        }
+
+        add_msr_field_signal(msr_name, sig_ctl_name, domain_type,
+                             begin_bit, end_bit, function, scalar, units,
+                             agg_function, description, behavior, format_function);
+        if (is_control) {
+            add_msr_field_control(sig_ctl_name, domain_type, msr_offset,
+                                  begin_bit, end_bit, function, scalar, units,
+                                  description);
+        }
     }
 
     void MSRIOGroup::parse_json_msrs_allowlist(const std::string &str,
@@ -1801,6 +2020,23 @@ namespace geopm
         }
     }
 
+    void MSRIOGroup::parse_msr_table_allowlist(const msr_table_s &table,
+                                               std::map<uint64_t, std::pair<uint64_t, std::string> > &allowlist_data)
+    {
+        for (size_t msr_idx = 0; msr_idx < table.num_msr; ++msr_idx) {
+            const msr_s &msr = table.msr[msr_idx];
+            uint64_t combined_write_mask = 0;
+            for (size_t field_idx = 0; field_idx < msr.num_field; ++field_idx) {
+                const msr_field_s &field = msr.field[field_idx];
+                if (field.is_writeable) {
+                    combined_write_mask |= (((1ULL << (field.end_bit - field.begin_bit + 1)) - 1) << field.begin_bit);
+                }
+            }
+            allowlist_data[msr.offset] =
+                std::pair<uint64_t, std::string>(combined_write_mask, msr.name);
+        }
+    }
+
     std::string MSRIOGroup::format_allowlist(const std::map<uint64_t, std::pair<uint64_t, std::string> > &allowlist_data)
     {
         std::map<uint64_t, std::string> offset_result_map;
@@ -1826,9 +2062,9 @@ namespace geopm
     std::string MSRIOGroup::msr_allowlist(int cpuid)
     {
         std::map<uint64_t, std::pair<uint64_t, std::string> > allowlist_data;
-        parse_json_msrs_allowlist(arch_msr_json(), allowlist_data);
+        parse_msr_table_allowlist(arch_msr_table(), allowlist_data);
         try {
-            parse_json_msrs_allowlist(platform_data(cpuid), allowlist_data);
+            parse_msr_table_allowlist(platform_table(cpuid), allowlist_data);
         }
         catch (const Exception &ex) {
             // Write only architectural MSRs
@@ -33,6 +33,7 @@ namespace geopm
                            uint64_t raw_value,
                            uint64_t write_mask) override;
             int create_batch_context(void) override;
+            void release_batch_context(int batch_ctx) override;
             int add_read(int cpu_idx, uint64_t offset) override;
             int add_read(int cpu_idx, uint64_t offset, int batch_ctx) override;
             void read_batch() override;
@@ -101,12 +102,18 @@ namespace geopm
             const int m_num_cpu;
             std::vector<int> m_file_desc;
             std::vector<struct m_batch_context_s> m_batch_context;
+            // Released batch contexts that can be handed out again
+            std::vector<int> m_free_batch_context;
             bool m_is_batch_enabled;
             std::map<uint64_t, uint64_t> m_offset_mask_map;
             bool m_is_open;
             std::shared_ptr<MSRPath> m_path;
             std::shared_ptr<IOUring> m_batch_reader;
             std::shared_ptr<IOUring> m_batch_writer;
+            // Number of operations the IOUring objects were sized
+            // for; injected objects are never replaced
+            uint32_t m_batch_reader_depth;
+            uint32_t m_batch_writer_depth;
     };
 }
 
@@ -241,7 +241,7 @@ namespace geopm
         for (auto &sv : m_signal_available) {
             std::vector<std::shared_ptr<signal_s> > result;
             for (int domain_idx = 0; domain_idx < m_platform_topo.num_domain(signal_domain_type(sv.first)); ++domain_idx) {
-                std::shared_ptr<signal_s> sgnl = std::make_shared<signal_s>(signal_s{0, false});
+                std::shared_ptr<signal_s> sgnl = std::make_shared<signal_s>(signal_s{0, sv.first, sv.second.domain, domain_idx});
                 result.push_back(sgnl);
             }
             sv.second.signals = std::move(result);
@@ -429,7 +429,6 @@ namespace geopm
         if (!is_found) {
             // If not pushed, add to pushed signals and configure for batch reads
             result = m_signal_pushed.size();
-            signal->m_do_read = true;
             m_signal_pushed.push_back(signal);
         }
 
@@ -530,27 +529,22 @@ namespace geopm
     void NVMLIOGroup::read_batch(void)
     {
         m_is_batch_read = true;
-        for (auto &sv : m_signal_available) {
-            if (sv.first == M_NAME_PREFIX + "GPU_CPU_ACTIVE_AFFINITIZATION") {
-                std::map<pid_t, double> process_map;
-                bool is_map_cached = false;
-
-                for (unsigned int domain_idx = 0; domain_idx < sv.second.signals.size(); ++domain_idx) {
-                    if (sv.second.signals.at(domain_idx)->m_do_read) {
-                        if (is_map_cached == false) {
-                            process_map = gpu_process_map();
-                            is_map_cached = true;
-                        }
-                        sv.second.signals.at(domain_idx)->m_value = cpu_gpu_affinity(domain_idx, process_map);
-                    }
+        // A signal pushed under both its name and an alias shares one
+        // signal_s, so each device query is issued once per batch.
+        const std::string affinity_name = M_NAME_PREFIX + "GPU_CPU_ACTIVE_AFFINITIZATION";
+        std::map<pid_t, double> process_map;
+        bool is_map_cached = false;
+        for (auto &signal : m_signal_pushed) {
+            if (signal->m_name == affinity_name) {
+                if (is_map_cached == false) {
+                    process_map = gpu_process_map();
+                    is_map_cached = true;
                 }
+                signal->m_value = cpu_gpu_affinity(signal->m_domain_idx, process_map);
             }
             else {
-                for (unsigned int domain_idx = 0; domain_idx < sv.second.signals.size(); ++domain_idx) {
-                    if (sv.second.signals.at(domain_idx)->m_do_read) {
-                        sv.second.signals.at(domain_idx)->m_value = read_signal(sv.first, sv.second.domain, domain_idx);
-                    }
-                }
+                signal->m_value = read_signal(signal->m_name, signal->m_domain_type,
+                                              signal->m_domain_idx);
             }
         }
     }
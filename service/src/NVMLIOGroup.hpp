@@ -75,7 +75,9 @@ namespace geopm
             struct signal_s
             {
                 double m_value;
-                bool m_do_read;
+                std::string m_name;
+                int m_domain_type;
+                int m_domain_idx;
             };
 
             struct control_s
@@ -8,23 +8,31 @@
 #include "PlatformIOImp.hpp"
 
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <sstream>
 #include <tuple>
 #include <memory>
 
 #include "geopm/Agg.hpp"
+#include "geopm/BatchIOGroup.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/IOGroup.hpp"
 #include "geopm/PlatformTopo.hpp"
 
 #include "geopm_pio.h"
+#include "geopm_debug.hpp"
 #include "BatchServer.hpp"
 #include "CombinedControl.hpp"
 #include "CombinedSignal.hpp"
+#include "LazyIOGroup.hpp"
+#include "SampleLoop.hpp"
+#include "PlatformTopoImp.hpp"
 #include "ServiceIOGroup.hpp"
 
 namespace geopm
@@ -49,8 +57,17 @@ namespace geopm
         platform_io_helper(true);
     }
 
+    const std::string PlatformIOImp::M_CACHE_FILE_NAME = "/tmp/geopm-pio-cache-" + std::to_string(getuid());
+    const std::string PlatformIOImp::M_SERVICE_CACHE_FILE_NAME = "/run/geopm/geopm-pio-cache";
+    const std::vector<std::string> PlatformIOImp::M_CACHE_ENV = {
+        "GEOPM_PLUGIN_PATH",
+        "GEOPM_MSR_CONFIG_PATH",
+        "GEOPM_CONST_CONFIG_PATH",
+    };
+
     PlatformIOImp::PlatformIOImp()
-        : PlatformIOImp({}, platform_topo())
+        : PlatformIOImp({}, platform_topo(),
+                        getuid() == 0 ? M_SERVICE_CACHE_FILE_NAME : M_CACHE_FILE_NAME)
     {
 
     }
@@ -231,16 +248,29 @@ namespace geopm
 
     PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                                  const PlatformTopo &topo)
+        : PlatformIOImp(std::move(iogroup_list), topo, "")
+    {
+
+    }
+
+    PlatformIOImp::PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                                 const PlatformTopo &topo,
+                                 const std::string &cache_file_name)
         : m_is_signal_active(false)
         , m_is_control_active(false)
         , m_platform_topo(topo)
         , m_iogroup_list(std::move(iogroup_list))
+        , m_num_valid_signal(0)
         , m_do_restore(false)
     {
-        if (m_iogroup_list.empty()) {
+        if (m_iogroup_list.empty() &&
+            (cache_file_name.empty() || !load_cache(cache_file_name))) {
+            std::vector<std::shared_ptr<IOGroup> > loaded;
             for (const auto &it : IOGroup::iogroup_names()) {
+                std::shared_ptr<IOGroup> iogroup;
                 try {
-                    register_iogroup(IOGroup::make_unique(it));
+                    iogroup = IOGroup::make_unique(it);
+                    register_iogroup(iogroup);
                 }
                 catch (const geopm::Exception &ex) {
 #ifdef GEOPM_DEBUG
@@ -250,10 +280,231 @@ namespace geopm
                               << "required by the Controller and Agent."
                               << std::endl;
                     std::cerr << "The error was: " << ex.what() << std::endl;
+#endif
+                }
+                loaded.push_back(iogroup);
+            }
+            if (!cache_file_name.empty()) {
+                // Record the IOGroups that loaded in the context of
+                // this process, so that later processes of the same
+                // user construct only the IOGroups that they use.
+                // Failing to write the cache is not an error.
+                try {
+                    if (!check_cache_file(cache_file_name)) {
+                        write_cache(cache_file_name, cache_contents(loaded));
+                    }
+                }
+                catch (const geopm::Exception &) {
+
+                }
+            }
+        }
+    }
+
+    void PlatformIO::create_cache(void)
+    {
+        PlatformIOImp::create_cache();
+    }
+
+    void PlatformIOImp::create_cache(void)
+    {
+        if (getuid() == 0) {
+            PlatformIOImp::create_cache(M_SERVICE_CACHE_FILE_NAME);
+        }
+        else {
+            PlatformIOImp::create_cache(M_CACHE_FILE_NAME);
+        }
+    }
+
+    void PlatformIOImp::create_cache(const std::string &cache_file_name)
+    {
+        // If cache file is not present, or is too old, create it
+        if (!check_cache_file(cache_file_name)) {
+            std::vector<std::shared_ptr<IOGroup> > iogroup;
+            for (const auto &iogroup_name : IOGroup::iogroup_names()) {
+                try {
+                    iogroup.push_back(IOGroup::make_unique(iogroup_name));
+                }
+                catch (const geopm::Exception &) {
+                    iogroup.push_back(nullptr);
+                }
+            }
+            write_cache(cache_file_name, cache_contents(iogroup));
+        }
+    }
+
+    bool PlatformIOImp::check_cache_file(const std::string &cache_file_name)
+    {
+        bool result = false;
+        try {
+            result = PlatformTopoImp::check_file(cache_file_name);
+        }
+        catch (const geopm::Exception &ex) {
+            if (ex.err_value() == EACCES) {
+                throw; // Permission was denied; Cannot create files at the desired path
+            }
+        }
+        return result;
+    }
+
+    void PlatformIOImp::write_cache(const std::string &cache_file_name,
+                                    const std::string &contents)
+    {
+        std::string tmp_string = cache_file_name + "XXXXXX";
+        char tmp_path[NAME_MAX];
+        tmp_path[NAME_MAX - 1] = '\0';
+        strncpy(tmp_path, tmp_string.c_str(), NAME_MAX - 1);
+        mode_t orig_mask = umask(S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IWOTH | S_IXOTH);
+        int tmp_fd = mkstemp(tmp_path);
+        umask(orig_mask);
+        if (tmp_fd == -1) {
+            throw Exception("PlatformIOImp::create_cache(): Could not create temp file: ",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        close(tmp_fd);
+        try {
+            write_file(tmp_path, contents);
+        }
+        catch (...) {
+            unlink(tmp_path);
+            throw;
+        }
+        int err = rename(tmp_path, cache_file_name.c_str());
+        if (err) {
+            unlink(tmp_path);
+            throw Exception("PlatformIOImp::create_cache(): Could not rename tmp_path: ",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    std::string PlatformIOImp::cache_contents(const std::vector<std::shared_ptr<IOGroup> > &iogroup_loaded)
+    {
+        // Each line is a tab separated record: the environment that
+        // the IOGroups were created with, then each IOGroup in load
+        // order followed by the signals and controls it provides.
+        std::ostringstream result;
+        for (const auto &env_name : M_CACHE_ENV) {
+            result << "ENV\t" << env_name << "\t" << get_env(env_name) << "\n";
+        }
+        std::vector<std::string> iogroup_names = IOGroup::iogroup_names();
+        for (size_t iogroup_idx = 0; iogroup_idx < iogroup_names.size(); ++iogroup_idx) {
+            const std::string &iogroup_name = iogroup_names[iogroup_idx];
+            const std::shared_ptr<IOGroup> &iogroup = iogroup_loaded.at(iogroup_idx);
+            if (iogroup == nullptr) {
+                result << "IOGROUP\t" << iogroup_name << "\tFAILED\n";
+                continue;
+            }
+            if (iogroup_name == ServiceIOGroup::plugin_name()) {
+                // The signals provided by the service depend on the
+                // access lists, which may change at any time
+                result << "IOGROUP\t" << iogroup_name << "\tEAGER\n";
+                continue;
+            }
+            std::ostringstream entry;
+            try {
+                for (const auto &signal_name : iogroup->signal_names()) {
+                    entry << "SIGNAL\t" << signal_name
+                          << "\t" << iogroup->signal_domain_type(signal_name)
+                          << "\t" << iogroup->signal_behavior(signal_name)
+                          << "\t" << Agg::function_to_type(iogroup->agg_function(signal_name))
+                          << "\t" << string_format_function_to_type(iogroup->format_function(signal_name))
+                          << "\n";
+                }
+                for (const auto &control_name : iogroup->control_names()) {
+                    entry << "CONTROL\t" << control_name
+                          << "\t" << iogroup->control_domain_type(control_name)
+                          << "\n";
+                }
+                result << "IOGROUP\t" << iogroup_name << "\tLAZY\n" << entry.str();
+            }
+            catch (const geopm::Exception &) {
+                // Custom aggregation or format functions cannot be
+                // recorded, so this IOGroup is always constructed
+                result << "IOGROUP\t" << iogroup_name << "\tEAGER\n";
+            }
+        }
+        return result.str();
+    }
+
+    bool PlatformIOImp::load_cache(const std::string &cache_file_name)
+    {
+        struct m_cache_iogroup_s {
+            std::string name;
+            std::string mode;
+            std::map<std::string, LazyIOGroup::signal_s> signal;
+            std::map<std::string, int> control;
+        };
+        std::vector<m_cache_iogroup_s> cache;
+        try {
+            if (!PlatformTopoImp::check_file(cache_file_name)) {
+                return false;
+            }
+            size_t env_count = 0;
+            for (const auto &line : string_split(read_file(cache_file_name), "\n")) {
+                if (line.empty()) {
+                    continue;
+                }
+                std::vector<std::string> field = string_split(line, "\t");
+                if (field[0] == "ENV" && field.size() == 3) {
+                    if (env_count == M_CACHE_ENV.size() ||
+                        field[1] != M_CACHE_ENV[env_count] ||
+                        field[2] != get_env(field[1])) {
+                        return false;
+                    }
+                    ++env_count;
+                }
+                else if (field[0] == "IOGROUP" && field.size() == 3) {
+                    cache.push_back({field[1], field[2], {}, {}});
+                }
+                else if (field[0] == "SIGNAL" && field.size() == 6 && !cache.empty()) {
+                    cache.back().signal[field[1]] = {std::stoi(field[2]),
+                                                     std::stoi(field[3]),
+                                                     std::stoi(field[4]),
+                                                     std::stoi(field[5])};
+                }
+                else if (field[0] == "CONTROL" && field.size() == 3 && !cache.empty()) {
+                    cache.back().control[field[1]] = std::stoi(field[2]);
+                }
+                else {
+                    return false;
+                }
+            }
+            if (env_count != M_CACHE_ENV.size()) {
+                return false;
+            }
+        }
+        catch (const std::exception &) {
+            return false;
+        }
+        // The plugins loaded by this process must match the cache
+        std::vector<std::string> iogroup_names = IOGroup::iogroup_names();
+        if (iogroup_names.size() != cache.size()) {
+            return false;
+        }
+        for (size_t idx = 0; idx < cache.size(); ++idx) {
+            if (iogroup_names[idx] != cache[idx].name) {
+                return false;
+            }
+        }
+        for (auto &it : cache) {
+            if (it.mode == "LAZY") {
+                register_iogroup(std::make_shared<LazyIOGroup>(it.name, it.signal, it.control));
+            }
+            else if (it.mode == "EAGER" || it.mode == "FAILED") {
+                // An IOGroup that failed when the cache was written
+                // may load now, e.g. after a change in permissions
+                try {
+                    register_iogroup(IOGroup::make_unique(it.name));
+                }
+                catch (const geopm::Exception &ex) {
+#ifdef GEOPM_DEBUG
+                    std::cerr << "Warning: <geopm> Failed to load " << it.name << " IOGroup: "
+                              << ex.what() << std::endl;
 #endif
                 }
             }
         }
+        return true;
     }
 
     void PlatformIOImp::register_iogroup(std::shared_ptr<IOGroup> iogroup)
@@ -415,39 +666,25 @@ namespace geopm
             result = sig_tup_it->second;
             no_support = false;
         }
-        std::string err_msg;
         if (result == -1) {
-            for (auto &ii : find_signal_iogroup(signal_name)) {
+            auto iogroups = find_signal_iogroup(signal_name);
+            if (!iogroups.empty()) {
                 no_support = false;
-                if (domain_type == ii->signal_domain_type(signal_name)) {
-                    bool do_push_signal = false;
-                    try {
-                        // Attempt to read before pushing to ensure batch reads will succeed
-                        (void)ii->read_signal(signal_name, domain_type, domain_idx);
-                        do_push_signal = true;
-                    }
-                    catch (const geopm::Exception &ex) {
-                        if (ex.err_value() == GEOPM_ERROR_NOT_IMPLEMENTED) {
-                            // IOGroups may not support read_signal()
-                            do_push_signal = true;
-                        }
-                        else {
-                            err_msg += std::string(ex.what()) + "\n";
-                        }
-                    }
-                    if (do_push_signal == true) {
-                        int group_signal_idx = ii->push_signal(signal_name, domain_type, domain_idx);
-                        result = m_active_signal.size();
-                        m_existing_signal[sig_tup] = result;
-                        m_active_signal.emplace_back(ii, group_signal_idx);
-                    }
+                if (domain_type == iogroups[0]->signal_domain_type(signal_name)) {
+                    // Reading the signal is deferred until validate_pushed()
+                    // so that all pushed signals are probed in one batch
+                    result = m_active_signal.size();
+                    m_existing_signal[sig_tup] = result;
+                    m_active_signal.emplace_back(nullptr, -1);
+                    geopm_request_s request = {domain_type, domain_idx, {}};
+                    strncpy(request.name, signal_name.c_str(), NAME_MAX - 1);
+                    m_pending_signal.push_back({result, request, std::move(iogroups), 0, ""});
                 }
                 else {
                     result = push_signal_convert_domain(signal_name, domain_type, domain_idx);
-                    m_existing_signal[sig_tup] = result;
-                }
-                if (result != -1) {
-                    break;
+                    if (result != -1) {
+                        m_existing_signal[sig_tup] = result;
+                    }
                 }
             }
         }
@@ -462,9 +699,6 @@ namespace geopm
                 msg = "PlatformIOImp::push_signal(): unable to read signal name \"" +
                       signal_name + "\" and domain type \"" +
                       std::to_string(domain_type) + "\"";
-                if (err_msg.size() > 0) {
-                    msg += "\nThe following errors were observed:\n" + err_msg;
-                }
             }
             throw Exception(msg, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
@@ -692,6 +926,10 @@ namespace geopm
             throw Exception("PlatformIOImp::adjust(): setting is NAN",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (!m_pending_signal.empty()) {
+            // IOGroups do not accept pushes once a control is adjusted
+            validate_pushed();
+        }
         auto &group_idx_pair = m_active_control[control_idx];
         if (group_idx_pair.first != nullptr) {
             group_idx_pair.first->adjust(group_idx_pair.second, setting);
@@ -715,12 +953,168 @@ namespace geopm
 
     void PlatformIOImp::read_batch(void)
     {
+        if (!m_pending_signal.empty()) {
+            validate_pushed();
+        }
         for (auto &it : m_iogroup_list) {
             it->read_batch();
         }
         m_is_signal_active = true;
     }
 
+    void PlatformIOImp::validate_pushed(void)
+    {
+        try {
+            while (!m_pending_signal.empty()) {
+                // Signals pushed while converting domains below are
+                // validated by the next pass
+                std::vector<m_pending_signal_s> pending;
+                pending.swap(m_pending_signal);
+                // Group the pending signals by the IOGroup that is next
+                // in line to provide them, in order of first appearance
+                std::vector<std::pair<std::shared_ptr<IOGroup>, std::vector<size_t> > > group;
+                for (size_t pend_idx = 0; pend_idx < pending.size(); ++pend_idx) {
+                    auto &pend = pending[pend_idx];
+                    const auto &iogroup = pend.iogroup[pend.iogroup_pos];
+                    int base_domain_type = iogroup->signal_domain_type(pend.request.name);
+                    if (base_domain_type != pend.request.domain_type) {
+                        if (!push_pending_convert_domain(pend, base_domain_type)) {
+                            retry_pending_signal(std::move(pend));
+                        }
+                        continue;
+                    }
+                    auto group_it = std::find_if(group.begin(), group.end(),
+                        [&iogroup](const std::pair<std::shared_ptr<IOGroup>, std::vector<size_t> > &gg)
+                        {
+                            return gg.first == iogroup;
+                        });
+                    if (group_it == group.end()) {
+                        group.emplace_back(iogroup, std::vector<size_t>{});
+                        group_it = group.end() - 1;
+                    }
+                    group_it->second.push_back(pend_idx);
+                }
+                for (const auto &gg : group) {
+                    std::vector<geopm_request_s> request;
+                    request.reserve(gg.second.size());
+                    for (auto pend_idx : gg.second) {
+                        request.push_back(pending[pend_idx].request);
+                    }
+                    std::vector<std::string> err_msg(request.size());
+                    std::vector<bool> is_valid = probe_signals(*gg.first, request, err_msg);
+                    for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                        auto &pend = pending[gg.second[req_idx]];
+                        const geopm_request_s &req = pend.request;
+                        if (is_valid[req_idx]) {
+                            int group_signal_idx = gg.first->push_signal(req.name, req.domain_type, req.domain_idx);
+                            m_active_signal[pend.signal_idx] = std::make_pair(gg.first, group_signal_idx);
+                        }
+                        else {
+                            pend.err_msg += err_msg[req_idx];
+                            retry_pending_signal(std::move(pend));
+                        }
+                    }
+                }
+            }
+        }
+        catch (...) {
+            rollback_pushed_signal();
+            throw;
+        }
+        m_num_valid_signal = m_active_signal.size();
+    }
+
+    void PlatformIOImp::retry_pending_signal(m_pending_signal_s pend)
+    {
+        ++pend.iogroup_pos;
+        if (pend.iogroup_pos == pend.iogroup.size()) {
+            const geopm_request_s &req = pend.request;
+            std::string msg = "PlatformIOImp::validate_pushed(): unable to read signal name \"" +
+                              std::string(req.name) + "\" and domain type \"" +
+                              std::to_string(req.domain_type) + "\"";
+            if (pend.err_msg.size() > 0) {
+                msg += "\nThe following errors were observed:\n" + pend.err_msg;
+            }
+            throw Exception(msg, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_pending_signal.push_back(std::move(pend));
+    }
+
+    bool PlatformIOImp::push_pending_convert_domain(const m_pending_signal_s &pend,
+                                                    int base_domain_type)
+    {
+        const geopm_request_s &req = pend.request;
+        if (!m_platform_topo.is_nested_domain(base_domain_type, req.domain_type)) {
+            return false;
+        }
+        std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
+                                                                      req.domain_type,
+                                                                      req.domain_idx);
+        std::vector<int> signal_idx;
+        for (auto it : base_domain_idx) {
+            signal_idx.push_back(push_signal(req.name, base_domain_type, it));
+        }
+        std::unique_ptr<CombinedSignal> combiner = geopm::make_unique<CombinedSignal>(agg_function(req.name));
+        register_combined_signal(pend.signal_idx, signal_idx, std::move(combiner));
+        m_active_signal[pend.signal_idx] = std::make_pair(nullptr, pend.signal_idx);
+        return true;
+    }
+
+    void PlatformIOImp::rollback_pushed_signal(void)
+    {
+        // Indices handed out since the last validation no longer
+        // refer to a signal; any IOGroup pushes that succeeded are
+        // left in place and are read with the IOGroup's batch
+        int num_valid = m_num_valid_signal;
+        m_pending_signal.clear();
+        m_active_signal.resize(m_num_valid_signal);
+        for (auto it = m_existing_signal.begin(); it != m_existing_signal.end();) {
+            if (it->second >= num_valid) {
+                it = m_existing_signal.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        m_combined_signal.erase(m_combined_signal.lower_bound(num_valid),
+                                m_combined_signal.end());
+    }
+
+    std::vector<bool> PlatformIOImp::probe_signals(IOGroup &iogroup,
+                                                   const std::vector<geopm_request_s> &request,
+                                                   std::vector<std::string> &err_msg)
+    {
+        std::vector<bool> result(request.size(), true);
+        try {
+            (void)BatchIOGroup::read_signals(iogroup, request);
+        }
+        catch (const geopm::Exception &ex) {
+            if (request.size() == 1) {
+                // IOGroups may not support read_signal()
+                if (ex.err_value() != GEOPM_ERROR_NOT_IMPLEMENTED) {
+                    result[0] = false;
+                    err_msg[0] = std::string(ex.what()) + "\n";
+                }
+                return result;
+            }
+            // Find the requests that failed by reading them one at a time
+            for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                const geopm_request_s &req = request[req_idx];
+                try {
+                    (void)iogroup.read_signal(req.name, req.domain_type, req.domain_idx);
+                }
+                catch (const geopm::Exception &ex) {
+                    // IOGroups may not support read_signal()
+                    if (ex.err_value() != GEOPM_ERROR_NOT_IMPLEMENTED) {
+                        result[req_idx] = false;
+                        err_msg[req_idx] = std::string(ex.what()) + "\n";
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
     void PlatformIOImp::write_batch(void)
     {
         for (auto &it : m_iogroup_list) {
@@ -781,6 +1175,110 @@ namespace geopm
         return result;
     }
 
+    std::vector<double> PlatformIOImp::read_signals(const std::vector<geopm_request_s> &request)
+    {
+        // Expand each request into reads of the signal at its native
+        // domain, reading each native domain only once.
+        std::vector<geopm_request_s> native_request;
+        std::vector<std::shared_ptr<IOGroup> > native_iogroup;
+        std::map<std::tuple<std::string, int, int>, int> native_map;
+        std::vector<std::vector<int> > operand(request.size());
+        std::vector<bool> is_native(request.size(), false);
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const geopm_request_s &req = request[req_idx];
+            std::string signal_name = req.name;
+            if (req.domain_type < 0 || req.domain_type >= GEOPM_NUM_DOMAIN) {
+                throw Exception("PlatformIOImp::read_signals(): domain_type is out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (req.domain_idx < 0 || req.domain_idx >= m_platform_topo.num_domain(req.domain_type)) {
+                throw Exception("PlatformIOImp::read_signals(): domain_idx is out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            auto iogroups = find_signal_iogroup(signal_name);
+            if (iogroups.empty()) {
+                throw Exception("PlatformIOImp::read_signals(): signal name \"" + signal_name + "\" not found",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            int base_domain_type = iogroups[0]->signal_domain_type(signal_name);
+            std::set<int> base_domain_idx;
+            if (base_domain_type == req.domain_type) {
+                base_domain_idx.insert(req.domain_idx);
+                is_native[req_idx] = true;
+            }
+            else if (m_platform_topo.is_nested_domain(base_domain_type, req.domain_type)) {
+                base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
+                                                                req.domain_type, req.domain_idx);
+            }
+            else {
+                throw Exception("PlatformIOImp::read_signals(): domain " + std::to_string(req.domain_type) +
+                                " is not valid for signal \"" + signal_name + "\"",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            for (auto idx : base_domain_idx) {
+                auto ins = native_map.emplace(std::make_tuple(signal_name, base_domain_type, idx),
+                                              native_request.size());
+                if (ins.second) {
+                    geopm_request_s native = req;
+                    native.domain_type = base_domain_type;
+                    native.domain_idx = idx;
+                    native_request.push_back(native);
+                    native_iogroup.push_back(iogroups[0]);
+                }
+                operand[req_idx].push_back(ins.first->second);
+            }
+        }
+
+        // Group the native requests by IOGroup so that each IOGroup
+        // can share work between its requests.  IOGroups are not
+        // required to be thread safe, so the groups are read one
+        // after another.
+        std::map<std::shared_ptr<IOGroup>, std::vector<int> > group_map;
+        for (size_t native_idx = 0; native_idx < native_request.size(); ++native_idx) {
+            group_map[native_iogroup[native_idx]].push_back(native_idx);
+        }
+        std::vector<double> native_value(native_request.size(), NAN);
+        for (const auto &group : group_map) {
+            std::vector<geopm_request_s> group_request;
+            for (auto native_idx : group.second) {
+                group_request.push_back(native_request[native_idx]);
+            }
+            try {
+                std::vector<double> group_value = BatchIOGroup::read_signals(*group.first, group_request);
+                GEOPM_DEBUG_ASSERT(group_value.size() == group.second.size(),
+                                   "BatchIOGroup::read_signals() returned the wrong number of values");
+                for (size_t group_idx = 0; group_idx < group.second.size(); ++group_idx) {
+                    native_value[group.second[group_idx]] = group_value[group_idx];
+                }
+            }
+            catch (const geopm::Exception &) {
+                // A failed group is read one request at a time so
+                // that other IOGroups that provide the signal are
+                // tried.
+                for (auto native_idx : group.second) {
+                    const geopm_request_s &native = native_request[native_idx];
+                    native_value[native_idx] = read_signal(native.name, native.domain_type,
+                                                           native.domain_idx);
+                }
+            }
+        }
+
+        std::vector<double> result(request.size(), NAN);
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            if (is_native[req_idx]) {
+                result[req_idx] = native_value[operand[req_idx][0]];
+            }
+            else {
+                std::vector<double> values;
+                for (auto native_idx : operand[req_idx]) {
+                    values.push_back(native_value[native_idx]);
+                }
+                result[req_idx] = agg_function(request[req_idx].name)(values);
+            }
+        }
+        return result;
+    }
+
     double PlatformIOImp::read_signal_convert_domain(const std::string &signal_name,
                                                      int domain_type,
                                                      int domain_idx)
@@ -1451,4 +1949,48 @@ extern "C" {
         return geopm::platform_io().is_valid_value(value) ? 0 : GEOPM_ERROR_INVALID;
     }
 
+    int geopm_pio_create_cache(void)
+    {
+        int err = 0;
+        try {
+            geopm::PlatformIO::create_cache();
+        }
+        catch (...) {
+            err = geopm::exception_handler(std::current_exception());
+            err = err < 0 ? err : GEOPM_ERROR_RUNTIME;
+        }
+        return err;
+    }
+
+    int geopm_pio_sample_loop(int num_request,
+                              const struct geopm_request_s *request,
+                              double period,
+                              int num_period,
+                              int output_format,
+                              int output_fd,
+                              int *num_missed,
+                              int *num_sample)
+    {
+        int err = 0;
+        try {
+            if (num_request <= 0 || request == nullptr ||
+                num_missed == nullptr || num_sample == nullptr) {
+                throw geopm::Exception("geopm_pio_sample_loop(): at least one request is required",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            std::vector<geopm_request_s> request_vec(request, request + num_request);
+            // The signals are pushed on geopm::platform_io() so that
+            // the IOGroups, including the batch server of the
+            // ServiceIOGroup, are shared with the other geopm_pio_*()
+            // functions rather than created a second time.
+            auto sample_loop = geopm::SampleLoop::make_unique(geopm::platform_io(), request_vec, output_format);
+            *num_missed = sample_loop->run(period, num_period, output_fd, *num_sample);
+        }
+        catch (...) {
+            err = geopm::exception_handler(std::current_exception());
+            err = err < 0 ? err : GEOPM_ERROR_RUNTIME;
+        }
+        return err;
+    }
+
 }
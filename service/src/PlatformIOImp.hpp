@@ -26,6 +26,19 @@ namespace geopm
             PlatformIOImp();
             PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
                           const PlatformTopo &topo);
+            /// @param [in] iogroup_list IOGroups to register; if empty
+            ///        the IOGroups are taken from the cache file or
+            ///        else every IOGroup plugin is constructed and
+            ///        the cache file is written.
+            ///
+            /// @param [in] topo PlatformTopo for the platform.
+            ///
+            /// @param [in] cache_file_name Path of the cache file
+            ///        created by create_cache(), or empty to construct
+            ///        every IOGroup plugin.
+            PlatformIOImp(std::list<std::shared_ptr<IOGroup> > iogroup_list,
+                          const PlatformTopo &topo,
+                          const std::string &cache_file_name);
             PlatformIOImp(const PlatformIOImp &other) = delete;
             PlatformIOImp &operator=(const PlatformIOImp &other) = delete;
             virtual ~PlatformIOImp() = default;
@@ -43,10 +56,38 @@ namespace geopm
             double sample(int signal_idx) override;
             void adjust(int control_idx, double setting) override;
             void read_batch(void) override;
+            /// @brief Check that every signal pushed since the last
+            ///        call can be read.  Called by read_batch() and
+            ///        adjust() when there are pending signals.  The
+            ///        pushed signals are read with one call to
+            ///        BatchIOGroup::read_signals() for each IOGroup
+            ///        that provides them.  A signal that cannot be
+            ///        read is assigned to the next IOGroup that
+            ///        provides it in the same native domain; an
+            ///        IOGroup that provides it in a nested domain is
+            ///        read through a combined signal.  Throws if no
+            ///        IOGroup can read a pushed signal, in which case
+            ///        all signals pushed since the last successful
+            ///        validation are removed.
+            void validate_pushed(void);
             void write_batch(void) override;
             double read_signal(const std::string &signal_name,
                                int domain_type,
                                int domain_idx) override;
+            /// @brief Read from platform and interpret into SI units
+            ///        many signals given their names and domains.
+            ///        Does not modify the values stored by calling
+            ///        read_batch().  The requests are grouped by the
+            ///        IOGroup that provides them so that, for example,
+            ///        every derivative signal in the request is
+            ///        computed from one shared sampling loop.
+            ///
+            /// @param [in] request Vector of signal names, domain
+            ///        types and domain indices to read.
+            ///
+            /// @return The values in SI units of the signals in the
+            ///         same order as the requests.
+            std::vector<double> read_signals(const std::vector<geopm_request_s> &request);
             void write_control(const std::string &control_name,
                                int domain_type,
                                int domain_idx,
@@ -67,6 +108,17 @@ namespace geopm
                                     std::string &server_key) override;
             void stop_batch_server(int server_pid) override;
 
+            static void create_cache(void);
+            static void create_cache(const std::string &cache_file_name);
+            /// @brief Register the IOGroups recorded in the cache
+            ///        file.  IOGroups described by the cache are not
+            ///        constructed until they are used.
+            ///
+            /// @return False without registering any IOGroup if the
+            ///         cache file is missing, is from a previous
+            ///         boot, or was created with a different set of
+            ///         IOGroups or environment.
+            bool load_cache(const std::string &cache_file_name);
             int num_signal_pushed(void) const;  // Used for testing only
             int num_control_pushed(void) const; // Used for testing only
         private:
@@ -131,6 +183,52 @@ namespace geopm
             ///        setting will be divided by the number of subdomains
             ///        before being applied.
             bool is_control_adjust_same(const std::string &control_name) const;
+            /// @brief Format the contents of the cache file.
+            ///
+            /// @param [in] iogroup_loaded The IOGroup constructed for
+            ///        each name returned by IOGroup::iogroup_names(),
+            ///        or nullptr if it failed to load.
+            static std::string cache_contents(const std::vector<std::shared_ptr<IOGroup> > &iogroup_loaded);
+            /// @brief Returns false if the cache file is missing or
+            ///        was created before the last boot.
+            static bool check_cache_file(const std::string &cache_file_name);
+            /// @brief Write the cache file through a temporary file
+            ///        that is only accessible by the owner.
+            static void write_cache(const std::string &cache_file_name,
+                                    const std::string &contents);
+            static const std::string M_CACHE_FILE_NAME;
+            static const std::string M_SERVICE_CACHE_FILE_NAME;
+            /// @brief Environment variables that change the signals
+            ///        and controls that the IOGroups provide.
+            static const std::vector<std::string> M_CACHE_ENV;
+            /// @brief A pushed signal that has not been read yet and
+            ///        the IOGroups that may provide it.
+            struct m_pending_signal_s {
+                int signal_idx;
+                geopm_request_s request;
+                std::vector<std::shared_ptr<IOGroup> > iogroup;
+                size_t iogroup_pos;
+                std::string err_msg;
+            };
+            /// @brief Read a group of pending signals through the
+            ///        IOGroup that is next in line to provide them.
+            ///        Returns whether each request could be read.
+            static std::vector<bool> probe_signals(IOGroup &iogroup,
+                                                   const std::vector<geopm_request_s> &request,
+                                                   std::vector<std::string> &err_msg);
+            /// @brief Move a pending signal to the next IOGroup that
+            ///        provides it.  Throws if there are none left.
+            void retry_pending_signal(m_pending_signal_s pend);
+            /// @brief Combine the signals provided in the native
+            ///        domain of an IOGroup to provide a pending signal
+            ///        in an enclosing domain.  Returns false if the
+            ///        native domain is not nested within the requested
+            ///        domain.
+            bool push_pending_convert_domain(const m_pending_signal_s &pend,
+                                             int base_domain_type);
+            /// @brief Remove the signals pushed since the last
+            ///        successful call to validate_pushed().
+            void rollback_pushed_signal(void);
             bool m_is_signal_active;
             bool m_is_control_active;
             const PlatformTopo &m_platform_topo;
@@ -138,6 +236,10 @@ namespace geopm
             std::vector<std::pair<std::shared_ptr<IOGroup>, int> > m_active_signal;
             std::vector<std::pair<std::shared_ptr<IOGroup>, int> > m_active_control;
             std::map<std::tuple<std::string, int, int>, int> m_existing_signal;
+            std::vector<m_pending_signal_s> m_pending_signal;
+            /// @brief Number of signals in m_active_signal that were
+            ///        validated by the last call to validate_pushed().
+            size_t m_num_valid_signal;
             std::map<std::tuple<std::string, int, int>, int> m_existing_control;
             std::map<int, std::pair<std::vector<int>,
                                     std::unique_ptr<CombinedSignal> > > m_combined_signal;
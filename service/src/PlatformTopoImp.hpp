@@ -32,6 +32,10 @@ namespace geopm
             static void create_cache();
             static void create_cache(const std::string &cache_file_name);
             static void create_cache(const std::string &cache_file_name, const GPUTopo &gtopo);
+            /// @brief Returns true if the cache file was created since
+            ///        the last boot with read and write permissions
+            ///        only for the owner.
+            static bool check_file(const std::string &file_name);
         private:
             static const std::string M_CACHE_FILE_NAME;
             static const std::string M_SERVICE_CACHE_FILE_NAME;
@@ -48,7 +52,6 @@ namespace geopm
             std::vector<std::set<int> > parse_lscpu_numa(const std::map<std::string, std::string> &lscpu_map);
             std::vector<std::set<int> > parse_lscpu_gpu(const std::map<std::string, std::string> &lscpu_map, int domain_type);
             std::string read_lscpu(void);
-            static bool check_file(const std::string &file_name);
             static std::string gpu_short_name(int domain_type);
             static std::unique_ptr<ServiceProxy> try_service_proxy(void);
             const std::string M_TEST_CACHE_FILE_NAME;
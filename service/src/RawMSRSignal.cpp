@@ -58,4 +58,19 @@ namespace geopm
         // convert to double
         return geopm_field_to_signal(m_msrio->read_msr(m_cpu, m_offset));
     }
+
+    int RawMSRSignal::add_read(int batch_ctx) const
+    {
+        GEOPM_DEBUG_ASSERT(m_msrio != nullptr, "no valid MSRIO object.");
+
+        return m_msrio->add_read(m_cpu, m_offset, batch_ctx);
+    }
+
+    double RawMSRSignal::sample(int batch_idx, int batch_ctx) const
+    {
+        GEOPM_DEBUG_ASSERT(m_msrio != nullptr, "no valid MSRIO object.");
+
+        // convert to double
+        return geopm_field_to_signal(m_msrio->sample(batch_idx, batch_ctx));
+    }
 }
@@ -31,6 +31,15 @@ namespace geopm
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Add a read of the MSR to one of the batch
+            ///        contexts of the MSRIO object.
+            /// @param [in] batch_ctx Batch context created with
+            ///        MSRIO::create_batch_context().
+            /// @return Index to pass to sample(int, int).
+            int add_read(int batch_ctx) const;
+            /// @brief Value of the MSR from the last call to
+            ///        MSRIO::read_batch() for the batch context.
+            double sample(int batch_idx, int batch_ctx) const;
         private:
             /// MSRIO object shared by all MSR signals in the same
             /// batch.  This object should outlive all other data in
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "RequestFile.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_error.h"
+
+namespace geopm
+{
+    std::vector<std::string> read_request_file(const std::string &file_path,
+                                               const std::vector<std::string> &field_name)
+    {
+        std::ifstream file_stream;
+        if (file_path != "-") {
+            file_stream.open(file_path);
+            if (!file_stream.is_open()) {
+                throw Exception("read_request_file(): unable to open request file: " + file_path,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        std::istream &input = file_path == "-" ? std::cin : file_stream;
+        std::vector<std::string> result;
+        std::string line;
+        int line_num = 0;
+        while (std::getline(input, line)) {
+            ++line_num;
+            std::istringstream line_stream(line);
+            std::vector<std::string> field;
+            std::string token;
+            while (line_stream >> token) {
+                field.push_back(token);
+            }
+            if (field.empty() || field[0][0] == '#') {
+                continue;
+            }
+            if (field.size() != field_name.size()) {
+                throw Exception("read_request_file(): " + file_path + ":" +
+                                std::to_string(line_num) + ": expected " +
+                                string_join(field_name, " "),
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            result.insert(result.end(), field.begin(), field.end());
+        }
+        if (result.empty()) {
+            throw Exception("read_request_file(): no requests in file: " + file_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+}
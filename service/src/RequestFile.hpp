@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef REQUESTFILE_HPP_INCLUDE
+#define REQUESTFILE_HPP_INCLUDE
+
+#include <string>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Read the requests given to geopmread or geopmwrite
+    ///        with the --file option.
+    /// @details Each line of the file holds one request made of
+    ///          white space separated fields.  Empty lines and lines
+    ///          that begin with '#' are ignored.  Throws if the file
+    ///          cannot be opened, if a line does not have one field
+    ///          for each name in field_name, or if the file holds no
+    ///          requests.
+    /// @param [in] file_path Path to the request file, or "-" to
+    ///             read from standard input.
+    /// @param [in] field_name Names of the fields of a request, used
+    ///             in error messages.
+    /// @return The fields of every request in the order read.
+    std::vector<std::string> read_request_file(const std::string &file_path,
+                                               const std::vector<std::string> &field_name);
+}
+
+#endif
@@ -8,12 +8,17 @@
 #include "SSTIO.hpp"
 
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/ioctl.h>
 
 #include <algorithm>
+#include <map>
+#include <set>
 #include <utility>
 
 #include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
 #include "SSTIOImp.hpp"
 #include "SSTIoctl.hpp"
 
@@ -24,14 +29,32 @@ namespace geopm
         return std::make_shared<SSTIOImp>(max_cpus);
     }
 
+    std::shared_ptr<SSTIO> SSTIO::make_shared(const std::vector<int> &cpu_package)
+    {
+        return std::make_shared<SSTIOImp>(cpu_package.size(),
+                                          SSTIoctl::make_shared("/dev/isst_interface"),
+                                          cpu_package);
+    }
+
     SSTIOImp::SSTIOImp(uint32_t max_cpus)
         : SSTIOImp(max_cpus, SSTIoctl::make_shared("/dev/isst_interface"))
     {
     }
 
     SSTIOImp::SSTIOImp(uint32_t max_cpus, std::shared_ptr<SSTIoctl> ioctl_interface)
+        : SSTIOImp(max_cpus, ioctl_interface, {})
+    {
+    }
+
+    SSTIOImp::SSTIOImp(uint32_t max_cpus, std::shared_ptr<SSTIoctl> ioctl_interface,
+                       const std::vector<int> &cpu_package)
         : m_ioctl(std::move(ioctl_interface))
         , m_batch_command_limit(0)
+        , m_cpu_package(cpu_package)
+        , m_is_partition_stale(false)
+        , m_worker_generation(0)
+        , m_num_worker_busy(0)
+        , m_is_worker_stop(false)
     {
         sst_version_s sst_version;
         int err = m_ioctl->version(&sst_version);
@@ -108,6 +131,7 @@ namespace geopm
         int idx = -1;
         if (it == m_mbox_read_interfaces.end()) {
             m_mbox_read_interfaces.push_back(mbox);
+            m_is_partition_stale = true;
 
             // Multiple ioctls with different data structures are used here,
             // along with multiple ioctl buffers. This vector indicates how a
@@ -207,6 +231,7 @@ namespace geopm
         };
         int mmio_idx = m_mmio_read_interfaces.size();
         m_mmio_read_interfaces.push_back(mmio);
+        m_is_partition_stale = true;
 
         int idx = m_added_interfaces.size();
         m_added_interfaces.emplace_back(MMIO, mmio_idx);
@@ -235,35 +260,215 @@ namespace geopm
         return idx;
     }
 
-    void SSTIOImp::read_batch(void)
+    SSTIOImp::~SSTIOImp()
     {
-        if (!m_mbox_read_interfaces.empty()) {
-            m_mbox_read_batch = ioctl_structs_from_vector<sst_mbox_interface_batch_s>(
-                m_mbox_read_interfaces);
+        stop_workers();
+    }
 
-            for (auto &batch : m_mbox_read_batch) {
-                errno = 0;
-                int err = m_ioctl->mbox(batch.get());
-                if (err == -1 && errno == EBUSY) {
-                    errno = 0;
-                    err = m_ioctl->mbox(batch.get());
+    int SSTIOImp::cpu_package(uint32_t cpu_index) const
+    {
+        int result = 0;
+        if (cpu_index < m_cpu_package.size()) {
+            result = m_cpu_package[cpu_index];
+        }
+        return result;
+    }
+
+    void SSTIOImp::update_read_partitions(void)
+    {
+        if (!m_is_partition_stale) {
+            return;
+        }
+        // One partition for the mailbox reads and one for the MMIO
+        // reads of each package, ordered by type then package.
+        std::map<std::pair<message_type_e, int>, std::vector<size_t> > partition_map;
+        for (size_t idx = 0; idx < m_mbox_read_interfaces.size(); ++idx) {
+            int package = cpu_package(m_mbox_read_interfaces[idx].cpu_index);
+            partition_map[std::make_pair(MBOX, package)].push_back(idx);
+        }
+        for (size_t idx = 0; idx < m_mmio_read_interfaces.size(); ++idx) {
+            int package = cpu_package(m_mmio_read_interfaces[idx].cpu_index);
+            partition_map[std::make_pair(MMIO, package)].push_back(idx);
+        }
+        m_read_partitions.clear();
+        m_mbox_read_location.assign(m_mbox_read_interfaces.size(), {});
+        m_mmio_read_location.assign(m_mmio_read_interfaces.size(), {});
+        for (auto &kv : partition_map) {
+            int partition_idx = m_read_partitions.size();
+            m_read_partitions.push_back({kv.first.first, kv.first.second,
+                                         std::move(kv.second), {}, {}});
+            auto &partition = m_read_partitions.back();
+            auto &location = partition.type == MBOX ?
+                             m_mbox_read_location : m_mmio_read_location;
+            for (size_t entry = 0; entry < partition.interface_idx.size(); ++entry) {
+                location[partition.interface_idx[entry]] = {
+                    partition_idx,
+                    entry / m_batch_command_limit,
+                    entry % m_batch_command_limit
+                };
+            }
+            if (partition.type == MBOX) {
+                std::vector<sst_mbox_interface_s> commands;
+                for (auto idx : partition.interface_idx) {
+                    commands.push_back(m_mbox_read_interfaces[idx]);
                 }
-                if (err == -1) {
-                    throw Exception("SSTIOImp::read_batch() mbox read failed",
-                                    errno, __FILE__, __LINE__);
+                partition.mbox_batch = ioctl_structs_from_vector<sst_mbox_interface_batch_s>(commands);
+            }
+            else {
+                std::vector<sst_mmio_interface_s> commands;
+                for (auto idx : partition.interface_idx) {
+                    commands.push_back(m_mmio_read_interfaces[idx]);
                 }
+                partition.mmio_batch = ioctl_structs_from_vector<sst_mmio_interface_batch_s>(commands);
             }
         }
-        if (!m_mmio_read_interfaces.empty()) {
-            m_mmio_read_batch = ioctl_structs_from_vector<sst_mmio_interface_batch_s>(
-                m_mmio_read_interfaces);
+        m_partition_error.assign(m_read_partitions.size(), nullptr);
+        // The calling thread reads the first partition
+        int num_worker = m_read_partitions.empty() ? 0 : m_read_partitions.size() - 1;
+        if (num_worker != (int)m_workers.size()) {
+            stop_workers();
+            start_workers(num_worker);
+        }
+        m_is_partition_stale = false;
+    }
 
-            for (auto &batch : m_mmio_read_batch) {
-                int err = m_ioctl->mmio(batch.get());
-                if (err == -1) {
-                    throw Exception("SSTIOImp::read_batch() mmio read failed",
-                                    errno, __FILE__, __LINE__);
+    void SSTIOImp::read_partition(int partition_idx)
+    {
+        auto &partition = m_read_partitions[partition_idx];
+        for (auto &batch : partition.mbox_batch) {
+            errno = 0;
+            int err = m_ioctl->mbox(batch.get());
+            if (err == -1 && errno == EBUSY) {
+                errno = 0;
+                err = m_ioctl->mbox(batch.get());
+            }
+            if (err == -1) {
+                throw Exception("SSTIOImp::read_batch() mbox read failed",
+                                errno, __FILE__, __LINE__);
+            }
+        }
+        for (auto &batch : partition.mmio_batch) {
+            int err = m_ioctl->mmio(batch.get());
+            if (err == -1) {
+                throw Exception("SSTIOImp::read_batch() mmio read failed",
+                                errno, __FILE__, __LINE__);
+            }
+        }
+    }
+
+    void SSTIOImp::start_workers(int num_worker)
+    {
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> guard(m_worker_mutex);
+            m_is_worker_stop = false;
+            generation = m_worker_generation;
+        }
+        for (int worker_idx = 0; worker_idx < num_worker; ++worker_idx) {
+            // Worker N reads partition N + 1
+            int partition_idx = worker_idx + 1;
+            m_workers.emplace_back(&SSTIOImp::worker_loop, this, partition_idx, generation);
+            set_worker_affinity(m_workers.back(), m_read_partitions[partition_idx].package);
+        }
+    }
+
+    void SSTIOImp::set_worker_affinity(std::thread &worker, int package)
+    {
+        // A new thread inherits the affinity of its creator, and the
+        // controller is usually pinned to one CPU by the time the
+        // first batch is read.  Let the worker run on any CPU of the
+        // package it reads instead so that the partitions are read
+        // in parallel.
+        std::set<int> package_cpu;
+        int num_cpu = 0;
+        for (const auto &cpu_punit : m_cpu_punit_core_map) {
+            if (cpu_package(cpu_punit.first) == package) {
+                package_cpu.insert(cpu_punit.first);
+            }
+            num_cpu = std::max(num_cpu, (int)cpu_punit.first + 1);
+        }
+        if (package_cpu.empty()) {
+            return;
+        }
+        auto cpu_mask = make_cpu_set(num_cpu, package_cpu);
+        // The worker keeps the inherited affinity if none of the
+        // package CPUs are available to the process
+        (void)pthread_setaffinity_np(worker.native_handle(), CPU_ALLOC_SIZE(num_cpu), cpu_mask.get());
+    }
+
+    void SSTIOImp::stop_workers(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_worker_mutex);
+            m_is_worker_stop = true;
+        }
+        m_worker_start_cv.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    void SSTIOImp::worker_loop(int partition_idx, uint64_t generation)
+    {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_worker_mutex);
+                m_worker_start_cv.wait(lock, [this, generation]() {
+                    return m_is_worker_stop || m_worker_generation != generation;
+                });
+                if (m_is_worker_stop) {
+                    break;
                 }
+                generation = m_worker_generation;
+            }
+            std::exception_ptr error = nullptr;
+            try {
+                read_partition(partition_idx);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> guard(m_worker_mutex);
+                m_partition_error[partition_idx] = error;
+                --m_num_worker_busy;
+            }
+            m_worker_done_cv.notify_one();
+        }
+    }
+
+    void SSTIOImp::read_batch(void)
+    {
+        update_read_partitions();
+        if (m_read_partitions.empty()) {
+            return;
+        }
+        if (!m_workers.empty()) {
+            {
+                std::lock_guard<std::mutex> guard(m_worker_mutex);
+                m_num_worker_busy = m_workers.size();
+                ++m_worker_generation;
+            }
+            m_worker_start_cv.notify_all();
+        }
+        m_partition_error[0] = nullptr;
+        try {
+            read_partition(0);
+        }
+        catch (...) {
+            m_partition_error[0] = std::current_exception();
+        }
+        if (!m_workers.empty()) {
+            std::unique_lock<std::mutex> lock(m_worker_mutex);
+            m_worker_done_cv.wait(lock, [this]() {
+                return m_num_worker_busy == 0;
+            });
+        }
+        // Report the first failure in partition order
+        for (const auto &error : m_partition_error) {
+            if (error) {
+                std::rethrow_exception(error);
             }
         }
     }
@@ -272,24 +477,24 @@ namespace geopm
     {
         const auto &interface = m_added_interfaces[batch_idx];
         uint64_t sample_value = 0;
-        // All interfaces in the list are divided into groups limited by a
-        // system-defined maximum size per group of commands. We use division
-        // to determine which group contains the requested sample. The modulo
-        // operation determines which sample within that group is the one we
-        // need.
+        // Reads are grouped into a partition per package and type,
+        // and each partition is divided into groups limited by a
+        // system-defined maximum size per group of commands.  The
+        // location of each read is recorded when the partitions are
+        // created.
         if (interface.first == MMIO) {
-            size_t mmio_batch_idx = interface.second / m_batch_command_limit;
-            size_t mmio_interface_idx = interface.second % m_batch_command_limit;
-            sample_value = m_mmio_read_batch[mmio_batch_idx]->interfaces[mmio_interface_idx].value;
+            const auto &location = m_mmio_read_location.at(interface.second);
+            const auto &partition = m_read_partitions.at(location.partition_idx);
+            sample_value = partition.mmio_batch[location.batch_idx]->interfaces[location.entry_idx].value;
         }
         else {
             if (interface.first != MBOX) {
                 throw Exception("SSTIOImp::sample(): Unexpected interface type",
                                 GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
             }
-            size_t mbox_batch_idx = interface.second / m_batch_command_limit;
-            size_t mbox_interface_idx = interface.second % m_batch_command_limit;
-            sample_value = m_mbox_read_batch[mbox_batch_idx]->interfaces[mbox_interface_idx].read_value;
+            const auto &location = m_mbox_read_location.at(interface.second);
+            const auto &partition = m_read_partitions.at(location.partition_idx);
+            sample_value = partition.mbox_batch[location.batch_idx]->interfaces[location.entry_idx].read_value;
         }
         return sample_value;
     }
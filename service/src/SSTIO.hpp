@@ -140,6 +140,13 @@ namespace geopm
             /// @param [in] max_cpus The number of CPUs to attempt to map
             ///             to punit cores.
             static std::shared_ptr<SSTIO> make_shared(uint32_t max_cpus);
+
+            /// @brief Create an SSTIO object that issues the batched
+            ///        reads for each package concurrently.
+            /// @param [in] cpu_package The package index of each
+            ///             CPU.  The size of the vector is the number
+            ///             of CPUs to attempt to map to punit cores.
+            static std::shared_ptr<SSTIO> make_shared(const std::vector<int> &cpu_package);
     };
 
 }
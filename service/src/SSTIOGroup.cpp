@@ -251,7 +251,12 @@ namespace geopm
         , m_mock_save_ctl(std::move(save_control))
     {
         if (m_sstio == nullptr) {
-            m_sstio = SSTIO::make_shared(m_topo.num_domain(GEOPM_DOMAIN_CPU));
+            int num_cpu = m_topo.num_domain(GEOPM_DOMAIN_CPU);
+            std::vector<int> cpu_package(num_cpu);
+            for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+                cpu_package[cpu_idx] = m_topo.domain_idx(GEOPM_DOMAIN_PACKAGE, cpu_idx);
+            }
+            m_sstio = SSTIO::make_shared(cpu_package);
         }
 
         // Directly register MBOX-based signals
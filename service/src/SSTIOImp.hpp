@@ -7,10 +7,14 @@
 #define SSTIOIMP_HPP_INCLUDE
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 #include "SSTIO.hpp"
@@ -32,7 +36,20 @@ namespace geopm
             /// you to override the ioctl interface.
             SSTIOImp(uint32_t max_cpus, std::shared_ptr<SSTIoctl> ioctl_interface);
 
-            virtual ~SSTIOImp() = default;
+            /// @brief Constructor that partitions batched reads by
+            ///        package.
+            /// @param [in] max_cpus The number of CPUs to attempt to map
+            ///             to punit cores.
+            /// @param [in] ioctl_interface The ioctl interface to use.
+            /// @param [in] cpu_package The package index of each CPU.
+            ///             Mailbox and MMIO reads for each package are
+            ///             issued concurrently by persistent worker
+            ///             threads.  If empty, all CPUs are treated as
+            ///             belonging to package zero.
+            SSTIOImp(uint32_t max_cpus, std::shared_ptr<SSTIoctl> ioctl_interface,
+                     const std::vector<int> &cpu_package);
+
+            virtual ~SSTIOImp();
 
             /// Interact with the mailbox on commands that are expected to return data
             int add_mbox_read(uint32_t cpu_index, uint16_t command,
@@ -116,8 +133,61 @@ namespace geopm
                 return outer_structs;
             }
 
+            /// @brief Subset of the batched reads that are issued
+            ///        together by one thread: all mailbox or all MMIO
+            ///        reads for one package.
+            struct m_read_partition_s {
+                message_type_e type;
+                int package;
+                /// Index into m_mbox_read_interfaces or
+                /// m_mmio_read_interfaces for each partition entry
+                std::vector<size_t> interface_idx;
+                std::vector<std::unique_ptr<sst_mbox_interface_batch_s, void(*)(sst_mbox_interface_batch_s*)> > mbox_batch;
+                std::vector<std::unique_ptr<sst_mmio_interface_batch_s, void(*)(sst_mmio_interface_batch_s*)> > mmio_batch;
+            };
+
+            /// @brief Location of a read within the partitions.
+            struct m_read_location_s {
+                int partition_idx;
+                size_t batch_idx;
+                size_t entry_idx;
+            };
+
+            // Threading model for read_batch(): the batched reads are
+            // split into partitions, one for the mailbox reads and one
+            // for the MMIO reads of each package.  The calling thread
+            // reads partition zero and a persistent worker thread reads
+            // each other partition.  The workers are created when the
+            // partitions are first built, and rebuilt when a read is
+            // added, and each worker is bound to the CPUs of the package
+            // it reads.  All threads issue their ioctl(2) calls on the
+            // same SSTIoctl file descriptor; this is safe because each
+            // call passes the buffers of its own partition and the
+            // driver serializes access to each mailbox.  Writes and the
+            // *_once() methods only run on the calling thread.
+            int cpu_package(uint32_t cpu_index) const;
+            void update_read_partitions(void);
+            void read_partition(int partition_idx);
+            void start_workers(int num_worker);
+            void set_worker_affinity(std::thread &worker, int package);
+            void stop_workers(void);
+            void worker_loop(int partition_idx, uint64_t generation);
+
             std::shared_ptr<SSTIoctl> m_ioctl;
             int m_batch_command_limit;
+            std::vector<int> m_cpu_package;
+            bool m_is_partition_stale;
+            std::vector<m_read_partition_s> m_read_partitions;
+            std::vector<m_read_location_s> m_mbox_read_location;
+            std::vector<m_read_location_s> m_mmio_read_location;
+            std::vector<std::exception_ptr> m_partition_error;
+            std::vector<std::thread> m_workers;
+            std::mutex m_worker_mutex;
+            std::condition_variable m_worker_start_cv;
+            std::condition_variable m_worker_done_cv;
+            uint64_t m_worker_generation;
+            int m_num_worker_busy;
+            bool m_is_worker_stop;
             std::vector<struct sst_mbox_interface_s> m_mbox_read_interfaces;
             std::vector<struct sst_mbox_interface_s> m_mbox_write_interfaces;
             std::vector<struct sst_mbox_interface_s> m_mbox_rmw_interfaces;
@@ -129,9 +199,7 @@ namespace geopm
             std::vector<uint32_t> m_mmio_rmw_read_masks;
             std::vector<uint32_t> m_mmio_rmw_write_masks;
             std::vector<std::pair<message_type_e, size_t> > m_added_interfaces;
-            std::vector<std::unique_ptr<sst_mbox_interface_batch_s, void(*)(sst_mbox_interface_batch_s*)> > m_mbox_read_batch;
             std::vector<std::unique_ptr<sst_mbox_interface_batch_s, void(*)(sst_mbox_interface_batch_s*)> > m_mbox_write_batch;
-            std::vector<std::unique_ptr<sst_mmio_interface_batch_s, void(*)(sst_mmio_interface_batch_s*)> > m_mmio_read_batch;
             std::vector<std::unique_ptr<sst_mmio_interface_batch_s, void(*)(sst_mmio_interface_batch_s*)> > m_mmio_write_batch;
             std::map<uint32_t, uint32_t> m_cpu_punit_core_map;
     };
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "SampleLoop.hpp"
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm_pio.h"
+
+namespace geopm
+{
+    static int64_t monotonic_time_ns(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+    }
+
+    // Sleep until the absolute CLOCK_MONOTONIC time deadline_ns.
+    // Returns false if the sleep was interrupted by a signal handler
+    // so that the caller can stop, e.g. when Python has deferred the
+    // handling of SIGINT to the interpreter.
+    static bool sleep_until(int64_t deadline_ns)
+    {
+        struct timespec deadline;
+        deadline.tv_sec = deadline_ns / 1000000000LL;
+        deadline.tv_nsec = deadline_ns % 1000000000LL;
+        int err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+        if (err == EINTR) {
+            return false;
+        }
+        if (err != 0) {
+            throw Exception("SampleLoopImp::run(): clock_nanosleep() failed",
+                            err, __FILE__, __LINE__);
+        }
+        return true;
+    }
+
+    static void write_all(int fd, const char *buffer, size_t size)
+    {
+        while (size != 0) {
+            ssize_t num_written = write(fd, buffer, size);
+            if (num_written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw Exception("SampleLoopImp::run(): failed to write output",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            buffer += num_written;
+            size -= num_written;
+        }
+    }
+
+    std::unique_ptr<SampleLoop> SampleLoop::make_unique(PlatformIO &platform_io,
+                                                        const std::vector<geopm_request_s> &request,
+                                                        int output_format)
+    {
+        return geopm::make_unique<SampleLoopImp>(platform_io, request, output_format);
+    }
+
+    SampleLoopImp::SampleLoopImp(PlatformIO &platform_io,
+                                 const std::vector<geopm_request_s> &request,
+                                 int output_format)
+        : m_platform_io(platform_io)
+        , m_output_format(output_format)
+    {
+        if (m_output_format != GEOPM_PIO_SAMPLE_FORMAT_TEXT &&
+            m_output_format != GEOPM_PIO_SAMPLE_FORMAT_BINARY) {
+            throw Exception("SampleLoopImp::SampleLoopImp(): invalid output format: " + std::to_string(output_format),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (request.empty()) {
+            throw Exception("SampleLoopImp::SampleLoopImp(): at least one request is required",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        for (const auto &req : request) {
+            m_signal_idx.push_back(m_platform_io.push_signal(req.name, req.domain_type, req.domain_idx));
+            if (m_output_format == GEOPM_PIO_SAMPLE_FORMAT_TEXT) {
+                m_format.push_back(m_platform_io.format_function(req.name));
+            }
+        }
+        m_binary_record.resize(request.size() + 1);
+    }
+
+    int SampleLoopImp::run(double period, int num_period, int output_fd, int &num_sample)
+    {
+        if (!(period >= 0.0) || std::isinf(period) || num_period < 0) {
+            throw Exception("SampleLoopImp::run(): period and num_period must not be negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int num_missed = 0;
+        num_sample = 0;
+        int64_t period_ns = std::llround(period * 1e9);
+        int64_t start_ns = monotonic_time_ns();
+        for (int period_idx = 0; period_idx <= num_period; ++period_idx) {
+            if (period_idx != 0) {
+                // Deadlines are computed from the start time rather
+                // than the previous deadline to avoid accumulating
+                // rounding error
+                int64_t deadline_ns = start_ns + period_idx * period_ns;
+                if (monotonic_time_ns() >= deadline_ns) {
+                    if (period_ns != 0) {
+                        ++num_missed;
+                    }
+                }
+                else if (!sleep_until(deadline_ns)) {
+                    break;
+                }
+            }
+            m_platform_io.read_batch();
+            write_record(1e-9 * (monotonic_time_ns() - start_ns), output_fd);
+            ++num_sample;
+        }
+        return num_missed;
+    }
+
+    void SampleLoopImp::write_record(double time, int output_fd)
+    {
+        if (m_output_format == GEOPM_PIO_SAMPLE_FORMAT_BINARY) {
+            m_binary_record[0] = time;
+            for (size_t req_idx = 0; req_idx < m_signal_idx.size(); ++req_idx) {
+                m_binary_record[req_idx + 1] = m_platform_io.sample(m_signal_idx[req_idx]);
+            }
+            write_all(output_fd, (const char *)m_binary_record.data(),
+                      m_binary_record.size() * sizeof(double));
+        }
+        else {
+            m_text_record.clear();
+            for (size_t req_idx = 0; req_idx < m_signal_idx.size(); ++req_idx) {
+                if (req_idx != 0) {
+                    m_text_record += ',';
+                }
+                m_text_record += m_format[req_idx](m_platform_io.sample(m_signal_idx[req_idx]));
+            }
+            m_text_record += '\n';
+            write_all(output_fd, m_text_record.data(), m_text_record.size());
+        }
+    }
+}
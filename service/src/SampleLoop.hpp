@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SAMPLELOOP_HPP_INCLUDE
+#define SAMPLELOOP_HPP_INCLUDE
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct geopm_request_s;
+
+namespace geopm
+{
+    class PlatformIO;
+
+    /// @brief Periodically reads a fixed set of signals through
+    ///        PlatformIO and writes each sample to a file descriptor.
+    ///
+    /// All of the requested signals are pushed when the object is
+    /// constructed.  Each period is one call to
+    /// PlatformIO::read_batch() followed by one record written to the
+    /// output.  Reads are scheduled on absolute CLOCK_MONOTONIC
+    /// deadlines, so time spent reading and writing does not
+    /// accumulate into drift.  A deadline that has already passed
+    /// when the loop is ready to wait for it is counted as missed,
+    /// and the read is made immediately.  If a signal handler
+    /// interrupts the wait for a deadline the loop stops early.
+    ///
+    /// Text records are the formatted values of one sample separated
+    /// by commas and terminated by a newline.  Binary records are
+    /// num_request + 1 doubles in host byte order: the time in
+    /// seconds since the loop started, then the value of each request
+    /// in the order requested.
+    class SampleLoop
+    {
+        public:
+            SampleLoop() = default;
+            virtual ~SampleLoop() = default;
+            /// @brief Read the signals num_period + 1 times, once
+            ///        immediately and then once at the end of each
+            ///        period, writing one record to output_fd for each
+            ///        read.
+            /// @param [in] period Time between reads in seconds.
+            /// @param [in] num_period Number of periods spanned by
+            ///        the loop.
+            /// @param [in] output_fd Open file descriptor where the
+            ///        records are written.
+            /// @param [out] num_sample Number of records written.
+            ///        This is less than num_period + 1 if the loop
+            ///        was stopped by a signal handler.
+            /// @return Number of deadlines that had passed before the
+            ///         loop was ready to wait for them.
+            virtual int run(double period, int num_period, int output_fd, int &num_sample) = 0;
+            /// @brief Create a SampleLoop that pushes the requested
+            ///        signals.
+            /// @param [in] platform_io PlatformIO object used to push
+            ///        and read the signals.  No signal may have been
+            ///        read through it yet.
+            /// @param [in] request Signals to read.
+            /// @param [in] output_format One of the
+            ///        geopm_pio_sample_format_e values.
+            /// @return A unique pointer to an object that implements
+            ///         the SampleLoop interface.
+            static std::unique_ptr<SampleLoop> make_unique(PlatformIO &platform_io,
+                                                           const std::vector<geopm_request_s> &request,
+                                                           int output_format);
+    };
+
+    class SampleLoopImp : public SampleLoop
+    {
+        public:
+            SampleLoopImp(PlatformIO &platform_io,
+                          const std::vector<geopm_request_s> &request,
+                          int output_format);
+            SampleLoopImp(const SampleLoopImp &other) = delete;
+            SampleLoopImp &operator=(const SampleLoopImp &other) = delete;
+            virtual ~SampleLoopImp() = default;
+            int run(double period, int num_period, int output_fd, int &num_sample) override;
+        private:
+            void write_record(double time, int output_fd);
+
+            PlatformIO &m_platform_io;
+            int m_output_format;
+            std::vector<int> m_signal_idx;
+            std::vector<std::function<std::string(double)> > m_format;
+            std::vector<double> m_binary_record;
+            std::string m_text_record;
+    };
+}
+
+#endif
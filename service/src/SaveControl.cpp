@@ -7,16 +7,34 @@
 
 #include "SaveControl.hpp"
 
+#include <cmath>
+#include <cstring>
+
 #include "geopm/json11.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/IOGroup.hpp"
+#include "geopm/BatchIOGroup.hpp"
+#include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 
 using json11::Json;
 
 namespace geopm
 {
+    static geopm_request_s make_request(const std::string &name,
+                                        int domain_type,
+                                        int domain_idx)
+    {
+        if (name.size() >= NAME_MAX) {
+            throw Exception("SaveControlImp: control name is too long: " + name,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        geopm_request_s result {domain_type, domain_idx, {}};
+        strncpy(result.name, name.c_str(), NAME_MAX - 1);
+        return result;
+    }
+
     std::unique_ptr<SaveControl>
     SaveControl::make_unique(const std::vector<m_setting_s> &settings)
     {
@@ -130,12 +148,13 @@ namespace geopm
 
     void SaveControlImp::restore(IOGroup &io_group) const
     {
+        std::vector<geopm_request_s> request;
+        std::vector<double> setting;
         for (const auto &ss : settings()) {
-            io_group.write_control(ss.name,
-                                   ss.domain_type,
-                                   ss.domain_idx,
-                                   ss.setting);
+            request.push_back(make_request(ss.name, ss.domain_type, ss.domain_idx));
+            setting.push_back(ss.setting);
         }
+        BatchIOGroup::write_controls(io_group, request, setting);
     }
 
     std::vector<SaveControl::m_setting_s>
@@ -143,22 +162,31 @@ namespace geopm
                              const PlatformTopo &topo)
     {
         std::vector<m_setting_s> result;
+        std::vector<geopm_request_s> request;
         std::string prefix = io_group.name() + "::";
         for (const auto &name : io_group.control_names()) {
             if (string_begins_with(name, prefix)) {
                 int dom_type = io_group.control_domain_type(name);
                 int num_dom = topo.num_domain(dom_type);
                 for (int dom_idx = 0; dom_idx != num_dom; ++dom_idx) {
-                    double setting = io_group.read_signal(name,
-                                                          dom_type,
-                                                          dom_idx);
+                    request.push_back(make_request(name, dom_type, dom_idx));
                     result.push_back({name,
                                       dom_type,
                                       dom_idx,
-                                      setting});
+                                      NAN});
                 }
             }
         }
+        // Read all of the settings with one request so that the
+        // IOGroup can batch the underlying operations
+        std::vector<double> setting = BatchIOGroup::read_signals(io_group, request);
+        if (setting.size() != result.size()) {
+            throw Exception("SaveControlImp::settings(): BatchIOGroup::read_signals() returned the wrong number of values",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+        for (size_t set_idx = 0; set_idx < result.size(); ++set_idx) {
+            result[set_idx].setting = setting[set_idx];
+        }
         return result;
     }
 }
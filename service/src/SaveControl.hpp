@@ -81,7 +81,8 @@ namespace geopm
             /// based on the control_names() return values that are
             /// within the IOGroup namespace.  The corresponding
             /// signal is read for all these low level controls at
-            /// their native domain.  The values that are read are
+            /// their native domain with one call to
+            /// BatchIOGroup::read_signals().  The values that are read are
             /// stored in the SaveControl object that is returned.
             ///
             /// @param io_group [in] An IOGroup that implements controls
@@ -112,8 +113,8 @@ namespace geopm
             virtual void write_json(const std::string &save_path) const = 0;
             /// @brief Write all of the control settings to the platform
             ///
-            /// Make a sequence of calls to io_group.write_control() with
-            /// the parameters returned by the settings() method.
+            /// Make one call to BatchIOGroup::write_controls() with the
+            /// parameters returned by the settings() method.
             ///
             /// @param io_group [in] An IOGroup that implements controls
             virtual void restore(IOGroup &io_group) const = 0;
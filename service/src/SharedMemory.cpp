@@ -7,6 +7,7 @@
 
 #include "SharedMemoryImp.hpp"
 
+#include <errno.h>
 #include <limits.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -26,6 +27,10 @@
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
 namespace geopm
 {
     void SharedMemory::cleanup_shmem(void)
@@ -79,6 +84,35 @@ namespace geopm
         }
     }
 
+    // Apply the placement options to a mapping that has not been
+    // touched yet: the huge page advice only affects pages allocated
+    // after it is set.
+    static void place_pages(void *ptr, size_t size, const SharedMemory::placement_s &placement)
+    {
+        if (placement.is_huge_page) {
+            // Kernels without transparent huge page support reject
+            // the advice with EINVAL, and the region is usable as is.
+            if (madvise(ptr, size, MADV_HUGEPAGE) != 0 && errno != EINVAL) {
+                throw Exception("SharedMemoryImp: Could not advise huge pages for shared memory region",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        if (placement.is_prefault) {
+            // MADV_POPULATE_WRITE was added in Linux 5.14; write to
+            // each page of the new, zero filled region on older kernels.
+            if (madvise(ptr, size, MADV_POPULATE_WRITE) != 0) {
+                if (errno != EINVAL) {
+                    throw Exception("SharedMemoryImp: Could not pre-fault shared memory region",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                size_t page_size = sysconf(_SC_PAGESIZE);
+                for (size_t offset = 0; offset < size; offset += page_size) {
+                    ((volatile char *)ptr)[offset] = 0;
+                }
+            }
+        }
+    }
+
     std::unique_ptr<SharedMemory> SharedMemory::make_unique_owner(const std::string &shm_key, size_t size)
     {
         std::unique_ptr<SharedMemoryImp> owner = geopm::make_unique<SharedMemoryImp>();
@@ -86,6 +120,14 @@ namespace geopm
         return std::unique_ptr<SharedMemory>(std::move(owner));
     }
 
+    std::unique_ptr<SharedMemory> SharedMemory::make_unique_owner(const std::string &shm_key, size_t size,
+                                                                  const placement_s &placement)
+    {
+        std::unique_ptr<SharedMemoryImp> owner = geopm::make_unique<SharedMemoryImp>();
+        owner->create_memory_region(shm_key, size, false, placement);
+        return std::unique_ptr<SharedMemory>(std::move(owner));
+    }
+
     std::unique_ptr<SharedMemory> SharedMemory::make_unique_owner_secure(const std::string &shm_key, size_t size)
     {
         std::unique_ptr<SharedMemoryImp> owner = geopm::make_unique<SharedMemoryImp>();
@@ -93,6 +135,14 @@ namespace geopm
         return std::unique_ptr<SharedMemory>(std::move(owner));
     }
 
+    std::unique_ptr<SharedMemory> SharedMemory::make_unique_owner_secure(const std::string &shm_key, size_t size,
+                                                                         const placement_s &placement)
+    {
+        std::unique_ptr<SharedMemoryImp> owner = geopm::make_unique<SharedMemoryImp>();
+        owner->create_memory_region(shm_key, size, true, placement);
+        return std::unique_ptr<SharedMemory>(std::move(owner));
+    }
+
     std::unique_ptr<SharedMemory> SharedMemory::make_unique_user(const std::string &shm_key, unsigned int timeout)
     {
         std::unique_ptr<SharedMemoryImp> user = geopm::make_unique<SharedMemoryImp>();
@@ -110,6 +160,12 @@ namespace geopm
     }
 
     void SharedMemoryImp::create_memory_region(const std::string &shm_key, size_t size, bool is_secure)
+    {
+        create_memory_region(shm_key, size, is_secure, {});
+    }
+
+    void SharedMemoryImp::create_memory_region(const std::string &shm_key, size_t size, bool is_secure,
+                                               const placement_s &placement)
     {
         if (!size) {
             throw Exception("SharedMemoryImp: Cannot create shared memory region of zero size", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
@@ -157,6 +213,15 @@ namespace geopm
         }
         umask(old_mask);
 
+        try {
+            place_pages(m_ptr, m_size, placement);
+        }
+        catch (...) {
+            (void) munmap(m_ptr, m_size);
+            (void) ::unlink(m_shm_path.c_str());
+            m_ptr = nullptr;
+            throw;
+        }
         setup_mutex((pthread_mutex_t*)m_ptr);
 
         m_is_linked = true;
@@ -33,6 +33,16 @@ namespace geopm
             /// @param [in] size Size of the region to create.
             /// @param [in] is_secure Disallow group and world r/w if true.
             void create_memory_region(const std::string &shm_key, size_t size, bool is_secure);
+            /// @brief Takes a key and a size and creates
+            ///        an inter-process shared memory region with its
+            ///        pages placed as requested.
+            /// @param [in] shm_key Shared memory key to create the region.
+            /// @param [in] size Size of the region to create.
+            /// @param [in] is_secure Disallow group and world r/w if true.
+            /// @param [in] placement Huge page and pre-fault options
+            ///             applied before the region is first touched.
+            void create_memory_region(const std::string &shm_key, size_t size, bool is_secure,
+                                      const placement_s &placement);
             /// @brief Takes a key and attempts to attach to a
             ///        inter-process shared memory region. This version of the
             ///        constructor tries to attach multiple times until a timeout
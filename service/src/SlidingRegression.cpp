@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "SlidingRegression.hpp"
+
+#include <cmath>
+
+#include "geopm/Exception.hpp"
+
+namespace geopm
+{
+    SlidingRegression::SlidingRegression(int num_sample, int num_lane)
+        : M_NUM_SAMPLE(num_sample)
+        , m_num_lane(num_lane)
+        , m_head(0)
+        , m_origin_time(0.0)
+        , m_time(M_NUM_SAMPLE > 0 ? M_NUM_SAMPLE : 0, 0.0)
+        , m_sample(m_time.size() * num_lane, 0.0)
+        , m_num_fit(num_lane, 0)
+        , m_origin_sample(num_lane, 0.0)
+        , m_sum_x(num_lane, 0.0)
+        , m_sum_xx(num_lane, 0.0)
+        , m_sum_y(num_lane, 0.0)
+        , m_sum_xy(num_lane, 0.0)
+        , m_slope(num_lane, NAN)
+    {
+
+    }
+
+    int SlidingRegression::add_lane(void)
+    {
+        // Grow each row of the history by one lane
+        std::vector<double> sample(m_time.size() * (m_num_lane + 1), 0.0);
+        for (size_t pos = 0; pos < m_time.size(); ++pos) {
+            for (int lane_idx = 0; lane_idx < m_num_lane; ++lane_idx) {
+                sample[pos * (m_num_lane + 1) + lane_idx] = m_sample[pos * m_num_lane + lane_idx];
+            }
+        }
+        m_sample = std::move(sample);
+        m_num_fit.push_back(0);
+        m_origin_sample.push_back(0.0);
+        m_sum_x.push_back(0.0);
+        m_sum_xx.push_back(0.0);
+        m_sum_y.push_back(0.0);
+        m_sum_xy.push_back(0.0);
+        m_slope.push_back(NAN);
+        return m_num_lane++;
+    }
+
+    int SlidingRegression::num_lane(void) const
+    {
+        return m_num_lane;
+    }
+
+    void SlidingRegression::insert(double time, const double *sample)
+    {
+        if (M_NUM_SAMPLE < 1) {
+            throw Exception("SlidingRegression::insert(): the window must hold at least one sample",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        bool is_empty = true;
+        for (int lane_idx = 0; is_empty && lane_idx < m_num_lane; ++lane_idx) {
+            is_empty = m_num_fit[lane_idx] == 0;
+        }
+        if (is_empty) {
+            m_origin_time = time;
+        }
+        const double x_new = time - m_origin_time;
+        // Only used by lanes with a full window, in which case the
+        // oldest sample is at the head.
+        const double x_old = m_time[m_head] - m_origin_time;
+        double *row = m_sample.data() + m_head * m_num_lane;
+        for (int lane_idx = 0; lane_idx < m_num_lane; ++lane_idx) {
+            if (m_num_fit[lane_idx] == 0) {
+                m_origin_sample[lane_idx] = sample[lane_idx];
+            }
+            if (m_num_fit[lane_idx] == M_NUM_SAMPLE) {
+                double y_old = row[lane_idx] - m_origin_sample[lane_idx];
+                m_sum_x[lane_idx] -= x_old;
+                m_sum_xx[lane_idx] -= x_old * x_old;
+                m_sum_y[lane_idx] -= y_old;
+                m_sum_xy[lane_idx] -= x_old * y_old;
+            }
+            else {
+                ++m_num_fit[lane_idx];
+            }
+            double y_new = sample[lane_idx] - m_origin_sample[lane_idx];
+            row[lane_idx] = sample[lane_idx];
+            m_sum_x[lane_idx] += x_new;
+            m_sum_xx[lane_idx] += x_new * x_new;
+            m_sum_y[lane_idx] += y_new;
+            m_sum_xy[lane_idx] += x_new * y_new;
+        }
+        m_time[m_head] = time;
+        m_head = (m_head + 1) % M_NUM_SAMPLE;
+        if (m_head == 0) {
+            recenter();
+        }
+        for (int lane_idx = 0; lane_idx < m_num_lane; ++lane_idx) {
+            update_slope(lane_idx);
+        }
+    }
+
+    double SlidingRegression::slope(int lane_idx) const
+    {
+        if (lane_idx < 0 || lane_idx >= m_num_lane) {
+            throw Exception("SlidingRegression::slope(): lane_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_slope[lane_idx];
+    }
+
+    void SlidingRegression::recenter(void)
+    {
+        // The history is full and the head is the oldest sample
+        m_origin_time = m_time[m_head];
+        for (int lane_idx = 0; lane_idx < m_num_lane; ++lane_idx) {
+            int num_fit = m_num_fit[lane_idx];
+            if (num_fit != 0) {
+                int pos = (m_head + M_NUM_SAMPLE - num_fit) % M_NUM_SAMPLE;
+                m_origin_sample[lane_idx] = m_sample[pos * m_num_lane + lane_idx];
+            }
+            m_sum_x[lane_idx] = 0.0;
+            m_sum_xx[lane_idx] = 0.0;
+            m_sum_y[lane_idx] = 0.0;
+            m_sum_xy[lane_idx] = 0.0;
+        }
+        for (int age = 0; age < M_NUM_SAMPLE; ++age) {
+            int pos = (m_head + age) % M_NUM_SAMPLE;
+            double x = m_time[pos] - m_origin_time;
+            const double *row = m_sample.data() + pos * m_num_lane;
+            for (int lane_idx = 0; lane_idx < m_num_lane; ++lane_idx) {
+                if (age >= M_NUM_SAMPLE - m_num_fit[lane_idx]) {
+                    double y = row[lane_idx] - m_origin_sample[lane_idx];
+                    m_sum_x[lane_idx] += x;
+                    m_sum_xx[lane_idx] += x * x;
+                    m_sum_y[lane_idx] += y;
+                    m_sum_xy[lane_idx] += x * y;
+                }
+            }
+        }
+    }
+
+    void SlidingRegression::update_slope(int lane_idx)
+    {
+        double result = NAN;
+        int num_fit = m_num_fit[lane_idx];
+        if (num_fit >= 2) {
+            double ssxx = m_sum_xx[lane_idx] - m_sum_x[lane_idx] * m_sum_x[lane_idx] / num_fit;
+            double ssxy = m_sum_xy[lane_idx] - m_sum_x[lane_idx] * m_sum_y[lane_idx] / num_fit;
+            if (ssxx != 0) {
+                result = ssxy / ssxx;
+            }
+        }
+        m_slope[lane_idx] = result;
+    }
+}
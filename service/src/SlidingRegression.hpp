@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SLIDINGREGRESSION_HPP_INCLUDE
+#define SLIDINGREGRESSION_HPP_INCLUDE
+
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Least squares slope over a sliding window of samples
+    ///        for a set of lanes that share the same time samples.
+    ///
+    /// Each lane keeps running sums of its window so that inserting
+    /// a sample and computing the slope is O(1) per lane rather than
+    /// O(window).  The lane data is stored as a structure of arrays
+    /// so that all lanes are updated together in one pass.  The
+    /// running sums are taken relative to an origin that is moved
+    /// to the oldest sample and recomputed from the stored history
+    /// each time the window wraps, which bounds both the magnitude
+    /// of the sums and the accumulated rounding error.
+    ///
+    /// A lane added after samples have been inserted starts with an
+    /// empty window.
+    class SlidingRegression
+    {
+        public:
+            /// @param [in] num_sample Number of samples in the window.
+            /// @param [in] num_lane Initial number of lanes.
+            SlidingRegression(int num_sample, int num_lane);
+            virtual ~SlidingRegression() = default;
+            /// @brief Add a lane with an empty window.
+            ///
+            /// @return Index of the new lane.
+            int add_lane(void);
+            /// @return Number of lanes.
+            int num_lane(void) const;
+            /// @brief Insert a sample for every lane and update the
+            ///        slope of each lane.
+            ///
+            /// @param [in] time Time of the sample shared by all
+            ///        lanes.
+            ///
+            /// @param [in] sample Array of num_lane() values, one
+            ///        for each lane.
+            void insert(double time, const double *sample);
+            /// @brief Slope of the least squares fit for a lane.
+            ///
+            /// @return The slope, or NAN if fewer than two samples
+            ///         have been inserted into the lane or all of
+            ///         the samples in its window have the same time.
+            double slope(int lane_idx) const;
+        private:
+            void recenter(void);
+            void update_slope(int lane_idx);
+
+            const int M_NUM_SAMPLE;
+            int m_num_lane;
+            // Index in the history of the next insert
+            int m_head;
+            double m_origin_time;
+            // History stored with the sample index major so that
+            // the lanes for one sample are contiguous.
+            std::vector<double> m_time;
+            std::vector<double> m_sample;
+            std::vector<int> m_num_fit;
+            std::vector<double> m_origin_sample;
+            std::vector<double> m_sum_x;
+            std::vector<double> m_sum_xx;
+            std::vector<double> m_sum_y;
+            std::vector<double> m_sum_xy;
+            std::vector<double> m_slope;
+    };
+}
+
+#endif
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "SysfsIOImp.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <stdexcept>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "IOUring.hpp"
+
+namespace geopm
+{
+    std::unique_ptr<SysfsIO> SysfsIO::make_unique(void)
+    {
+        return geopm::make_unique<SysfsIOImp>();
+    }
+
+    SysfsIOImp::SysfsIOImp()
+        : SysfsIOImp(nullptr, nullptr)
+    {
+
+    }
+
+    SysfsIOImp::SysfsIOImp(std::shared_ptr<IOUring> batch_reader,
+                           std::shared_ptr<IOUring> batch_writer)
+        : m_batch_reader(std::move(batch_reader))
+        , m_is_batch_reader_fixed(m_batch_reader != nullptr)
+        , m_is_batch_current(m_is_batch_reader_fixed)
+        , m_batch_writer(std::move(batch_writer))
+        , m_is_batch_writer_fixed(m_batch_writer != nullptr)
+        , m_is_write_batch_current(m_is_batch_writer_fixed)
+    {
+
+    }
+
+    SysfsIOImp::~SysfsIOImp()
+    {
+        for (const auto &file : m_file) {
+            close(file.fd);
+            if (file.write_fd != -1) {
+                close(file.write_fd);
+            }
+        }
+    }
+
+    int SysfsIOImp::open_file(const std::string &path,
+                              const std::string &units)
+    {
+        auto it = m_path_idx.find(path);
+        if (it != m_path_idx.end()) {
+            if (m_file[it->second].units != units) {
+                throw Exception("SysfsIOImp::open_file(): file \"" + path +
+                                "\" was opened with units \"" + m_file[it->second].units + "\"",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            return it->second;
+        }
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw Exception("SysfsIOImp::open_file(): unable to open \"" + path + "\"",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        int result = m_file.size();
+        m_file.push_back({path, units, fd, -1});
+        m_path_idx[path] = result;
+        return result;
+    }
+
+    double SysfsIOImp::read(int file_idx)
+    {
+        check_file_idx(file_idx, "read");
+        const m_file_s &file = m_file[file_idx];
+        char buffer[M_BUFFER_SIZE];
+        ssize_t num_read = pread(file.fd, buffer, M_BUFFER_SIZE - 1, 0);
+        if (num_read < 0) {
+            throw Exception("SysfsIOImp::read(): unable to read \"" + file.path + "\"",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return parse_buffer(file, buffer, num_read, "read");
+    }
+
+    int SysfsIOImp::add_read(int file_idx)
+    {
+        check_file_idx(file_idx, "add_read");
+        auto it = std::find(m_read_file_idx.begin(), m_read_file_idx.end(), file_idx);
+        if (it != m_read_file_idx.end()) {
+            return it - m_read_file_idx.begin();
+        }
+        int result = m_read_file_idx.size();
+        m_read_file_idx.push_back(file_idx);
+        m_read_ret.push_back(std::make_shared<int>(0));
+        m_read_buffer.resize(m_read_file_idx.size() * M_BUFFER_SIZE, '\0');
+        m_read_value.push_back(NAN);
+        if (!m_is_batch_reader_fixed) {
+            m_is_batch_current = false;
+        }
+        return result;
+    }
+
+    void SysfsIOImp::read_batch(void)
+    {
+        if (m_read_file_idx.empty()) {
+            return;
+        }
+        if (!m_is_batch_current) {
+            m_batch_reader = IOUring::make_unique(m_read_file_idx.size());
+            m_is_batch_current = true;
+        }
+        for (size_t batch_idx = 0; batch_idx < m_read_file_idx.size(); ++batch_idx) {
+            *m_read_ret[batch_idx] = 0;
+            m_batch_reader->prep_read(m_read_ret[batch_idx],
+                                      m_file[m_read_file_idx[batch_idx]].fd,
+                                      batch_buffer(batch_idx), M_BUFFER_SIZE - 1, 0);
+        }
+        m_batch_reader->submit();
+        for (size_t batch_idx = 0; batch_idx < m_read_file_idx.size(); ++batch_idx) {
+            const m_file_s &file = m_file[m_read_file_idx[batch_idx]];
+            int num_read = *m_read_ret[batch_idx];
+            if (num_read < 0) {
+                throw Exception("SysfsIOImp::read_batch(): unable to read \"" + file.path +
+                                "\": " + strerror(-num_read),
+                                -num_read, __FILE__, __LINE__);
+            }
+            m_read_value[batch_idx] = parse_buffer(file, batch_buffer(batch_idx), num_read, "read_batch");
+        }
+    }
+
+    double SysfsIOImp::sample(int batch_idx) const
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_read_value.size()) {
+            throw Exception("SysfsIOImp::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_read_value[batch_idx];
+    }
+
+    void SysfsIOImp::write(int file_idx, double value)
+    {
+        check_file_idx(file_idx, "write");
+        int fd = write_fd(file_idx);
+        std::string buffer = format_value(value);
+        ssize_t num_write = pwrite(fd, buffer.data(), buffer.size(), 0);
+        if (num_write != (ssize_t)buffer.size()) {
+            throw Exception("SysfsIOImp::write(): unable to write \"" + m_file[file_idx].path + "\"",
+                            num_write < 0 && errno ? errno : GEOPM_ERROR_RUNTIME,
+                            __FILE__, __LINE__);
+        }
+    }
+
+    int SysfsIOImp::add_write(int file_idx)
+    {
+        check_file_idx(file_idx, "add_write");
+        auto it = std::find(m_write_file_idx.begin(), m_write_file_idx.end(), file_idx);
+        if (it != m_write_file_idx.end()) {
+            return it - m_write_file_idx.begin();
+        }
+        // Open for writing now so that a file that cannot be written
+        // is reported when the write is added rather than in the
+        // middle of a batch.
+        write_fd(file_idx);
+        int result = m_write_file_idx.size();
+        m_write_file_idx.push_back(file_idx);
+        m_write_ret.push_back(std::make_shared<int>(0));
+        m_write_buffer.emplace_back();
+        m_is_write_adjusted.push_back(false);
+        if (!m_is_batch_writer_fixed) {
+            m_is_write_batch_current = false;
+        }
+        return result;
+    }
+
+    void SysfsIOImp::adjust(int batch_idx, double value)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_write_file_idx.size()) {
+            throw Exception("SysfsIOImp::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_write_buffer[batch_idx] = format_value(value);
+        m_is_write_adjusted[batch_idx] = true;
+    }
+
+    void SysfsIOImp::write_batch(void)
+    {
+        if (std::find(m_is_write_adjusted.begin(), m_is_write_adjusted.end(), true) ==
+            m_is_write_adjusted.end()) {
+            return;
+        }
+        if (!m_is_write_batch_current) {
+            m_batch_writer = IOUring::make_unique(m_write_file_idx.size());
+            m_is_write_batch_current = true;
+        }
+        for (size_t batch_idx = 0; batch_idx < m_write_file_idx.size(); ++batch_idx) {
+            if (m_is_write_adjusted[batch_idx]) {
+                *m_write_ret[batch_idx] = 0;
+                m_batch_writer->prep_write(m_write_ret[batch_idx],
+                                           m_file[m_write_file_idx[batch_idx]].write_fd,
+                                           m_write_buffer[batch_idx].data(),
+                                           m_write_buffer[batch_idx].size(), 0);
+            }
+        }
+        m_batch_writer->submit();
+        for (size_t batch_idx = 0; batch_idx < m_write_file_idx.size(); ++batch_idx) {
+            if (!m_is_write_adjusted[batch_idx]) {
+                continue;
+            }
+            m_is_write_adjusted[batch_idx] = false;
+            int num_write = *m_write_ret[batch_idx];
+            if (num_write != (int)m_write_buffer[batch_idx].size()) {
+                const std::string &path = m_file[m_write_file_idx[batch_idx]].path;
+                if (num_write < 0) {
+                    throw Exception("SysfsIOImp::write_batch(): unable to write \"" + path +
+                                    "\": " + strerror(-num_write),
+                                    -num_write, __FILE__, __LINE__);
+                }
+                throw Exception("SysfsIOImp::write_batch(): incomplete write to \"" + path + "\"",
+                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+    }
+
+    double SysfsIOImp::parse_value(const char *buffer,
+                                   const std::string &units,
+                                   const std::string &path)
+    {
+        static const char *separators = " \t\n";
+        char *value_end = nullptr;
+        errno = 0;
+        double result = strtod(buffer, &value_end);
+        // Report a missing or out of range number the same way as
+        // std::stod()
+        if (value_end == buffer) {
+            throw std::invalid_argument("SysfsIOImp::parse_value(): no number in " + path);
+        }
+        if (errno == ERANGE) {
+            throw std::out_of_range("SysfsIOImp::parse_value(): number out of range in " + path);
+        }
+        const char *units_begin = value_end + strspn(value_end, separators);
+        const char *units_end = units_begin;
+        while (*units_end != '\0' && strchr(separators, *units_end) == nullptr) {
+            ++units_end;
+        }
+        // Units must be separated from the value and be the only
+        // other token in the file
+        bool is_valid = units_end - units_begin == (ptrdiff_t)units.size() &&
+                        units.compare(0, units.size(), units_begin, units.size()) == 0 &&
+                        (units.empty() || units_begin != value_end) &&
+                        units_end[strspn(units_end, separators)] == '\0';
+        if (!is_valid) {
+            throw Exception("Unexpected format in " + path, GEOPM_ERROR_RUNTIME,
+                            __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    double SysfsIOImp::parse_buffer(const m_file_s &file, char *buffer,
+                                    ssize_t num_read, const std::string &func)
+    {
+        if (num_read == 0) {
+            throw Exception("SysfsIOImp::" + func + "(): file \"" + file.path + "\" is empty",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // Contents that fill the buffer are only accepted if they
+        // are null terminated within it.
+        if (num_read == (ssize_t)M_BUFFER_SIZE - 1 &&
+            memchr(buffer, '\0', num_read) == nullptr) {
+            throw Exception("SysfsIOImp::" + func + "(): contents of \"" + file.path + "\" are too long",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        buffer[num_read] = '\0';
+        return parse_value(buffer, file.units, file.path);
+    }
+
+    void SysfsIOImp::check_file_idx(int file_idx, const std::string &func) const
+    {
+        if (file_idx < 0 || file_idx >= (int)m_file.size()) {
+            throw Exception("SysfsIOImp::" + func + "(): file_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    char *SysfsIOImp::batch_buffer(int batch_idx)
+    {
+        return m_read_buffer.data() + batch_idx * M_BUFFER_SIZE;
+    }
+
+    int SysfsIOImp::write_fd(int file_idx)
+    {
+        m_file_s &file = m_file[file_idx];
+        if (file.write_fd == -1) {
+            file.write_fd = open(file.path.c_str(), O_WRONLY | O_CLOEXEC);
+            if (file.write_fd == -1) {
+                throw Exception("SysfsIOImp::write_fd(): unable to open \"" + file.path +
+                                "\" for writing",
+                                errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+        }
+        return file.write_fd;
+    }
+
+    std::string SysfsIOImp::format_value(double value)
+    {
+        if (!std::isfinite(value)) {
+            throw Exception("SysfsIOImp::format_value(): value is not finite",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return std::to_string(std::llround(value));
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SYSFSIO_HPP_INCLUDE
+#define SYSFSIO_HPP_INCLUDE
+
+#include <memory>
+#include <string>
+
+namespace geopm
+{
+    /// @brief Reads and writes numeric values in small text files
+    ///        such as those found in sysfs.
+    ///
+    /// Each file is opened once and the descriptor is kept open for
+    /// the lifetime of the object.  Every read is a pread() from the
+    /// start of the file, and all reads of a batch are submitted
+    /// together.  The file contents must be a number, optionally
+    /// followed by white space and the expected units.  Files are
+    /// only opened for writing on the first write, and values are
+    /// written as integers without units.
+    class SysfsIO
+    {
+        public:
+            SysfsIO() = default;
+            virtual ~SysfsIO() = default;
+            /// @brief Open a file for reading.  Opening a path that
+            ///        is already open returns the same index.
+            /// @param [in] path Path to the file.
+            /// @param [in] units Units that follow the value in the
+            ///        file, or the empty string if the file contains
+            ///        only the value.
+            /// @return The index of the file that is passed to
+            ///         read() and add_read().
+            virtual int open_file(const std::string &path,
+                                  const std::string &units) = 0;
+            /// @brief Read the value of a single file immediately.
+            /// @param [in] file_idx Index returned by open_file().
+            /// @return The value parsed from the file.
+            virtual double read(int file_idx) = 0;
+            /// @brief Extend the set of files read by read_batch().
+            ///        Adding a file that is already in the batch
+            ///        returns the same index.
+            /// @param [in] file_idx Index returned by open_file().
+            /// @return The index that is passed to sample().
+            virtual int add_read(int file_idx) = 0;
+            /// @brief Read all files added with add_read().
+            virtual void read_batch(void) = 0;
+            /// @brief Value of a file from the last call to
+            ///        read_batch().
+            /// @param [in] batch_idx Index returned by add_read().
+            /// @return The value parsed from the file.
+            virtual double sample(int batch_idx) const = 0;
+            /// @brief Write a value to a single file immediately.
+            /// @param [in] file_idx Index returned by open_file().
+            /// @param [in] value Value to write, rounded to the
+            ///        nearest integer.
+            virtual void write(int file_idx, double value) = 0;
+            /// @brief Extend the set of files written by
+            ///        write_batch().  Adding a file that is already
+            ///        in the batch returns the same index.
+            /// @param [in] file_idx Index returned by open_file().
+            /// @return The index that is passed to adjust().
+            virtual int add_write(int file_idx) = 0;
+            /// @brief Set the value written to a file by the next
+            ///        call to write_batch().
+            /// @param [in] batch_idx Index returned by add_write().
+            /// @param [in] value Value to write, rounded to the
+            ///        nearest integer.
+            virtual void adjust(int batch_idx, double value) = 0;
+            /// @brief Write all files that were adjusted since the
+            ///        last call to write_batch().
+            virtual void write_batch(void) = 0;
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the default constructor of
+            ///        the derived class.
+            static std::unique_ptr<SysfsIO> make_unique(void);
+    };
+}
+
+#endif
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "SysfsIOGroup.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "geopm/Agg.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "geopm_topo.h"
+#include "SaveControl.hpp"
+#include "SysfsIO.hpp"
+
+namespace geopm
+{
+    static const std::string RAPL_ZONE_PREFIX("intel-rapl:");
+
+    // Contents of a file with trailing white space removed, or the
+    // empty string if the file cannot be read.
+    static std::string read_attribute(const std::string &path)
+    {
+        std::string result;
+        try {
+            result = read_file(path);
+        }
+        catch (const Exception &) {
+            return "";
+        }
+        result.erase(result.find_last_not_of(" \t\n") + 1);
+        return result;
+    }
+
+    SysfsIOGroup::SysfsIOGroup()
+        : SysfsIOGroup(platform_topo(), "/sys", SysfsIO::make_unique())
+    {
+
+    }
+
+    SysfsIOGroup::SysfsIOGroup(const PlatformTopo &topo,
+                               const std::string &sysfs_root,
+                               std::shared_ptr<SysfsIO> sysfs_io)
+        : m_topo(topo)
+        , m_sysfs_io(std::move(sysfs_io))
+    {
+        add_powercap(sysfs_root + "/class/powercap");
+        add_cpufreq(sysfs_root + "/devices/system/cpu");
+        if (m_signal_available.empty()) {
+            throw Exception("SysfsIOGroup::SysfsIOGroup(): no powercap or cpufreq files are available",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        register_alias("CPU_ENERGY", "SYSFS::CPU_ENERGY");
+        register_alias("DRAM_ENERGY", "SYSFS::DRAM_ENERGY");
+        register_alias("CPU_POWER_LIMIT_CONTROL", "SYSFS::CPU_POWER_LIMIT_CONTROL");
+        register_alias("CPU_POWER_TIME_WINDOW_CONTROL", "SYSFS::CPU_POWER_TIME_WINDOW_CONTROL");
+        register_alias("CPU_FREQUENCY_STATUS", "SYSFS::CPU_FREQUENCY_STATUS");
+        register_alias("CPU_FREQUENCY_MIN_AVAIL", "SYSFS::CPU_FREQUENCY_MIN_AVAIL");
+        register_alias("CPU_FREQUENCY_MAX_AVAIL", "SYSFS::CPU_FREQUENCY_MAX_AVAIL");
+        register_alias("CPU_FREQUENCY_MIN_CONTROL", "SYSFS::CPU_FREQUENCY_MIN_CONTROL");
+        register_alias("CPU_FREQUENCY_MAX_CONTROL", "SYSFS::CPU_FREQUENCY_MAX_CONTROL");
+    }
+
+    void SysfsIOGroup::add_powercap(const std::string &powercap_path)
+    {
+        std::vector<std::string> zone_names;
+        try {
+            zone_names = list_directory_files(powercap_path);
+        }
+        catch (const Exception &) {
+            return;
+        }
+        int num_package = m_topo.num_domain(GEOPM_DOMAIN_PACKAGE);
+        std::vector<std::string> package_zone(num_package);
+        std::vector<std::string> dram_zone(num_package);
+        // Top level zones are named "package-N" and contain a
+        // "dram" sub-zone when DRAM energy is reported.
+        for (const auto &zone : zone_names) {
+            if (!string_begins_with(zone, RAPL_ZONE_PREFIX) ||
+                zone.find(':', RAPL_ZONE_PREFIX.size()) != std::string::npos) {
+                continue;
+            }
+            std::string zone_name = read_attribute(powercap_path + "/" + zone + "/name");
+            std::string package_str = zone_name.substr(std::min(zone_name.size(), sizeof("package-") - 1));
+            if (!string_begins_with(zone_name, "package-") || package_str.empty() ||
+                package_str.find_first_not_of("0123456789") != std::string::npos) {
+                continue;
+            }
+            int package_idx = std::stoi(package_str);
+            if (package_idx < num_package && package_zone[package_idx].empty()) {
+                package_zone[package_idx] = zone;
+            }
+        }
+        for (const auto &zone : zone_names) {
+            size_t parent_end = zone.find(':', RAPL_ZONE_PREFIX.size());
+            if (!string_begins_with(zone, RAPL_ZONE_PREFIX) ||
+                parent_end == std::string::npos ||
+                read_attribute(powercap_path + "/" + zone + "/name") != "dram") {
+                continue;
+            }
+            auto parent_it = std::find(package_zone.begin(), package_zone.end(),
+                                       zone.substr(0, parent_end));
+            if (parent_it != package_zone.end()) {
+                dram_zone[parent_it - package_zone.begin()] = zone;
+            }
+        }
+
+        auto zone_paths = [&powercap_path](const std::vector<std::string> &zones,
+                                           const std::string &file_name) {
+            return [powercap_path, zones, file_name](int package_idx) {
+                const std::string &zone = zones[package_idx];
+                return zone.empty() ? "" : powercap_path + "/" + zone + "/" + file_name;
+            };
+        };
+        add_signal("SYSFS::CPU_ENERGY", {
+                   "An increasing meter of energy consumed by the package over time",
+                   GEOPM_DOMAIN_PACKAGE, M_UNITS_JOULES, Agg::sum, string_format_double,
+                   M_SIGNAL_BEHAVIOR_MONOTONE, 1e-6, false, num_package,
+                   zone_paths(package_zone, "energy_uj"),
+                   zone_paths(package_zone, "max_energy_range_uj")});
+        add_signal("SYSFS::DRAM_ENERGY", {
+                   "An increasing meter of energy consumed by the DRAM over time",
+                   GEOPM_DOMAIN_PACKAGE, M_UNITS_JOULES, Agg::sum, string_format_double,
+                   M_SIGNAL_BEHAVIOR_MONOTONE, 1e-6, false, num_package,
+                   zone_paths(dram_zone, "energy_uj"),
+                   zone_paths(dram_zone, "max_energy_range_uj")});
+        add_signal("SYSFS::CPU_POWER_LIMIT_CONTROL", {
+                   "The average power usage limit over the time window of the package",
+                   GEOPM_DOMAIN_PACKAGE, M_UNITS_WATTS, Agg::sum, string_format_double,
+                   M_SIGNAL_BEHAVIOR_VARIABLE, 1e-6, true, num_package,
+                   zone_paths(package_zone, "constraint_0_power_limit_uw"), nullptr});
+        add_signal("SYSFS::CPU_POWER_TIME_WINDOW_CONTROL", {
+                   "The time window associated with the package power limit",
+                   GEOPM_DOMAIN_PACKAGE, M_UNITS_SECONDS, Agg::average, string_format_double,
+                   M_SIGNAL_BEHAVIOR_VARIABLE, 1e-6, true, num_package,
+                   zone_paths(package_zone, "constraint_0_time_window_us"), nullptr});
+    }
+
+    void SysfsIOGroup::add_cpufreq(const std::string &cpu_path)
+    {
+        int num_cpu = m_topo.num_domain(GEOPM_DOMAIN_CPU);
+        auto cpu_paths = [&cpu_path](const std::string &file_name) {
+            return [cpu_path, file_name](int cpu_idx) {
+                return cpu_path + "/cpu" + std::to_string(cpu_idx) + "/cpufreq/" + file_name;
+            };
+        };
+        add_signal("SYSFS::CPU_FREQUENCY_STATUS", {
+                   "The current operating frequency of the CPU as reported by cpufreq",
+                   GEOPM_DOMAIN_CPU, M_UNITS_HERTZ, Agg::average, string_format_double,
+                   M_SIGNAL_BEHAVIOR_VARIABLE, 1e3, false, num_cpu,
+                   cpu_paths("scaling_cur_freq"), nullptr});
+        add_signal("SYSFS::CPU_FREQUENCY_MIN_AVAIL", {
+                   "Minimum operating frequency of the CPU",
+                   GEOPM_DOMAIN_CPU, M_UNITS_HERTZ, Agg::expect_same, string_format_double,
+                   M_SIGNAL_BEHAVIOR_CONSTANT, 1e3, false, num_cpu,
+                   cpu_paths("cpuinfo_min_freq"), nullptr});
+        add_signal("SYSFS::CPU_FREQUENCY_MAX_AVAIL", {
+                   "Maximum operating frequency of the CPU",
+                   GEOPM_DOMAIN_CPU, M_UNITS_HERTZ, Agg::expect_same, string_format_double,
+                   M_SIGNAL_BEHAVIOR_CONSTANT, 1e3, false, num_cpu,
+                   cpu_paths("cpuinfo_max_freq"), nullptr});
+        add_signal("SYSFS::CPU_FREQUENCY_MIN_CONTROL", {
+                   "Lower limit of the frequency selected by the cpufreq governor",
+                   GEOPM_DOMAIN_CPU, M_UNITS_HERTZ, Agg::average, string_format_double,
+                   M_SIGNAL_BEHAVIOR_VARIABLE, 1e3, true, num_cpu,
+                   cpu_paths("scaling_min_freq"), nullptr});
+        add_signal("SYSFS::CPU_FREQUENCY_MAX_CONTROL", {
+                   "Upper limit of the frequency selected by the cpufreq governor",
+                   GEOPM_DOMAIN_CPU, M_UNITS_HERTZ, Agg::average, string_format_double,
+                   M_SIGNAL_BEHAVIOR_VARIABLE, 1e3, true, num_cpu,
+                   cpu_paths("scaling_max_freq"), nullptr});
+    }
+
+    void SysfsIOGroup::add_signal(const std::string &name,
+                                  const m_signal_info_s &info)
+    {
+        // Only offer signals that are readable in every domain, and
+        // controls that are also writable in every domain.  A CPU
+        // has several files each, so only those of the first CPU are
+        // checked here rather than making thousands of access()
+        // calls when the IOGroup is loaded.  The files of the other
+        // CPUs are checked when they are opened.
+        int num_check = info.domain_type == GEOPM_DOMAIN_CPU ?
+                        std::min(info.num_domain, 1) : info.num_domain;
+        if (num_check == 0) {
+            return;
+        }
+        bool is_control = info.is_control;
+        for (int domain_idx = 0; domain_idx < num_check; ++domain_idx) {
+            std::string path = info.path(domain_idx);
+            if (path.empty() || access(path.c_str(), R_OK) != 0 ||
+                (info.range_path &&
+                 access(info.range_path(domain_idx).c_str(), R_OK) != 0)) {
+                return;
+            }
+            is_control = is_control && access(path.c_str(), W_OK) == 0;
+        }
+        auto it = m_signal_available.emplace(name, info).first;
+        it->second.is_control = is_control;
+    }
+
+    void SysfsIOGroup::register_alias(const std::string &alias_name,
+                                      const std::string &signal_name)
+    {
+        if (m_signal_available.find(signal_name) != m_signal_available.end()) {
+            m_alias[alias_name] = signal_name;
+        }
+    }
+
+    const std::string &SysfsIOGroup::canonical_name(const std::string &name) const
+    {
+        auto it = m_alias.find(name);
+        return it == m_alias.end() ? name : it->second;
+    }
+
+    const SysfsIOGroup::m_signal_info_s &SysfsIOGroup::signal_info(const std::string &signal_name,
+                                                                   int domain_type, int domain_idx,
+                                                                   const std::string &func) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        if (it == m_signal_available.end()) {
+            throw Exception("SysfsIOGroup::" + func + "(): " + signal_name +
+                            " not valid for SysfsIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != it->second.domain_type) {
+            throw Exception("SysfsIOGroup::" + func + "(): domain_type " +
+                            std::to_string(domain_type) + " not valid for " + signal_name,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= it->second.num_domain) {
+            throw Exception("SysfsIOGroup::" + func + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+
+    const SysfsIOGroup::m_signal_info_s &SysfsIOGroup::control_info(const std::string &control_name,
+                                                                    int domain_type, int domain_idx,
+                                                                    const std::string &func) const
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("SysfsIOGroup::" + func + "(): " + control_name +
+                            " not valid for SysfsIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return signal_info(control_name, domain_type, domain_idx, func);
+    }
+
+    int SysfsIOGroup::file_idx(const m_signal_info_s &info, int domain_idx)
+    {
+        return m_sysfs_io->open_file(info.path(domain_idx), "");
+    }
+
+    SysfsIOGroup::m_counter_s *SysfsIOGroup::counter(const m_signal_info_s &info, int domain_idx)
+    {
+        if (!info.range_path) {
+            return nullptr;
+        }
+        auto key = std::make_pair(&info, domain_idx);
+        auto it = m_counter.find(key);
+        if (it == m_counter.end()) {
+            double range = m_sysfs_io->read(m_sysfs_io->open_file(info.range_path(domain_idx), ""));
+            it = m_counter.emplace(key, m_counter_s {range, NAN, 0.0}).first;
+        }
+        return &(it->second);
+    }
+
+    double SysfsIOGroup::unwrap(m_counter_s &counter, double raw)
+    {
+        // Energy counters wrap at the range reported by the zone
+        if (counter.range > 0.0 && raw < counter.last_raw) {
+            counter.offset += counter.range;
+        }
+        counter.last_raw = raw;
+        return raw + counter.offset;
+    }
+
+    std::set<std::string> SysfsIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &signal : m_signal_available) {
+            result.insert(signal.first);
+        }
+        for (const auto &alias : m_alias) {
+            result.insert(alias.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> SysfsIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &name : signal_names()) {
+            if (is_valid_control(name)) {
+                result.insert(name);
+            }
+        }
+        return result;
+    }
+
+    bool SysfsIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_available.find(canonical_name(signal_name)) != m_signal_available.end();
+    }
+
+    bool SysfsIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(control_name));
+        return it != m_signal_available.end() && it->second.is_control;
+    }
+
+    int SysfsIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        return it == m_signal_available.end() ? GEOPM_DOMAIN_INVALID : it->second.domain_type;
+    }
+
+    int SysfsIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return is_valid_control(control_name) ? signal_domain_type(control_name) : GEOPM_DOMAIN_INVALID;
+    }
+
+    int SysfsIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        const m_signal_info_s &info = signal_info(signal_name, domain_type, domain_idx, "push_signal");
+        for (size_t pushed_idx = 0; pushed_idx < m_signal_pushed.size(); ++pushed_idx) {
+            if (m_signal_pushed[pushed_idx].info == &info &&
+                m_signal_pushed[pushed_idx].domain_idx == domain_idx) {
+                return pushed_idx;
+            }
+        }
+        m_counter_s *pushed_counter = counter(info, domain_idx);
+        int batch_idx = m_sysfs_io->add_read(file_idx(info, domain_idx));
+        m_signal_pushed.push_back({&info, domain_idx, batch_idx, pushed_counter, NAN});
+        return m_signal_pushed.size() - 1;
+    }
+
+    int SysfsIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        const m_signal_info_s &info = control_info(control_name, domain_type, domain_idx, "push_control");
+        for (size_t pushed_idx = 0; pushed_idx < m_control_pushed.size(); ++pushed_idx) {
+            if (m_control_pushed[pushed_idx].info == &info &&
+                m_control_pushed[pushed_idx].domain_idx == domain_idx) {
+                return pushed_idx;
+            }
+        }
+        int batch_idx = m_sysfs_io->add_write(file_idx(info, domain_idx));
+        m_control_pushed.push_back({&info, domain_idx, batch_idx});
+        return m_control_pushed.size() - 1;
+    }
+
+    void SysfsIOGroup::read_batch(void)
+    {
+        if (m_signal_pushed.empty()) {
+            return;
+        }
+        m_sysfs_io->read_batch();
+        for (auto &pushed : m_signal_pushed) {
+            double raw = m_sysfs_io->sample(pushed.batch_idx);
+            if (pushed.counter != nullptr) {
+                raw = unwrap(*pushed.counter, raw);
+            }
+            pushed.value = raw * pushed.info->scale;
+        }
+    }
+
+    void SysfsIOGroup::write_batch(void)
+    {
+        m_sysfs_io->write_batch();
+    }
+
+    double SysfsIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_signal_pushed.size()) {
+            throw Exception("SysfsIOGroup::sample(): batch_idx " + std::to_string(batch_idx) +
+                            " out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_signal_pushed[batch_idx].value;
+    }
+
+    void SysfsIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || batch_idx >= (int)m_control_pushed.size()) {
+            throw Exception("SysfsIOGroup::adjust(): batch_idx " + std::to_string(batch_idx) +
+                            " out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const m_control_pushed_s &pushed = m_control_pushed[batch_idx];
+        m_sysfs_io->adjust(pushed.batch_idx, setting / pushed.info->scale);
+    }
+
+    double SysfsIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        const m_signal_info_s &info = signal_info(signal_name, domain_type, domain_idx, "read_signal");
+        double raw = m_sysfs_io->read(file_idx(info, domain_idx));
+        m_counter_s *read_counter = counter(info, domain_idx);
+        if (read_counter != nullptr) {
+            raw = unwrap(*read_counter, raw);
+        }
+        return raw * info.scale;
+    }
+
+    std::vector<double> SysfsIOGroup::read_signals(const std::vector<geopm_request_s> &request)
+    {
+        std::vector<double> result;
+        result.reserve(request.size());
+        for (const auto &req : request) {
+            result.push_back(read_signal(req.name, req.domain_type, req.domain_idx));
+        }
+        return result;
+    }
+
+    void SysfsIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        const m_signal_info_s &info = control_info(control_name, domain_type, domain_idx, "write_control");
+        m_sysfs_io->write(file_idx(info, domain_idx), setting / info.scale);
+    }
+
+    void SysfsIOGroup::write_controls(const std::vector<geopm_request_s> &request,
+                                      const std::vector<double> &setting)
+    {
+        if (request.size() != setting.size()) {
+            throw Exception("SysfsIOGroup::write_controls(): number of settings does not match the number of requests",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<m_file_write_s> file_write;
+        for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+            const geopm_request_s &req = request[req_idx];
+            const m_signal_info_s &info = control_info(req.name, req.domain_type, req.domain_idx,
+                                                       "write_controls");
+            file_write.push_back({&info, req.domain_idx, setting[req_idx] / info.scale});
+        }
+        write_files(file_write);
+    }
+
+    void SysfsIOGroup::write_files(const std::vector<m_file_write_s> &file_write)
+    {
+        // The kernel rejects a scaling_max_freq below the current
+        // scaling_min_freq and a scaling_min_freq above the current
+        // scaling_max_freq.  When both limits of a CPU are written,
+        // write the other limit first if writing this one first
+        // would cross the current value of the other.
+        auto min_it = m_signal_available.find("SYSFS::CPU_FREQUENCY_MIN_CONTROL");
+        auto max_it = m_signal_available.find("SYSFS::CPU_FREQUENCY_MAX_CONTROL");
+        const m_signal_info_s *min_info = min_it == m_signal_available.end() ? nullptr : &(min_it->second);
+        const m_signal_info_s *max_info = max_it == m_signal_available.end() ? nullptr : &(max_it->second);
+        std::map<std::pair<const m_signal_info_s *, int>, size_t> write_map;
+        for (size_t write_idx = 0; write_idx < file_write.size(); ++write_idx) {
+            write_map[std::make_pair(file_write[write_idx].info,
+                                     file_write[write_idx].domain_idx)] = write_idx;
+        }
+        std::vector<bool> is_written(file_write.size(), false);
+        for (size_t write_idx = 0; write_idx < file_write.size(); ++write_idx) {
+            if (is_written[write_idx]) {
+                continue;
+            }
+            const m_file_write_s &curr = file_write[write_idx];
+            const m_signal_info_s *other_info = nullptr;
+            if (curr.info == min_info) {
+                other_info = max_info;
+            }
+            else if (curr.info == max_info) {
+                other_info = min_info;
+            }
+            auto other_it = write_map.find(std::make_pair(other_info, curr.domain_idx));
+            if (other_info != nullptr && other_it != write_map.end() &&
+                !is_written[other_it->second]) {
+                const m_file_write_s &other = file_write[other_it->second];
+                double other_current = m_sysfs_io->read(file_idx(*other.info, other.domain_idx));
+                if (curr.info == max_info ? curr.value < other_current :
+                                            curr.value > other_current) {
+                    m_sysfs_io->write(file_idx(*other.info, other.domain_idx), other.value);
+                    is_written[other_it->second] = true;
+                }
+            }
+            m_sysfs_io->write(file_idx(*curr.info, curr.domain_idx), curr.value);
+            is_written[write_idx] = true;
+        }
+    }
+
+    void SysfsIOGroup::save_control(void)
+    {
+        m_saved_file_value.clear();
+        for (const auto &signal : m_signal_available) {
+            if (!signal.second.is_control) {
+                continue;
+            }
+            for (int domain_idx = 0; domain_idx < signal.second.num_domain; ++domain_idx) {
+                double value = m_sysfs_io->read(file_idx(signal.second, domain_idx));
+                m_saved_file_value.push_back({&(signal.second), domain_idx, value});
+            }
+        }
+    }
+
+    void SysfsIOGroup::restore_control(void)
+    {
+        // Only write the files that were changed since they were
+        // saved
+        std::vector<m_file_write_s> file_write;
+        for (const auto &saved : m_saved_file_value) {
+            if (m_sysfs_io->read(file_idx(*saved.info, saved.domain_idx)) != saved.value) {
+                file_write.push_back(saved);
+            }
+        }
+        write_files(file_write);
+    }
+
+    std::function<double(const std::vector<double> &)> SysfsIOGroup::agg_function(const std::string &signal_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        if (it == m_signal_available.end()) {
+            throw Exception("SysfsIOGroup::agg_function(): unknown how to aggregate \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second.agg_function;
+    }
+
+    std::function<std::string(double)> SysfsIOGroup::format_function(const std::string &signal_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        if (it == m_signal_available.end()) {
+            throw Exception("SysfsIOGroup::format_function(): unknown how to format \"" +
+                            signal_name + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second.format_function;
+    }
+
+    std::string SysfsIOGroup::signal_description(const std::string &signal_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        if (it == m_signal_available.end()) {
+            throw Exception("SysfsIOGroup::signal_description(): " + signal_name +
+                            " not valid for SysfsIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::string result = "    description: " + it->second.description + '\n';
+        if (it->first != signal_name) {
+            result += "    alias_for: " + it->first + '\n';
+        }
+        result += "    units: " + IOGroup::units_to_string(it->second.units) + '\n';
+        result += "    aggregation: " + Agg::function_to_name(it->second.agg_function) + '\n';
+        result += "    domain: " + PlatformTopo::domain_type_to_name(it->second.domain_type) + '\n';
+        result += "    iogroup: SysfsIOGroup";
+        return result;
+    }
+
+    std::string SysfsIOGroup::control_description(const std::string &control_name) const
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("SysfsIOGroup::control_description(): " + control_name +
+                            " not valid for SysfsIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return signal_description(control_name);
+    }
+
+    int SysfsIOGroup::signal_behavior(const std::string &signal_name) const
+    {
+        auto it = m_signal_available.find(canonical_name(signal_name));
+        if (it == m_signal_available.end()) {
+            throw Exception("SysfsIOGroup::signal_behavior(): " + signal_name +
+                            " not valid for SysfsIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second.behavior;
+    }
+
+    void SysfsIOGroup::save_control(const std::string &save_path)
+    {
+        SaveControl::make_unique(*this)->write_json(save_path);
+    }
+
+    void SysfsIOGroup::restore_control(const std::string &save_path)
+    {
+        SaveControl::make_unique(read_file(save_path))->restore(*this);
+    }
+
+    std::string SysfsIOGroup::name(void) const
+    {
+        return plugin_name();
+    }
+
+    std::string SysfsIOGroup::plugin_name(void)
+    {
+        return "SYSFS";
+    }
+
+    std::unique_ptr<IOGroup> SysfsIOGroup::make_plugin(void)
+    {
+        return geopm::make_unique<SysfsIOGroup>();
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SYSFSIOGROUP_HPP_INCLUDE
+#define SYSFSIOGROUP_HPP_INCLUDE
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geopm/IOGroup.hpp"
+#include "geopm/BatchIOGroup.hpp"
+
+namespace geopm
+{
+    class PlatformTopo;
+    class SysfsIO;
+
+    /// @brief IOGroup that provides RAPL energy, power limits and CPU
+    ///        frequency limits through the Linux powercap and cpufreq
+    ///        sysfs interfaces.
+    ///
+    /// @details These files are available without the msr-safe driver.
+    ///          The IOGroup is loaded before the MSRIOGroup so that the
+    ///          high level aliases it registers are only used when the
+    ///          MSRIOGroup does not provide them.  Signals and controls
+    ///          are only offered when the backing file exists and is
+    ///          readable (or writable for controls) in every package,
+    ///          or for the first CPU for the per-CPU cpufreq files.
+    ///          The files of the other CPUs are opened on first use.
+    class SysfsIOGroup : public IOGroup, public BatchIOGroup
+    {
+        public:
+            SysfsIOGroup();
+            /// @param [in] topo Platform topology.
+            /// @param [in] sysfs_root Mount point of sysfs, the
+            ///        powercap zones are read from
+            ///        class/powercap and the cpufreq attributes from
+            ///        devices/system/cpu below it.
+            /// @param [in] sysfs_io Object used for all file access.
+            SysfsIOGroup(const PlatformTopo &topo,
+                         const std::string &sysfs_root,
+                         std::shared_ptr<SysfsIO> sysfs_io);
+            virtual ~SysfsIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            std::vector<double> read_signals(const std::vector<geopm_request_s> &request) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void write_controls(const std::vector<geopm_request_s> &request,
+                                const std::vector<double> &setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)> format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            int signal_behavior(const std::string &signal_name) const override;
+            void save_control(const std::string &save_path) override;
+            void restore_control(const std::string &save_path) override;
+            std::string name(void) const override;
+            static std::string plugin_name(void);
+            static std::unique_ptr<IOGroup> make_plugin(void);
+        private:
+            struct m_signal_info_s {
+                std::string description;
+                int domain_type;
+                int units;
+                std::function<double(const std::vector<double> &)> agg_function;
+                std::function<std::string(double)> format_function;
+                int behavior;
+                // Multiplier from the file contents to the signal units
+                double scale;
+                bool is_control;
+                int num_domain;
+                // Path of the file for a domain index, or the empty
+                // string if the domain has no file
+                std::function<std::string(int)> path;
+                // Path of the file holding the counter range for a
+                // domain index, or empty if the value does not wrap
+                std::function<std::string(int)> range_path;
+            };
+            // State used to unwrap an energy counter
+            struct m_counter_s {
+                double range;
+                double last_raw;
+                double offset;
+            };
+            struct m_signal_pushed_s {
+                const m_signal_info_s *info;
+                int domain_idx;
+                int batch_idx;
+                m_counter_s *counter;
+                double value;
+            };
+            // One file write in the units of the file
+            struct m_file_write_s {
+                const m_signal_info_s *info;
+                int domain_idx;
+                double value;
+            };
+            struct m_control_pushed_s {
+                const m_signal_info_s *info;
+                int domain_idx;
+                int batch_idx;
+            };
+            void add_powercap(const std::string &powercap_path);
+            void add_cpufreq(const std::string &cpu_path);
+            void add_signal(const std::string &name,
+                            const m_signal_info_s &info);
+            void register_alias(const std::string &alias_name,
+                                const std::string &signal_name);
+            const std::string &canonical_name(const std::string &name) const;
+            const m_signal_info_s &signal_info(const std::string &signal_name,
+                                               int domain_type, int domain_idx,
+                                               const std::string &func) const;
+            const m_signal_info_s &control_info(const std::string &control_name,
+                                                int domain_type, int domain_idx,
+                                                const std::string &func) const;
+            int file_idx(const m_signal_info_s &info, int domain_idx);
+            m_counter_s *counter(const m_signal_info_s &info, int domain_idx);
+            static double unwrap(m_counter_s &counter, double raw);
+            void write_files(const std::vector<m_file_write_s> &file_write);
+
+            const PlatformTopo &m_topo;
+            std::shared_ptr<SysfsIO> m_sysfs_io;
+            std::map<std::string, m_signal_info_s> m_signal_available;
+            std::map<std::string, std::string> m_alias;
+            std::vector<m_signal_pushed_s> m_signal_pushed;
+            std::vector<m_control_pushed_s> m_control_pushed;
+            std::map<std::pair<const m_signal_info_s *, int>, m_counter_s> m_counter;
+            // Contents of each control file recorded by save_control()
+            std::vector<m_file_write_s> m_saved_file_value;
+    };
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SYSFSIOIMP_HPP_INCLUDE
+#define SYSFSIOIMP_HPP_INCLUDE
+
+#include <sys/types.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SysfsIO.hpp"
+
+namespace geopm
+{
+    class IOUring;
+
+    class SysfsIOImp : public SysfsIO
+    {
+        public:
+            SysfsIOImp();
+            /// @param [in] batch_reader IOUring used by read_batch(),
+            ///        or nullptr to create one sized for the batch.
+            /// @param [in] batch_writer IOUring used by write_batch(),
+            ///        or nullptr to create one sized for the batch.
+            SysfsIOImp(std::shared_ptr<IOUring> batch_reader,
+                       std::shared_ptr<IOUring> batch_writer);
+            SysfsIOImp(const SysfsIOImp &other) = delete;
+            SysfsIOImp &operator=(const SysfsIOImp &other) = delete;
+            virtual ~SysfsIOImp();
+            int open_file(const std::string &path,
+                          const std::string &units) override;
+            double read(int file_idx) override;
+            int add_read(int file_idx) override;
+            void read_batch(void) override;
+            double sample(int batch_idx) const override;
+            void write(int file_idx, double value) override;
+            int add_write(int file_idx) override;
+            void adjust(int batch_idx, double value) override;
+            void write_batch(void) override;
+            /// @brief Parse the contents of a file: a number
+            ///        optionally followed by white space and units.
+            /// @param [in] buffer Null terminated file contents.
+            /// @param [in] units Expected units or the empty string.
+            /// @param [in] path Path to the file used in error
+            ///        messages.
+            /// @return The parsed number.
+            /// @throw std::invalid_argument if the contents do not
+            ///        start with a number, like std::stod().
+            static double parse_value(const char *buffer,
+                                      const std::string &units,
+                                      const std::string &path);
+        private:
+            // Largest file that can be read including the null
+            // terminator
+            static constexpr size_t M_BUFFER_SIZE = 64;
+            struct m_file_s {
+                std::string path;
+                std::string units;
+                int fd;
+                // Opened on the first write, -1 until then
+                int write_fd;
+            };
+            static double parse_buffer(const m_file_s &file, char *buffer,
+                                       ssize_t num_read, const std::string &func);
+            void check_file_idx(int file_idx, const std::string &func) const;
+            char *batch_buffer(int batch_idx);
+            int write_fd(int file_idx);
+            static std::string format_value(double value);
+
+            std::vector<m_file_s> m_file;
+            std::map<std::string, int> m_path_idx;
+            std::vector<int> m_read_file_idx;
+            std::vector<std::shared_ptr<int> > m_read_ret;
+            std::vector<char> m_read_buffer;
+            std::vector<double> m_read_value;
+            std::shared_ptr<IOUring> m_batch_reader;
+            const bool m_is_batch_reader_fixed;
+            bool m_is_batch_current;
+            std::vector<int> m_write_file_idx;
+            std::vector<std::shared_ptr<int> > m_write_ret;
+            std::vector<std::string> m_write_buffer;
+            std::vector<bool> m_is_write_adjusted;
+            std::shared_ptr<IOUring> m_batch_writer;
+            const bool m_is_batch_writer_fixed;
+            bool m_is_write_batch_current;
+    };
+}
+
+#endif
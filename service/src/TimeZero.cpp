@@ -5,6 +5,9 @@
 
 #include "config.h"
 
+#include <errno.h>
+#include <time.h>
+
 #include "geopm_time.h"
 #include "geopm/Exception.hpp"
 
@@ -71,6 +74,19 @@ namespace geopm
         geopm_time(&result);
         return result;
     }
+
+    void time_sleep_until_real(const geopm_time_s &deadline)
+    {
+        int err = 0;
+        do {
+            err = clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME,
+                                  &(deadline.t), nullptr);
+        } while (err == EINTR);
+        if (err != 0) {
+            throw Exception("geopm::time_sleep_until_real(): clock_nanosleep() failed",
+                            err, __FILE__, __LINE__);
+        }
+    }
 }
 
 extern "C"
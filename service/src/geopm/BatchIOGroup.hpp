@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BATCHIOGROUP_HPP_INCLUDE
+#define BATCHIOGROUP_HPP_INCLUDE
+
+#include <vector>
+
+struct geopm_request_s;
+
+namespace geopm
+{
+    class IOGroup;
+
+    /// @brief Optional interface for an IOGroup that can read several
+    ///        signals or write several controls in one call.
+    ///
+    /// An IOGroup implementation may derive from this class in
+    /// addition to IOGroup.  The IOGroup interface is not changed, so
+    /// IOGroup plugins that do not derive from this class keep
+    /// working.  Callers use the static read_signals() and
+    /// write_controls() methods which find the interface with
+    /// dynamic_cast and otherwise call IOGroup::read_signal() or
+    /// IOGroup::write_control() once for each request.
+    class BatchIOGroup
+    {
+        public:
+            BatchIOGroup() = default;
+            virtual ~BatchIOGroup() = default;
+            /// @brief Read several signals from the platform in one
+            ///        call.  Does not modify the values stored by
+            ///        calling read_batch().  Each request must name a
+            ///        signal provided by the IOGroup at its native
+            ///        domain.
+            /// @param [in] request Vector of signal names, domain
+            ///        types and domain indices to read.
+            /// @return The values in SI units of the signals in the
+            ///         same order as the requests.
+            virtual std::vector<double> read_signals(const std::vector<geopm_request_s> &request) = 0;
+            /// @brief Write several controls to the platform in one
+            ///        call.  Does not modify the values stored by
+            ///        calling adjust().  Each request must name a
+            ///        control provided by the IOGroup at its native
+            ///        domain.
+            /// @param [in] request Vector of control names, domain
+            ///        types and domain indices to write.
+            /// @param [in] setting Values in SI units of the
+            ///        settings in the same order as the requests.
+            virtual void write_controls(const std::vector<geopm_request_s> &request,
+                                        const std::vector<double> &setting) = 0;
+            /// @brief Read several signals from an IOGroup, in one
+            ///        call if the IOGroup implements BatchIOGroup.
+            /// @param [in] iogroup The IOGroup that provides every
+            ///        requested signal.
+            /// @param [in] request Vector of signal names, domain
+            ///        types and domain indices to read.
+            /// @return The values in SI units of the signals in the
+            ///         same order as the requests.
+            static std::vector<double> read_signals(IOGroup &iogroup,
+                                                    const std::vector<geopm_request_s> &request);
+            /// @brief Write several controls to an IOGroup, in one
+            ///        call if the IOGroup implements BatchIOGroup.
+            /// @param [in] iogroup The IOGroup that provides every
+            ///        requested control.
+            /// @param [in] request Vector of control names, domain
+            ///        types and domain indices to write.
+            /// @param [in] setting Values in SI units of the
+            ///        settings in the same order as the requests.
+            static void write_controls(IOGroup &iogroup,
+                                       const std::vector<geopm_request_s> &request,
+                                       const std::vector<double> &setting);
+    };
+}
+
+#endif
@@ -16,18 +16,22 @@
 #include "geopm/json11.hpp"
 
 #include "IOGroup.hpp"
+#include "BatchIOGroup.hpp"
 #include "geopm_time.h"
 
 namespace geopm
 {
+    class DerivativeBatch;
     class MSRIO;
     class PlatformTopo;
     class Signal;
     class Control;
+    class MSRFieldControl;
     class SaveControl;
+    struct msr_table_s;
 
     /// @brief IOGroup that provides signals and controls based on MSRs.
-    class MSRIOGroup : public IOGroup
+    class MSRIOGroup : public IOGroup, public BatchIOGroup
     {
         public:
             enum m_cpuid_e {
@@ -67,10 +71,13 @@ namespace geopm
             double read_signal(const std::string &signal_name,
                                int domain_type,
                                int domain_idx) override;
+            std::vector<double> read_signals(const std::vector<geopm_request_s> &request) override;
             void write_control(const std::string &control_name,
                                int domain_type,
                                int domain_idx,
                                double setting) override;
+            void write_controls(const std::vector<geopm_request_s> &request,
+                                const std::vector<double> &setting) override;
             void save_control(void) override;
             void restore_control(void) override;
             std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override;
@@ -97,10 +104,36 @@ namespace geopm
             static std::string plugin_name(void);
             static std::unique_ptr<IOGroup> make_plugin(void);
         private:
+            /// @brief Check a request made through read_signal() or
+            ///        read_signals() and return the signal to read.
+            std::shared_ptr<Signal> check_read_signal(const std::string &signal_name,
+                                                      int domain_type,
+                                                      int domain_idx);
+            /// @brief Check a request made through write_control()
+            ///        or write_controls() and return the control to
+            ///        write.
+            std::shared_ptr<Control> check_write_control(const std::string &control_name,
+                                                         int domain_type,
+                                                         int domain_idx);
+            /// @brief Add a write_controls() request to a batch
+            ///        context of the MSRIO object.
+            void add_write_control(const std::string &control_name,
+                                   int domain_type,
+                                   int domain_idx,
+                                   double setting,
+                                   int batch_ctx);
+            /// @brief Add the raw MSRs and fields of a table compiled
+            ///        from the built-in JSON data as available signals
+            ///        and controls.
+            void parse_msr_table(const msr_table_s &table);
             /// @brief Parse the given JSON string and update the
             ///        allowlist data map.
             static void parse_json_msrs_allowlist(const std::string &str,
                                                   std::map<uint64_t, std::pair<uint64_t, std::string> > &allowlist_data);
+            /// @brief Update the allowlist data map from a compiled
+            ///        MSR table.
+            static void parse_msr_table_allowlist(const msr_table_s &table,
+                                                  std::map<uint64_t, std::pair<uint64_t, std::string> > &allowlist_data);
             /// @brief Format a string with the msr-safe allowlist file contents
             ///        reflecting all known MSRs for the current platform.
             /// @param [in] allowlist_data Map from MSR offset to
@@ -109,9 +142,9 @@ namespace geopm
             ///        an msr-safe allowlist file.
             static std::string format_allowlist(const std::map<uint64_t, std::pair<uint64_t, std::string> > &allowlist_data);
 
-            /// @brief Return the JSON string for the MSR data
-            ///        associated with the given cpuid.
-            static std::string platform_data(int cpu_id);
+            /// @brief Return the compiled MSR table associated with
+            ///        the given cpuid.
+            static const msr_table_s &platform_table(int cpu_id);
 
             enum MsrConfigWarningPreference_e {
                 SILENCE_CONFIG_DEPRECATION_WARNING,
@@ -181,13 +214,27 @@ namespace geopm
             // Add raw MSR as an available signal
             void add_raw_msr_signal(const std::string &msr_name, int domain_type,
                                     uint64_t msr_offset);
+            // Add a bitfield of an MSR as an available signal and
+            // also as a control if it is writable, applying the
+            // platform specific adjustments common to the JSON and
+            // compiled table definitions
+            void add_msr_field(const std::string &msr_name,
+                               const std::string &field_name,
+                               int domain_type,
+                               uint64_t msr_offset,
+                               int begin_bit, int end_bit,
+                               int function, double scalar, int units,
+                               bool is_control, int behavior,
+                               const std::function<double(const std::vector<double> &)> &aggregation,
+                               const std::string &description,
+                               bool is_trl_writable);
             // Add a bitfield of an MSR as an available signal
             void add_msr_field_signal(const std::string &msr_name,
                                       const std::string &msr_field_name,
                                       int domain_type,
                                       int begin_bit, int end_bit,
                                       int function, double scalar, int units,
-                                      const std::string &aggregation,
+                                      const std::function<double(const std::vector<double> &)> &aggregation,
                                       const std::string &description,
                                       int behavior,
                                       const std::function<std::string(double)> &format_function);
@@ -233,6 +280,9 @@ namespace geopm
 
             int m_derivative_window;
             double m_sleep_time;
+            // Derivatives with respect to MSR::TIME, which are
+            // updated together when sampled
+            std::shared_ptr<DerivativeBatch> m_derivative_batch;
 
             /// @brief Return the Intel Resource Director Technology
             ///        support information
@@ -261,6 +311,9 @@ namespace geopm
             struct control_info
             {
                 std::vector<std::shared_ptr<Control> > controls;
+                // Field control of each CPU in each domain, used to
+                // batch the writes of write_controls()
+                std::vector<std::vector<std::shared_ptr<MSRFieldControl> > > cpu_controls;
                 int domain;
                 int units;
                 std::string description;
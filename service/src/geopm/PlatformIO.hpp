@@ -88,7 +88,9 @@ namespace geopm
             ///         or throws if the signal is not valid
             ///         on the platform.  Returned signal index will be
             ///         repeated for each unique tuple of push_signal
-            ///         input parameters.
+            ///         input parameters.  Reading the signal is not
+            ///         attempted until the next call to read_batch()
+            ///         or adjust().
             virtual int push_signal(const std::string &signal_name,
                                     int domain_type,
                                     int domain_idx) = 0;
@@ -134,6 +136,8 @@ namespace geopm
                                 double setting) = 0;
             /// @brief Read all pushed signals so that the next call
             ///        to sample() will reflect the updated data.
+            ///        Throws if a signal pushed since the last call
+            ///        cannot be read by any IOGroup.
             virtual void read_batch(void) = 0;
             /// @brief Write all of the pushed controls so that values
             ///        previously given to adjust() are written to the
@@ -253,6 +257,11 @@ namespace geopm
             ///
             /// @return true if the value is valid, false if the value is invalid.
             static bool is_valid_value(double value);
+            /// @brief Create a cache file in tmpfs that records the
+            ///        signals and controls provided by each IOGroup
+            ///        so that later PlatformIO objects construct only
+            ///        the IOGroups that are used.
+            static void create_cache(void);
     };
 
     PlatformIO &platform_io(void);
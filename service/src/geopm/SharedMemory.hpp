@@ -19,6 +19,25 @@ namespace geopm
     class SharedMemory
     {
         public:
+            /// @brief Placement of the pages backing a region created
+            ///        with make_unique_owner() or
+            ///        make_unique_owner_secure().  The options only
+            ///        pay off for regions of at least one huge page
+            ///        (2 MiB on x86) that are read repeatedly.
+            struct placement_s {
+                /// @brief Advise the kernel to back the region with
+                ///        transparent huge pages.  This is a hint: it
+                ///        only has an effect when the file system
+                ///        holding the region allows huge pages, e.g. a
+                ///        tmpfs mounted with huge=advise.
+                bool is_huge_page = false;
+                /// @brief Fault in every page of the region when it is
+                ///        created rather than on first access.  The
+                ///        pages are charged to the memory cgroup of
+                ///        the creating process.
+                bool is_prefault = false;
+            };
+
             SharedMemory() = default;
             SharedMemory(const SharedMemory &other) = default;
             SharedMemory &operator=(const SharedMemory &other) = default;
@@ -48,10 +67,23 @@ namespace geopm
             ///
             /// @return a pointer to a SharedMemory object managing the region.
             static std::unique_ptr<SharedMemory> make_unique_owner(const std::string &shm_key, size_t size);
+            /// @brief Creates a shared memory region with the given key
+            ///        and size with its pages placed as requested.
+            ///
+            /// @return a pointer to a SharedMemory object managing the region.
+            static std::unique_ptr<SharedMemory> make_unique_owner(const std::string &shm_key, size_t size,
+                                                                   const placement_s &placement);
             /// @brief Creates a shared memory region with the given key and size without group or world permissions.
             ///
             /// @return a pointer to a SharedMemory object managing the region.
             static std::unique_ptr<SharedMemory> make_unique_owner_secure(const std::string &shm_key, size_t size);
+            /// @brief Creates a shared memory region with the given key
+            ///        and size without group or world permissions with
+            ///        its pages placed as requested.
+            ///
+            /// @return a pointer to a SharedMemory object managing the region.
+            static std::unique_ptr<SharedMemory> make_unique_owner_secure(const std::string &shm_key, size_t size,
+                                                                          const placement_s &placement);
             /// @brief Attaches to the shared memory region with the given key.
             ///
             /// @return a pointer to a SharedMemory object managing the region.
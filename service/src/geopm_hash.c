@@ -5,55 +5,336 @@
 #include "config.h"
 
 #include <string.h>
+#include <pthread.h>
 #ifdef GEOPM_HAS_SSE42
 #include <smmintrin.h>
-#else
-#include <stdio.h>
 #endif
 
 #include "geopm_hash.h"
+#include "geopm_hash_backend.h"
+#include "geopm_error.h"
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-uint64_t geopm_crc32_u64(uint64_t begin, uint64_t key)
+/* CRC32C (Castagnoli) polynomial in reflected bit order, matches the
+   SSE4.2 crc32 instruction. */
+#define GEOPM_CRC32C_POLY 0x82f63b78U
+/* Number of 64-bit words in each stream of the interleaved hardware
+   path.  Keys of at least three times this length are split into
+   three independent streams that are combined at the end of each
+   block.  Must be a power of two. */
+#define GEOPM_CRC32_STREAM_WORD 8
+
+/* Slice-by-8 lookup tables for the software implementation. */
+static uint32_t g_crc32_table[8][256];
+/* Tables that multiply a CRC by x^(64 * GEOPM_CRC32_STREAM_WORD)
+   modulo the polynomial, i.e. advance the CRC over one stream worth
+   of zero valued words.  One table per byte of the CRC. */
+static uint32_t g_crc32_shift_table[4][256];
+static pthread_once_t g_crc32_table_once = PTHREAD_ONCE_INIT;
+static pthread_once_t g_backend_once = PTHREAD_ONCE_INIT;
+static int g_backend = GEOPM_HASH_BACKEND_SOFTWARE;
+
+/* Multiply two polynomials modulo the CRC polynomial, both in
+   reflected bit order where the most significant bit is x^0. */
+static uint32_t geopm_crc32_mult_mod(uint32_t aa, uint32_t bb)
+{
+    uint32_t result = 0;
+    for (uint32_t mask = 1U << 31; mask != 0; mask >>= 1) {
+        if (aa & mask) {
+            result ^= bb;
+        }
+        bb = (bb & 1) ? (bb >> 1) ^ GEOPM_CRC32C_POLY : bb >> 1;
+    }
+    return result;
+}
+
+static void geopm_crc32_table_init(void)
+{
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+        uint32_t crc = byte;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ GEOPM_CRC32C_POLY : crc >> 1;
+        }
+        g_crc32_table[0][byte] = crc;
+    }
+    for (int slice = 1; slice < 8; ++slice) {
+        for (int byte = 0; byte < 256; ++byte) {
+            uint32_t crc = g_crc32_table[slice - 1][byte];
+            g_crc32_table[slice][byte] = (crc >> 8) ^ g_crc32_table[0][crc & 0xff];
+        }
+    }
+    /* x^8 is the operator that advances the CRC by one zero byte:
+       square it until it advances by one stream. */
+    uint32_t shift_op = 1U << 23;
+    for (int num_byte = 1; num_byte < 8 * GEOPM_CRC32_STREAM_WORD; num_byte *= 2) {
+        shift_op = geopm_crc32_mult_mod(shift_op, shift_op);
+    }
+    for (int slice = 0; slice < 4; ++slice) {
+        for (uint32_t byte = 0; byte < 256; ++byte) {
+            g_crc32_shift_table[slice][byte] =
+                geopm_crc32_mult_mod(shift_op, byte << (8 * slice));
+        }
+    }
+}
+
+static uint32_t geopm_crc32_shift(uint32_t crc)
+{
+    return g_crc32_shift_table[0][crc & 0xff] ^
+           g_crc32_shift_table[1][(crc >> 8) & 0xff] ^
+           g_crc32_shift_table[2][(crc >> 16) & 0xff] ^
+           g_crc32_shift_table[3][crc >> 24];
+}
+
+/* Load the word at word_idx from a key of the given length in little
+   endian byte order, zero padding beyond the end of the key. */
+static inline uint64_t geopm_crc32_load_word(const char *key, size_t length, size_t word_idx)
+{
+    uint64_t result = 0;
+    const char *ptr = key + 8 * word_idx;
+    size_t num_byte = length - 8 * word_idx;
+    if (num_byte >= 8) {
+        memcpy(&result, ptr, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        result = __builtin_bswap64(result);
+#endif
+    }
+    else {
+        for (size_t byte_idx = 0; byte_idx < num_byte; ++byte_idx) {
+            result |= (uint64_t)(unsigned char)ptr[byte_idx] << (8 * byte_idx);
+        }
+    }
+    return result;
+}
+
+static inline size_t geopm_crc32_num_word(size_t length)
+{
+    return length / 8 + (length % 8 ? 1 : 0);
+}
+
+static inline uint64_t geopm_crc32_u64_sw(uint64_t begin, uint64_t key)
+{
+    uint64_t word = key ^ (uint32_t)begin;
+    return g_crc32_table[7][word & 0xff] ^
+           g_crc32_table[6][(word >> 8) & 0xff] ^
+           g_crc32_table[5][(word >> 16) & 0xff] ^
+           g_crc32_table[4][(word >> 24) & 0xff] ^
+           g_crc32_table[3][(word >> 32) & 0xff] ^
+           g_crc32_table[2][(word >> 40) & 0xff] ^
+           g_crc32_table[1][(word >> 48) & 0xff] ^
+           g_crc32_table[0][word >> 56];
+}
+
+static uint64_t geopm_crc32_str_len_sw(const char *key, size_t length)
 {
     uint64_t result = 0;
+    size_t num_word = geopm_crc32_num_word(length);
+    for (size_t word_idx = 0; word_idx < num_word; ++word_idx) {
+        result = geopm_crc32_u64_sw(result, geopm_crc32_load_word(key, length, word_idx));
+    }
+    return result;
+}
+
 #ifdef GEOPM_HAS_SSE42
-    result = _mm_crc32_u64(begin, key);
-#else
-#ifdef GEOPM_DEBUG
-    static int is_once = 1;
-    if (is_once) {
-        fprintf(stderr, "Warning: <geopm> geopm_crc32_u64() called, but was compiled without SSE4.2 support, returning 0.\n");
-        is_once = 0;
+static uint64_t geopm_crc32_str_len_sse42(const char *key, size_t length)
+{
+    uint64_t result = 0;
+    size_t num_word = geopm_crc32_num_word(length);
+    size_t num_full_word = length / 8;
+    size_t word_idx = 0;
+    /* The crc32 instruction has a latency of several cycles but a
+       throughput of one per cycle, so long keys are hashed as three
+       interleaved streams that are combined with the shift tables. */
+    for (; word_idx + 3 * GEOPM_CRC32_STREAM_WORD <= num_full_word;
+         word_idx += 3 * GEOPM_CRC32_STREAM_WORD) {
+        const char *ptr = key + 8 * word_idx;
+        uint64_t crc_1 = 0;
+        uint64_t crc_2 = 0;
+        for (int stream_idx = 0; stream_idx < GEOPM_CRC32_STREAM_WORD; ++stream_idx) {
+            uint64_t word_0, word_1, word_2;
+            memcpy(&word_0, ptr + 8 * stream_idx, 8);
+            memcpy(&word_1, ptr + 8 * (stream_idx + GEOPM_CRC32_STREAM_WORD), 8);
+            memcpy(&word_2, ptr + 8 * (stream_idx + 2 * GEOPM_CRC32_STREAM_WORD), 8);
+            result = _mm_crc32_u64(result, word_0);
+            crc_1 = _mm_crc32_u64(crc_1, word_1);
+            crc_2 = _mm_crc32_u64(crc_2, word_2);
+        }
+        result = geopm_crc32_shift(geopm_crc32_shift(result) ^ crc_1) ^ crc_2;
+    }
+    for (; word_idx < num_word; ++word_idx) {
+        result = _mm_crc32_u64(result, geopm_crc32_load_word(key, length, word_idx));
+    }
+    return result;
+}
+
+static void geopm_crc32_str_batch_sse42(size_t num_key, const char **key,
+                                        const size_t *length, uint64_t *hash)
+{
+    size_t key_idx = 0;
+    /* Hash three short keys at a time to hide the latency of the
+       crc32 instruction. */
+    for (; key_idx + 3 <= num_key; key_idx += 3) {
+        size_t num_word[3];
+        size_t min_word = SIZE_MAX;
+        for (int ii = 0; ii < 3; ++ii) {
+            num_word[ii] = geopm_crc32_num_word(length[key_idx + ii]);
+            if (num_word[ii] < min_word) {
+                min_word = num_word[ii];
+            }
+        }
+        if (min_word >= 3 * GEOPM_CRC32_STREAM_WORD) {
+            /* Long keys benefit more from the single key streams */
+            for (int ii = 0; ii < 3; ++ii) {
+                hash[key_idx + ii] = geopm_crc32_str_len_sse42(key[key_idx + ii], length[key_idx + ii]);
+            }
+            continue;
+        }
+        uint64_t crc[3] = {0, 0, 0};
+        for (size_t word_idx = 0; word_idx < min_word; ++word_idx) {
+            crc[0] = _mm_crc32_u64(crc[0], geopm_crc32_load_word(key[key_idx], length[key_idx], word_idx));
+            crc[1] = _mm_crc32_u64(crc[1], geopm_crc32_load_word(key[key_idx + 1], length[key_idx + 1], word_idx));
+            crc[2] = _mm_crc32_u64(crc[2], geopm_crc32_load_word(key[key_idx + 2], length[key_idx + 2], word_idx));
+        }
+        for (int ii = 0; ii < 3; ++ii) {
+            for (size_t word_idx = min_word; word_idx < num_word[ii]; ++word_idx) {
+                crc[ii] = _mm_crc32_u64(crc[ii], geopm_crc32_load_word(key[key_idx + ii], length[key_idx + ii], word_idx));
+            }
+            hash[key_idx + ii] = crc[ii];
+        }
     }
+    for (; key_idx < num_key; ++key_idx) {
+        hash[key_idx] = geopm_crc32_str_len_sse42(key[key_idx], length[key_idx]);
+    }
+}
 #endif
+
+static void geopm_hash_backend_init(void)
+{
+    pthread_once(&g_crc32_table_once, geopm_crc32_table_init);
+#if defined(GEOPM_HAS_SSE42) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        g_backend = GEOPM_HASH_BACKEND_SSE42;
+    }
 #endif
+}
+
+int geopm_hash_backend(void)
+{
+    pthread_once(&g_backend_once, geopm_hash_backend_init);
+    return g_backend;
+}
+
+int geopm_hash_backend_is_supported(int backend)
+{
+    int result = 0;
+    if (backend == GEOPM_HASH_BACKEND_SOFTWARE) {
+        result = 1;
+    }
+    else if (backend == GEOPM_HASH_BACKEND_SSE42) {
+        result = (geopm_hash_backend() == GEOPM_HASH_BACKEND_SSE42);
+    }
     return result;
 }
 
-uint64_t geopm_crc32_str(const char *key)
+uint64_t geopm_crc32_u64_backend(int backend, uint64_t begin, uint64_t key)
 {
     uint64_t result = 0;
-    const uint64_t *ptr = (const uint64_t *)key;
-    size_t num_word = strlen(key) / 8;
-    for (size_t i = 0; i < num_word; ++i) {
-        result = geopm_crc32_u64(result, ptr[i]);
+#ifdef GEOPM_HAS_SSE42
+    if (backend == GEOPM_HASH_BACKEND_SSE42 &&
+        geopm_hash_backend_is_supported(backend)) {
+        result = _mm_crc32_u64(begin, key);
     }
-    size_t extra = strlen(key) - 8 * num_word;
-    if (extra) {
-        uint64_t last_word = 0;
-        for (size_t i = 0; i < extra; ++i) {
-            ((char *)(&last_word))[i] = ((char *)(ptr + num_word))[i];
-        }
-        result = geopm_crc32_u64(result, last_word);
+    else
+#endif
+    {
+        pthread_once(&g_crc32_table_once, geopm_crc32_table_init);
+        result = geopm_crc32_u64_sw(begin, key);
     }
     return result;
 }
 
+uint64_t geopm_crc32_str_len_backend(int backend, const char *key, size_t length)
+{
+    uint64_t result = 0;
+    pthread_once(&g_crc32_table_once, geopm_crc32_table_init);
+#ifdef GEOPM_HAS_SSE42
+    if (backend == GEOPM_HASH_BACKEND_SSE42 &&
+        geopm_hash_backend_is_supported(backend)) {
+        result = geopm_crc32_str_len_sse42(key, length);
+    }
+    else
+#endif
+    {
+        result = geopm_crc32_str_len_sw(key, length);
+    }
+    return result;
+}
+
+int geopm_crc32_str_batch_backend(int backend, size_t num_key, const char **key,
+                                  const size_t *length, uint64_t *hash)
+{
+    if (key == NULL || length == NULL || hash == NULL) {
+        return GEOPM_ERROR_INVALID;
+    }
+    pthread_once(&g_crc32_table_once, geopm_crc32_table_init);
+#ifdef GEOPM_HAS_SSE42
+    if (backend == GEOPM_HASH_BACKEND_SSE42 &&
+        geopm_hash_backend_is_supported(backend)) {
+        geopm_crc32_str_batch_sse42(num_key, key, length, hash);
+    }
+    else
+#endif
+    {
+        for (size_t key_idx = 0; key_idx < num_key; ++key_idx) {
+            hash[key_idx] = geopm_crc32_str_len_sw(key[key_idx], length[key_idx]);
+        }
+    }
+    return 0;
+}
+
+uint64_t geopm_crc32_u64(uint64_t begin, uint64_t key)
+{
+    return geopm_crc32_u64_backend(geopm_hash_backend(), begin, key);
+}
+
+uint64_t geopm_crc32_str(const char *key)
+{
+    return geopm_crc32_str_len_backend(geopm_hash_backend(), key, strlen(key));
+}
+
+uint64_t geopm_crc32_str_len(const char *key, size_t length)
+{
+    return geopm_crc32_str_len_backend(geopm_hash_backend(), key, length);
+}
+
+int geopm_crc32_str_batch(size_t num_key, const char **key,
+                          const size_t *length, uint64_t *hash)
+{
+    int err = 0;
+    if (key == NULL || hash == NULL) {
+        err = GEOPM_ERROR_INVALID;
+    }
+    else if (length != NULL) {
+        err = geopm_crc32_str_batch_backend(geopm_hash_backend(), num_key, key, length, hash);
+    }
+    else {
+        size_t length_buf[64];
+        for (size_t key_idx = 0; !err && key_idx < num_key; key_idx += 64) {
+            size_t num_chunk = num_key - key_idx < 64 ? num_key - key_idx : 64;
+            for (size_t chunk_idx = 0; chunk_idx < num_chunk; ++chunk_idx) {
+                length_buf[chunk_idx] = strlen(key[key_idx + chunk_idx]);
+            }
+            err = geopm_crc32_str_batch_backend(geopm_hash_backend(), num_chunk, key + key_idx,
+                                                length_buf, hash + key_idx);
+        }
+    }
+    return err;
+}
+
 #ifdef __cplusplus
 }
 #endif
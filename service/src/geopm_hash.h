@@ -57,6 +57,39 @@ uint64_t geopm_crc32_u64(uint64_t begin, uint64_t key);
 /// @return uint64_t The result is returned as a 64-bit integer.
 uint64_t geopm_crc32_str(const char *key);
 
+/// @brief Hash the first length characters of a string.
+///
+/// @details Produces the same result as geopm_crc32_str() for a
+///          string of the given length, without scanning the string
+///          for the terminating null character.
+///
+/// @param [in] key Characters that are hashed, need not be null
+///        terminated.
+///
+/// @param [in] length Number of characters in key.
+///
+/// @return uint64_t The result is returned as a 64-bit integer.
+uint64_t geopm_crc32_str_len(const char *key, size_t length);
+
+/// @brief Hash many strings with one call.
+///
+/// @details Equivalent to calling geopm_crc32_str_len() for each
+///          key, but interleaves the computation of several keys to
+///          hide the latency of the CRC32 instruction.
+///
+/// @param [in] num_key Number of strings to hash.
+///
+/// @param [in] key Array of num_key strings.
+///
+/// @param [in] length Array of num_key string lengths, or NULL if
+///        the strings are null terminated.
+///
+/// @param [out] hash Array of num_key results.
+///
+/// @return Zero on success, error code on failure.
+int geopm_crc32_str_batch(size_t num_key, const char **key,
+                          const size_t *length, uint64_t *hash);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef GEOPM_HASH_BACKEND_H_INCLUDE
+#define GEOPM_HASH_BACKEND_H_INCLUDE
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// @brief Implementations of the CRC32C algorithm used by the
+///        geopm_hash.h interfaces.  All backends produce identical
+///        results.
+enum geopm_hash_backend_e {
+    GEOPM_HASH_BACKEND_SOFTWARE, /* Portable slice-by-8 table lookup */
+    GEOPM_HASH_BACKEND_SSE42,    /* x86 crc32 instruction */
+    GEOPM_NUM_HASH_BACKEND,
+};
+
+/// @brief Get the backend used by the geopm_hash.h interfaces.
+///
+/// @return The fastest backend supported by the build and the CPU,
+///         one of the geopm_hash_backend_e values.
+int geopm_hash_backend(void);
+
+/// @brief Check if a backend may be used.
+///
+/// @param [in] backend One of the geopm_hash_backend_e values.
+///
+/// @return One if the backend is supported, zero otherwise.
+int geopm_hash_backend_is_supported(int backend);
+
+/// @brief Implementation of geopm_crc32_u64() with a specific
+///        backend.  Unsupported backends fall back to software.
+uint64_t geopm_crc32_u64_backend(int backend, uint64_t begin, uint64_t key);
+
+/// @brief Implementation of geopm_crc32_str_len() with a specific
+///        backend.  Unsupported backends fall back to software.
+uint64_t geopm_crc32_str_len_backend(int backend, const char *key, size_t length);
+
+/// @brief Implementation of geopm_crc32_str_batch() with a specific
+///        backend.  Unsupported backends fall back to software.
+///        The length array is required.
+int geopm_crc32_str_batch_backend(int backend, size_t num_key, const char **key,
+                                  const size_t *length, uint64_t *hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -472,6 +472,70 @@ void geopm_pio_reset(void);
 /// @return 0 if the value is valid, GEOPM_ERROR_INVALID if the value is invalid.
 int geopm_pio_check_valid_value(double value);
 
+/// @brief Create the PlatformIO cache file that records the signals
+///        and controls provided by each IOGroup if the file does not
+///        exist or was created before the last boot.  PlatformIO
+///        objects created afterwards construct only the IOGroups
+///        that are used.
+///
+/// @return Zero on success, error value on failure.
+int geopm_pio_create_cache(void);
+
+/// @brief Output formats for geopm_pio_sample_loop().
+enum geopm_pio_sample_format_e {
+    /// @brief One line per sample: the formatted values separated by
+    ///        commas.
+    GEOPM_PIO_SAMPLE_FORMAT_TEXT,
+    /// @brief One record per sample of num_request + 1 doubles in
+    ///        host byte order: the time in seconds since the loop
+    ///        started, followed by the value of each request.
+    GEOPM_PIO_SAMPLE_FORMAT_BINARY,
+};
+
+/// @brief Periodically read a set of signals and write every sample
+///        to a file descriptor from native code.
+///
+/// @details All of the requests are pushed and then read
+///          num_period + 1 times: once immediately and then once at
+///          the end of each period.  Each read is one batch read of
+///          all of the requests.  Reads are scheduled on absolute
+///          CLOCK_MONOTONIC deadlines.  The requests are pushed
+///          like geopm_pio_push_signal() and remain pushed after the
+///          call returns, so this function fails if
+///          geopm_pio_read_batch() or geopm_pio_adjust() has been
+///          called since the last geopm_pio_reset().
+///
+/// @param [in] num_request Number of elements in the request array.
+///
+/// @param [in] request Array of signal requests to read.
+///
+/// @param [in] period Time between reads in seconds.
+///
+/// @param [in] num_period Number of periods spanned by the loop.
+///
+/// @param [in] output_format One of the geopm_pio_sample_format_e
+///        values.
+///
+/// @param [in] output_fd Open file descriptor where each sample is
+///        written.
+///
+/// @param [out] num_missed Number of read deadlines that had already
+///        passed when the loop was ready to wait for them.
+///
+/// @param [out] num_sample Number of samples written.  The loop stops
+///        early, with fewer than num_period + 1 samples, if a signal
+///        handler interrupts the wait for a deadline.
+///
+/// @return Zero on success, error value on failure.
+int geopm_pio_sample_loop(int num_request,
+                          const struct geopm_request_s *request,
+                          double period,
+                          int num_period,
+                          int output_format,
+                          int output_fd,
+                          int *num_missed,
+                          int *num_sample);
+
 /// @brief Discover the thread PIDS associated with an application
 ///
 /// Called by a profiling application (like geopmctl) to determine
@@ -38,7 +38,7 @@ static pthread_once_t g_proc_cpuset_once = PTHREAD_ONCE_INIT;
 static cpu_set_t *g_proc_cpuset = NULL;
 static size_t g_proc_cpuset_size = 0;
 
-/* If /proc/self/status is usable and correct then parse this file to
+/* Parse the Cpus_allowed field of a /proc/<pid>/status file to
    determine the process affinity. */
 
 int geopm_sched_proc_cpuset_helper(int num_cpu, uint32_t *proc_cpuset, FILE *fid)
@@ -111,7 +111,10 @@ static void geopm_proc_cpuset_once(void)
     }
 }
 
-int geopm_sched_proc_cpuset_pid(int pid, int num_cpu, cpu_set_t *cpuset)
+/* Parse /proc/<pid>/status to determine the affinity of pid.  This
+   is slower than sched_getaffinity(2) and is only used if the system
+   call fails. */
+static int geopm_sched_proc_status_pid(int pid, int num_cpu, cpu_set_t *cpuset)
 {
     const size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
     const int num_read = num_cpu / 32 + (num_cpu % 32 ? 1 : 0);
@@ -155,17 +158,107 @@ int geopm_sched_proc_cpuset_pid(int pid, int num_cpu, cpu_set_t *cpuset)
         CPU_ZERO_S(cpuset_size, cpuset);
         memcpy(cpuset, proc_cpuset, num_read * sizeof(*proc_cpuset));
     }
-    else if (cpuset) {
+    if (proc_cpuset) {
+        free(proc_cpuset);
+    }
+    return err;
+}
+
+/* Query the affinity of pid with sched_getaffinity(2).  The kernel
+   rejects masks that are smaller than the number of CPUs it supports,
+   which may be larger than num_cpu, so the query is made into
+   *buffer.  The buffer is grown as needed and may be reused across
+   calls; the caller frees it with CPU_FREE(). */
+static int geopm_sched_affinity_pid(int pid, int num_cpu, cpu_set_t *cpuset,
+                                    cpu_set_t **buffer, int *buffer_num_cpu)
+{
+    int err = 0;
+    if (*buffer_num_cpu < num_cpu) {
+        if (*buffer) {
+            CPU_FREE(*buffer);
+        }
+        *buffer_num_cpu = num_cpu;
+        *buffer = CPU_ALLOC(*buffer_num_cpu);
+    }
+    while (!err) {
+        if (*buffer == NULL) {
+            *buffer_num_cpu = 0;
+            err = ENOMEM;
+        }
+        else if (sched_getaffinity(pid, CPU_ALLOC_SIZE(*buffer_num_cpu), *buffer) == 0) {
+            break;
+        }
+        else if (errno != EINVAL || *buffer_num_cpu >= INT_MAX / 2) {
+            err = errno ? errno : GEOPM_ERROR_RUNTIME;
+        }
+        else {
+            CPU_FREE(*buffer);
+            *buffer_num_cpu *= 2;
+            *buffer = CPU_ALLOC(*buffer_num_cpu);
+        }
+    }
+    if (!err) {
+        const size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
+        const size_t buffer_size = CPU_ALLOC_SIZE(*buffer_num_cpu);
+        CPU_ZERO_S(cpuset_size, cpuset);
+        for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+            if (CPU_ISSET_S(cpu_idx, buffer_size, *buffer)) {
+                CPU_SET_S(cpu_idx, cpuset_size, cpuset);
+            }
+        }
+    }
+    return err;
+}
+
+static int geopm_sched_proc_cpuset_pid_buffer(int pid, int num_cpu, cpu_set_t *cpuset,
+                                              cpu_set_t **buffer, int *buffer_num_cpu)
+{
+    int err = geopm_sched_affinity_pid(pid, num_cpu, cpuset, buffer, buffer_num_cpu);
+    if (err && err != ESRCH) {
+        err = geopm_sched_proc_status_pid(pid, num_cpu, cpuset);
+    }
+    if (err && cpuset) {
+        const size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
         for (int i = 0; i < num_cpu; ++i) {
             CPU_SET_S(i, cpuset_size, cpuset);
         }
     }
-    if (proc_cpuset) {
-        free(proc_cpuset);
+    return err;
+}
+
+int geopm_sched_proc_cpuset_pid(int pid, int num_cpu, cpu_set_t *cpuset)
+{
+    cpu_set_t *buffer = NULL;
+    int buffer_num_cpu = 0;
+    int err = geopm_sched_proc_cpuset_pid_buffer(pid, num_cpu, cpuset,
+                                                 &buffer, &buffer_num_cpu);
+    if (buffer) {
+        CPU_FREE(buffer);
     }
     return err;
 }
 
+int geopm_sched_proc_cpuset_pids(int num_pid, const int *pid, int num_cpu,
+                                 cpu_set_t *cpuset, int *pid_err)
+{
+    if (num_pid < 0 || num_cpu <= 0 ||
+        (num_pid != 0 && (pid == NULL || cpuset == NULL || pid_err == NULL))) {
+        return GEOPM_ERROR_INVALID;
+    }
+    const size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
+    cpu_set_t *buffer = NULL;
+    int buffer_num_cpu = 0;
+    for (int pid_idx = 0; pid_idx < num_pid; ++pid_idx) {
+        cpu_set_t *pid_cpuset = (cpu_set_t *)((char *)cpuset + pid_idx * cpuset_size);
+        pid_err[pid_idx] = geopm_sched_proc_cpuset_pid_buffer(pid[pid_idx], num_cpu, pid_cpuset,
+                                                              &buffer, &buffer_num_cpu);
+    }
+    if (buffer) {
+        CPU_FREE(buffer);
+    }
+    return 0;
+}
+
 int geopm_sched_proc_cpuset(int num_cpu, cpu_set_t *proc_cpuset)
 {
     int err = pthread_once(&g_proc_cpuset_once, geopm_proc_cpuset_once);
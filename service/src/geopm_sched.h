@@ -57,6 +57,9 @@ int geopm_sched_proc_cpuset(int num_cpu, cpu_set_t *proc_cpuset);
 
 int geopm_sched_proc_cpuset_pid(int pid, int num_cpu, cpu_set_t *cpuset);
 
+int geopm_sched_proc_cpuset_pids(int num_pid, const int *pid, int num_cpu,
+                                 cpu_set_t *cpuset, int *pid_err);
+
 int geopm_sched_woomp(int num_cpu, cpu_set_t *woomp);
 
 #ifdef __cplusplus
@@ -114,6 +114,10 @@ namespace geopm
     struct geopm_time_s time_zero(void);
     struct geopm_time_s time_curr(void);
     void time_zero_reset(const geopm_time_s &zero);
+    /// @brief Sleep until an absolute CLOCK_REALTIME deadline such
+    ///        as one computed with geopm_time_real().  The sleep is
+    ///        resumed if a signal handler interrupts it.
+    void time_sleep_until_real(const geopm_time_s &deadline);
 }
 #endif
 #endif
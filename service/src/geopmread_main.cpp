@@ -14,15 +14,20 @@
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <vector>
 
 #include "geopm_version.h"
 #include "geopm_error.h"
 #include "geopm_hash.h"
+#include "geopm_pio.h"
 #include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/SharedMemory.hpp"
-#include "geopm/Exception.hpp"
+#include "PlatformIOImp.hpp"
+#include "RequestFile.hpp"
+#include "SampleLoop.hpp"
 
 #include "config.h"
 
@@ -31,6 +36,12 @@ using geopm::PlatformTopo;
 
 int parse_domain_type(const std::string &dom);
 static int main_imp(int argc, char **argv);
+static int parse_request(const std::vector<std::string> &pos_args,
+                         const PlatformTopo &platform_topo,
+                         std::vector<geopm_request_s> &request);
+static int sample_loop(PlatformIO &platform_io,
+                       const std::vector<geopm_request_s> &request,
+                       double period, int count);
 
 int main(int argc, char **argv)
 {
@@ -48,18 +59,34 @@ int main(int argc, char **argv)
 static int main_imp(int argc, char **argv)
 {
     const char *usage = "\nUsage:\n"
-                        "       geopmread SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX\n"
+                        "       geopmread SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX [SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX ...]\n"
+                        "       geopmread --file FILE [--period PERIOD [--count COUNT]]\n"
                         "       geopmread [--info [SIGNAL_NAME]]\n"
                         "       geopmread [--help] [--version] [--cache] [--info-all] [--domain]\n"
                         "\n"
                         "  SIGNAL_NAME:  name of the signal\n"
                         "  DOMAIN_TYPE:  name of the domain for which the signal should be read\n"
-                        "  DOMAIN_INDEX: index of the domain, starting from 0\n"
+                        "  DOMAIN_INDEX: index of the domain, starting from 0, or \"all\" for\n"
+                        "                every domain of the type\n"
+                        "\n"
+                        "  When more than one signal is requested the signals are read together\n"
+                        "  and one value is printed per line in the order requested.  Signals that\n"
+                        "  are derived from repeated samples, e.g. power, share a single sampling\n"
+                        "  period.\n"
                         "\n"
+                        "  -f, --file=FILE                  read requests from FILE, one\n"
+                        "                                   \"SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX\"\n"
+                        "                                   per line, or from standard input if\n"
+                        "                                   FILE is \"-\"\n"
+                        "  -p, --period=PERIOD              read all requests every PERIOD seconds\n"
+                        "                                   and print one comma separated line of\n"
+                        "                                   values per period\n"
+                        "  -n, --count=COUNT                stop after COUNT periods (default: run\n"
+                        "                                   until interrupted)\n"
                         "  -d, --domain                     print domains detected\n"
                         "  -i, --info                       print longer description of a signal\n"
                         "  -I, --info-all                   print longer description of all signals\n"
-                        "  -c, --cache                      create geopm topo cache and clean up /dev/shm\n"
+                        "  -c, --cache                      create geopm topo and pio caches and clean up /dev/shm\n"
                         "  -h, --help                       print brief summary of the command line\n"
                         "                                   usage information, then exit\n"
                         "  -v, --version                    print version of GEOPM to standard output,\n"
@@ -75,6 +102,9 @@ static int main_imp(int argc, char **argv)
         {"cache", no_argument, NULL, 'c'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
+        {"file", required_argument, NULL, 'f'},
+        {"period", required_argument, NULL, 'p'},
+        {"count", required_argument, NULL, 'n'},
         {NULL, 0, NULL, 0}
     };
 
@@ -83,7 +113,10 @@ static int main_imp(int argc, char **argv)
     bool is_domain = false;
     bool is_info = false;
     bool is_all_info = false;
-    while (!err && (opt = getopt_long(argc, argv, "diIchv", long_options, NULL)) != -1) {
+    std::string file_path;
+    double period = 0.0;
+    int count = 0;
+    while (!err && (opt = getopt_long(argc, argv, "diIchvf:p:n:", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
                 is_domain = true;
@@ -94,8 +127,36 @@ static int main_imp(int argc, char **argv)
             case 'I':
                 is_all_info = true;
                 break;
+            case 'f':
+                file_path = optarg;
+                break;
+            case 'p':
+                try {
+                    period = std::stod(optarg);
+                }
+                catch (const std::exception &) {
+                    period = -1.0;
+                }
+                if (!(period > 0.0)) {
+                    std::cerr << "Error: invalid period: " << optarg << std::endl;
+                    err = EINVAL;
+                }
+                break;
+            case 'n':
+                try {
+                    count = std::stoi(optarg);
+                }
+                catch (const std::exception &) {
+                    count = -1;
+                }
+                if (count <= 0) {
+                    std::cerr << "Error: invalid count: " << optarg << std::endl;
+                    err = EINVAL;
+                }
+                break;
             case 'c':
                 geopm::PlatformTopo::create_cache();
+                geopm::PlatformIO::create_cache();
                 geopm::SharedMemory::cleanup_shmem();
                 return 0;
             case 'h':
@@ -116,15 +177,37 @@ static int main_imp(int argc, char **argv)
         }
     }
 
+    if (err) {
+        return err;
+    }
     if (is_domain && is_info) {
         std::cerr << "Error: info about domain not implemented." << std::endl;
         return EINVAL;
     }
+    if (count != 0 && period == 0.0) {
+        std::cerr << "Error: --count requires --period." << std::endl;
+        return EINVAL;
+    }
 
     std::vector<std::string> pos_args;
     while (optind < argc) {
         pos_args.emplace_back(argv[optind++]);
     }
+    if (!file_path.empty()) {
+        try {
+            std::vector<std::string> file_args =
+                geopm::read_request_file(file_path, {"SIGNAL_NAME", "DOMAIN_TYPE", "DOMAIN_INDEX"});
+            pos_args.insert(pos_args.end(), file_args.begin(), file_args.end());
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: " << ex.what() << std::endl;
+            return EINVAL;
+        }
+    }
+    if (period != 0.0 && pos_args.empty()) {
+        std::cerr << "Error: --period requires at least one signal request." << std::endl;
+        return EINVAL;
+    }
 
     PlatformIO &platform_io = geopm::platform_io();
     const PlatformTopo &platform_topo = geopm::platform_topo();
@@ -169,22 +252,30 @@ static int main_imp(int argc, char **argv)
                 std::cout << sig << std::endl;
             }
         }
-        else if (pos_args.size() >= 3) {
-            // read signal
-            std::string signal_name = pos_args[0];
-            int domain_idx = -1;
-            try {
-                domain_idx = std::stoi(pos_args[2]);
-            }
-            catch (const std::invalid_argument &) {
-                std::cerr << "Error: invalid domain index.\n" << std::endl;
-                err = EINVAL;
+        else if (pos_args.size() % 3 == 0) {
+            // read signals
+            std::vector<geopm_request_s> request;
+            err = parse_request(pos_args, platform_topo, request);
+            if (!err && period != 0.0) {
+                err = sample_loop(platform_io, request, period, count);
             }
-            if (!err) {
+            else if (!err) {
                 try {
-                    int domain_type = PlatformTopo::domain_name_to_type(pos_args[1]);
-                    double result = platform_io.read_signal(signal_name, domain_type, domain_idx);
-                    std::cout << platform_io.format_function(signal_name)(result) << std::endl;
+                    std::vector<double> result;
+                    auto *platform_io_imp = dynamic_cast<geopm::PlatformIOImp *>(&platform_io);
+                    if (request.size() > 1 && platform_io_imp != nullptr) {
+                        result = platform_io_imp->read_signals(request);
+                    }
+                    else {
+                        for (const auto &req : request) {
+                            result.push_back(platform_io.read_signal(req.name,
+                                                                     req.domain_type,
+                                                                     req.domain_idx));
+                        }
+                    }
+                    for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                        std::cout << platform_io.format_function(request[req_idx].name)(result[req_idx]) << std::endl;
+                    }
                 }
                 catch (const geopm::Exception &ex) {
                     std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
@@ -199,3 +290,71 @@ static int main_imp(int argc, char **argv)
     }
     return err;
 }
+
+// Convert groups of SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX arguments into
+// requests, expanding a DOMAIN_INDEX of "all" into one request per domain.
+static int parse_request(const std::vector<std::string> &pos_args,
+                         const PlatformTopo &platform_topo,
+                         std::vector<geopm_request_s> &request)
+{
+    int err = 0;
+    for (size_t arg_idx = 0; !err && arg_idx < pos_args.size(); arg_idx += 3) {
+        geopm_request_s req {};
+        const std::string &signal_name = pos_args[arg_idx];
+        if (signal_name.size() >= NAME_MAX) {
+            std::cerr << "Error: signal name is too long: " << signal_name << "\n" << std::endl;
+            err = EINVAL;
+            break;
+        }
+        strncpy(req.name, signal_name.c_str(), NAME_MAX - 1);
+        try {
+            req.domain_type = PlatformTopo::domain_name_to_type(pos_args[arg_idx + 1]);
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
+            err = EINVAL;
+            break;
+        }
+        if (pos_args[arg_idx + 2] == "all") {
+            int num_domain = platform_topo.num_domain(req.domain_type);
+            for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+                req.domain_idx = domain_idx;
+                request.push_back(req);
+            }
+        }
+        else {
+            try {
+                req.domain_idx = std::stoi(pos_args[arg_idx + 2]);
+                request.push_back(req);
+            }
+            catch (const std::invalid_argument &) {
+                std::cerr << "Error: invalid domain index.\n" << std::endl;
+                err = EINVAL;
+            }
+        }
+    }
+    return err;
+}
+
+// Push every request once and then sample all of them with one
+// read_batch() per period.
+static int sample_loop(PlatformIO &platform_io,
+                       const std::vector<geopm_request_s> &request,
+                       double period, int count)
+{
+    try {
+        auto loop = geopm::SampleLoop::make_unique(platform_io, request, GEOPM_PIO_SAMPLE_FORMAT_TEXT);
+        // The loop reads once before the first period; without a
+        // count it is restarted until the process is interrupted
+        int num_period = count == 0 ? std::numeric_limits<int>::max() - 1 : count - 1;
+        int num_sample = 0;
+        do {
+            loop->run(period, num_period, STDOUT_FILENO, num_sample);
+        } while (count == 0 && num_sample == num_period + 1);
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: cannot read signal: " << ex.what() << std::endl;
+        return EINVAL;
+    }
+    return 0;
+}
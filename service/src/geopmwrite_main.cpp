@@ -22,6 +22,7 @@
 #include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Exception.hpp"
+#include "RequestFile.hpp"
 
 #include "config.h"
 
@@ -30,6 +31,10 @@ using geopm::PlatformTopo;
 
 int parse_domain_type(const std::string &dom);
 static int main_imp(int argc, char **argv);
+static int parse_request(const std::vector<std::string> &pos_args,
+                         const PlatformTopo &platform_topo,
+                         std::vector<geopm_request_s> &request,
+                         std::vector<double> &setting);
 
 int main(int argc, char **argv)
 {
@@ -47,19 +52,28 @@ int main(int argc, char **argv)
 static int main_imp(int argc, char **argv)
 {
     const char *usage = "\nUsage:\n"
-                        "       geopmwrite CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE\n"
+                        "       geopmwrite CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE [CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE ...]\n"
+                        "       geopmwrite --file FILE\n"
                         "       geopmwrite [--info [CONTROL_NAME]]\n"
                         "       geopmwrite [--help] [--version] [--cache] [--info-all] [--domain]\n"
                         "\n"
                         "  CONTROL_NAME:  name of the control\n"
                         "  DOMAIN_TYPE:  name of the domain for which the control should be written\n"
-                        "  DOMAIN_INDEX: index of the domain, starting from 0\n"
+                        "  DOMAIN_INDEX: index of the domain, starting from 0, or \"all\" for\n"
+                        "                every domain of the type\n"
                         "  VALUE:        setting to adjust control to\n"
                         "\n"
+                        "  When more than one control is requested all of the settings are\n"
+                        "  applied with a single batch write.\n"
+                        "\n"
+                        "  -f, --file=FILE                  read requests from FILE, one\n"
+                        "                                   \"CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE\"\n"
+                        "                                   per line, or from standard input if\n"
+                        "                                   FILE is \"-\"\n"
                         "  -d, --domain                     print domains detected\n"
                         "  -i, --info                       print longer description of a control\n"
                         "  -I, --info-all                   print longer description of all controls\n"
-                        "  -c, --cache                      create geopm topo cache if it does not exist\n"
+                        "  -c, --cache                      create geopm topo and pio caches if they do not exist\n"
                         "  -h, --help                       print brief summary of the command line\n"
                         "                                   usage information, then exit\n"
                         "  -v, --version                    print version of GEOPM to standard output,\n"
@@ -75,6 +89,7 @@ static int main_imp(int argc, char **argv)
         {"cache", no_argument, NULL, 'c'},
         {"help", no_argument, NULL, 'h'},
         {"version", no_argument, NULL, 'v'},
+        {"file", required_argument, NULL, 'f'},
         {NULL, 0, NULL, 0}
     };
 
@@ -83,7 +98,8 @@ static int main_imp(int argc, char **argv)
     bool is_domain = false;
     bool is_info = false;
     bool is_all_info = false;
-    while (!err && (opt = getopt_long(argc, argv, "diIchv", long_options, NULL)) != -1) {
+    std::string file_path;
+    while (!err && (opt = getopt_long(argc, argv, "diIchvf:", long_options, NULL)) != -1) {
         switch (opt) {
             case 'd':
                 is_domain = true;
@@ -94,8 +110,12 @@ static int main_imp(int argc, char **argv)
             case 'I':
                 is_all_info = true;
                 break;
+            case 'f':
+                file_path = optarg;
+                break;
             case 'c':
                 geopm::PlatformTopo::create_cache();
+                geopm::PlatformIO::create_cache();
                 return 0;
             case 'h':
                 printf("%s", usage);
@@ -125,6 +145,18 @@ static int main_imp(int argc, char **argv)
     while (optind < argc) {
         pos_args.emplace_back(argv[optind++]);
     }
+    if (!err && !file_path.empty()) {
+        try {
+            std::vector<std::string> file_args =
+                geopm::read_request_file(file_path, {"CONTROL_NAME", "DOMAIN_TYPE",
+                                                     "DOMAIN_INDEX", "VALUE"});
+            pos_args.insert(pos_args.end(), file_args.begin(), file_args.end());
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: " << ex.what() << std::endl;
+            return EINVAL;
+        }
+    }
 
     PlatformIO &platform_io = geopm::platform_io();
     const PlatformTopo &platform_topo = geopm::platform_topo();
@@ -169,7 +201,7 @@ static int main_imp(int argc, char **argv)
                 std::cout << con << std::endl;
             }
         }
-        else if (pos_args.size() >= 4) {
+        else if (pos_args.size() == 4 && pos_args[2] != "all") {
             // write control
             std::string control_name = pos_args[0];
             int domain_idx = -1;
@@ -201,6 +233,29 @@ static int main_imp(int argc, char **argv)
                 }
             }
         }
+        else if (pos_args.size() % 4 == 0) {
+            // write several controls: validate every request before
+            // any of them is applied, then write them all in one batch
+            std::vector<geopm_request_s> request;
+            std::vector<double> setting;
+            err = parse_request(pos_args, platform_topo, request, setting);
+            if (!err) {
+                try {
+                    std::vector<int> control_idx;
+                    for (const auto &req : request) {
+                        control_idx.push_back(platform_io.push_control(req.name, req.domain_type, req.domain_idx));
+                    }
+                    for (size_t req_idx = 0; req_idx < request.size(); ++req_idx) {
+                        platform_io.adjust(control_idx[req_idx], setting[req_idx]);
+                    }
+                    platform_io.write_batch();
+                }
+                catch (const geopm::Exception &ex) {
+                    std::cerr << "Error: cannot write control: " << ex.what() << std::endl;
+                    err = EINVAL;
+                }
+            }
+        }
         else {
             std::cerr << "Error: domain type, domain index, and value are required to write control.\n" << std::endl;
             err = EINVAL;
@@ -209,3 +264,61 @@ static int main_imp(int argc, char **argv)
 
     return err;
 }
+
+// Convert groups of CONTROL_NAME DOMAIN_TYPE DOMAIN_INDEX VALUE arguments
+// into requests, expanding a DOMAIN_INDEX of "all" into one request per
+// domain.
+static int parse_request(const std::vector<std::string> &pos_args,
+                         const PlatformTopo &platform_topo,
+                         std::vector<geopm_request_s> &request,
+                         std::vector<double> &setting)
+{
+    int err = 0;
+    for (size_t arg_idx = 0; !err && arg_idx < pos_args.size(); arg_idx += 4) {
+        geopm_request_s req {};
+        const std::string &control_name = pos_args[arg_idx];
+        if (control_name.size() >= NAME_MAX) {
+            std::cerr << "Error: control name is too long: " << control_name << "\n" << std::endl;
+            err = EINVAL;
+            break;
+        }
+        strncpy(req.name, control_name.c_str(), NAME_MAX - 1);
+        try {
+            req.domain_type = PlatformTopo::domain_name_to_type(pos_args[arg_idx + 1]);
+        }
+        catch (const geopm::Exception &ex) {
+            std::cerr << "Error: cannot write control: " << ex.what() << std::endl;
+            err = EINVAL;
+            break;
+        }
+        double write_value = NAN;
+        try {
+            write_value = std::stod(pos_args[arg_idx + 3]);
+        }
+        catch (const std::invalid_argument &) {
+            std::cerr << "Error: invalid write value.\n" << std::endl;
+            err = EINVAL;
+            break;
+        }
+        if (pos_args[arg_idx + 2] == "all") {
+            int num_domain = platform_topo.num_domain(req.domain_type);
+            for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+                req.domain_idx = domain_idx;
+                request.push_back(req);
+                setting.push_back(write_value);
+            }
+        }
+        else {
+            try {
+                req.domain_idx = std::stoi(pos_args[arg_idx + 2]);
+                request.push_back(req);
+                setting.push_back(write_value);
+            }
+            catch (const std::invalid_argument &) {
+                std::cerr << "Error: invalid domain index.\n" << std::endl;
+                err = EINVAL;
+            }
+        }
+    }
+    return err;
+}
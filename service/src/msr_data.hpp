@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MSR_DATA_HPP_INCLUDE
+#define MSR_DATA_HPP_INCLUDE
+
+#include <cstddef>
+#include <cstdint>
+
+namespace geopm
+{
+    /// @brief Definition of one bit field within an MSR.  The
+    ///        enumerated values are the ones that the MSRIOGroup
+    ///        would otherwise derive from the strings in the JSON
+    ///        data file.
+    struct msr_field_s {
+        const char *name;
+        int begin_bit;
+        int end_bit;
+        int function;           // MSR::m_function_e
+        double scalar;
+        int units;              // IOGroup::m_units_e
+        bool is_writeable;
+        int behavior;           // IOGroup::m_signal_behavior_e
+        int agg_type;           // Agg::m_type_e
+        const char *description;  // nullptr selects the default description
+    };
+
+    /// @brief Definition of one MSR and its bit fields.
+    struct msr_s {
+        const char *name;
+        uint64_t offset;
+        int domain_type;        // geopm_domain_e
+        const msr_field_s *field;
+        size_t num_field;
+    };
+
+    /// @brief All MSRs defined by one of the JSON files in
+    ///        docs/json_data, sorted by MSR name and then by field
+    ///        name.
+    struct msr_table_s {
+        const msr_s *msr;
+        size_t num_msr;
+    };
+
+    /// @brief Tables generated at build time by src/msr_data_gen.py
+    ///        from docs/json_data/msr_data_{arch,hsx,knl,skx,snb}.json.
+    const msr_table_s &arch_msr_table(void);
+    const msr_table_s &hsx_msr_table(void);
+    const msr_table_s &knl_msr_table(void);
+    const msr_table_s &skx_msr_table(void);
+    const msr_table_s &snb_msr_table(void);
+}
+
+#endif
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+#
+#  Copyright (c) 2015 - 2023, Intel Corporation
+#  SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""Generate a C++ source file that defines the msr_table_s for one of
+the MSR JSON data files in docs/json_data.  The MSRIOGroup registers
+its built-in signals and controls from these tables so that the JSON
+is only parsed at build time.
+
+Usage: msr_data_gen.py msr_data_{arch}.json > msr_data_{arch}.cpp
+
+The generated file defines {arch}_msr_table().
+
+The checks mirror MSRIOGroup::check_msr_root() and
+MSRIOGroup::check_msr_field() so that a malformed data file fails the
+build rather than silently dropping MSRs at run time.
+"""
+
+import json
+import os
+import sys
+
+_DOMAIN = {
+    'board': 'GEOPM_DOMAIN_BOARD',
+    'package': 'GEOPM_DOMAIN_PACKAGE',
+    'core': 'GEOPM_DOMAIN_CORE',
+    'cpu': 'GEOPM_DOMAIN_CPU',
+    'memory': 'GEOPM_DOMAIN_MEMORY',
+    'package_integrated_memory': 'GEOPM_DOMAIN_PACKAGE_INTEGRATED_MEMORY',
+    'nic': 'GEOPM_DOMAIN_NIC',
+    'package_integrated_nic': 'GEOPM_DOMAIN_PACKAGE_INTEGRATED_NIC',
+    'gpu': 'GEOPM_DOMAIN_GPU',
+    'package_integrated_gpu': 'GEOPM_DOMAIN_PACKAGE_INTEGRATED_GPU',
+    'gpu_chip': 'GEOPM_DOMAIN_GPU_CHIP',
+}
+
+_FUNCTION = {
+    'scale': 'MSR::M_FUNCTION_SCALE',
+    'log_half': 'MSR::M_FUNCTION_LOG_HALF',
+    '7_bit_float': 'MSR::M_FUNCTION_7_BIT_FLOAT',
+    'logic': 'MSR::M_FUNCTION_LOGIC',
+    'overflow': 'MSR::M_FUNCTION_OVERFLOW',
+}
+
+_UNITS = {
+    'none': 'IOGroup::M_UNITS_NONE',
+    'seconds': 'IOGroup::M_UNITS_SECONDS',
+    'hertz': 'IOGroup::M_UNITS_HERTZ',
+    'watts': 'IOGroup::M_UNITS_WATTS',
+    'joules': 'IOGroup::M_UNITS_JOULES',
+    'celsius': 'IOGroup::M_UNITS_CELSIUS',
+}
+
+_BEHAVIOR = {
+    'constant': 'IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT',
+    'monotone': 'IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE',
+    'variable': 'IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE',
+    'label': 'IOGroup::M_SIGNAL_BEHAVIOR_LABEL',
+}
+
+_AGGREGATION = {
+    'sum': 'Agg::M_SUM',
+    'average': 'Agg::M_AVERAGE',
+    'median': 'Agg::M_MEDIAN',
+    'integer_bitwise_or': 'Agg::M_INTEGER_BITWISE_OR',
+    'logical_and': 'Agg::M_LOGICAL_AND',
+    'logical_or': 'Agg::M_LOGICAL_OR',
+    'min': 'Agg::M_MIN',
+    'max': 'Agg::M_MAX',
+    'stddev': 'Agg::M_STDDEV',
+    'region_hash': 'Agg::M_REGION_HASH',
+    'region_hint': 'Agg::M_REGION_HINT',
+    'select_first': 'Agg::M_SELECT_FIRST',
+    'expect_same': 'Agg::M_EXPECT_SAME',
+}
+
+_HEADER = """\
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+// Generated by src/msr_data_gen.py from {json_path}; do not edit.
+
+#include "config.h"
+
+#include "msr_data.hpp"
+
+#include "geopm/Agg.hpp"
+#include "geopm/IOGroup.hpp"
+#include "geopm_topo.h"
+#include "MSR.hpp"
+
+namespace geopm
+{{
+"""
+
+_FOOTER = """\
+    const msr_table_s &{arch}_msr_table(void)
+    {{
+        static constexpr msr_table_s result = {{
+            M_{ARCH}_MSR, sizeof(M_{ARCH}_MSR) / sizeof(M_{ARCH}_MSR[0])
+        }};
+        return result;
+    }}
+}}
+"""
+
+
+class MSRDataError(Exception):
+    pass
+
+
+def c_string(value):
+    """Format a python string as a C string literal."""
+    result = ['"']
+    for cc in value.encode('utf-8'):
+        ch = chr(cc)
+        if ch in '"\\':
+            result.append('\\' + ch)
+        elif ch == '\n':
+            result.append('\\n')
+        elif ch == '\t':
+            result.append('\\t')
+        elif cc < 0x20 or cc >= 0x7f:
+            # Octal escapes never merge with the following character
+            # when all three digits are given
+            result.append('\\{:03o}'.format(cc))
+        else:
+            result.append(ch)
+    result.append('"')
+    return ''.join(result)
+
+
+def c_double(value):
+    # repr() gives the shortest string that round trips the double
+    result = repr(float(value))
+    if result in ('inf', '-inf', 'nan'):
+        raise MSRDataError('scalar must be finite')
+    return result
+
+
+def check_type(obj, key, expected, where):
+    if key not in obj:
+        raise MSRDataError('missing key "{}" {}'.format(key, where))
+    value = obj[key]
+    # bool is a subclass of int, reject it where a number is expected
+    if isinstance(value, bool) and expected is not bool:
+        raise MSRDataError('"{}" {} has the wrong type'.format(key, where))
+    if not isinstance(value, expected):
+        raise MSRDataError('"{}" {} has the wrong type'.format(key, where))
+    return value
+
+
+def lookup(table, obj, key, where):
+    value = check_type(obj, key, str, where)
+    try:
+        return table[value]
+    except KeyError:
+        raise MSRDataError('invalid value "{}" for "{}" {}'.format(value, key, where))
+
+
+def check_keys(obj, required, optional, where):
+    extra = set(obj) - set(required) - set(optional)
+    if extra:
+        raise MSRDataError('unexpected key(s) {} {}'.format(
+                           ', '.join('"{}"'.format(kk) for kk in sorted(extra)), where))
+
+
+def parse_offset(obj, where):
+    value = check_type(obj, 'offset', str, where)
+    try:
+        result = int(value, 16)
+    except ValueError:
+        raise MSRDataError('"offset" {} must be a hex string'.format(where))
+    if result == 0:
+        raise MSRDataError('"offset" {} must be non-zero'.format(where))
+    return result
+
+
+def parse_field(msr_name, field_name, field):
+    where = 'in "{}:{}"'.format(msr_name, field_name)
+    if not isinstance(field, dict):
+        raise MSRDataError('"{}" field within msr "{}" must be an object'.format(field_name, msr_name))
+    required = ('begin_bit', 'end_bit', 'function', 'units', 'scalar',
+                'writeable', 'behavior', 'aggregation')
+    check_keys(field, required, ('description',), where)
+    begin_bit = check_type(field, 'begin_bit', int, where)
+    end_bit = check_type(field, 'end_bit', int, where)
+    if not 0 <= begin_bit <= end_bit <= 63:
+        raise MSRDataError('bits [{}, {}] {} are not within a 64 bit register'.format(
+                           begin_bit, end_bit, where))
+    description = 'nullptr'
+    if 'description' in field:
+        description = c_string(check_type(field, 'description', str, where))
+    return '{{{name}, {begin_bit}, {end_bit}, {function}, {scalar}, {units}, ' \
+           '{writeable}, {behavior}, {agg}, {description}}}'.format(
+               name=c_string(field_name),
+               begin_bit=begin_bit,
+               end_bit=end_bit,
+               function=lookup(_FUNCTION, field, 'function', where),
+               scalar=c_double(check_type(field, 'scalar', (int, float), where)),
+               units=lookup(_UNITS, field, 'units', where),
+               writeable='true' if check_type(field, 'writeable', bool, where) else 'false',
+               behavior=lookup(_BEHAVIOR, field, 'behavior', where),
+               agg=lookup(_AGGREGATION, field, 'aggregation', where),
+               description=description)
+
+
+def generate(json_path, arch, json_str):
+    try:
+        root = json.loads(json_str)
+    except ValueError as ex:
+        raise MSRDataError('detected a malformed json string: {}'.format(ex))
+    if not isinstance(root, dict):
+        raise MSRDataError('detected a malformed json string')
+    check_keys(root, ('msrs',), (), 'at top level')
+    msrs = check_type(root, 'msrs', dict, 'at top level')
+
+    out = [_HEADER.format(json_path=json_path)]
+    msr_entries = []
+    # Sort by name: the same order the json11 object map produced
+    for msr_idx, msr_name in enumerate(sorted(msrs)):
+        msr = msrs[msr_name]
+        where = 'in msr "{}"'.format(msr_name)
+        if not isinstance(msr, dict):
+            raise MSRDataError('data for msr "{}" must be an object'.format(msr_name))
+        check_keys(msr, ('offset', 'domain', 'fields'), (), where)
+        offset = parse_offset(msr, where)
+        domain = lookup(_DOMAIN, msr, 'domain', where)
+        fields = check_type(msr, 'fields', dict, where)
+        field_array = 'M_{}_FIELD_{}'.format(arch.upper(), msr_idx)
+        if fields:
+            out.append('    // {}\n'.format(msr_name))
+            out.append('    static constexpr msr_field_s {}[] = {{\n'.format(field_array))
+            for field_name in sorted(fields):
+                out.append('        {},\n'.format(parse_field(msr_name, field_name, fields[field_name])))
+            out.append('    };\n\n')
+        else:
+            field_array = 'nullptr'
+        msr_entries.append('        {{{}, 0x{:x}ULL, {}, {}, {}}},\n'.format(
+                           c_string(msr_name), offset, domain, field_array, len(fields)))
+    if not msr_entries:
+        raise MSRDataError('no msrs defined')
+    out.append('    static constexpr msr_s M_{}_MSR[] = {{\n'.format(arch.upper()))
+    out.extend(msr_entries)
+    out.append('    };\n\n')
+    out.append(_FOOTER.format(arch=arch, ARCH=arch.upper()))
+    return ''.join(out)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write('Usage: {} msr_data_{{arch}}.json\n'.format(sys.argv[0]))
+        return 1
+    json_path = sys.argv[1]
+    arch = os.path.basename(json_path)
+    if not arch.startswith('msr_data_') or not arch.endswith('.json'):
+        sys.stderr.write('Error: {}: expected a file named msr_data_{{arch}}.json\n'.format(json_path))
+        return 1
+    arch = arch[len('msr_data_'):-len('.json')]
+    try:
+        with open(json_path) as fid:
+            sys.stdout.write(generate(json_path, arch, fid.read()))
+    except (OSError, MSRDataError) as ex:
+        sys.stderr.write('Error: {}: {}\n'.format(json_path, ex))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -8,12 +8,14 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include "DerivativeBatch.hpp"
 #include "DerivativeSignal.hpp"
 #include "geopm/Helper.hpp"
 #include "MockSignal.hpp"
 #include "geopm_test.hpp"
 
 using geopm::Signal;
+using geopm::DerivativeBatch;
 using geopm::DerivativeSignal;
 
 using testing::Return;
@@ -177,3 +179,102 @@ TEST_F(DerivativeSignalTest, errors)
                                "setup_batch() must be called before sample()");
 
 }
+
+TEST_F(DerivativeSignalTest, batch)
+{
+    auto batch = std::make_shared<DerivativeBatch>(m_time_sig, m_num_history_sample);
+    auto y_sig_1 = std::make_shared<MockSignal>();
+    auto y_sig_2 = std::make_shared<MockSignal>();
+    auto sig_0 = geopm::make_unique<DerivativeSignal>(m_time_sig, m_y_sig,
+                                                      m_num_history_sample, m_sleep_time,
+                                                      batch);
+    auto sig_1 = geopm::make_unique<DerivativeSignal>(m_time_sig, y_sig_1,
+                                                      m_num_history_sample, m_sleep_time,
+                                                      batch);
+    auto sig_2 = geopm::make_unique<DerivativeSignal>(m_time_sig, y_sig_2,
+                                                      m_num_history_sample, m_sleep_time,
+                                                      batch);
+    EXPECT_CALL(*m_time_sig, setup_batch()).Times(1);
+    EXPECT_CALL(*m_y_sig, setup_batch()).Times(1);
+    EXPECT_CALL(*y_sig_1, setup_batch()).Times(1);
+    EXPECT_CALL(*y_sig_2, setup_batch()).Times(1);
+    sig_0->setup_batch();
+    sig_1->setup_batch();
+    sig_2->setup_batch();
+    sig_2->setup_batch();
+
+    // The signals in the batch are sampled once for each new time,
+    // regardless of which derivative is sampled or how often.
+    double result_0 = NAN;
+    double result_1 = NAN;
+    double result_2 = NAN;
+    for (size_t ii = 0; ii < m_sample_values_2.size(); ++ii) {
+        EXPECT_CALL(*m_time_sig, sample()).WillRepeatedly(Return(ii));
+        EXPECT_CALL(*m_y_sig, sample()).WillOnce(Return(m_sample_values_0[ii % m_sample_values_0.size()]));
+        EXPECT_CALL(*y_sig_1, sample()).WillOnce(Return(m_sample_values_1[ii]));
+        EXPECT_CALL(*y_sig_2, sample()).WillOnce(Return(m_sample_values_2[ii]));
+        result_2 = sig_2->sample();
+        result_0 = sig_0->sample();
+        result_1 = sig_1->sample();
+        if (ii == 0) {
+            EXPECT_TRUE(std::isnan(result_0));
+            EXPECT_TRUE(std::isnan(result_1));
+            EXPECT_TRUE(std::isnan(result_2));
+        }
+        else {
+            EXPECT_EQ(result_2, sig_2->sample());
+        }
+    }
+    EXPECT_NEAR(m_exp_slope_0, result_0, 0.0001);
+    EXPECT_NEAR(m_exp_slope_1, result_1, 0.0001);
+    EXPECT_NEAR(m_exp_slope_2, result_2, 0.0001);
+}
+
+TEST_F(DerivativeSignalTest, read_all)
+{
+    auto y_sig_1 = std::make_shared<MockSignal>();
+    auto time_sig_2 = std::make_shared<MockSignal>();
+    auto y_sig_2 = std::make_shared<MockSignal>();
+    auto other_sig = std::make_shared<MockSignal>();
+    std::vector<std::shared_ptr<Signal> > signal = {
+        std::make_shared<DerivativeSignal>(m_time_sig, m_y_sig,
+                                           m_num_history_sample, m_sleep_time),
+        other_sig,
+        std::make_shared<DerivativeSignal>(m_time_sig, y_sig_1,
+                                           m_num_history_sample, m_sleep_time),
+        std::make_shared<DerivativeSignal>(time_sig_2, y_sig_2,
+                                           m_num_history_sample, m_sleep_time),
+    };
+    // All derivatives share one sampling loop and the shared time
+    // signal is read once per sample.
+    double time = 0.0;
+    EXPECT_CALL(*m_time_sig, read()).Times(m_num_history_sample)
+        .WillRepeatedly(InvokeWithoutArgs([&time]() {
+                    time += 1.0;
+                    return time;
+                }));
+    EXPECT_CALL(*time_sig_2, read()).Times(m_num_history_sample)
+        .WillRepeatedly(InvokeWithoutArgs([&time]() {
+                    return time;
+                }));
+    double val = 2.5;
+    EXPECT_CALL(*m_y_sig, read()).Times(m_num_history_sample)
+        .WillRepeatedly(InvokeWithoutArgs([&val]() {
+                    val += 1.0;
+                    return val;
+                }));
+    EXPECT_CALL(*y_sig_1, read()).Times(m_num_history_sample)
+        .WillRepeatedly(Return(7.7));
+    size_t ii = 0;
+    EXPECT_CALL(*y_sig_2, read()).Times(m_num_history_sample)
+        .WillRepeatedly(InvokeWithoutArgs([this, &ii]() {
+                    return m_sample_values_2[ii++];
+                }));
+    EXPECT_CALL(*other_sig, read()).WillOnce(Return(42.0));
+    std::vector<double> result = DerivativeSignal::read_all(signal);
+    ASSERT_EQ(4ULL, result.size());
+    EXPECT_NEAR(m_exp_slope_1, result[0], 0.0001);
+    EXPECT_EQ(42.0, result[1]);
+    EXPECT_NEAR(m_exp_slope_0, result[2], 0.0001);
+    EXPECT_NEAR(m_exp_slope_2, result[3], 0.001);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "geopm_hash.h"
+#include "geopm_hash_backend.h"
+#include "geopm_error.h"
+#include "geopm_time.h"
+#include "geopm_test.hpp"
+
+class GEOPMHashTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        std::vector<int> m_backends;
+        std::vector<std::string> m_keys;
+};
+
+void GEOPMHashTest::SetUp(void)
+{
+    for (int backend = 0; backend < GEOPM_NUM_HASH_BACKEND; ++backend) {
+        if (geopm_hash_backend_is_supported(backend)) {
+            m_backends.push_back(backend);
+        }
+    }
+    // Lengths that cover the partial word tail and the interleaved
+    // stream blocks of the hardware path.
+    srand(42);
+    for (size_t length = 0; length < 1024; length += 1 + length / 16) {
+        std::string key(length, ' ');
+        for (auto &cc : key) {
+            cc = 1 + rand() % 255;
+        }
+        m_keys.push_back(key);
+    }
+}
+
+TEST_F(GEOPMHashTest, known_values)
+{
+    EXPECT_TRUE(geopm_hash_backend_is_supported(GEOPM_HASH_BACKEND_SOFTWARE));
+    EXPECT_TRUE(geopm_hash_backend_is_supported(geopm_hash_backend()));
+    EXPECT_FALSE(geopm_hash_backend_is_supported(GEOPM_NUM_HASH_BACKEND));
+    for (int backend : m_backends) {
+        EXPECT_EQ((uint64_t)GEOPM_REGION_HASH_UNMARKED,
+                  geopm_crc32_str_len_backend(backend, "GEOPM_REGION_HASH_UNMARKED", 26)) << backend;
+        EXPECT_EQ((uint64_t)GEOPM_REGION_HASH_EPOCH,
+                  geopm_crc32_str_len_backend(backend, "GEOPM_REGION_HASH_EPOCH", 23)) << backend;
+        EXPECT_EQ((uint64_t)GEOPM_REGION_HASH_APP,
+                  geopm_crc32_str_len_backend(backend, "GEOPM_REGION_HASH_APP", 21)) << backend;
+        EXPECT_EQ(0ULL, geopm_crc32_str_len_backend(backend, "", 0)) << backend;
+    }
+    EXPECT_EQ((uint64_t)GEOPM_REGION_HASH_UNMARKED, geopm_crc32_str("GEOPM_REGION_HASH_UNMARKED"));
+}
+
+TEST_F(GEOPMHashTest, backend_equality)
+{
+    for (const auto &key : m_keys) {
+        uint64_t expect = geopm_crc32_str_len_backend(GEOPM_HASH_BACKEND_SOFTWARE,
+                                                      key.c_str(), key.size());
+        EXPECT_EQ(expect, geopm_crc32_str(key.c_str())) << key.size();
+        EXPECT_EQ(expect, geopm_crc32_str_len(key.c_str(), key.size())) << key.size();
+        for (int backend : m_backends) {
+            EXPECT_EQ(expect, geopm_crc32_str_len_backend(backend, key.c_str(), key.size()))
+                << "backend: " << backend << " length: " << key.size();
+        }
+        // Only the first length characters are hashed
+        std::string prefix = key.substr(0, key.size() / 2);
+        EXPECT_EQ(geopm_crc32_str(prefix.c_str()),
+                  geopm_crc32_str_len(key.c_str(), prefix.size())) << key.size();
+    }
+    uint64_t word = 0x0123456789abcdefULL;
+    uint64_t expect = geopm_crc32_u64_backend(GEOPM_HASH_BACKEND_SOFTWARE, 0xfedcba98ULL, word);
+    EXPECT_EQ(expect, geopm_crc32_u64(0xfedcba98ULL, word));
+    for (int backend : m_backends) {
+        EXPECT_EQ(expect, geopm_crc32_u64_backend(backend, 0xfedcba98ULL, word)) << backend;
+    }
+}
+
+TEST_F(GEOPMHashTest, batch)
+{
+    std::vector<const char *> key_ptr;
+    std::vector<size_t> length;
+    std::vector<uint64_t> expect;
+    for (const auto &key : m_keys) {
+        key_ptr.push_back(key.c_str());
+        length.push_back(key.size());
+        expect.push_back(geopm_crc32_str(key.c_str()));
+    }
+    std::vector<uint64_t> hash(m_keys.size());
+    EXPECT_EQ(0, geopm_crc32_str_batch(key_ptr.size(), key_ptr.data(),
+                                       length.data(), hash.data()));
+    EXPECT_EQ(expect, hash);
+    std::fill(hash.begin(), hash.end(), 0);
+    EXPECT_EQ(0, geopm_crc32_str_batch(key_ptr.size(), key_ptr.data(),
+                                       nullptr, hash.data()));
+    EXPECT_EQ(expect, hash);
+    for (int backend : m_backends) {
+        // Every remainder of keys that are interleaved in groups
+        for (size_t num_key = 0; num_key < 8; ++num_key) {
+            std::fill(hash.begin(), hash.end(), 0);
+            EXPECT_EQ(0, geopm_crc32_str_batch_backend(backend, num_key, key_ptr.data(),
+                                                       length.data(), hash.data()));
+            EXPECT_EQ(std::vector<uint64_t>(expect.begin(), expect.begin() + num_key),
+                      std::vector<uint64_t>(hash.begin(), hash.begin() + num_key));
+        }
+        std::fill(hash.begin(), hash.end(), 0);
+        EXPECT_EQ(0, geopm_crc32_str_batch_backend(backend, key_ptr.size(), key_ptr.data(),
+                                                   length.data(), hash.data()));
+        EXPECT_EQ(expect, hash);
+        EXPECT_EQ(GEOPM_ERROR_INVALID,
+                  geopm_crc32_str_batch_backend(backend, key_ptr.size(), key_ptr.data(),
+                                                nullptr, hash.data()));
+    }
+    EXPECT_EQ(GEOPM_ERROR_INVALID,
+              geopm_crc32_str_batch(key_ptr.size(), nullptr, nullptr, hash.data()));
+    EXPECT_EQ(GEOPM_ERROR_INVALID,
+              geopm_crc32_str_batch(key_ptr.size(), key_ptr.data(), nullptr, nullptr));
+}
+
+TEST_F(GEOPMHashTest, performance)
+{
+    GEOPM_TEST_EXTENDED("Requires accurate timing");
+
+    const int num_rep = 10000;
+    for (size_t length : {16, 48, 128, 512, 4096}) {
+        std::vector<std::string> keys(64, std::string(length, 'x'));
+        std::vector<const char *> key_ptr;
+        std::vector<size_t> key_length;
+        for (size_t key_idx = 0; key_idx < keys.size(); ++key_idx) {
+            keys[key_idx][key_idx % length] = 'a' + key_idx % 26;
+            key_ptr.push_back(keys[key_idx].c_str());
+            key_length.push_back(length);
+        }
+        std::vector<uint64_t> hash(keys.size());
+        for (int backend : m_backends) {
+            geopm_time_s time_0;
+            geopm_time(&time_0);
+            for (int rep = 0; rep < num_rep; ++rep) {
+                for (size_t key_idx = 0; key_idx < keys.size(); ++key_idx) {
+                    hash[key_idx] = geopm_crc32_str_len_backend(backend, key_ptr[key_idx], length);
+                }
+            }
+            double single_time = geopm_time_since(&time_0) / (num_rep * keys.size());
+            geopm_time(&time_0);
+            for (int rep = 0; rep < num_rep; ++rep) {
+                geopm_crc32_str_batch_backend(backend, keys.size(), key_ptr.data(),
+                                              key_length.data(), hash.data());
+            }
+            double batch_time = geopm_time_since(&time_0) / (num_rep * keys.size());
+            std::cout << "backend: " << backend << " length: " << length
+                      << " single (ns): " << single_time * 1e9
+                      << " batch (ns): " << batch_time * 1e9 << "\n";
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "LazyIOGroup.hpp"
+#include "MockIOGroup.hpp"
+#include "geopm/Agg.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_test.hpp"
+#include "geopm_topo.h"
+
+using geopm::Agg;
+using geopm::IOGroup;
+using geopm::LazyIOGroup;
+using ::testing::Return;
+
+class LazyIOGroupTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        std::unique_ptr<LazyIOGroup> m_group;
+        MockIOGroup *m_iogroup;
+        int m_num_make;
+};
+
+void LazyIOGroupTest::SetUp()
+{
+    m_iogroup = nullptr;
+    m_num_make = 0;
+    std::map<std::string, LazyIOGroup::signal_s> signal = {
+        {"LAZY::ENERGY", {GEOPM_DOMAIN_PACKAGE, IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE,
+                          Agg::M_SUM, geopm::STRING_FORMAT_DOUBLE}},
+        {"LAZY::HASH", {GEOPM_DOMAIN_CPU, IOGroup::M_SIGNAL_BEHAVIOR_LABEL,
+                        Agg::M_REGION_HASH, geopm::STRING_FORMAT_HEX}},
+    };
+    std::map<std::string, int> control = {
+        {"LAZY::LIMIT", GEOPM_DOMAIN_BOARD},
+    };
+    m_group = geopm::make_unique<LazyIOGroup>(
+        "LAZY", signal, control,
+        [this]() {
+            ++m_num_make;
+            auto result = geopm::make_unique<MockIOGroup>();
+            m_iogroup = result.get();
+            EXPECT_CALL(*m_iogroup, push_signal("LAZY::ENERGY", GEOPM_DOMAIN_PACKAGE, 0))
+                .WillOnce(Return(3));
+            EXPECT_CALL(*m_iogroup, read_batch());
+            EXPECT_CALL(*m_iogroup, sample(3)).WillOnce(Return(42.0));
+            EXPECT_CALL(*m_iogroup, signal_description("LAZY::ENERGY"))
+                .WillOnce(Return("energy"));
+            return std::unique_ptr<IOGroup>(std::move(result));
+        });
+}
+
+TEST_F(LazyIOGroupTest, describe_without_load)
+{
+    EXPECT_EQ("LAZY", m_group->name());
+    EXPECT_EQ(std::set<std::string>({"LAZY::ENERGY", "LAZY::HASH"}), m_group->signal_names());
+    EXPECT_EQ(std::set<std::string>({"LAZY::LIMIT"}), m_group->control_names());
+    EXPECT_TRUE(m_group->is_valid_signal("LAZY::HASH"));
+    EXPECT_FALSE(m_group->is_valid_signal("LAZY::LIMIT"));
+    EXPECT_TRUE(m_group->is_valid_control("LAZY::LIMIT"));
+    EXPECT_FALSE(m_group->is_valid_control("LAZY::ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, m_group->signal_domain_type("LAZY::ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, m_group->signal_domain_type("LAZY::LIMIT"));
+    EXPECT_EQ(GEOPM_DOMAIN_BOARD, m_group->control_domain_type("LAZY::LIMIT"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, m_group->control_domain_type("LAZY::HASH"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_LABEL, m_group->signal_behavior("LAZY::HASH"));
+    EXPECT_EQ(Agg::M_REGION_HASH, Agg::function_to_type(m_group->agg_function("LAZY::HASH")));
+    EXPECT_EQ(geopm::STRING_FORMAT_HEX,
+              geopm::string_format_function_to_type(m_group->format_function("LAZY::HASH")));
+    GEOPM_EXPECT_THROW_MESSAGE(m_group->agg_function("LAZY::LIMIT"),
+                               GEOPM_ERROR_INVALID, "not valid for LAZY IOGroup");
+    // Nothing was pushed, so there is nothing to read or write
+    m_group->read_batch();
+    m_group->write_batch();
+    EXPECT_FALSE(m_group->is_loaded());
+    EXPECT_EQ(0, m_num_make);
+}
+
+TEST_F(LazyIOGroupTest, load_on_use)
+{
+    EXPECT_EQ(3, m_group->push_signal("LAZY::ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_TRUE(m_group->is_loaded());
+    m_group->read_batch();
+    EXPECT_EQ(42.0, m_group->sample(3));
+    EXPECT_EQ("energy", m_group->signal_description("LAZY::ENERGY"));
+    EXPECT_EQ(1, m_num_make);
+}
+
+TEST_F(LazyIOGroupTest, save_restore_without_controls)
+{
+    LazyIOGroup group("LAZY", {}, {},
+        [this]() {
+            ++m_num_make;
+            return geopm::make_unique<MockIOGroup>();
+        });
+    group.save_control();
+    group.restore_control();
+    group.save_control("/tmp");
+    group.restore_control("/tmp");
+    EXPECT_FALSE(group.is_loaded());
+    EXPECT_EQ(0, m_num_make);
+}
+
+TEST_F(LazyIOGroupTest, load_failure)
+{
+    LazyIOGroup group("LAZY",
+        {{"LAZY::ENERGY", {GEOPM_DOMAIN_PACKAGE, IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE,
+                           Agg::M_SUM, geopm::STRING_FORMAT_DOUBLE}}},
+        {{"LAZY::LIMIT", GEOPM_DOMAIN_BOARD}},
+        [this]() -> std::unique_ptr<IOGroup> {
+            ++m_num_make;
+            throw geopm::Exception("LazyIOGroupTest: permission denied",
+                                   GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        });
+    EXPECT_TRUE(group.is_valid_control("LAZY::LIMIT"));
+    // Saving the controls does not fail if the IOGroup cannot be
+    // constructed
+    group.save_control();
+    EXPECT_FALSE(group.is_loaded());
+    EXPECT_EQ(1, m_num_make);
+    // The construction is not attempted again and the names are no
+    // longer provided
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("LAZY::ENERGY", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_RUNTIME, "permission denied");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("LAZY::ENERGY", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_RUNTIME, "permission denied");
+    group.restore_control();
+    EXPECT_EQ(1, m_num_make);
+    EXPECT_TRUE(group.signal_names().empty());
+    EXPECT_TRUE(group.control_names().empty());
+    EXPECT_FALSE(group.is_valid_signal("LAZY::ENERGY"));
+    EXPECT_FALSE(group.is_valid_control("LAZY::LIMIT"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group.signal_domain_type("LAZY::ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group.control_domain_type("LAZY::LIMIT"));
+}
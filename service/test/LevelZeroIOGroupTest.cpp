@@ -351,14 +351,17 @@ TEST_F(LevelZeroIOGroupTest, read_signal_and_batch)
 
     for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
         EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy_chip.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, energy_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_time_chip.at(sub_idx)));
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy_chip.at(sub_idx), mock_time_chip.at(sub_idx))));
         batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_CORE_ENERGY", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
     }
 
     for (int gpu_idx = 0; gpu_idx < m_num_gpu; ++gpu_idx) {
         EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy.at(gpu_idx)));
         // Since GPU_ENERGY is in m_special_signal_set, GPU_ENERGY_TIMESTAMP is automatically pushed under the hood.
-        EXPECT_CALL(*m_device_pool, energy_timestamp(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_time.at(gpu_idx)));
+        // Both are served by a single energy_pair() query per batch.
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy.at(gpu_idx), mock_time.at(gpu_idx))));
         batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_ENERGY", GEOPM_DOMAIN_GPU, gpu_idx));
     }
 
@@ -404,6 +407,8 @@ TEST_F(LevelZeroIOGroupTest, read_signal_and_batch)
         EXPECT_CALL(*m_device_pool, frequency_status(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_freq.at(sub_idx)));
         EXPECT_CALL(*m_device_pool, frequency_throttle_reasons(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_throttle.at(sub_idx)));
         EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy_chip.at(sub_idx)));
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy_chip.at(sub_idx), mock_time_chip.at(sub_idx))));
     }
 
     for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
@@ -412,6 +417,8 @@ TEST_F(LevelZeroIOGroupTest, read_signal_and_batch)
 
     for (int gpu_idx = 0; gpu_idx < m_num_gpu; ++gpu_idx) {
         EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy.at(gpu_idx)));
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy.at(gpu_idx), mock_time.at(gpu_idx))));
     }
 
     levelzero_io.read_batch();
@@ -469,12 +476,12 @@ TEST_F(LevelZeroIOGroupTest, read_timestamp_batch_reverse)
     LevelZeroIOGroup levelzero_io(*m_platform_topo, *m_device_pool, nullptr);
 
     for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_active_time.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_active_time_compute.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY)).WillRepeatedly(Return(mock_active_time_copy.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_active_time_timestamp.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_active_time_timestamp_compute.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY)).WillRepeatedly(Return(mock_active_time_timestamp_copy.at(sub_idx)));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_active_time.at(sub_idx), mock_active_time_timestamp.at(sub_idx))));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE))
+            .WillOnce(Return(std::make_pair(mock_active_time_compute.at(sub_idx), mock_active_time_timestamp_compute.at(sub_idx))));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY))
+            .WillOnce(Return(std::make_pair(mock_active_time_copy.at(sub_idx), mock_active_time_timestamp_copy.at(sub_idx))));
 
         active_time_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_ACTIVE_TIME_TIMESTAMP", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
         active_time_compute_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_CORE_ACTIVE_TIME_TIMESTAMP", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
@@ -482,8 +489,8 @@ TEST_F(LevelZeroIOGroupTest, read_timestamp_batch_reverse)
     }
 
     for (int gpu_idx = 0; gpu_idx < m_num_gpu; ++gpu_idx) {
-        EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy.at(gpu_idx)));
-        EXPECT_CALL(*m_device_pool, energy_timestamp(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy_timestamp.at(gpu_idx)));
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy.at(gpu_idx), mock_energy_timestamp.at(gpu_idx))));
 
         energy_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_ENERGY_TIMESTAMP", GEOPM_DOMAIN_GPU, gpu_idx));
     }
@@ -539,12 +546,12 @@ TEST_F(LevelZeroIOGroupTest, read_timestamp_batch)
     LevelZeroIOGroup levelzero_io(*m_platform_topo, *m_device_pool, nullptr);
 
     for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_active_time.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_active_time_compute.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY)).WillRepeatedly(Return(mock_active_time_copy.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_active_time_timestamp.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE)).WillRepeatedly(Return(mock_active_time_timestamp_compute.at(sub_idx)));
-        EXPECT_CALL(*m_device_pool, active_time_timestamp(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY)).WillRepeatedly(Return(mock_active_time_timestamp_copy.at(sub_idx)));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_active_time.at(sub_idx), mock_active_time_timestamp.at(sub_idx))));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE))
+            .WillOnce(Return(std::make_pair(mock_active_time_compute.at(sub_idx), mock_active_time_timestamp_compute.at(sub_idx))));
+        EXPECT_CALL(*m_device_pool, active_time_pair(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_MEMORY))
+            .WillOnce(Return(std::make_pair(mock_active_time_copy.at(sub_idx), mock_active_time_timestamp_copy.at(sub_idx))));
 
         active_time_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_ACTIVE_TIME", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
         active_time_compute_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_CORE_ACTIVE_TIME", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
@@ -552,8 +559,8 @@ TEST_F(LevelZeroIOGroupTest, read_timestamp_batch)
     }
 
     for (int gpu_idx = 0; gpu_idx < m_num_gpu; ++gpu_idx) {
-        EXPECT_CALL(*m_device_pool, energy(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy.at(gpu_idx)));
-        EXPECT_CALL(*m_device_pool, energy_timestamp(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL)).WillRepeatedly(Return(mock_energy_timestamp.at(gpu_idx)));
+        EXPECT_CALL(*m_device_pool, energy_pair(GEOPM_DOMAIN_GPU, gpu_idx, MockLevelZero::M_DOMAIN_ALL))
+            .WillOnce(Return(std::make_pair(mock_energy.at(gpu_idx), mock_energy_timestamp.at(gpu_idx))));
 
         energy_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_ENERGY", GEOPM_DOMAIN_GPU, gpu_idx));
     }
@@ -587,6 +594,38 @@ TEST_F(LevelZeroIOGroupTest, read_timestamp_batch)
     }
 }
 
+TEST_F(LevelZeroIOGroupTest, read_batch_query_once)
+{
+    SetUpDefaultExpectCalls();
+    std::vector<double> mock_freq_min = {200, 300, 400, 500, 600, 700, 800, 900};
+    std::vector<double> mock_freq_max = {1200, 1300, 1400, 1500, 1600, 1700, 1800, 1900};
+    std::vector<int> min_batch_idx;
+    std::vector<int> max_batch_idx;
+
+    LevelZeroIOGroup levelzero_io(*m_platform_topo, *m_device_pool, nullptr);
+
+    for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
+        min_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_CORE_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
+        max_batch_idx.push_back(levelzero_io.push_signal("LEVELZERO::GPU_CORE_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_GPU_CHIP, sub_idx));
+    }
+
+    // The min and max signals share one frequency_range() query per batch
+    for (int batch = 0; batch < 2; ++batch) {
+        for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
+            EXPECT_CALL(*m_device_pool, frequency_range(GEOPM_DOMAIN_GPU_CHIP, sub_idx, MockLevelZero::M_DOMAIN_COMPUTE))
+                .WillOnce(Return(std::make_pair(mock_freq_min.at(sub_idx) + batch,
+                                                mock_freq_max.at(sub_idx) + batch)));
+        }
+        levelzero_io.read_batch();
+        for (int sub_idx = 0; sub_idx < m_num_gpu_subdevice; ++sub_idx) {
+            EXPECT_DOUBLE_EQ((mock_freq_min.at(sub_idx) + batch) * 1e6,
+                             levelzero_io.sample(min_batch_idx.at(sub_idx)));
+            EXPECT_DOUBLE_EQ((mock_freq_max.at(sub_idx) + batch) * 1e6,
+                             levelzero_io.sample(max_batch_idx.at(sub_idx)));
+        }
+    }
+}
+
 TEST_F(LevelZeroIOGroupTest, read_signal)
 {
     SetUpDefaultExpectCalls();
@@ -27,10 +27,12 @@
 #include "geopm_hash.h"
 #include "geopm_field.h"
 #include "geopm/Helper.hpp"
+#include "geopm/PlatformIO.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "MSRIOImp.hpp"
 #include "MSR.hpp"
 #include "geopm/Exception.hpp"
+#include "geopm/Agg.hpp"
 #include "geopm/PluginFactory.hpp"
 #include "geopm/MSRIOGroup.hpp"
 #include "MockPlatformTopo.hpp"
@@ -582,6 +584,62 @@ TEST_F(MSRIOGroupTest, read_signal_counter)
     EXPECT_EQ(66666, result);
 }
 
+TEST_F(MSRIOGroupTest, read_signals_batch)
+{
+    uint64_t status_offset = 0x198;
+    uint64_t limit_offset = 0x1ad;
+    int batch_ctx = 5;
+    std::vector<geopm_request_s> request = {
+        {GEOPM_DOMAIN_CPU, 0, "MSR::PERF_STATUS:FREQ"},
+        {GEOPM_DOMAIN_PACKAGE, 0, "CPU_FREQUENCY_MAX_AVAIL"},
+    };
+    // Both MSRs are read with one batch operation
+    EXPECT_CALL(*m_msrio, create_batch_context()).WillOnce(Return(batch_ctx));
+    EXPECT_CALL(*m_msrio, add_read(0, status_offset, batch_ctx)).WillOnce(Return(0));
+    EXPECT_CALL(*m_msrio, add_read(0, limit_offset, batch_ctx)).WillOnce(Return(1));
+    EXPECT_CALL(*m_msrio, read_batch(batch_ctx));
+    EXPECT_CALL(*m_msrio, sample(0, batch_ctx)).WillOnce(Return(0xD00));
+    EXPECT_CALL(*m_msrio, sample(1, batch_ctx)).WillOnce(Return(0xF));
+    EXPECT_CALL(*m_msrio, release_batch_context(batch_ctx));
+    std::vector<double> result = m_msrio_group->read_signals(request);
+    EXPECT_EQ(std::vector<double>({1.3e9, 1.5e9}), result);
+
+    request.push_back({GEOPM_DOMAIN_CPU, 0, "MSR::PERF_STATUS:INVALID"});
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->read_signals(request),
+                               GEOPM_ERROR_INVALID, "not found");
+}
+
+TEST_F(MSRIOGroupTest, write_controls_batch)
+{
+    uint64_t perf_ctl_offset = 0x199;
+    uint64_t perf_ctl_mask = 0xFF00;
+    uint64_t uncore_ratio_offset = 0x620;
+    uint64_t uncore_min_mask = 0x7F00;
+    int batch_ctx = 6;
+    std::vector<geopm_request_s> request = {
+        {GEOPM_DOMAIN_CORE, 0, "MSR::PERF_CTL:FREQ"},
+        {GEOPM_DOMAIN_PACKAGE, 0, "MSR::UNCORE_RATIO_LIMIT:MIN_RATIO"},
+    };
+    // All CPUs of each domain are staged in one batch and written once
+    EXPECT_CALL(*m_msrio, create_batch_context()).WillOnce(Return(batch_ctx));
+    for (int cpu_idx : {0, 4, 8, 12}) {
+        EXPECT_CALL(*m_msrio, add_write(cpu_idx, perf_ctl_offset, batch_ctx))
+            .WillOnce(Return(cpu_idx));
+        EXPECT_CALL(*m_msrio, adjust(cpu_idx, 0x1E00ULL, perf_ctl_mask, batch_ctx));
+    }
+    for (int cpu_idx : {0, 1, 4, 5, 8, 9, 12, 13}) {
+        EXPECT_CALL(*m_msrio, add_write(cpu_idx, uncore_ratio_offset, batch_ctx))
+            .WillOnce(Return(100 + cpu_idx));
+        EXPECT_CALL(*m_msrio, adjust(100 + cpu_idx, 0xF00ULL, uncore_min_mask, batch_ctx));
+    }
+    EXPECT_CALL(*m_msrio, write_batch(batch_ctx));
+    EXPECT_CALL(*m_msrio, release_batch_context(batch_ctx));
+    m_msrio_group->write_controls(request, {3e9, 1.5e9});
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->write_controls(request, {3e9}),
+                               GEOPM_ERROR_INVALID, "number of settings");
+}
+
 TEST_F(MSRIOGroupTest, read_signal_frequency)
 {
     uint64_t status_offset = 0x198;
@@ -1410,6 +1468,65 @@ TEST_F(MSRIOGroupTest, parse_json_msrs)
     EXPECT_TRUE(is_agg_expect_same(m_msrio_group->agg_function("MSR::MSR_TWO:FIELD_RW")));
 }
 
+TEST_F(MSRIOGroupTest, msr_table_matches_json)
+{
+    // The built-in MSRs are registered from tables generated from
+    // the JSON data files; check that the result matches the JSON.
+    char file_name[NAME_MAX] = __FILE__;
+    std::string json_dir = std::string(dirname(file_name)) + "/../docs/json_data/";
+    std::map<std::string, Json> fields;
+    std::map<std::string, std::string> raw_domain;
+    for (const std::string arch : {"arch", "skx"}) {
+        std::string err;
+        Json root = Json::parse(geopm::read_file(json_dir + "msr_data_" + arch + ".json"), err);
+        ASSERT_TRUE(err.empty()) << err;
+        for (const auto &msr : root["msrs"].object_items()) {
+            raw_domain["MSR::" + msr.first + "#"] = msr.second["domain"].string_value();
+            for (const auto &field : msr.second["fields"].object_items()) {
+                fields["MSR::" + msr.first + ":" + field.first] = field.second;
+            }
+        }
+    }
+    for (const auto &raw : raw_domain) {
+        // HWP signals are removed when HWP is not enabled
+        if (!m_msrio_group->is_valid_signal(raw.first)) {
+            EXPECT_TRUE(geopm::string_begins_with(raw.first, "MSR::HWP")) << raw.first;
+            continue;
+        }
+        EXPECT_EQ(PlatformTopo::domain_name_to_type(raw.second),
+                  m_msrio_group->signal_domain_type(raw.first)) << raw.first;
+    }
+    int num_checked = 0;
+    for (const auto &field : fields) {
+        const std::string &name = field.first;
+        if (!m_msrio_group->is_valid_signal(name)) {
+            EXPECT_TRUE(geopm::string_begins_with(name, "MSR::HWP")) << name;
+            continue;
+        }
+        std::string raw_name = name.substr(0, name.find(':', 5)) + "#";
+        EXPECT_EQ(m_msrio_group->signal_domain_type(raw_name),
+                  m_msrio_group->signal_domain_type(name)) << name;
+        EXPECT_EQ(field.second["aggregation"].string_value(),
+                  geopm::Agg::function_to_name(m_msrio_group->agg_function(name))) << name;
+        if (!geopm::string_begins_with(name, "MSR::TURBO_RATIO_LIMIT:")) {
+            EXPECT_EQ(geopm::IOGroup::string_to_behavior(field.second["behavior"].string_value()),
+                      m_msrio_group->signal_behavior(name)) << name;
+            EXPECT_EQ(field.second["writeable"].bool_value(),
+                      m_msrio_group->is_valid_control(name)) << name;
+        }
+        std::string description = m_msrio_group->signal_description(name);
+        EXPECT_NE(std::string::npos,
+                  description.find("units: " + field.second["units"].string_value())) << name;
+        if (field.second["description"].is_string()) {
+            EXPECT_NE(std::string::npos,
+                      description.find(
+                          "description: " + field.second["description"].string_value())) << name;
+        }
+        ++num_checked;
+    }
+    EXPECT_LT(100, num_checked);
+}
+
 TEST_F(MSRIOGroupTest, batch_calls_no_push)
 {
     // Make sure calling read_batch and write batch with nothing
@@ -917,3 +917,19 @@ TEST_F(MSRIOTest, write_batch)
     EXPECT_EQ(end_words0, written_words0);
     EXPECT_EQ(end_words1, written_words1);
 }
+
+TEST_F(MSRIOTest, release_batch_context)
+{
+    int batch_ctx = m_msrio->create_batch_context();
+    EXPECT_EQ(0, m_msrio->add_read(0, 0xd28, batch_ctx));
+    EXPECT_EQ(1, m_msrio->add_read(0, 0x520, batch_ctx));
+    m_msrio->release_batch_context(batch_ctx);
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio->release_batch_context(batch_ctx),
+                               GEOPM_ERROR_INVALID, "invalid batch context");
+    // The released context is handed out again without its operations
+    EXPECT_EQ(batch_ctx, m_msrio->create_batch_context());
+    EXPECT_EQ(0, m_msrio->add_read(0, 0x520, batch_ctx));
+    EXPECT_NE(batch_ctx, m_msrio->create_batch_context());
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio->release_batch_context(0),
+                               GEOPM_ERROR_INVALID, "invalid batch context");
+}
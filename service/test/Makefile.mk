@@ -2,7 +2,9 @@
 #  SPDX-License-Identifier: BSD-3-Clause
 #
 
-check_PROGRAMS += test/geopm_test
+check_PROGRAMS += test/geopm_test \
+                  test/geopm_micro_bench \
+                  # end
 
 GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/AggTest.agg_function \
@@ -98,11 +100,13 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/DCGMIOGroupTest.push_control_adjust_write_batch \
               test/gtest_links/DCGMIOGroupTest.error_path \
               test/gtest_links/DCGMIOGroupTest.valid_signals \
+              test/gtest_links/DerivativeSignalTest.batch \
               test/gtest_links/DerivativeSignalTest.errors \
               test/gtest_links/DerivativeSignalTest.read_batch_flat \
               test/gtest_links/DerivativeSignalTest.read_batch_first \
               test/gtest_links/DerivativeSignalTest.read_batch_slope_1 \
               test/gtest_links/DerivativeSignalTest.read_batch_slope_2 \
+              test/gtest_links/DerivativeSignalTest.read_all \
               test/gtest_links/DerivativeSignalTest.read_flat \
               test/gtest_links/DerivativeSignalTest.read_slope_1 \
               test/gtest_links/DerivativeSignalTest.setup_batch \
@@ -124,6 +128,10 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/ExceptionTest.check_ronn \
               test/gtest_links/ExceptionTest.hello \
               test/gtest_links/ExceptionTest.last_message \
+              test/gtest_links/GEOPMHashTest.known_values \
+              test/gtest_links/GEOPMHashTest.backend_equality \
+              test/gtest_links/GEOPMHashTest.batch \
+              test/gtest_links/GEOPMHashTest.performance \
               test/gtest_links/GEOPMHintTest.check_hint \
               test/gtest_links/HelperTest.string_begins_with \
               test/gtest_links/HelperTest.string_ends_with \
@@ -139,6 +147,10 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/IOGroupTest.string_to_behavior \
               test/gtest_links/IOUringTest.batch_read \
               test/gtest_links/IOUringTest.batch_write \
+              test/gtest_links/LazyIOGroupTest.describe_without_load \
+              test/gtest_links/LazyIOGroupTest.load_failure \
+              test/gtest_links/LazyIOGroupTest.load_on_use \
+              test/gtest_links/LazyIOGroupTest.save_restore_without_controls \
               test/gtest_links/LevelZeroGPUTopoTest.no_gpu_config \
               test/gtest_links/LevelZeroGPUTopoTest.four_forty_config \
               test/gtest_links/LevelZeroGPUTopoTest.eight_fiftysix_affinitization_config \
@@ -161,12 +173,14 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/LevelZeroIOGroupTest.save_restore \
               test/gtest_links/LevelZeroIOGroupTest.push_control_adjust_write_batch \
               test/gtest_links/LevelZeroIOGroupTest.read_signal_and_batch \
+              test/gtest_links/LevelZeroIOGroupTest.read_batch_query_once \
               test/gtest_links/LevelZeroIOGroupTest.read_timestamp_batch \
               test/gtest_links/LevelZeroIOGroupTest.read_timestamp_batch_reverse \
               test/gtest_links/LevelZeroIOGroupTest.save_restore_control \
               test/gtest_links/MSRIOGroupTest.adjust \
               test/gtest_links/MSRIOGroupTest.control_error \
               test/gtest_links/MSRIOGroupTest.parse_json_msrs \
+              test/gtest_links/MSRIOGroupTest.msr_table_matches_json \
               test/gtest_links/MSRIOGroupTest.parse_json_msrs_error_fields \
               test/gtest_links/MSRIOGroupTest.parse_json_msrs_error_msrs \
               test/gtest_links/MSRIOGroupTest.parse_json_msrs_error_top_level \
@@ -179,6 +193,7 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/MSRIOGroupTest.read_signal_power \
               test/gtest_links/MSRIOGroupTest.read_signal_scalability \
               test/gtest_links/MSRIOGroupTest.read_signal_temperature \
+              test/gtest_links/MSRIOGroupTest.read_signals_batch \
               test/gtest_links/MSRIOGroupTest.sample \
               test/gtest_links/MSRIOGroupTest.sample_raw \
               test/gtest_links/MSRIOGroupTest.signal_error \
@@ -189,12 +204,14 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/MSRIOGroupTest.valid_signal_names \
               test/gtest_links/MSRIOGroupTest.allowlist \
               test/gtest_links/MSRIOGroupTest.write_control \
+              test/gtest_links/MSRIOGroupTest.write_controls_batch \
               test/gtest_links/MSRIOGroupTest.batch_calls_no_push \
               test/gtest_links/MSRIOGroupTest.save_restore_control \
               test/gtest_links/MSRIOGroupTest.turbo_ratio_limit_writability \
               test/gtest_links/MSRIOTest.read_aligned \
               test/gtest_links/MSRIOTest.read_batch \
               test/gtest_links/MSRIOTest.read_unaligned \
+              test/gtest_links/MSRIOTest.release_batch_context \
               test/gtest_links/MSRIOTest.write \
               test/gtest_links/MSRIOTest.write_batch \
               test/gtest_links/MSRFieldControlTest.errors \
@@ -229,6 +246,7 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/NVMLGPUTopoTest.high_cpu_count_gaps_config \
               test/gtest_links/NVMLIOGroupTest.read_signal \
               test/gtest_links/NVMLIOGroupTest.read_signal_and_batch \
+              test/gtest_links/NVMLIOGroupTest.read_batch_alias_once \
               test/gtest_links/NVMLIOGroupTest.write_control \
               test/gtest_links/NVMLIOGroupTest.push_control_adjust_write_batch \
               test/gtest_links/NVMLIOGroupTest.error_path \
@@ -242,6 +260,7 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/PlatformIOTest.agg_function \
               test/gtest_links/PlatformIOTest.domain_type \
               test/gtest_links/PlatformIOTest.is_valid_value \
+              test/gtest_links/PlatformIOTest.load_cache \
               test/gtest_links/PlatformIOTest.push_control \
               test/gtest_links/PlatformIOTest.push_control_agg \
               test/gtest_links/PlatformIOTest.push_control_iogroup_fallback \
@@ -250,11 +269,16 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/PlatformIOTest.push_signal_iogroup_fallback \
               test/gtest_links/PlatformIOTest.push_signal_iogroup_fallback_domain_change \
               test/gtest_links/PlatformIOTest.push_signal_agg \
+              test/gtest_links/PlatformIOTest.push_signal_validate_batch \
+              test/gtest_links/PlatformIOTest.push_signal_validate_rollback \
+              test/gtest_links/PlatformIOTest.push_signal_validate_convert_domain \
               test/gtest_links/PlatformIOTest.read_signal \
               test/gtest_links/PlatformIOTest.read_signal_agg \
               test/gtest_links/PlatformIOTest.read_signal_iogroup_fallback_domain_change \
               test/gtest_links/PlatformIOTest.read_signal_iogroup_fallback \
               test/gtest_links/PlatformIOTest.read_signal_override \
+              test/gtest_links/PlatformIOTest.read_signals \
+              test/gtest_links/PlatformIOTest.read_signals_iogroup_fallback \
               test/gtest_links/PlatformIOTest.sample \
               test/gtest_links/PlatformIOTest.sample_not_active \
               test/gtest_links/PlatformIOTest.sample_agg \
@@ -309,6 +333,13 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/RawMSRSignalTest.read \
               test/gtest_links/RawMSRSignalTest.read_batch \
               test/gtest_links/RawMSRSignalTest.setup_batch \
+              test/gtest_links/RequestFileTest.errors \
+              test/gtest_links/RequestFileTest.parse \
+              test/gtest_links/SampleLoopTest.binary_output \
+              test/gtest_links/SampleLoopTest.errors \
+              test/gtest_links/SampleLoopTest.interrupted \
+              test/gtest_links/SampleLoopTest.missed_deadline \
+              test/gtest_links/SampleLoopTest.text_output \
               test/gtest_links/SaveControlTest.static_json \
               test/gtest_links/SaveControlTest.static_settings \
               test/gtest_links/SaveControlTest.make_from_struct \
@@ -364,6 +395,10 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/SharedMemoryTest.default_permissions_file \
               test/gtest_links/SharedMemoryTest.secure_permissions_shm \
               test/gtest_links/SharedMemoryTest.secure_permissions_file \
+              test/gtest_links/SharedMemoryTest.placement \
+              test/gtest_links/SlidingRegressionTest.add_lane \
+              test/gtest_links/SlidingRegressionTest.degenerate \
+              test/gtest_links/SlidingRegressionTest.match_reference \
               test/gtest_links/SSTControlTest.mailbox_adjust_batch \
               test/gtest_links/SSTControlTest.mmio_adjust_batch \
               test/gtest_links/SSTControlTest.save_restore_mmio \
@@ -397,6 +432,25 @@ GTEST_TESTS = test/gtest_links/GPUTopoNullTest.default_config \
               test/gtest_links/SSTIOTest.write_mbox_once \
               test/gtest_links/SSTIOTest.write_mmio_once \
               test/gtest_links/SSTIOTest.get_punit_from_cpu \
+              test/gtest_links/SSTIOTest.package_partitioned_reads \
+              test/gtest_links/SSTIOTest.package_partitioned_reads_performance \
+              test/gtest_links/SSTIOTest.worker_affinity \
+              test/gtest_links/SysfsIOGroupTest.missing_files \
+              test/gtest_links/SysfsIOGroupTest.read_batch \
+              test/gtest_links/SysfsIOGroupTest.read_signal \
+              test/gtest_links/SysfsIOGroupTest.save_restore_control \
+              test/gtest_links/SysfsIOGroupTest.read_signal_wrap \
+              test/gtest_links/SysfsIOGroupTest.restore_frequency_order \
+              test/gtest_links/SysfsIOGroupTest.restore_unchanged \
+              test/gtest_links/SysfsIOGroupTest.valid_names \
+              test/gtest_links/SysfsIOGroupTest.write_batch \
+              test/gtest_links/SysfsIOGroupTest.write_control \
+              test/gtest_links/SysfsIOTest.parse \
+              test/gtest_links/SysfsIOTest.read \
+              test/gtest_links/SysfsIOTest.read_batch \
+              test/gtest_links/SysfsIOTest.read_batch_uring \
+              test/gtest_links/SysfsIOTest.write \
+              test/gtest_links/SysfsIOTest.write_batch_uring \
               test/gtest_links/TimeIOGroupTest.adjust \
               test/gtest_links/TimeIOGroupTest.is_valid \
               test/gtest_links/TimeIOGroupTest.push \
@@ -434,10 +488,12 @@ test_geopm_test_SOURCES = test/GPUTopoNullTest.cpp \
                           test/geopm_test.cpp \
                           test/geopm_test.hpp \
                           test/geopm_test_helper.cpp \
+                          test/GEOPMHashTest.cpp \
                           test/GEOPMHintTest.cpp \
                           test/HelperTest.cpp \
                           test/IOGroupTest.cpp \
                           test/IOUringTest.cpp \
+                          test/LazyIOGroupTest.cpp \
                           test/LevelZeroGPUTopoTest.cpp \
                           test/LevelZeroDevicePoolTest.cpp \
                           test/LevelZeroIOGroupTest.cpp \
@@ -474,15 +530,20 @@ test_geopm_test_SOURCES = test/GPUTopoNullTest.cpp \
                           test/PlatformIOTest.cpp \
                           test/PlatformTopoTest.cpp \
                           test/RawMSRSignalTest.cpp \
+                          test/RequestFileTest.cpp \
                           test/SharedMemoryTest.cpp \
+                          test/SampleLoopTest.cpp \
                           test/SaveControlTest.cpp \
                           test/SecurePathTest.cpp \
                           test/ServiceIOGroupTest.cpp \
                           test/ServiceProxyTest.cpp \
+                          test/SlidingRegressionTest.cpp \
                           test/SSTControlTest.cpp \
                           test/SSTIOGroupTest.cpp \
                           test/SSTSignalTest.cpp \
                           test/SSTIOTest.cpp \
+                          test/SysfsIOGroupTest.cpp \
+                          test/SysfsIOTest.cpp \
                           test/TimeIOGroupTest.cpp \
                           # end
 
@@ -495,6 +556,27 @@ test_geopm_test_CPPFLAGS = $(AM_CPPFLAGS) -Iplugin
 test_geopm_test_CFLAGS = $(AM_CFLAGS)
 test_geopm_test_CXXFLAGS = $(AM_CXXFLAGS)
 
+# Micro benchmarks for the code that runs every control period.  They
+# use temporary files in place of hardware and report ns/op and
+# allocations/op.  Run with "make bench" or run
+# test/geopm_micro_bench directly to pass a filter.
+test_geopm_micro_bench_SOURCES = test/geopm_micro_bench.cpp \
+                                 test/geopm_micro_bench.hpp \
+                                 test/PlatformIOBench.cpp \
+                                 test/SharedMemoryBench.cpp \
+                                 test/SignalBench.cpp \
+                                 test/SysfsBench.cpp \
+                                 # end
+
+test_geopm_micro_bench_LDADD = libgeopmd.la
+test_geopm_micro_bench_CPPFLAGS = $(AM_CPPFLAGS)
+test_geopm_micro_bench_CXXFLAGS = $(AM_CXXFLAGS)
+
+bench: test/geopm_micro_bench
+	test/geopm_micro_bench
+
+PHONY_TARGETS += bench
+
 # Target for building test programs.
 gtest-checkprogs: $(GTEST_TESTS)
 
@@ -233,6 +233,38 @@ TEST_F(NVMLIOGroupTest, read_signal_and_batch)
     }
 }
 
+TEST_F(NVMLIOGroupTest, read_batch_alias_once)
+{
+    EXPECT_CALL(*m_device_pool, is_privileged_access()).WillRepeatedly(Return(false));
+    const int num_gpu = m_platform_topo->num_domain(GEOPM_DOMAIN_GPU);
+
+    std::vector<uint64_t> mock_power = {153600, 70000, 300000, 50000};
+    std::vector<uint64_t> mock_energy = {630000, 280000, 470000, 950000};
+    std::vector<int> batch_idx;
+    std::vector<int> alias_batch_idx;
+
+    NVMLIOGroup nvml_io(*m_platform_topo, *m_device_pool, nullptr);
+
+    for (int gpu_idx = 0; gpu_idx < num_gpu; ++gpu_idx) {
+        batch_idx.push_back(nvml_io.push_signal(M_NAME_PREFIX + "GPU_POWER", GEOPM_DOMAIN_GPU, gpu_idx));
+        alias_batch_idx.push_back(nvml_io.push_signal("GPU_POWER", GEOPM_DOMAIN_GPU, gpu_idx));
+        batch_idx.push_back(nvml_io.push_signal(M_NAME_PREFIX + "GPU_ENERGY_CONSUMPTION_TOTAL", GEOPM_DOMAIN_GPU, gpu_idx));
+        alias_batch_idx.push_back(nvml_io.push_signal("GPU_ENERGY", GEOPM_DOMAIN_GPU, gpu_idx));
+    }
+    EXPECT_EQ(batch_idx, alias_batch_idx);
+
+    // A signal pushed by name and by alias is queried once per batch
+    for (int gpu_idx = 0; gpu_idx < num_gpu; ++gpu_idx) {
+        EXPECT_CALL(*m_device_pool, power(gpu_idx)).WillOnce(Return(mock_power.at(gpu_idx)));
+        EXPECT_CALL(*m_device_pool, energy(gpu_idx)).WillOnce(Return(mock_energy.at(gpu_idx)));
+    }
+    nvml_io.read_batch();
+    for (int gpu_idx = 0; gpu_idx < num_gpu; ++gpu_idx) {
+        EXPECT_DOUBLE_EQ(mock_power.at(gpu_idx) * 1e-3, nvml_io.sample(batch_idx.at(2 * gpu_idx)));
+        EXPECT_DOUBLE_EQ(mock_energy.at(gpu_idx) * 1e-3, nvml_io.sample(batch_idx.at(2 * gpu_idx + 1)));
+    }
+}
+
 TEST_F(NVMLIOGroupTest, read_signal)
 {
     EXPECT_CALL(*m_device_pool, is_privileged_access()).WillRepeatedly(Return(false));
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <list>
+#include <set>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm/Exception.hpp"
+#include "geopm/MSRIOGroup.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "geopm_topo.h"
+#include "CombinedControl.hpp"
+#include "CombinedSignal.hpp"
+#include "MSRIOImp.hpp"
+#include "MSRPath.hpp"
+#include "PlatformIOImp.hpp"
+#include "TimeIOGroup.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::Exception;
+using geopm::IOGroup;
+using geopm::MSRIOGroup;
+using geopm::MSRIOImp;
+using geopm::MSRPath;
+using geopm::PlatformIOImp;
+using geopm::PlatformTopo;
+using geopm::TimeIOGroup;
+
+namespace
+{
+    /// Two socket, 36 core, 72 CPU system.  Hyper-threads of a core
+    /// are numbered num_core apart as on Linux.  The lscpu based
+    /// PlatformTopoImp always regenerates its cache when run as root,
+    /// so the topology is described directly.
+    class BenchPlatformTopo : public PlatformTopo
+    {
+        public:
+            BenchPlatformTopo() = default;
+            virtual ~BenchPlatformTopo() = default;
+
+            int num_domain(int domain_type) const override
+            {
+                int result = 0;
+                switch (domain_type) {
+                    case GEOPM_DOMAIN_BOARD:
+                        result = 1;
+                        break;
+                    case GEOPM_DOMAIN_PACKAGE:
+                        result = M_NUM_PACKAGE;
+                        break;
+                    case GEOPM_DOMAIN_CORE:
+                        result = M_NUM_PACKAGE * M_NUM_CORE_PER_PACKAGE;
+                        break;
+                    case GEOPM_DOMAIN_CPU:
+                        result = M_NUM_PACKAGE * M_NUM_CORE_PER_PACKAGE * M_NUM_THREAD_PER_CORE;
+                        break;
+                    default:
+                        break;
+                }
+                return result;
+            }
+
+            int domain_idx(int domain_type, int cpu_idx) const override
+            {
+                int num_core = num_domain(GEOPM_DOMAIN_CORE);
+                int result = -1;
+                switch (domain_type) {
+                    case GEOPM_DOMAIN_BOARD:
+                        result = 0;
+                        break;
+                    case GEOPM_DOMAIN_PACKAGE:
+                        result = (cpu_idx % num_core) / M_NUM_CORE_PER_PACKAGE;
+                        break;
+                    case GEOPM_DOMAIN_CORE:
+                        result = cpu_idx % num_core;
+                        break;
+                    case GEOPM_DOMAIN_CPU:
+                        result = cpu_idx;
+                        break;
+                    default:
+                        throw Exception("BenchPlatformTopo::domain_idx(): unsupported domain",
+                                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                return result;
+            }
+
+            bool is_nested_domain(int inner_domain, int outer_domain) const override
+            {
+                return depth(inner_domain) >= depth(outer_domain);
+            }
+
+            std::set<int> domain_nested(int inner_domain, int outer_domain,
+                                        int outer_idx) const override
+            {
+                std::set<int> result;
+                int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
+                for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+                    if (domain_idx(outer_domain, cpu_idx) == outer_idx) {
+                        result.insert(domain_idx(inner_domain, cpu_idx));
+                    }
+                }
+                return result;
+            }
+
+        private:
+            static int depth(int domain_type)
+            {
+                int result = -1;
+                switch (domain_type) {
+                    case GEOPM_DOMAIN_BOARD:
+                        result = 0;
+                        break;
+                    case GEOPM_DOMAIN_PACKAGE:
+                        result = 1;
+                        break;
+                    case GEOPM_DOMAIN_CORE:
+                        result = 2;
+                        break;
+                    case GEOPM_DOMAIN_CPU:
+                        result = 3;
+                        break;
+                    default:
+                        break;
+                }
+                return result;
+            }
+
+            static constexpr int M_NUM_PACKAGE = 2;
+            static constexpr int M_NUM_CORE_PER_PACKAGE = 18;
+            static constexpr int M_NUM_THREAD_PER_CORE = 2;
+    };
+
+    /// Temporary files that stand in for the MSR device files of a
+    /// platform.
+    class BenchPlatformFiles
+    {
+        public:
+            BenchPlatformFiles()
+            {
+                std::string msr_space(M_MSR_SPACE_SIZE, '\0');
+                for (size_t byte_idx = 0; byte_idx < msr_space.size(); ++byte_idx) {
+                    msr_space[byte_idx] = (char)(byte_idx * 131 + 7);
+                }
+                int num_cpu = m_topo.num_domain(GEOPM_DOMAIN_CPU);
+                for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+                    m_msr_path.push_back(make_file(msr_space));
+                }
+            }
+
+            virtual ~BenchPlatformFiles()
+            {
+                for (const auto &path : m_msr_path) {
+                    unlink(path.c_str());
+                }
+            }
+
+            const PlatformTopo &topo(void) const
+            {
+                return m_topo;
+            }
+
+            const std::vector<std::string> &msr_path(void) const
+            {
+                return m_msr_path;
+            }
+
+        private:
+            static std::string make_file(const std::string &contents)
+            {
+                char path[NAME_MAX] = "/tmp/geopm_micro_bench_msr_XXXXXX";
+                int fd = mkstemp(path);
+                if (fd == -1) {
+                    throw Exception("BenchPlatformFiles: mkstemp() failed",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME,
+                                    __FILE__, __LINE__);
+                }
+                ssize_t num_write = write(fd, contents.data(), contents.size());
+                close(fd);
+                if (num_write != (ssize_t)contents.size()) {
+                    unlink(path);
+                    throw Exception("BenchPlatformFiles: write() failed",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME,
+                                    __FILE__, __LINE__);
+                }
+                return path;
+            }
+
+            // Large enough to hold every MSR offset in the SKX tables
+            static constexpr size_t M_MSR_SPACE_SIZE = 0x10000;
+            BenchPlatformTopo m_topo;
+            std::vector<std::string> m_msr_path;
+    };
+
+    class BenchMSRPath : public MSRPath
+    {
+        public:
+            BenchMSRPath(const std::vector<std::string> &msr_path)
+                : m_msr_path(msr_path)
+            {
+            }
+
+            virtual ~BenchMSRPath() = default;
+
+            std::string msr_path(int cpu_idx, int fallback_idx) override
+            {
+                return m_msr_path.at(cpu_idx);
+            }
+
+            std::string msr_batch_path(void) override
+            {
+                // Fall back to reading the per-CPU files
+                return "/dev/null/geopm_micro_bench_no_batch";
+            }
+
+        private:
+            std::vector<std::string> m_msr_path;
+    };
+
+    std::shared_ptr<MSRIOGroup> make_msr_iogroup(const BenchPlatformFiles &files)
+    {
+        auto msrio = std::make_shared<MSRIOImp>(
+            files.msr_path().size(),
+            std::make_shared<BenchMSRPath>(files.msr_path()),
+            nullptr, nullptr);
+        return std::make_shared<MSRIOGroup>(files.topo(), msrio,
+                                            MSRIOGroup::M_CPUID_SKX,
+                                            files.msr_path().size(), nullptr);
+    }
+
+    /// Push a signal for every domain of its native type and return
+    /// the batch indices.
+    template <typename io_type>
+    std::vector<int> push_all_domains(io_type &io, const PlatformTopo &topo,
+                                      const std::string &signal_name)
+    {
+        std::vector<int> result;
+        int domain_type = io.signal_domain_type(signal_name);
+        int num_domain = topo.num_domain(domain_type);
+        for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+            result.push_back(io.push_signal(signal_name, domain_type, domain_idx));
+        }
+        return result;
+    }
+}
+
+GEOPM_MICRO_BENCH(MSRIOGroup, read_batch_sample)
+{
+    auto files = std::make_shared<BenchPlatformFiles>();
+    auto group = make_msr_iogroup(*files);
+    auto signal_idx = push_all_domains(*group, files->topo(), "MSR::PERF_STATUS:FREQ");
+    auto energy_idx = push_all_domains(*group, files->topo(), "MSR::PKG_ENERGY_STATUS:ENERGY");
+    signal_idx.insert(signal_idx.end(), energy_idx.begin(), energy_idx.end());
+    return [files, group, signal_idx]() {
+        group->read_batch();
+        for (auto idx : signal_idx) {
+            group->sample(idx);
+        }
+    };
+}
+
+GEOPM_MICRO_BENCH(PlatformIO, read_batch_sample)
+{
+    auto files = std::make_shared<BenchPlatformFiles>();
+    std::list<std::shared_ptr<IOGroup> > iogroup_list {
+        std::make_shared<TimeIOGroup>(),
+        make_msr_iogroup(*files),
+    };
+    auto pio = std::make_shared<PlatformIOImp>(iogroup_list, files->topo());
+    std::vector<int> signal_idx = push_all_domains(*pio, files->topo(), "CPU_FREQUENCY_STATUS");
+    signal_idx.push_back(pio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    // Board energy is combined from the package signals
+    signal_idx.push_back(pio->push_signal("CPU_ENERGY", GEOPM_DOMAIN_BOARD, 0));
+    return [files, pio, signal_idx]() {
+        pio->read_batch();
+        for (auto idx : signal_idx) {
+            pio->sample(idx);
+        }
+    };
+}
+
+GEOPM_MICRO_BENCH(PlatformIO, push_signal_repeated)
+{
+    auto files = std::make_shared<BenchPlatformFiles>();
+    std::list<std::shared_ptr<IOGroup> > iogroup_list {
+        std::make_shared<TimeIOGroup>(),
+        make_msr_iogroup(*files),
+    };
+    auto pio = std::make_shared<PlatformIOImp>(iogroup_list, files->topo());
+    pio->push_signal("CPU_ENERGY", GEOPM_DOMAIN_BOARD, 0);
+    // Pushing a signal that is already in the batch returns the
+    // existing index
+    return [files, pio]() {
+        pio->push_signal("CPU_ENERGY", GEOPM_DOMAIN_BOARD, 0);
+    };
+}
+
+GEOPM_MICRO_BENCH(PlatformIO, adjust_write_batch)
+{
+    auto files = std::make_shared<BenchPlatformFiles>();
+    std::list<std::shared_ptr<IOGroup> > iogroup_list {
+        make_msr_iogroup(*files),
+    };
+    auto pio = std::make_shared<PlatformIOImp>(iogroup_list, files->topo());
+    // Board control fans out to every native domain
+    int control_idx = pio->push_control("MSR::PERF_CTL:FREQ", GEOPM_DOMAIN_BOARD, 0);
+    auto setting = std::make_shared<double>(1.0e9);
+    return [files, pio, control_idx, setting]() {
+        // Alternate the setting so that every write_batch() is dirty
+        *setting = *setting == 1.0e9 ? 1.1e9 : 1.0e9;
+        pio->adjust(control_idx, *setting);
+        pio->write_batch();
+    };
+}
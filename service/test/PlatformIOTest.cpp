@@ -3,8 +3,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <sys/stat.h>
+#include <unistd.h>
 #include <list>
 #include <set>
+#include <sstream>
 #include <memory>
 #include <string>
 #include <algorithm>
@@ -16,12 +19,15 @@
 #include "geopm_hash.h"
 #include "geopm_field.h"
 #include "PlatformIOImp.hpp"
+#include "TimeIOGroup.hpp"
 #include "geopm/IOGroup.hpp"
+#include "geopm/BatchIOGroup.hpp"
 #include "MockIOGroup.hpp"
 #include "MockPlatformTopo.hpp"
 #include "geopm/PlatformTopo.hpp"
 #include "geopm/Exception.hpp"
 #include "geopm/Agg.hpp"
+#include "geopm/Helper.hpp"
 #include "CombinedControl.hpp"
 #include "CombinedSignal.hpp"
 #include "geopm_test.hpp"
@@ -40,7 +46,7 @@ using ::testing::Throw;
 using ::testing::Not;
 using ::testing::IsEmpty;
 
-class PlatformIOTestMockIOGroup : public MockIOGroup
+class PlatformIOTestMockIOGroup : public MockIOGroup, public geopm::BatchIOGroup
 {
     public:
         PlatformIOTestMockIOGroup()
@@ -53,8 +59,26 @@ class PlatformIOTestMockIOGroup : public MockIOGroup
             //  registered plugins
             EXPECT_CALL(*this, is_valid_signal(_)).Times(AtLeast(0));
             EXPECT_CALL(*this, is_valid_control(_)).Times(AtLeast(0));
+            // Pushed signals are validated with read_signals(), which
+            // reads each request with read_signal() by default
+            ON_CALL(*this, read_signals(_))
+                .WillByDefault([this](const std::vector<geopm_request_s> &request)
+                               {
+                                   std::vector<double> result;
+                                   for (const auto &req : request) {
+                                       result.push_back(read_signal(req.name, req.domain_type, req.domain_idx));
+                                   }
+                                   return result;
+                               });
+            EXPECT_CALL(*this, read_signals(_)).Times(AtLeast(0));
         }
 
+        MOCK_METHOD(std::vector<double>, read_signals,
+                    (const std::vector<geopm_request_s> &request), (override));
+        MOCK_METHOD(void, write_controls,
+                    (const std::vector<geopm_request_s> &request,
+                     const std::vector<double> &setting), (override));
+
         // Set up mock behavior for the IOGroup to provide a set of signals for specific domains
         void set_valid_signals(const std::vector<std::pair<std::string, int> > &signals)
         {
@@ -245,12 +269,12 @@ TEST_F(PlatformIOTest, push_signal)
 {
     int idx = -1;
     EXPECT_EQ(0, m_platio->num_signal_pushed());
-    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(2);
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(3);
     EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
     EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
     idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0);
     EXPECT_EQ(0, idx);
-    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(2);
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(3);
     EXPECT_CALL(*m_time_iogroup, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
     EXPECT_CALL(*m_time_iogroup, read_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
     idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
@@ -287,6 +311,7 @@ TEST_F(PlatformIOTest, push_signal_agg)
     // Domain of FREQ is CPU
     m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
     EXPECT_EQ(1 + m_cpu_set0.size(), (unsigned int)m_platio->num_signal_pushed());
+    m_platio->validate_pushed();
 }
 
 TEST_F(PlatformIOTest, push_signal_iogroup_fallback)
@@ -294,7 +319,7 @@ TEST_F(PlatformIOTest, push_signal_iogroup_fallback)
     int idx = -1;
     EXPECT_EQ(0, m_platio->num_signal_pushed());
 
-    EXPECT_CALL(*m_override_iogroup, signal_domain_type("TEMP")).Times(2);
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type("TEMP")).Times(3);
     EXPECT_CALL(*m_override_iogroup, read_signal("TEMP", GEOPM_DOMAIN_BOARD, 0))
         .WillOnce(Throw(geopm::Exception("injected exception", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
 
@@ -305,23 +330,123 @@ TEST_F(PlatformIOTest, push_signal_iogroup_fallback)
     idx = m_platio->push_signal("TEMP", GEOPM_DOMAIN_BOARD, 0);
     EXPECT_EQ(1, m_platio->num_signal_pushed());
     EXPECT_EQ(0, idx);
+    m_platio->validate_pushed();
+}
+
+TEST_F(PlatformIOTest, push_signal_validate_batch)
+{
+    // All pushed signals provided by an IOGroup are probed with one
+    // call to read_signals()
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, read_signals(::testing::SizeIs(m_cpu_set_board.size())))
+        .WillOnce(Return(std::vector<double>(m_cpu_set_board.size(), 0.0)));
+    EXPECT_CALL(*m_control_iogroup, read_signal(_, _, _)).Times(0);
+    for (auto cpu : m_cpu_set_board) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu));
+        EXPECT_EQ((int)cpu, m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu));
+    }
+    // Failing entries fall back to the next IOGroup
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type("TEMP")).Times(3);
+    EXPECT_CALL(*m_override_iogroup, read_signals(::testing::SizeIs(1)))
+        .WillOnce(Throw(geopm::Exception("injected exception", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_override_iogroup, push_signal(_, _, _)).Times(0);
+    EXPECT_CALL(*m_fallback_iogroup, signal_domain_type("TEMP")).Times(2);
+    EXPECT_CALL(*m_fallback_iogroup, read_signals(::testing::SizeIs(1)))
+        .WillOnce(Return(std::vector<double>{0.0}));
+    EXPECT_CALL(*m_fallback_iogroup, push_signal("TEMP", GEOPM_DOMAIN_BOARD, 0));
+    int temp_idx = m_platio->push_signal("TEMP", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_EQ((int)m_cpu_set_board.size(), temp_idx);
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    m_platio->read_batch();
+    EXPECT_CALL(*m_fallback_iogroup, sample(0)).WillOnce(Return(42.0));
+    EXPECT_EQ(42.0, m_platio->sample(temp_idx));
 }
 
 TEST_F(PlatformIOTest, push_signal_iogroup_fallback_domain_change)
 {
     // Test that if the initial call to the override_iogroup fails (e.g. because of permissions)
     // the fallback logic is enforced and the call is routed appropriately to the control_iogroup.
-    EXPECT_CALL(*m_override_iogroup, signal_domain_type("MODE")).Times(2);
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type("MODE")).Times(3);
     EXPECT_CALL(*m_override_iogroup, read_signal("MODE", GEOPM_DOMAIN_BOARD, 0))
         .WillOnce(Throw(geopm::Exception("injected exception", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
 
     // This IOGroup should should be pruned because the native domain of the signal changed.
     EXPECT_CALL(*m_control_iogroup, signal_domain_type("MODE")).Times(AtLeast(1));
 
-    GEOPM_EXPECT_THROW_MESSAGE(m_platio->push_signal("MODE", GEOPM_DOMAIN_BOARD, 0),
+    // Reading is deferred until the pushed signals are validated
+    EXPECT_EQ(0, m_platio->push_signal("MODE", GEOPM_DOMAIN_BOARD, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->validate_pushed(),
                                GEOPM_ERROR_INVALID, "unable to read signal name \"MODE\"");
 }
 
+TEST_F(PlatformIOTest, push_signal_validate_rollback)
+{
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type(_)).Times(AtLeast(1));
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type(_)).Times(AtLeast(1));
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type(_)).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+    EXPECT_EQ(0, m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+    m_platio->validate_pushed();
+
+    // The MODE signal cannot be read, so every signal pushed since
+    // the last validation is removed
+    EXPECT_CALL(*m_override_iogroup, read_signal("MODE", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Throw(geopm::Exception("injected exception", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0)).Times(2);
+    EXPECT_EQ(1, m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_EQ(2, m_platio->push_signal("MODE", GEOPM_DOMAIN_BOARD, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->validate_pushed(),
+                               GEOPM_ERROR_INVALID, "unable to read signal name \"MODE\"");
+    EXPECT_EQ(1, m_platio->num_signal_pushed());
+
+    EXPECT_EQ(0, m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0));
+    EXPECT_EQ(1, m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    m_platio->read_batch();
+    EXPECT_EQ(2, m_platio->num_signal_pushed());
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(42.0));
+    EXPECT_EQ(42.0, m_platio->sample(1));
+}
+
+TEST_F(PlatformIOTest, push_signal_validate_convert_domain)
+{
+    // The IOGroup reports a nested native domain when the pushed
+    // signal is validated, so the signal is combined from the
+    // values in the nested domain
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type("MODE"))
+        .WillOnce(Return(GEOPM_DOMAIN_BOARD))
+        .WillOnce(Return(GEOPM_DOMAIN_BOARD))
+        .WillRepeatedly(Return(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("MODE")).Times(AtLeast(1));
+    EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_BOARD))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(std::set<int>{0, 1}));
+    EXPECT_CALL(*m_override_iogroup, agg_function("MODE"))
+        .WillOnce(Return(geopm::Agg::sum));
+    EXPECT_CALL(*m_override_iogroup, push_signal("MODE", GEOPM_DOMAIN_PACKAGE, 0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_override_iogroup, push_signal("MODE", GEOPM_DOMAIN_PACKAGE, 1))
+        .WillOnce(Return(1));
+    int mode_idx = m_platio->push_signal("MODE", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_EQ(0, mode_idx);
+    m_platio->validate_pushed();
+    EXPECT_EQ(3, m_platio->num_signal_pushed());
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    m_platio->read_batch();
+    EXPECT_CALL(*m_override_iogroup, sample(0)).WillOnce(Return(2.0));
+    EXPECT_CALL(*m_override_iogroup, sample(1)).WillOnce(Return(3.0));
+    EXPECT_EQ(5.0, m_platio->sample(mode_idx));
+}
+
 TEST_F(PlatformIOTest, push_control)
 {
     EXPECT_EQ(0, m_platio->num_control_pushed());
@@ -441,10 +566,10 @@ TEST_F(PlatformIOTest, save_restore)
 
 TEST_F(PlatformIOTest, sample)
 {
-    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(2);
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(3);
     EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", _, _));
     EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", _, _));
-    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(2);
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(3);
     EXPECT_CALL(*m_time_iogroup, push_signal("TIME", _, _));
     EXPECT_CALL(*m_time_iogroup, read_signal("TIME", _, _));
     int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_CPU, 0);
@@ -682,6 +807,60 @@ TEST_F(PlatformIOTest, read_signal_iogroup_fallback)
     EXPECT_DOUBLE_EQ(5e9, freq);
 }
 
+TEST_F(PlatformIOTest, read_signals)
+{
+    EXPECT_CALL(*m_topo, is_nested_domain(_, _)).Times(AtLeast(1));
+    EXPECT_CALL(*m_topo, domain_nested(_, _, _));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ")).WillOnce(Return(Agg::average));
+    // CPU 1 is requested directly and as part of package 0 but is
+    // read only once.
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, read_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(1e9 * (cpu)));
+    }
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(AtLeast(1));
+    EXPECT_CALL(*m_time_iogroup, read_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(2.0));
+    std::vector<geopm_request_s> request = {{GEOPM_DOMAIN_CPU, 1, "FREQ"},
+                                            {GEOPM_DOMAIN_PACKAGE, 0, "FREQ"},
+                                            {GEOPM_DOMAIN_BOARD, 0, "TIME"}};
+    std::vector<double> result = m_platio->read_signals(request);
+    ASSERT_EQ(3ULL, result.size());
+    EXPECT_DOUBLE_EQ(1e9, result[0]);
+    EXPECT_DOUBLE_EQ((0 + 1 + 4 + 5) * 1e9 / 4.0, result[1]);
+    EXPECT_DOUBLE_EQ(2.0, result[2]);
+
+    EXPECT_TRUE(m_platio->read_signals({}).empty());
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_signals({{GEOPM_DOMAIN_CPU, 0, "INVALID"}}),
+                               GEOPM_ERROR_INVALID, "signal name \"INVALID\" not found");
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_signals({{GEOPM_DOMAIN_MEMORY, 0, "TIME"}}),
+                               GEOPM_ERROR_INVALID, "domain 4 is not valid for signal \"TIME\"");
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_signals({{GEOPM_DOMAIN_CPU, -1, "FREQ"}}),
+                               GEOPM_ERROR_INVALID, "domain_idx is out of range");
+}
+
+TEST_F(PlatformIOTest, read_signals_iogroup_fallback)
+{
+    // A failed read from the override IOGroup falls back to the
+    // other IOGroup that provides the signal without affecting the
+    // requests served by other IOGroups.
+    EXPECT_CALL(*m_override_iogroup, signal_domain_type("TEMP")).Times(AtLeast(1));
+    EXPECT_CALL(*m_override_iogroup, read_signal("TEMP", GEOPM_DOMAIN_BOARD, 0))
+        .WillRepeatedly(Throw(geopm::Exception("injected exception", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_fallback_iogroup, signal_domain_type("TEMP")).Times(AtLeast(1));
+    EXPECT_CALL(*m_fallback_iogroup, read_signal("TEMP", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(5e9));
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME")).Times(AtLeast(1));
+    EXPECT_CALL(*m_time_iogroup, read_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(2.0));
+    std::vector<double> result = m_platio->read_signals({{GEOPM_DOMAIN_BOARD, 0, "TEMP"},
+                                                         {GEOPM_DOMAIN_BOARD, 0, "TIME"}});
+    ASSERT_EQ(2ULL, result.size());
+    EXPECT_DOUBLE_EQ(5e9, result[0]);
+    EXPECT_DOUBLE_EQ(2.0, result[1]);
+}
+
 TEST_F(PlatformIOTest, write_control)
 {
     // write_control will not affect pushed controls
@@ -829,3 +1008,70 @@ TEST_F(PlatformIOTest, is_valid_value)
         EXPECT_EQ(false, m_platio->is_valid_value(geopm_field_to_signal(temp)));
     }
 }
+
+TEST_F(PlatformIOTest, load_cache)
+{
+    std::string cache_path = "PlatformIOTest.load_cache";
+    std::ostringstream env;
+    for (const auto &env_name : {"GEOPM_PLUGIN_PATH",
+                                 "GEOPM_MSR_CONFIG_PATH",
+                                 "GEOPM_CONST_CONFIG_PATH"}) {
+        env << "ENV\t" << env_name << "\t" << geopm::get_env(env_name) << "\n";
+    }
+    // Describe the first IOGroup plugin and cache the others as
+    // providing nothing so that none of them are constructed
+    std::vector<std::string> iogroup_names = IOGroup::iogroup_names();
+    ASSERT_FALSE(iogroup_names.empty());
+    std::ostringstream iogroup;
+    iogroup << "IOGROUP\t" << iogroup_names[0] << "\tLAZY\n"
+            << "SIGNAL\tCACHED::SIGNAL\t" << GEOPM_DOMAIN_PACKAGE
+            << "\t" << IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE
+            << "\t" << Agg::M_AVERAGE
+            << "\t" << geopm::STRING_FORMAT_DOUBLE << "\n"
+            << "CONTROL\tCACHED::CONTROL\t" << GEOPM_DOMAIN_CPU << "\n";
+    for (size_t idx = 1; idx < iogroup_names.size(); ++idx) {
+        iogroup << "IOGROUP\t" << iogroup_names[idx] << "\tLAZY\n";
+    }
+    geopm::write_file(cache_path, env.str() + iogroup.str());
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR);
+
+    PlatformIOImp platio({}, *m_topo, cache_path);
+    EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, platio.signal_domain_type("CACHED::SIGNAL"));
+    EXPECT_EQ(GEOPM_DOMAIN_CPU, platio.control_domain_type("CACHED::CONTROL"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE, platio.signal_behavior("CACHED::SIGNAL"));
+
+    // An IOGroup that failed to load when the cache was written is
+    // constructed again
+    ASSERT_NE(iogroup_names.end(), std::find(iogroup_names.begin(), iogroup_names.end(),
+                                             geopm::TimeIOGroup::plugin_name()));
+    std::ostringstream failed;
+    for (const auto &iogroup_name : iogroup_names) {
+        failed << "IOGROUP\t" << iogroup_name
+               << (iogroup_name == geopm::TimeIOGroup::plugin_name() ? "\tFAILED\n" : "\tLAZY\n");
+    }
+    geopm::write_file(cache_path, env.str() + failed.str());
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR);
+    PlatformIOImp failed_platio({}, *m_topo, cache_path);
+    EXPECT_EQ(1u, failed_platio.signal_names().count("TIME"));
+
+    // The cache is not used if the environment differs
+    geopm::write_file(cache_path, "ENV\tGEOPM_PLUGIN_PATH\t" +
+                      geopm::get_env("GEOPM_PLUGIN_PATH") + "/invalid\n" + iogroup.str());
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR);
+    EXPECT_FALSE(m_platio->load_cache(cache_path));
+    // The cache is not used if the IOGroup plugins differ
+    geopm::write_file(cache_path, env.str() + "IOGROUP\tINVALID\tFAILED\n");
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR);
+    EXPECT_FALSE(m_platio->load_cache(cache_path));
+    // The cache is not used if it is not private to the user
+    geopm::write_file(cache_path, env.str() + iogroup.str());
+    chmod(cache_path.c_str(), S_IRUSR | S_IWUSR | S_IROTH);
+    EXPECT_FALSE(m_platio->load_cache(cache_path));
+    unlink(cache_path.c_str());
+    EXPECT_FALSE(m_platio->load_cache(cache_path));
+    // Without a cache file every IOGroup is constructed, and the
+    // IOGroups that loaded in this process are recorded for the next
+    PlatformIOImp eager_platio({}, *m_topo, cache_path);
+    EXPECT_TRUE(m_platio->load_cache(cache_path));
+    unlink(cache_path.c_str());
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "RequestFile.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_test.hpp"
+
+class RequestFileTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        std::string m_path;
+        std::vector<std::string> m_field_name;
+};
+
+void RequestFileTest::SetUp()
+{
+    m_path = "RequestFileTest_" + std::to_string(getpid());
+    m_field_name = {"SIGNAL_NAME", "DOMAIN_TYPE", "DOMAIN_INDEX"};
+}
+
+void RequestFileTest::TearDown()
+{
+    unlink(m_path.c_str());
+}
+
+TEST_F(RequestFileTest, parse)
+{
+    geopm::write_file(m_path, "# comment\n"
+                              "TIME board 0\n"
+                              "\n"
+                              "  CPU_ENERGY\tpackage   all  \n");
+    std::vector<std::string> expected = {"TIME", "board", "0",
+                                         "CPU_ENERGY", "package", "all"};
+    EXPECT_EQ(expected, geopm::read_request_file(m_path, m_field_name));
+}
+
+TEST_F(RequestFileTest, errors)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::read_request_file(m_path, m_field_name),
+                               GEOPM_ERROR_INVALID, "unable to open request file");
+    geopm::write_file(m_path, "TIME board 0\nTIME board\n");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::read_request_file(m_path, m_field_name),
+                               GEOPM_ERROR_INVALID,
+                               ":2: expected SIGNAL_NAME DOMAIN_TYPE DOMAIN_INDEX");
+    // A file without requests is rejected
+    geopm::write_file(m_path, "");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::read_request_file(m_path, m_field_name),
+                               GEOPM_ERROR_INVALID, "no requests");
+    geopm::write_file(m_path, "# comment\n\n");
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::read_request_file(m_path, m_field_name),
+                               GEOPM_ERROR_INVALID, "no requests");
+}
@@ -3,12 +3,27 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "gmock/gmock-spec-builders.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include "geopm/Helper.hpp"
+#include "geopm_test.hpp"
+#include "geopm_time.h"
 #include "MockSSTIoctl.hpp"
 #include "SSTIO.hpp"
 #include "SSTIOImp.hpp"
@@ -417,3 +432,242 @@ TEST_F(SSTIOTest, get_punit_from_cpu)
         EXPECT_EQ(cpu_punit_pair.second, sstio.get_punit_from_cpu(cpu_punit_pair.first));
     }
 }
+
+/// SSTIoctl that derives read values from the requested location,
+/// records the packages touched by each batch and the CPU affinity
+/// of the thread reading each package's MMIO batch, and optionally
+/// simulates the latency of each ioctl.
+class FakeSSTIoctl : public SSTIoctl
+{
+    public:
+        FakeSSTIoctl(const std::vector<int> &cpu_package, int batch_command_limit,
+                     std::chrono::microseconds latency)
+            : m_cpu_package(cpu_package)
+            , m_batch_command_limit(batch_command_limit)
+            , m_latency(latency)
+            , m_is_mixed_batch(false)
+            , m_failed_mmio_package(-1)
+        {
+        }
+        virtual ~FakeSSTIoctl() = default;
+        int version(geopm::sst_version_s *version) override
+        {
+            *version = DEFAULT_VERSION;
+            version->batch_command_limit = m_batch_command_limit;
+            return 0;
+        }
+        int get_cpu_id(geopm::sst_cpu_map_interface_batch_s *cpu_batch) override
+        {
+            for (uint32_t idx = 0; idx < cpu_batch->num_entries; ++idx) {
+                cpu_batch->interfaces[idx].punit_cpu = cpu_batch->interfaces[idx].cpu_index << 1;
+            }
+            return 0;
+        }
+        int mbox(sst_mbox_interface_batch_s *mbox_batch) override
+        {
+            std::set<int> package;
+            for (uint32_t idx = 0; idx < mbox_batch->num_entries; ++idx) {
+                auto &interface = mbox_batch->interfaces[idx];
+                interface.read_value = mbox_value(interface.cpu_index,
+                                                  interface.command,
+                                                  interface.subcommand);
+                package.insert(m_cpu_package[interface.cpu_index]);
+            }
+            record(package);
+            return 0;
+        }
+        int mmio(sst_mmio_interface_batch_s *mmio_batch) override
+        {
+            std::set<int> package;
+            for (uint32_t idx = 0; idx < mmio_batch->num_entries; ++idx) {
+                auto &interface = mmio_batch->interfaces[idx];
+                interface.value = mmio_value(interface.cpu_index,
+                                             interface.register_offset);
+                package.insert(m_cpu_package[interface.cpu_index]);
+            }
+            record(package);
+            record_affinity(package);
+            if (package.count(m_failed_mmio_package) != 0) {
+                errno = EIO;
+                return -1;
+            }
+            return 0;
+        }
+        static uint32_t mbox_value(uint32_t cpu_idx, uint16_t command, uint16_t subcommand)
+        {
+            return cpu_idx * 1000 + command * 10 + subcommand;
+        }
+        static uint32_t mmio_value(uint32_t cpu_idx, uint32_t register_offset)
+        {
+            return cpu_idx * 1000 + 500 + register_offset;
+        }
+        bool is_mixed_batch(void)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_is_mixed_batch;
+        }
+        void fail_mmio_package(int package)
+        {
+            m_failed_mmio_package = package;
+        }
+        std::map<int, std::set<int> > mmio_affinity(void)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_mmio_affinity;
+        }
+    private:
+        void record_affinity(const std::set<int> &package)
+        {
+            cpu_set_t cpu_mask;
+            CPU_ZERO(&cpu_mask);
+            ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_mask), &cpu_mask));
+            std::set<int> cpu_set;
+            for (int cpu_idx = 0; cpu_idx < CPU_SETSIZE; ++cpu_idx) {
+                if (CPU_ISSET(cpu_idx, &cpu_mask)) {
+                    cpu_set.insert(cpu_idx);
+                }
+            }
+            std::lock_guard<std::mutex> guard(m_lock);
+            for (int package_idx : package) {
+                m_mmio_affinity[package_idx] = cpu_set;
+            }
+        }
+        void record(const std::set<int> &package)
+        {
+            if (m_latency.count() != 0) {
+                std::this_thread::sleep_for(m_latency);
+            }
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (package.size() > 1) {
+                m_is_mixed_batch = true;
+            }
+        }
+        std::vector<int> m_cpu_package;
+        int m_batch_command_limit;
+        std::chrono::microseconds m_latency;
+        std::mutex m_lock;
+        bool m_is_mixed_batch;
+        int m_failed_mmio_package;
+        std::map<int, std::set<int> > m_mmio_affinity;
+};
+
+TEST_F(SSTIOTest, package_partitioned_reads)
+{
+    std::vector<int> cpu_package = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+    auto ioctl = std::make_shared<FakeSSTIoctl>(cpu_package, 2, std::chrono::microseconds(0));
+    SSTIOImp sstio(cpu_package.size(), ioctl, cpu_package);
+
+    // Interleave the packages and types so that each partition
+    // reorders the requests relative to the push order.
+    std::vector<int> mbox_idx;
+    std::vector<int> mmio_idx;
+    for (int rep = 0; rep < 4; ++rep) {
+        for (int cpu_idx = 11; cpu_idx >= 0; --cpu_idx) {
+            mbox_idx.push_back(sstio.add_mbox_read(cpu_idx, 0x7f, rep, 0));
+            mmio_idx.push_back(sstio.add_mmio_read(cpu_idx, 4 * rep));
+        }
+    }
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        sstio.read_batch();
+        int count = 0;
+        for (int rep = 0; rep < 4; ++rep) {
+            for (int cpu_idx = 11; cpu_idx >= 0; --cpu_idx) {
+                EXPECT_EQ(FakeSSTIoctl::mbox_value(cpu_idx, 0x7f, rep),
+                          sstio.sample(mbox_idx[count]));
+                EXPECT_EQ(FakeSSTIoctl::mmio_value(cpu_idx, 4 * rep),
+                          sstio.sample(mmio_idx[count]));
+                ++count;
+            }
+        }
+    }
+    EXPECT_FALSE(ioctl->is_mixed_batch());
+
+    // Adding a read after the first batch repartitions the requests
+    int late_idx = sstio.add_mmio_read(5, 64);
+    sstio.read_batch();
+    EXPECT_EQ(FakeSSTIoctl::mmio_value(5, 64), sstio.sample(late_idx));
+    EXPECT_EQ(FakeSSTIoctl::mbox_value(11, 0x7f, 0), sstio.sample(mbox_idx[0]));
+
+    // A failure in a worker partition is reported to the caller
+    ioctl->fail_mmio_package(2);
+    GEOPM_EXPECT_THROW_MESSAGE(sstio.read_batch(), EIO, "mmio read failed");
+    ioctl->fail_mmio_package(-1);
+    sstio.read_batch();
+    EXPECT_EQ(FakeSSTIoctl::mmio_value(5, 64), sstio.sample(late_idx));
+}
+
+TEST_F(SSTIOTest, worker_affinity)
+{
+    int num_cpu = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t old_mask;
+    CPU_ZERO(&old_mask);
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(old_mask), &old_mask));
+    if (num_cpu < 2 || num_cpu > CPU_SETSIZE ||
+        !CPU_ISSET(0, &old_mask) || !CPU_ISSET(num_cpu - 1, &old_mask)) {
+        GTEST_SKIP() << "Requires two CPUs available to the test";
+    }
+    // Split the CPUs of the host into two packages
+    std::vector<int> cpu_package;
+    std::map<int, std::set<int> > expected_affinity;
+    for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+        int package = cpu_idx < num_cpu / 2 ? 0 : 1;
+        cpu_package.push_back(package);
+        if (CPU_ISSET(cpu_idx, &old_mask)) {
+            expected_affinity[package].insert(cpu_idx);
+        }
+    }
+    auto ioctl = std::make_shared<FakeSSTIoctl>(cpu_package, 2, std::chrono::microseconds(0));
+    SSTIOImp sstio(cpu_package.size(), ioctl, cpu_package);
+    sstio.add_mbox_read(0, 0x7f, 0, 0);
+    sstio.add_mmio_read(0, 0);
+    sstio.add_mmio_read(num_cpu - 1, 0);
+
+    // The workers are created by the first read_batch() of a thread
+    // that is pinned to CPU 0 like a controller
+    auto pin_mask = geopm::make_cpu_set(num_cpu, {0});
+    ASSERT_EQ(0, pthread_setaffinity_np(pthread_self(), CPU_ALLOC_SIZE(num_cpu), pin_mask.get()));
+    sstio.read_batch();
+    ASSERT_EQ(0, pthread_setaffinity_np(pthread_self(), sizeof(old_mask), &old_mask));
+
+    // Both MMIO partitions are read by workers running on the CPUs
+    // of their package
+    EXPECT_EQ(expected_affinity, ioctl->mmio_affinity());
+}
+
+TEST_F(SSTIOTest, package_partitioned_reads_performance)
+{
+    GEOPM_TEST_EXTENDED("Requires multiple threads and timing");
+    const int num_package = 4;
+    const int num_cpu_per_package = 16;
+    const int num_iteration = 20;
+    std::vector<int> cpu_package;
+    for (int package = 0; package < num_package; ++package) {
+        cpu_package.insert(cpu_package.end(), num_cpu_per_package, package);
+    }
+    auto ioctl = std::make_shared<FakeSSTIoctl>(cpu_package, 8, std::chrono::microseconds(200));
+    SSTIOImp sstio_serial(cpu_package.size(), ioctl);
+    SSTIOImp sstio_package(cpu_package.size(), ioctl, cpu_package);
+    for (int cpu_idx = 0; cpu_idx < (int)cpu_package.size(); ++cpu_idx) {
+        sstio_serial.add_mbox_read(cpu_idx, 0x7f, 0, 0);
+        sstio_serial.add_mmio_read(cpu_idx, 0);
+        sstio_package.add_mbox_read(cpu_idx, 0x7f, 0, 0);
+        sstio_package.add_mmio_read(cpu_idx, 0);
+    }
+    sstio_serial.read_batch();
+    sstio_package.read_batch();
+
+    geopm_time_s begin;
+    geopm_time(&begin);
+    for (int iteration = 0; iteration < num_iteration; ++iteration) {
+        sstio_serial.read_batch();
+    }
+    double serial_time = geopm_time_since(&begin);
+    geopm_time(&begin);
+    for (int iteration = 0; iteration < num_iteration; ++iteration) {
+        sstio_package.read_batch();
+    }
+    double package_time = geopm_time_since(&begin);
+    std::cout << "serial read_batch:      " << serial_time / num_iteration << " s\n"
+              << "per-package read_batch: " << package_time / num_iteration << " s\n";
+    EXPECT_LT(package_time, serial_time / 2);
+}
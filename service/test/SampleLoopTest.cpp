@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "SampleLoop.hpp"
+#include "MockPlatformIO.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm_pio.h"
+#include "geopm_test.hpp"
+#include "geopm_topo.h"
+
+using geopm::SampleLoop;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class SampleLoopTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void) override;
+        void TearDown(void) override;
+        std::string read_output(void);
+        MockPlatformIO m_platform_io;
+        std::vector<geopm_request_s> m_request;
+        int m_pipe[2];
+};
+
+void SampleLoopTest::SetUp(void)
+{
+    m_request = {
+        {GEOPM_DOMAIN_BOARD, 0, "TIME"},
+        {GEOPM_DOMAIN_PACKAGE, 1, "CPU_ENERGY"},
+    };
+    ASSERT_EQ(0, pipe(m_pipe));
+    EXPECT_CALL(m_platform_io, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
+        .WillOnce(Return(0));
+    EXPECT_CALL(m_platform_io, push_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 1))
+        .WillOnce(Return(1));
+}
+
+void SampleLoopTest::TearDown(void)
+{
+    close(m_pipe[0]);
+    close(m_pipe[1]);
+}
+
+std::string SampleLoopTest::read_output(void)
+{
+    close(m_pipe[1]);
+    m_pipe[1] = -1;
+    std::string result;
+    char buffer[256];
+    ssize_t num_read = 0;
+    while ((num_read = read(m_pipe[0], buffer, sizeof(buffer))) > 0) {
+        result.append(buffer, num_read);
+    }
+    return result;
+}
+
+TEST_F(SampleLoopTest, text_output)
+{
+    EXPECT_CALL(m_platform_io, format_function("TIME"))
+        .WillOnce(Return([](double value) { return std::to_string((int)value); }));
+    EXPECT_CALL(m_platform_io, format_function("CPU_ENERGY"))
+        .WillOnce(Return([](double value) { return "E" + std::to_string((int)value); }));
+    EXPECT_CALL(m_platform_io, read_batch()).Times(3);
+    EXPECT_CALL(m_platform_io, sample(0))
+        .WillOnce(Return(1.0))
+        .WillOnce(Return(2.0))
+        .WillOnce(Return(3.0));
+    EXPECT_CALL(m_platform_io, sample(1))
+        .WillOnce(Return(10.0))
+        .WillOnce(Return(20.0))
+        .WillOnce(Return(30.0));
+    auto sample_loop = SampleLoop::make_unique(m_platform_io, m_request, GEOPM_PIO_SAMPLE_FORMAT_TEXT);
+    int num_sample = 0;
+    // A zero period never misses a deadline
+    EXPECT_EQ(0, sample_loop->run(0.0, 2, m_pipe[1], num_sample));
+    EXPECT_EQ(3, num_sample);
+    EXPECT_EQ("1,E10\n2,E20\n3,E30\n", read_output());
+}
+
+TEST_F(SampleLoopTest, binary_output)
+{
+    EXPECT_CALL(m_platform_io, format_function(_)).Times(0);
+    EXPECT_CALL(m_platform_io, read_batch()).Times(2);
+    EXPECT_CALL(m_platform_io, sample(0))
+        .WillOnce(Return(1.5))
+        .WillOnce(Return(2.5));
+    EXPECT_CALL(m_platform_io, sample(1))
+        .WillOnce(Return(10.5))
+        .WillOnce(Return(20.5));
+    auto sample_loop = SampleLoop::make_unique(m_platform_io, m_request, GEOPM_PIO_SAMPLE_FORMAT_BINARY);
+    int num_sample = 0;
+    // Whether the deadline is missed depends on the load of the test
+    // host, so only the samples are checked
+    sample_loop->run(0.01, 1, m_pipe[1], num_sample);
+    EXPECT_EQ(2, num_sample);
+    std::string output = read_output();
+    ASSERT_EQ(6 * sizeof(double), output.size());
+    std::vector<double> record(6);
+    memcpy(record.data(), output.data(), output.size());
+    EXPECT_LE(0.0, record[0]);
+    EXPECT_EQ(1.5, record[1]);
+    EXPECT_EQ(10.5, record[2]);
+    // The second read waits for the first deadline
+    EXPECT_LE(0.01, record[3]);
+    EXPECT_EQ(2.5, record[4]);
+    EXPECT_EQ(20.5, record[5]);
+}
+
+TEST_F(SampleLoopTest, missed_deadline)
+{
+    EXPECT_CALL(m_platform_io, read_batch())
+        .WillOnce(Invoke([]() { usleep(20000); }))
+        .WillRepeatedly(Return());
+    EXPECT_CALL(m_platform_io, sample(_)).WillRepeatedly(Return(0.0));
+    auto sample_loop = SampleLoop::make_unique(m_platform_io, m_request, GEOPM_PIO_SAMPLE_FORMAT_BINARY);
+    // The first read overruns the deadlines of the next two reads
+    int num_sample = 0;
+    EXPECT_EQ(2, sample_loop->run(0.005, 2, m_pipe[1], num_sample));
+    EXPECT_EQ(3, num_sample);
+    EXPECT_EQ(3 * 3 * sizeof(double), read_output().size());
+}
+
+static void sample_loop_test_handler(int signum)
+{
+    // Only interrupts clock_nanosleep()
+}
+
+TEST_F(SampleLoopTest, interrupted)
+{
+    struct sigaction action = {};
+    struct sigaction old_action = {};
+    action.sa_handler = sample_loop_test_handler;
+    ASSERT_EQ(0, sigaction(SIGALRM, &action, &old_action));
+    EXPECT_CALL(m_platform_io, read_batch()).Times(1);
+    EXPECT_CALL(m_platform_io, sample(_)).WillRepeatedly(Return(0.0));
+    auto sample_loop = SampleLoop::make_unique(m_platform_io, m_request, GEOPM_PIO_SAMPLE_FORMAT_BINARY);
+    // The signal arrives while waiting for the first deadline
+    struct itimerval timer = {{0, 0}, {0, 10000}};
+    ASSERT_EQ(0, setitimer(ITIMER_REAL, &timer, nullptr));
+    int num_sample = -1;
+    EXPECT_EQ(0, sample_loop->run(10.0, 360, m_pipe[1], num_sample));
+    EXPECT_EQ(1, num_sample);
+    EXPECT_EQ(3 * sizeof(double), read_output().size());
+    sigaction(SIGALRM, &old_action, nullptr);
+}
+
+TEST_F(SampleLoopTest, errors)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(SampleLoop::make_unique(m_platform_io, m_request, 2),
+                               GEOPM_ERROR_INVALID, "invalid output format");
+    GEOPM_EXPECT_THROW_MESSAGE(SampleLoop::make_unique(m_platform_io, {}, GEOPM_PIO_SAMPLE_FORMAT_BINARY),
+                               GEOPM_ERROR_INVALID, "at least one request");
+    auto sample_loop = SampleLoop::make_unique(m_platform_io, m_request, GEOPM_PIO_SAMPLE_FORMAT_BINARY);
+    int num_sample = 0;
+    GEOPM_EXPECT_THROW_MESSAGE(sample_loop->run(-1.0, 1, m_pipe[1], num_sample),
+                               GEOPM_ERROR_INVALID, "must not be negative");
+    GEOPM_EXPECT_THROW_MESSAGE(sample_loop->run(1.0, -1, m_pipe[1], num_sample),
+                               GEOPM_ERROR_INVALID, "must not be negative");
+    EXPECT_CALL(m_platform_io, read_batch());
+    EXPECT_CALL(m_platform_io, sample(_)).WillRepeatedly(Return(0.0));
+    GEOPM_EXPECT_THROW_MESSAGE(sample_loop->run(0.0, 0, -1, num_sample),
+                               EBADF, "failed to write output");
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "geopm/SharedMemory.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::SharedMemory;
+
+namespace
+{
+    std::string bench_key(const std::string &name)
+    {
+        return "/geopm_micro_bench_shmem_" + name + "_" + std::to_string(getpid());
+    }
+
+    struct read_state_s {
+        std::unique_ptr<SharedMemory> shmem;
+        std::vector<size_t> offset;
+        uint64_t sum;
+    };
+
+    // Read one word from every page of a 64 MiB region in a random
+    // order.  With 4 KiB pages nearly every read misses the TLB, so
+    // the difference between the default and huge page placements is
+    // the cost of the page walks.  Huge pages are only used when the
+    // tmpfs holding the region allows them (mount option huge=advise
+    // or shmem_enabled=force); run under "perf stat -e dTLB-load-misses"
+    // to confirm.
+    geopm::MicroBenchOp random_read(const std::string &name,
+                                    const SharedMemory::placement_s &placement)
+    {
+        size_t size = 64 * 1024 * 1024;
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        auto state = std::make_shared<read_state_s>();
+        state->shmem = SharedMemory::make_unique_owner(bench_key(name), size, placement);
+        state->shmem->unlink();
+        for (size_t offset = 0; offset < size; offset += page_size) {
+            state->offset.push_back(offset);
+        }
+        std::shuffle(state->offset.begin(), state->offset.end(), std::mt19937(0));
+        state->sum = 0;
+        return [state]() {
+            const char *base = (const char *)state->shmem->pointer();
+            for (auto offset : state->offset) {
+                state->sum += *(const volatile uint64_t *)(base + offset);
+            }
+        };
+    }
+
+    // Create a 4 MiB region and write every page once: the work done
+    // by the first controller period that touches a new region.
+    // Pre-faulting moves the page faults into the creation.
+    geopm::MicroBenchOp create_write(const std::string &name,
+                                     const SharedMemory::placement_s &placement)
+    {
+        size_t size = 4 * 1024 * 1024;
+        size_t page_size = sysconf(_SC_PAGESIZE);
+        std::string key = bench_key(name);
+        return [key, size, page_size, placement]() {
+            auto shmem = SharedMemory::make_unique_owner(key, size, placement);
+            shmem->unlink();
+            char *base = (char *)shmem->pointer();
+            for (size_t offset = 0; offset < size; offset += page_size) {
+                base[offset] = 1;
+            }
+        };
+    }
+}
+
+GEOPM_MICRO_BENCH(SharedMemory, random_read_64MiB)
+{
+    SharedMemory::placement_s placement;
+    placement.is_prefault = true;
+    return random_read("random_read", placement);
+}
+
+GEOPM_MICRO_BENCH(SharedMemory, random_read_64MiB_huge_page)
+{
+    SharedMemory::placement_s placement;
+    placement.is_huge_page = true;
+    placement.is_prefault = true;
+    return random_read("random_read_huge_page", placement);
+}
+
+GEOPM_MICRO_BENCH(SharedMemory, create_write_4MiB)
+{
+    return create_write("create_write", {});
+}
+
+GEOPM_MICRO_BENCH(SharedMemory, create_write_4MiB_prefault)
+{
+    SharedMemory::placement_s placement;
+    placement.is_prefault = true;
+    return create_write("create_write_prefault", placement);
+}
@@ -10,6 +10,8 @@
 #include <errno.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "geopm_error.h"
 #include "geopm/Exception.hpp"
@@ -355,3 +357,30 @@ TEST_F(SharedMemoryTest, secure_permissions_file)
     std::string key_path = construct_shm_path(m_key_file);
     secure_permissions_test(m_key_file, key_path);
 }
+
+TEST_F(SharedMemoryTest, placement)
+{
+    std::string key = m_key_shm + "-placement";
+    size_t size = 4 * 1024 * 1024;
+    SharedMemory::placement_s placement;
+    placement.is_huge_page = true;
+    placement.is_prefault = true;
+    m_shmem = SharedMemory::make_unique_owner(key, size, placement);
+    EXPECT_EQ(size, m_shmem->size());
+
+    // Every page is resident before the region is touched
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t begin = (uintptr_t)m_shmem->pointer() & ~(page_size - 1);
+    uintptr_t end = (uintptr_t)m_shmem->pointer() + size;
+    std::vector<unsigned char> is_resident((end - begin + page_size - 1) / page_size);
+    ASSERT_EQ(0, mincore((void *)begin, end - begin, is_resident.data()));
+    for (auto page : is_resident) {
+        EXPECT_EQ(1, page & 1);
+    }
+
+    // The placement does not change how users attach
+    config_shmem_u(key);
+    size_t shared_data = 0xDEADBEEFCAFED00D;
+    memcpy(m_shmem->pointer(), &shared_data, sizeof(shared_data));
+    EXPECT_EQ(0, memcmp(m_shmem_u->pointer(), &shared_data, sizeof(shared_data)));
+}
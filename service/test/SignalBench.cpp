@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <memory>
+#include <vector>
+
+#include "geopm/Agg.hpp"
+#include "CombinedSignal.hpp"
+#include "DerivativeSignal.hpp"
+#include "Signal.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::Agg;
+using geopm::CombinedSignal;
+using geopm::DerivativeSignal;
+using geopm::Signal;
+
+namespace
+{
+    /// Signal that increases by a fixed step on every sample
+    class RampSignal : public Signal
+    {
+        public:
+            RampSignal(double step)
+                : m_step(step)
+                , m_value(0.0)
+            {
+            }
+
+            virtual ~RampSignal() = default;
+
+            void setup_batch(void) override
+            {
+            }
+
+            double sample(void) override
+            {
+                m_value += m_step;
+                return m_value;
+            }
+
+            double read(void) const override
+            {
+                return m_value;
+            }
+
+        private:
+            double m_step;
+            double m_value;
+    };
+}
+
+GEOPM_MICRO_BENCH(DerivativeSignal, sample)
+{
+    auto time_sig = std::make_shared<RampSignal>(0.005);
+    auto energy_sig = std::make_shared<RampSignal>(1.5);
+    auto signal = std::make_shared<DerivativeSignal>(time_sig, energy_sig, 8, 0.005);
+    signal->setup_batch();
+    return [signal]() {
+        signal->sample();
+    };
+}
+
+GEOPM_MICRO_BENCH(CombinedSignal, sample_sum)
+{
+    auto signal = std::make_shared<CombinedSignal>(Agg::sum);
+    auto values = std::make_shared<std::vector<double> >(72, 1.5);
+    return [signal, values]() {
+        signal->sample(*values);
+    };
+}
+
+GEOPM_MICRO_BENCH(CombinedSignal, sample_average)
+{
+    auto signal = std::make_shared<CombinedSignal>(Agg::average);
+    auto values = std::make_shared<std::vector<double> >(72, 1.5);
+    return [signal, values]() {
+        signal->sample(*values);
+    };
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "SlidingRegression.hpp"
+#include "geopm_test.hpp"
+
+using geopm::SlidingRegression;
+
+class SlidingRegressionTest : public ::testing::Test
+{
+    protected:
+        /// Least squares slope over the last num_sample values
+        /// computed directly from the samples.
+        static double reference_slope(const std::vector<double> &time,
+                                      const std::vector<double> &sample,
+                                      size_t num_sample);
+        static void expect_slope_near(double expected, double actual);
+};
+
+double SlidingRegressionTest::reference_slope(const std::vector<double> &time,
+                                              const std::vector<double> &sample,
+                                              size_t num_sample)
+{
+    size_t num_fit = std::min(num_sample, time.size());
+    double result = NAN;
+    if (num_fit >= 2) {
+        size_t begin = time.size() - num_fit;
+        double A = 0.0, B = 0.0, C = 0.0, D = 0.0;
+        double E = 1.0 / num_fit;
+        for (size_t idx = begin; idx < time.size(); ++idx) {
+            double dt = time[idx] - time[begin];
+            double sig = sample[idx] - sample[begin];
+            A += dt * sig;
+            B += dt;
+            C += sig;
+            D += dt * dt;
+        }
+        double ssxx = D - B * B * E;
+        double ssxy = A - B * C * E;
+        if (ssxx != 0) {
+            result = ssxy / ssxx;
+        }
+    }
+    return result;
+}
+
+void SlidingRegressionTest::expect_slope_near(double expected, double actual)
+{
+    if (std::isnan(expected)) {
+        EXPECT_TRUE(std::isnan(actual));
+    }
+    else {
+        EXPECT_NEAR(expected, actual, 1e-6 * std::max(1.0, std::fabs(expected)));
+    }
+}
+
+TEST_F(SlidingRegressionTest, match_reference)
+{
+    // Energy counter like samples: large offset, small noisy
+    // increments, and a jittered sample period.
+    const int num_sample = 8;
+    const int num_lane = 3;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::vector<double> offset = {1.0e6, 0.0, -3.0e4};
+    std::vector<double> rate = {150.0, 0.0, -2.5};
+    SlidingRegression fit(num_sample, num_lane);
+    std::vector<double> time;
+    std::vector<std::vector<double> > sample(num_lane);
+    double curr_time = 1.0e5;
+    for (int step = 0; step < 1000; ++step) {
+        curr_time += 0.005 * (1.0 + 0.1 * noise(gen));
+        time.push_back(curr_time);
+        std::vector<double> row(num_lane);
+        for (int lane_idx = 0; lane_idx < num_lane; ++lane_idx) {
+            row[lane_idx] = offset[lane_idx] + rate[lane_idx] * (curr_time - 1.0e5) +
+                            noise(gen);
+            sample[lane_idx].push_back(row[lane_idx]);
+        }
+        fit.insert(curr_time, row.data());
+        for (int lane_idx = 0; lane_idx < num_lane; ++lane_idx) {
+            expect_slope_near(reference_slope(time, sample[lane_idx], num_sample),
+                              fit.slope(lane_idx));
+        }
+    }
+}
+
+TEST_F(SlidingRegressionTest, add_lane)
+{
+    const int num_sample = 4;
+    SlidingRegression fit(num_sample, 1);
+    std::vector<double> time;
+    std::vector<double> sample_0;
+    std::vector<double> sample_1;
+    for (int step = 0; step < 3; ++step) {
+        double row[] = {2.0 * step};
+        time.push_back(step);
+        sample_0.push_back(row[0]);
+        fit.insert(step, row);
+    }
+    EXPECT_EQ(1, fit.add_lane());
+    EXPECT_EQ(2, fit.num_lane());
+    EXPECT_TRUE(std::isnan(fit.slope(1)));
+    std::vector<double> time_1;
+    for (int step = 3; step < 20; ++step) {
+        double row[] = {2.0 * step, 1.0 * step * step};
+        time.push_back(step);
+        time_1.push_back(step);
+        sample_0.push_back(row[0]);
+        sample_1.push_back(row[1]);
+        fit.insert(step, row);
+        expect_slope_near(reference_slope(time, sample_0, num_sample), fit.slope(0));
+        expect_slope_near(reference_slope(time_1, sample_1, num_sample), fit.slope(1));
+    }
+}
+
+TEST_F(SlidingRegressionTest, degenerate)
+{
+    SlidingRegression fit(8, 1);
+    double sample = 1.0;
+    fit.insert(1.0, &sample);
+    EXPECT_TRUE(std::isnan(fit.slope(0)));
+    fit.insert(1.0, &sample);
+    EXPECT_TRUE(std::isnan(fit.slope(0)));
+    GEOPM_EXPECT_THROW_MESSAGE(fit.slope(1), GEOPM_ERROR_INVALID, "lane_idx out of range");
+    SlidingRegression empty(0, 1);
+    GEOPM_EXPECT_THROW_MESSAGE(empty.insert(1.0, &sample), GEOPM_ERROR_INVALID,
+                               "at least one sample");
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "CNLIOGroup.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::CNLIOGroup;
+using geopm::Exception;
+
+namespace
+{
+    /// Temporary directory that stands in for /sys/cray/pm_counters
+    class BenchPMCounters
+    {
+        public:
+            BenchPMCounters()
+            {
+                char path[NAME_MAX] = "/tmp/geopm_micro_bench_pm_counters_XXXXXX";
+                if (mkdtemp(path) == nullptr) {
+                    throw Exception("BenchPMCounters: mkdtemp() failed",
+                                    errno ? errno : GEOPM_ERROR_RUNTIME,
+                                    __FILE__, __LINE__);
+                }
+                m_dir = path;
+                for (const auto &file : M_FILE_CONTENTS) {
+                    std::ofstream(m_dir + "/" + file.first) << file.second;
+                }
+            }
+
+            virtual ~BenchPMCounters()
+            {
+                for (const auto &file : M_FILE_CONTENTS) {
+                    unlink((m_dir + "/" + file.first).c_str());
+                }
+                rmdir(m_dir.c_str());
+            }
+
+            const std::string &dir(void) const
+            {
+                return m_dir;
+            }
+
+            std::vector<std::pair<std::string, std::string> > unit_files(void) const
+            {
+                return {{"power", "W"}, {"energy", "J"},
+                        {"memory_power", "W"}, {"memory_energy", "J"},
+                        {"cpu_power", "W"}, {"cpu_energy", "J"},
+                        {"freshness", ""}};
+            }
+
+        private:
+            const std::vector<std::pair<std::string, std::string> > M_FILE_CONTENTS = {
+                {"power", "85 W\n"},
+                {"energy", "598732067 J\n"},
+                {"memory_power", "6 W\n"},
+                {"memory_energy", "58869289 J\n"},
+                {"cpu_power", "33 W\n"},
+                {"cpu_energy", "374953759 J\n"},
+                {"freshness", "123456\n"},
+                {"raw_scan_hz", "10\n"},
+            };
+            std::string m_dir;
+    };
+}
+
+GEOPM_MICRO_BENCH(CNLIOGroup, read_batch_sample)
+{
+    auto files = std::make_shared<BenchPMCounters>();
+    auto group = std::make_shared<CNLIOGroup>(files->dir());
+    std::vector<int> signal_idx;
+    for (const auto &name : group->signal_names()) {
+        signal_idx.push_back(group->push_signal(name, GEOPM_DOMAIN_BOARD, 0));
+    }
+    return [files, group, signal_idx]() {
+        group->read_batch();
+        for (auto idx : signal_idx) {
+            group->sample(idx);
+        }
+    };
+}
+
+// Reference for CNLIOGroup.read_batch_sample: open, parse and close
+// each of the files like the IOGroup did before it kept them open.
+GEOPM_MICRO_BENCH(CNLIOGroup, read_double_from_file)
+{
+    auto files = std::make_shared<BenchPMCounters>();
+    auto unit_files = files->unit_files();
+    for (auto &file : unit_files) {
+        file.first = files->dir() + "/" + file.first;
+    }
+    return [files, unit_files]() {
+        for (const auto &file : unit_files) {
+            geopm::read_double_from_file(file.first, file.second);
+        }
+    };
+}
@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/PlatformIO.hpp"
+#include "geopm_topo.h"
+#include "SysfsIOGroup.hpp"
+#include "SysfsIOImp.hpp"
+#include "MockPlatformTopo.hpp"
+#include "geopm_test.hpp"
+
+using geopm::SysfsIOGroup;
+using geopm::SysfsIOImp;
+using testing::_;
+using testing::AtLeast;
+
+/// SysfsIO that rejects cpufreq limits that cross each other like the
+/// kernel does, and counts the writes
+class FreqLimitSysfsIO : public geopm::SysfsIO
+{
+    public:
+        int open_file(const std::string &path, const std::string &units) override
+        {
+            int result = m_sysfs_io.open_file(path, units);
+            m_path[result] = path;
+            return result;
+        }
+        double read(int file_idx) override
+        {
+            return m_sysfs_io.read(file_idx);
+        }
+        int add_read(int file_idx) override
+        {
+            return m_sysfs_io.add_read(file_idx);
+        }
+        void read_batch(void) override
+        {
+            m_sysfs_io.read_batch();
+        }
+        double sample(int batch_idx) const override
+        {
+            return m_sysfs_io.sample(batch_idx);
+        }
+        void write(int file_idx, double value) override
+        {
+            const std::string &path = m_path.at(file_idx);
+            std::string dir = path.substr(0, path.rfind('/') + 1);
+            if (geopm::string_ends_with(path, "scaling_max_freq") &&
+                value < std::stod(geopm::read_file(dir + "scaling_min_freq"))) {
+                throw geopm::Exception("max below min", EINVAL, __FILE__, __LINE__);
+            }
+            if (geopm::string_ends_with(path, "scaling_min_freq") &&
+                value > std::stod(geopm::read_file(dir + "scaling_max_freq"))) {
+                throw geopm::Exception("min above max", EINVAL, __FILE__, __LINE__);
+            }
+            ++num_write;
+            m_sysfs_io.write(file_idx, value);
+        }
+        int add_write(int file_idx) override
+        {
+            return m_sysfs_io.add_write(file_idx);
+        }
+        void adjust(int batch_idx, double value) override
+        {
+            m_sysfs_io.adjust(batch_idx, value);
+        }
+        void write_batch(void) override
+        {
+            m_sysfs_io.write_batch();
+        }
+        int num_write = 0;
+    private:
+        SysfsIOImp m_sysfs_io;
+        std::map<int, std::string> m_path;
+};
+
+/// Builds a synthetic sysfs tree with two packages and four CPUs
+class SysfsIOGroupTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override;
+        void TearDown() override;
+        void make_dir(const std::string &path);
+        void write_file(const std::string &path, const std::string &contents);
+        void remove(const std::string &path);
+        std::unique_ptr<SysfsIOGroup> make_group(void);
+        std::string zone_path(int zone_idx) const;
+        std::string cpufreq_path(int cpu_idx) const;
+
+        const int m_num_package = 2;
+        const int m_num_core = 2;
+        const int m_num_cpu = 4;
+        std::shared_ptr<MockPlatformTopo> m_topo;
+        std::string m_root;
+        std::string m_powercap_dir;
+        std::string m_cpu_dir;
+        std::vector<std::string> m_created;
+};
+
+void SysfsIOGroupTest::SetUp()
+{
+    m_topo = make_topo(m_num_package, m_num_core, m_num_cpu);
+    EXPECT_CALL(*m_topo, num_domain(_)).Times(AtLeast(0));
+    char path[NAME_MAX] = "/tmp/SysfsIOGroupTest_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(path));
+    m_root = path;
+    m_powercap_dir = m_root + "/class/powercap";
+    m_cpu_dir = m_root + "/devices/system/cpu";
+    make_dir(m_root + "/class");
+    make_dir(m_powercap_dir);
+    make_dir(m_root + "/devices");
+    make_dir(m_root + "/devices/system");
+    make_dir(m_cpu_dir);
+    // Zones are listed in a different order than the packages
+    // they belong to.
+    for (int package_idx = 0; package_idx < m_num_package; ++package_idx) {
+        int zone_idx = m_num_package - 1 - package_idx;
+        std::string zone = zone_path(zone_idx);
+        std::string dram = zone + ":0";
+        make_dir(zone);
+        write_file(zone + "/name", "package-" + std::to_string(package_idx) + "\n");
+        write_file(zone + "/energy_uj", std::to_string(1000000 * (package_idx + 1)) + "\n");
+        write_file(zone + "/max_energy_range_uj", "262143328850\n");
+        write_file(zone + "/constraint_0_power_limit_uw", "150000000\n");
+        write_file(zone + "/constraint_0_time_window_us", "999424\n");
+        make_dir(dram);
+        write_file(dram + "/name", "dram\n");
+        write_file(dram + "/energy_uj", std::to_string(500000 * (package_idx + 1)) + "\n");
+        write_file(dram + "/max_energy_range_uj", "65712999613\n");
+    }
+    // A zone from a different control type that must be ignored
+    make_dir(m_powercap_dir + "/intel-rapl-mmio:0");
+    write_file(m_powercap_dir + "/intel-rapl-mmio:0/name", "package-0\n");
+    for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+        std::string cpu = m_cpu_dir + "/cpu" + std::to_string(cpu_idx);
+        std::string cpufreq = cpufreq_path(cpu_idx);
+        make_dir(cpu);
+        make_dir(cpufreq);
+        write_file(cpufreq + "/scaling_cur_freq", std::to_string(2000000 + cpu_idx * 100000) + "\n");
+        write_file(cpufreq + "/scaling_min_freq", "1000000\n");
+        write_file(cpufreq + "/scaling_max_freq", "3700000\n");
+        write_file(cpufreq + "/cpuinfo_min_freq", "1000000\n");
+        write_file(cpufreq + "/cpuinfo_max_freq", "3700000\n");
+    }
+}
+
+void SysfsIOGroupTest::TearDown()
+{
+    for (auto it = m_created.rbegin(); it != m_created.rend(); ++it) {
+        (void)::remove(it->c_str());
+    }
+    rmdir(m_root.c_str());
+}
+
+void SysfsIOGroupTest::make_dir(const std::string &path)
+{
+    ASSERT_EQ(0, mkdir(path.c_str(), S_IRWXU));
+    m_created.push_back(path);
+}
+
+void SysfsIOGroupTest::write_file(const std::string &path, const std::string &contents)
+{
+    bool is_new = access(path.c_str(), F_OK) != 0;
+    std::ofstream(path) << contents;
+    if (is_new) {
+        m_created.push_back(path);
+    }
+}
+
+void SysfsIOGroupTest::remove(const std::string &path)
+{
+    ASSERT_EQ(0, ::remove(path.c_str()));
+}
+
+std::unique_ptr<SysfsIOGroup> SysfsIOGroupTest::make_group(void)
+{
+    return geopm::make_unique<SysfsIOGroup>(*m_topo, m_root, std::make_shared<SysfsIOImp>());
+}
+
+std::string SysfsIOGroupTest::zone_path(int zone_idx) const
+{
+    return m_powercap_dir + "/intel-rapl:" + std::to_string(zone_idx);
+}
+
+std::string SysfsIOGroupTest::cpufreq_path(int cpu_idx) const
+{
+    return m_cpu_dir + "/cpu" + std::to_string(cpu_idx) + "/cpufreq";
+}
+
+TEST_F(SysfsIOGroupTest, valid_names)
+{
+    auto group = make_group();
+    EXPECT_EQ("SYSFS", group->name());
+    std::set<std::string> expected_controls = {
+        "SYSFS::CPU_POWER_LIMIT_CONTROL",
+        "SYSFS::CPU_POWER_TIME_WINDOW_CONTROL",
+        "SYSFS::CPU_FREQUENCY_MIN_CONTROL",
+        "SYSFS::CPU_FREQUENCY_MAX_CONTROL",
+        "CPU_POWER_LIMIT_CONTROL",
+        "CPU_POWER_TIME_WINDOW_CONTROL",
+        "CPU_FREQUENCY_MIN_CONTROL",
+        "CPU_FREQUENCY_MAX_CONTROL",
+    };
+    std::set<std::string> expected_signals = expected_controls;
+    expected_signals.insert({
+        "SYSFS::CPU_ENERGY", "SYSFS::DRAM_ENERGY",
+        "SYSFS::CPU_FREQUENCY_STATUS", "SYSFS::CPU_FREQUENCY_MIN_AVAIL",
+        "SYSFS::CPU_FREQUENCY_MAX_AVAIL",
+        "CPU_ENERGY", "DRAM_ENERGY", "CPU_FREQUENCY_STATUS",
+        "CPU_FREQUENCY_MIN_AVAIL", "CPU_FREQUENCY_MAX_AVAIL",
+    });
+    EXPECT_EQ(expected_signals, group->signal_names());
+    EXPECT_EQ(expected_controls, group->control_names());
+    for (const auto &name : expected_signals) {
+        EXPECT_TRUE(group->is_valid_signal(name)) << name;
+        EXPECT_NE(GEOPM_DOMAIN_INVALID, group->signal_domain_type(name)) << name;
+    }
+    EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, group->signal_domain_type("CPU_ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, group->control_domain_type("CPU_POWER_LIMIT_CONTROL"));
+    EXPECT_EQ(GEOPM_DOMAIN_CPU, group->control_domain_type("CPU_FREQUENCY_MAX_CONTROL"));
+    EXPECT_FALSE(group->is_valid_control("CPU_ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group->control_domain_type("CPU_ENERGY"));
+    EXPECT_FALSE(group->is_valid_signal("SYSFS::INVALID"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group->signal_domain_type("SYSFS::INVALID"));
+
+    EXPECT_EQ(geopm::IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE, group->signal_behavior("CPU_ENERGY"));
+    EXPECT_EQ(geopm::IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT,
+              group->signal_behavior("SYSFS::CPU_FREQUENCY_MAX_AVAIL"));
+    EXPECT_THAT(group->signal_description("CPU_ENERGY"),
+                testing::HasSubstr("alias_for: SYSFS::CPU_ENERGY"));
+    EXPECT_THAT(group->signal_description("SYSFS::CPU_ENERGY"),
+                testing::Not(testing::HasSubstr("alias_for")));
+    EXPECT_THAT(group->control_description("SYSFS::CPU_FREQUENCY_MAX_CONTROL"),
+                testing::HasSubstr("units: hertz"));
+    GEOPM_EXPECT_THROW_MESSAGE(group->control_description("CPU_ENERGY"),
+                               GEOPM_ERROR_INVALID, "not valid for SysfsIOGroup");
+}
+
+TEST_F(SysfsIOGroupTest, missing_files)
+{
+    // DRAM energy is only offered if every package has a DRAM zone,
+    // and cpufreq signals only if the first CPU has the file.
+    remove(zone_path(0) + ":0/name");
+    write_file(zone_path(0) + ":0/name", "core\n");
+    remove(cpufreq_path(0) + "/scaling_cur_freq");
+    auto group = make_group();
+    EXPECT_FALSE(group->is_valid_signal("DRAM_ENERGY"));
+    EXPECT_FALSE(group->is_valid_signal("SYSFS::DRAM_ENERGY"));
+    EXPECT_FALSE(group->is_valid_signal("CPU_FREQUENCY_STATUS"));
+    EXPECT_TRUE(group->is_valid_signal("CPU_ENERGY"));
+    EXPECT_TRUE(group->is_valid_control("CPU_FREQUENCY_MAX_CONTROL"));
+
+    // The files of the other CPUs are checked when they are used
+    remove(cpufreq_path(3) + "/cpuinfo_max_freq");
+    group = make_group();
+    EXPECT_TRUE(group->is_valid_signal("CPU_FREQUENCY_MAX_AVAIL"));
+    EXPECT_DOUBLE_EQ(3.7e9, group->read_signal("CPU_FREQUENCY_MAX_AVAIL", GEOPM_DOMAIN_CPU, 2));
+    EXPECT_THROW(group->read_signal("CPU_FREQUENCY_MAX_AVAIL", GEOPM_DOMAIN_CPU, 3),
+                 geopm::Exception);
+
+    // No powercap directory at all
+    std::string hidden_dir = m_root + "/class/hidden";
+    ASSERT_EQ(0, rename(m_powercap_dir.c_str(), hidden_dir.c_str()));
+    group = make_group();
+    EXPECT_FALSE(group->is_valid_signal("CPU_ENERGY"));
+    EXPECT_TRUE(group->is_valid_signal("CPU_FREQUENCY_MIN_AVAIL"));
+    ASSERT_EQ(0, rename(hidden_dir.c_str(), m_powercap_dir.c_str()));
+
+    GEOPM_EXPECT_THROW_MESSAGE(
+        SysfsIOGroup(*m_topo, m_root + "/missing", std::make_shared<SysfsIOImp>()),
+        GEOPM_ERROR_RUNTIME, "no powercap or cpufreq files are available");
+}
+
+TEST_F(SysfsIOGroupTest, read_signal)
+{
+    auto group = make_group();
+    EXPECT_DOUBLE_EQ(1.0, group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(2.0, group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(1.0, group->read_signal("SYSFS::DRAM_ENERGY", GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(150.0, group->read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_DOUBLE_EQ(0.999424, group->read_signal("CPU_POWER_TIME_WINDOW_CONTROL",
+                                                  GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_DOUBLE_EQ(2.3e9, group->read_signal("CPU_FREQUENCY_STATUS", GEOPM_DOMAIN_CPU, 3));
+    EXPECT_DOUBLE_EQ(3.7e9, group->read_signal("CPU_FREQUENCY_MAX_AVAIL", GEOPM_DOMAIN_CPU, 0));
+    EXPECT_DOUBLE_EQ(1.0e9, group->read_signal("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 2));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group->read_signal("SYSFS::INVALID", GEOPM_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not valid for SysfsIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "domain_type");
+    GEOPM_EXPECT_THROW_MESSAGE(group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 2),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+}
+
+TEST_F(SysfsIOGroupTest, read_batch)
+{
+    auto group = make_group();
+    int energy_idx = group->push_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    EXPECT_EQ(energy_idx, group->push_signal("SYSFS::CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    int freq_idx = group->push_signal("CPU_FREQUENCY_STATUS", GEOPM_DOMAIN_CPU, 1);
+    EXPECT_NE(energy_idx, freq_idx);
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_signal("CPU_FREQUENCY_STATUS", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "domain_type");
+
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(1.0, group->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(2.1e9, group->sample(freq_idx));
+
+    write_file(zone_path(1) + "/energy_uj", "262143000000\n");
+    write_file(cpufreq_path(1) + "/scaling_cur_freq", "3000000\n");
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(262143.0, group->sample(energy_idx));
+    EXPECT_DOUBLE_EQ(3.0e9, group->sample(freq_idx));
+
+    // The energy counter wraps at max_energy_range_uj
+    write_file(zone_path(1) + "/energy_uj", "671522\n");
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(262143.328850 + 0.671522, group->sample(energy_idx));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group->sample(2), GEOPM_ERROR_INVALID, "out of range");
+}
+
+TEST_F(SysfsIOGroupTest, write_control)
+{
+    auto group = make_group();
+    group->write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 2, 2.5e9);
+    EXPECT_DOUBLE_EQ(2500000, std::stod(geopm::read_file(cpufreq_path(2) + "/scaling_max_freq")));
+    EXPECT_DOUBLE_EQ(2.5e9, group->read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 2));
+    group->write_control("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_PACKAGE, 1, 120.5);
+    EXPECT_DOUBLE_EQ(120500000, std::stod(geopm::read_file(zone_path(0) + "/constraint_0_power_limit_uw")));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group->write_control("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0, 1.0),
+                               GEOPM_ERROR_INVALID, "not valid for SysfsIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(group->write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 4, 1.0e9),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+}
+
+TEST_F(SysfsIOGroupTest, write_batch)
+{
+    auto group = make_group();
+    int max_idx = group->push_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 0);
+    int min_idx = group->push_control("SYSFS::CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 0);
+    int limit_idx = group->push_control("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_PACKAGE, 0);
+    EXPECT_EQ(max_idx, group->push_control("SYSFS::CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(group->push_control("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "not valid for SysfsIOGroup");
+
+    group->adjust(max_idx, 2.8e9);
+    group->adjust(limit_idx, 100.0);
+    group->write_batch();
+    EXPECT_DOUBLE_EQ(2800000, std::stod(geopm::read_file(cpufreq_path(0) + "/scaling_max_freq")));
+    EXPECT_DOUBLE_EQ(1000000, std::stod(geopm::read_file(cpufreq_path(0) + "/scaling_min_freq")));
+    EXPECT_DOUBLE_EQ(100000000, std::stod(geopm::read_file(zone_path(1) + "/constraint_0_power_limit_uw")));
+
+    group->adjust(min_idx, 1.2e9);
+    group->write_batch();
+    EXPECT_DOUBLE_EQ(1200000, std::stod(geopm::read_file(cpufreq_path(0) + "/scaling_min_freq")));
+
+    GEOPM_EXPECT_THROW_MESSAGE(group->adjust(3, 1.0), GEOPM_ERROR_INVALID, "out of range");
+}
+
+TEST_F(SysfsIOGroupTest, save_restore_control)
+{
+    auto group = make_group();
+    group->save_control();
+    group->write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 1, 2.0e9);
+    group->write_control("CPU_POWER_TIME_WINDOW_CONTROL", GEOPM_DOMAIN_PACKAGE, 0, 0.5);
+    EXPECT_DOUBLE_EQ(2.0e9, group->read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    group->restore_control();
+    EXPECT_DOUBLE_EQ(3.7e9, group->read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    EXPECT_DOUBLE_EQ(0.999424, group->read_signal("CPU_POWER_TIME_WINDOW_CONTROL",
+                                                  GEOPM_DOMAIN_PACKAGE, 0));
+}
+
+TEST_F(SysfsIOGroupTest, read_signal_wrap)
+{
+    // Energy read with read_signal() is unwrapped like read_batch()
+    auto group = make_group();
+    write_file(zone_path(1) + "/energy_uj", "262143000000\n");
+    EXPECT_DOUBLE_EQ(262143.0, group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    write_file(zone_path(1) + "/energy_uj", "671522\n");
+    EXPECT_DOUBLE_EQ(262143.328850 + 0.671522,
+                     group->read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0));
+    int energy_idx = group->push_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 0);
+    group->read_batch();
+    EXPECT_DOUBLE_EQ(262143.328850 + 0.671522, group->sample(energy_idx));
+}
+
+TEST_F(SysfsIOGroupTest, restore_frequency_order)
+{
+    auto sysfs_io = std::make_shared<FreqLimitSysfsIO>();
+    SysfsIOGroup group(*m_topo, m_root, sysfs_io);
+    // Saved limits below the limits in effect at restore
+    group.write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 0, 1.5e9);
+    group.save_control();
+    group.write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 0, 3.7e9);
+    group.write_control("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 0, 3.0e9);
+    group.restore_control();
+    EXPECT_DOUBLE_EQ(1.0e9, group.read_signal("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 0));
+    EXPECT_DOUBLE_EQ(1.5e9, group.read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 0));
+
+    // Saved limits above the limits in effect at restore
+    group.write_control("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 1, 3.0e9);
+    group.save_control();
+    group.write_control("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 1, 1.0e9);
+    group.write_control("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 1, 1.2e9);
+    group.restore_control();
+    EXPECT_DOUBLE_EQ(3.0e9, group.read_signal("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    EXPECT_DOUBLE_EQ(3.7e9, group.read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 1));
+
+    // The same ordering applies to write_controls()
+    std::vector<geopm_request_s> request = {{GEOPM_DOMAIN_CPU, 2, "CPU_FREQUENCY_MAX_CONTROL"},
+                                            {GEOPM_DOMAIN_CPU, 2, "CPU_FREQUENCY_MIN_CONTROL"}};
+    group.write_controls(request, {1.2e9, 1.1e9});
+    EXPECT_DOUBLE_EQ(1.1e9, group.read_signal("CPU_FREQUENCY_MIN_CONTROL", GEOPM_DOMAIN_CPU, 2));
+    EXPECT_DOUBLE_EQ(1.2e9, group.read_signal("CPU_FREQUENCY_MAX_CONTROL", GEOPM_DOMAIN_CPU, 2));
+}
+
+TEST_F(SysfsIOGroupTest, restore_unchanged)
+{
+    // Files that were not changed since they were saved are not
+    // written
+    auto sysfs_io = std::make_shared<FreqLimitSysfsIO>();
+    SysfsIOGroup group(*m_topo, m_root, sysfs_io);
+    group.save_control();
+    group.restore_control();
+    EXPECT_EQ(0, sysfs_io->num_write);
+    group.write_control("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_PACKAGE, 1, 100.0);
+    group.restore_control();
+    EXPECT_EQ(2, sysfs_io->num_write);
+    EXPECT_DOUBLE_EQ(150.0, group.read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_PACKAGE, 1));
+}
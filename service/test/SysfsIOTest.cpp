@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "SysfsIOImp.hpp"
+#include "MockIOUring.hpp"
+#include "geopm_test.hpp"
+
+using geopm::SysfsIOImp;
+using testing::_;
+using testing::Eq;
+using testing::Invoke;
+
+class SysfsIOTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override;
+        void TearDown() override;
+        const std::string m_test_dir = "SysfsIOTest_files";
+        const std::string m_power_path = m_test_dir + "/power";
+        const std::string m_energy_path = m_test_dir + "/energy";
+        const std::string m_count_path = m_test_dir + "/count";
+};
+
+void SysfsIOTest::SetUp()
+{
+    mkdir(m_test_dir.c_str(), S_IRWXU);
+    std::ofstream(m_power_path) << "85 W\n";
+    std::ofstream(m_energy_path) << "598732067 J\n";
+    std::ofstream(m_count_path) << "12\n";
+}
+
+void SysfsIOTest::TearDown()
+{
+    unlink(m_power_path.c_str());
+    unlink(m_energy_path.c_str());
+    unlink(m_count_path.c_str());
+    rmdir(m_test_dir.c_str());
+}
+
+TEST_F(SysfsIOTest, read)
+{
+    SysfsIOImp sysfs_io;
+    int power_idx = sysfs_io.open_file(m_power_path, "W");
+    int count_idx = sysfs_io.open_file(m_count_path, "");
+    EXPECT_EQ(power_idx, sysfs_io.open_file(m_power_path, "W"));
+    EXPECT_NE(power_idx, count_idx);
+    EXPECT_DOUBLE_EQ(85, sysfs_io.read(power_idx));
+    EXPECT_DOUBLE_EQ(12, sysfs_io.read(count_idx));
+
+    // The open descriptor sees updates to the file
+    std::ofstream(m_power_path) << "99.5 W\n";
+    EXPECT_DOUBLE_EQ(99.5, sysfs_io.read(power_idx));
+
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.open_file(m_power_path, "J"),
+                               GEOPM_ERROR_INVALID, "was opened with units \"W\"");
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.open_file(m_test_dir + "/missing", ""),
+                               ENOENT, "unable to open");
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read(2), GEOPM_ERROR_INVALID,
+                               "file_idx out of range");
+}
+
+TEST_F(SysfsIOTest, read_batch)
+{
+    SysfsIOImp sysfs_io;
+    int power_idx = sysfs_io.open_file(m_power_path, "W");
+    int energy_idx = sysfs_io.open_file(m_energy_path, "J");
+    int power_batch_idx = sysfs_io.add_read(power_idx);
+    EXPECT_EQ(power_batch_idx, sysfs_io.add_read(power_idx));
+    sysfs_io.read_batch();
+    EXPECT_DOUBLE_EQ(85, sysfs_io.sample(power_batch_idx));
+
+    // Reads added after the first batch are included in the next
+    int energy_batch_idx = sysfs_io.add_read(energy_idx);
+    std::ofstream(m_power_path) << "100 W\n";
+    sysfs_io.read_batch();
+    EXPECT_DOUBLE_EQ(100, sysfs_io.sample(power_batch_idx));
+    EXPECT_DOUBLE_EQ(598732067, sysfs_io.sample(energy_batch_idx));
+
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.sample(2), GEOPM_ERROR_INVALID,
+                               "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.add_read(-1), GEOPM_ERROR_INVALID,
+                               "file_idx out of range");
+}
+
+TEST_F(SysfsIOTest, read_batch_uring)
+{
+    auto batch_reader = std::make_shared<MockIOUring>();
+    SysfsIOImp sysfs_io(batch_reader, nullptr);
+    int power_batch_idx = sysfs_io.add_read(sysfs_io.open_file(m_power_path, "W"));
+    int count_batch_idx = sysfs_io.add_read(sysfs_io.open_file(m_count_path, ""));
+    std::vector<std::string> contents = {"42 W\n", "7\n"};
+    size_t op_idx = 0;
+    EXPECT_CALL(*batch_reader, prep_read(_, _, _, _, Eq(0))).Times(2)
+        .WillRepeatedly(Invoke([&contents, &op_idx](std::shared_ptr<int> ret, int fd,
+                                                    void *buf, unsigned nbytes, off_t offset) {
+            const std::string &data = contents.at(op_idx++);
+            ASSERT_LT(data.size(), nbytes);
+            data.copy((char *)buf, data.size());
+            *ret = data.size();
+        }));
+    EXPECT_CALL(*batch_reader, submit()).Times(1);
+    sysfs_io.read_batch();
+    EXPECT_DOUBLE_EQ(42, sysfs_io.sample(power_batch_idx));
+    EXPECT_DOUBLE_EQ(7, sysfs_io.sample(count_batch_idx));
+
+    EXPECT_CALL(*batch_reader, prep_read(_, _, _, _, _)).Times(2)
+        .WillRepeatedly(Invoke([](std::shared_ptr<int> ret, int fd,
+                                  void *buf, unsigned nbytes, off_t offset) {
+            *ret = -EIO;
+        }));
+    EXPECT_CALL(*batch_reader, submit()).Times(1);
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read_batch(), EIO, "unable to read");
+}
+
+TEST_F(SysfsIOTest, write)
+{
+    SysfsIOImp sysfs_io;
+    int count_idx = sysfs_io.open_file(m_count_path, "");
+    sysfs_io.write(count_idx, 41.6);
+    EXPECT_DOUBLE_EQ(42, std::stod(geopm::read_file(m_count_path)));
+    EXPECT_DOUBLE_EQ(42, sysfs_io.read(count_idx));
+
+    int count_batch_idx = sysfs_io.add_write(count_idx);
+    EXPECT_EQ(count_batch_idx, sysfs_io.add_write(count_idx));
+    // Nothing is written until the batch is adjusted
+    sysfs_io.write_batch();
+    EXPECT_DOUBLE_EQ(42, std::stod(geopm::read_file(m_count_path)));
+    sysfs_io.adjust(count_batch_idx, 2400000);
+    sysfs_io.write_batch();
+    EXPECT_DOUBLE_EQ(2400000, std::stod(geopm::read_file(m_count_path)));
+
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.adjust(1, 0), GEOPM_ERROR_INVALID,
+                               "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.adjust(count_batch_idx, NAN), GEOPM_ERROR_INVALID,
+                               "value is not finite");
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.write(1, 0), GEOPM_ERROR_INVALID,
+                               "file_idx out of range");
+}
+
+TEST_F(SysfsIOTest, write_batch_uring)
+{
+    auto batch_writer = std::make_shared<MockIOUring>();
+    SysfsIOImp sysfs_io(nullptr, batch_writer);
+    int power_batch_idx = sysfs_io.add_write(sysfs_io.open_file(m_power_path, "W"));
+    int count_batch_idx = sysfs_io.add_write(sysfs_io.open_file(m_count_path, ""));
+    sysfs_io.adjust(power_batch_idx, 120);
+    sysfs_io.adjust(count_batch_idx, 3);
+    sysfs_io.adjust(count_batch_idx, 4);
+    std::vector<std::string> written;
+    EXPECT_CALL(*batch_writer, prep_write(_, _, _, _, Eq(0))).Times(2)
+        .WillRepeatedly(Invoke([&written](std::shared_ptr<int> ret, int fd,
+                                          const void *buf, unsigned nbytes, off_t offset) {
+            written.emplace_back((const char *)buf, nbytes);
+            *ret = nbytes;
+        }));
+    EXPECT_CALL(*batch_writer, submit()).Times(1);
+    sysfs_io.write_batch();
+    EXPECT_EQ(std::vector<std::string>({"120", "4"}), written);
+
+    // Only adjusted files are written in the next batch
+    sysfs_io.adjust(count_batch_idx, 5);
+    EXPECT_CALL(*batch_writer, prep_write(_, _, _, _, _)).Times(1)
+        .WillOnce(Invoke([](std::shared_ptr<int> ret, int fd,
+                            const void *buf, unsigned nbytes, off_t offset) {
+            *ret = -EINVAL;
+        }));
+    EXPECT_CALL(*batch_writer, submit()).Times(1);
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.write_batch(), EINVAL, "unable to write");
+}
+
+TEST_F(SysfsIOTest, parse)
+{
+    SysfsIOImp sysfs_io;
+    int power_idx = sysfs_io.open_file(m_power_path, "W");
+    int count_idx = sysfs_io.open_file(m_count_path, "");
+
+    std::string sparse_string("85 W\n");
+    sparse_string.resize(4096);
+    std::ofstream(m_power_path) << sparse_string;
+    EXPECT_DOUBLE_EQ(85, sysfs_io.read(power_idx));
+
+    std::ofstream(m_count_path) << " \t-3.5e2 \n\n";
+    EXPECT_DOUBLE_EQ(-350, sysfs_io.read(count_idx));
+
+    for (const char *bad_units : {"85 WW\n", "85W\n", "85", "85 W J\n", "85 💡\n"}) {
+        std::ofstream(m_power_path) << bad_units;
+        GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read(power_idx), GEOPM_ERROR_RUNTIME,
+                                   "Unexpected format in " + m_power_path);
+    }
+    std::ofstream(m_count_path) << "12 W\n";
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read(count_idx), GEOPM_ERROR_RUNTIME,
+                               "Unexpected format in " + m_count_path);
+
+    std::ofstream(m_power_path) << "Eighty-five Watts\n";
+    EXPECT_THROW(sysfs_io.read(power_idx), std::invalid_argument);
+    std::ofstream(m_power_path) << "\n";
+    EXPECT_THROW(sysfs_io.read(power_idx), std::invalid_argument);
+    std::ofstream(m_power_path) << "";
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read(power_idx), GEOPM_ERROR_INVALID, "is empty");
+    std::ofstream(m_power_path) << std::string(100, '1') << " W\n";
+    GEOPM_EXPECT_THROW_MESSAGE(sysfs_io.read(power_idx), GEOPM_ERROR_RUNTIME, "are too long");
+}
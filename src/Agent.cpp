@@ -33,6 +33,7 @@ namespace geopm
 {
     const std::string Agent::m_num_sample_string = "NUM_SAMPLE";
     const std::string Agent::m_num_policy_string = "NUM_POLICY";
+    const std::string Agent::m_variable_policy_string = "VARIABLE_NUM_POLICY";
     const std::string Agent::m_sample_prefix = "SAMPLE_";
     const std::string Agent::m_policy_prefix = "POLICY_";
     const std::string Agent::M_PLUGIN_PREFIX = "libgeopmagent_";
@@ -54,7 +55,8 @@ namespace geopm
         register_plugin(FrequencyMapAgent::plugin_name(),
                         FrequencyMapAgent::make_plugin,
                         Agent::make_dictionary(FrequencyMapAgent::policy_names(),
-                                               FrequencyMapAgent::sample_names()));
+                                               FrequencyMapAgent::sample_names(),
+                                               true));
         register_plugin(GPUActivityAgent::plugin_name(),
                         GPUActivityAgent::make_plugin,
                         Agent::make_dictionary(GPUActivityAgent::policy_names(),
@@ -193,6 +195,28 @@ namespace geopm
         return Agent::policy_names(agent_factory().dictionary(agent_name));
     }
 
+    bool Agent::is_variable_policy_size(const std::map<std::string, std::string> &dictionary)
+    {
+        auto it = dictionary.find(m_variable_policy_string);
+        return it != dictionary.end() && it->second == "1";
+    }
+
+    bool Agent::is_variable_policy_size(const std::string &agent_name)
+    {
+        return Agent::is_variable_policy_size(agent_factory().dictionary(agent_name));
+    }
+
+    std::map<std::string, std::string> Agent::make_dictionary(const std::vector<std::string> &policy_names,
+                                                              const std::vector<std::string> &sample_names,
+                                                              bool is_variable_policy_size)
+    {
+        auto result = make_dictionary(policy_names, sample_names);
+        if (is_variable_policy_size) {
+            result[m_variable_policy_string] = "1";
+        }
+        return result;
+    }
+
     std::map<std::string, std::string> Agent::make_dictionary(const std::vector<std::string> &policy_names,
                                                               const std::vector<std::string> &sample_names)
     {
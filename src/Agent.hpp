@@ -155,6 +155,19 @@ namespace geopm
             ///        Agent.
             /// @param [in] agent_name Name of the agent.
             static std::vector<std::string> sample_names(const std::string &agent_name);
+            /// @brief Used to look up whether a specific Agent
+            ///        accepts policies shorter than num_policy(),
+            ///        reading the missing trailing values as NAN.
+            ///        This should be called with the dictionary
+            ///        returned by
+            ///        agent_factory().dictionary(agent_name) for the
+            ///        Agent of interest.
+            /// @param [in] dictionary Factory dictionary for the agent.
+            static bool is_variable_policy_size(const std::map<std::string, std::string> &dictionary);
+            /// @brief Used to look up whether a specific Agent
+            ///        accepts policies shorter than num_policy().
+            /// @param [in] agent_name Name of the agent.
+            static bool is_variable_policy_size(const std::string &agent_name);
             /// @brief Used to create a correctly-formatted dictionary
             ///        for an Agent at the time the Agent is
             ///        registered with the factory.  Concrete Agent
@@ -163,6 +176,13 @@ namespace geopm
             ///        to be passed to this method.
             static std::map<std::string, std::string> make_dictionary(const std::vector<std::string> &policy_names,
                                                                       const std::vector<std::string> &sample_names);
+            /// @brief Used to create a correctly-formatted dictionary
+            ///        for an Agent that accepts policies shorter than
+            ///        the number of policy names when
+            ///        is_variable_policy_size is true.
+            static std::map<std::string, std::string> make_dictionary(const std::vector<std::string> &policy_names,
+                                                                      const std::vector<std::string> &sample_names,
+                                                                      bool is_variable_policy_size);
             /// @brief Generically aggregate a vector of samples given
             ///        a vector of aggregation functions.  This helper
             ///        method applies a different aggregation
@@ -182,6 +202,7 @@ namespace geopm
         private:
             static const std::string m_num_sample_string;
             static const std::string m_num_policy_string;
+            static const std::string m_variable_policy_string;
             static const std::string m_sample_prefix;
             static const std::string m_policy_prefix;
     };
@@ -12,6 +12,7 @@
 #include <array>
 #include <cstring>
 #include <cerrno>
+#include <future>
 #include <stdexcept>
 #include <unistd.h>
 #include <time.h>
@@ -102,7 +103,8 @@ namespace geopm
                                 {},
                                 environment().profile(),
                                 {},
-                                Scheduler::make_unique())
+                                Scheduler::make_unique(),
+                                environment().num_drain_thread())
     {
 
     }
@@ -116,10 +118,33 @@ namespace geopm
                                                  const std::string &profile_name,
                                                  const std::map<int, std::set<int> > &client_cpu_map,
                                                  std::shared_ptr<Scheduler> scheduler)
+        : ApplicationSamplerImp(std::move(status),
+                                platform_topo,
+                                process_map,
+                                is_filtered,
+                                filter_name,
+                                is_cpu_active,
+                                profile_name,
+                                client_cpu_map,
+                                std::move(scheduler),
+                                1)
+    {
+
+    }
+
+    ApplicationSamplerImp::ApplicationSamplerImp(std::shared_ptr<ApplicationStatus> status,
+                                                 const PlatformTopo &platform_topo,
+                                                 const std::map<int, m_process_s> &process_map,
+                                                 bool is_filtered,
+                                                 const std::string &filter_name,
+                                                 const std::vector<bool> &is_cpu_active,
+                                                 const std::string &profile_name,
+                                                 const std::map<int, std::set<int> > &client_cpu_map,
+                                                 std::shared_ptr<Scheduler> scheduler,
+                                                 int num_drain_thread)
         : m_status(std::move(status))
         , m_topo(platform_topo)
         , m_num_cpu(m_topo.num_domain(GEOPM_DOMAIN_CPU))
-        , m_process_map(process_map)
         , m_is_filtered(is_filtered)
         , m_filter_name(filter_name)
         , m_hint_time(m_num_cpu, std::array<double, GEOPM_NUM_REGION_HINT>{})
@@ -128,7 +153,6 @@ namespace geopm
         , m_is_first_update(true)
         , m_hint_last(m_num_cpu, uint64_t(GEOPM_REGION_HINT_UNSET))
         , m_profile_name(profile_name)
-        , m_client_cpu_map(client_cpu_map)
         , m_scheduler(std::move(scheduler))
         , m_do_shutdown(false)
         , m_last_stop({})
@@ -136,10 +160,42 @@ namespace geopm
         , m_overhead_time(0.0)
         , m_num_registered(0)
         , m_num_client(0)
+        , m_num_event_step(0)
+        , m_num_period_step(0)
+        , m_num_drain_thread(num_drain_thread)
+        , m_num_drain_shard(0)
+        , m_drain_generation(0)
+        , m_num_drain_busy(0)
+        , m_is_drain_stop(false)
     {
+        for (const auto &process_it : process_map) {
+            m_process.push_back(process_it.second);
+        }
+        start_drain_workers();
         if (m_is_cpu_active.empty()) {
             m_is_cpu_active.resize(m_num_cpu, false);
         }
+        for (const auto &client_it : client_cpu_map) {
+            std::vector<bool> &cpu_bitmap = client_cpu_bitmap(client_it.first);
+            for (int cpu_idx : client_it.second) {
+                cpu_bitmap.at(cpu_idx) = true;
+            }
+        }
+    }
+
+    ApplicationSamplerImp::~ApplicationSamplerImp()
+    {
+        stop_drain_workers();
+    }
+
+    int ApplicationSamplerImp::num_shard(int num_process, int num_thread)
+    {
+        if (num_thread == 0) {
+            num_thread = (num_process + M_PROCESS_PER_THREAD - 1) / M_PROCESS_PER_THREAD;
+            num_thread = std::min(num_thread, M_MAX_THREAD);
+        }
+        num_thread = std::min(num_thread, num_process);
+        return std::max(num_thread, 1);
     }
 
     void ApplicationSamplerImp::update(const geopm_time_s &curr_time)
@@ -151,55 +207,10 @@ namespace geopm
                            (int) m_hint_last.size() == m_num_cpu,
                            "Mismatch in CPU/hint vectors");
         // Dump the record log from each process, filter the results,
-        // and reindex the short region event signals.
-
-        // Clear the buffers that we will be building.
-        m_record_buffer.clear();
-        m_short_region_buffer.clear();
-        // Iterate over the record log for each process
-        for (auto &proc_map_it : m_process_map) {
-            // Record the location in the record buffer where this
-            // process' data begins for updating the short region
-            // event signals.
-            size_t record_offset = m_record_buffer.size();
-            // Get data from the record log
-            auto &proc_it = proc_map_it.second;
-            proc_it.record_log->dump(proc_it.records, proc_it.short_regions);
-            if (m_is_filtered) {
-                // Filter and check the records and push them onto
-                // m_record_buffer
-                for (const auto &record_it : proc_it.records) {
-                    for (auto &filtered_it : proc_it.filter->filter(record_it)) {
-                        proc_it.valid.check(filtered_it);
-                        m_record_buffer.push_back(filtered_it);
-                    }
-                }
-            }
-            else {
-                // Check the records and push them onto m_record_buffer
-                for (const auto &record : proc_it.records) {
-                    proc_it.valid.check(record);
-                }
-                m_record_buffer.insert(m_record_buffer.end(),
-                                       proc_it.records.begin(),
-                                       proc_it.records.end());
-            }
-            // Update the "signal" field for all of the short region
-            // events to have the right offset.
-            size_t short_region_remain = proc_it.short_regions.size();
-            for (auto record_it = m_record_buffer.begin() + record_offset;
-                 short_region_remain > 0 &&
-                 record_it != m_record_buffer.end();
-                 ++record_it) {
-                if (record_it->event == EVENT_SHORT_REGION) {
-                    record_it->signal += m_short_region_buffer.size();
-                    --short_region_remain;
-                }
-            }
-            m_short_region_buffer.insert(m_short_region_buffer.end(),
-                                         proc_it.short_regions.begin(),
-                                         proc_it.short_regions.end());
-        }
+        // and merge them in time order with the short region event
+        // signals reindexed.
+        drain_records();
+        merge_records();
         update_start();
         m_status->update_cache();
         double time_delta;
@@ -220,6 +231,197 @@ namespace geopm
         update_stop();
     }
 
+    std::vector<record_s> &ApplicationSamplerImp::drained_records(m_process_s &process)
+    {
+        return m_is_filtered ? process.filtered : process.records;
+    }
+
+    void ApplicationSamplerImp::drain_process(m_process_s &process)
+    {
+        process.record_log->dump(process.records, process.short_regions);
+        if (m_is_filtered) {
+            // Filter and check the records
+            process.filtered.clear();
+            for (const auto &record_it : process.records) {
+                for (auto &filtered_it : process.filter->filter(record_it)) {
+                    process.valid.check(filtered_it);
+                    process.filtered.push_back(filtered_it);
+                }
+            }
+        }
+        else {
+            for (const auto &record : process.records) {
+                process.valid.check(record);
+            }
+        }
+    }
+
+    void ApplicationSamplerImp::drain_shard(int shard_idx)
+    {
+        size_t begin = shard_idx * m_process.size() / m_num_drain_shard;
+        size_t end = (shard_idx + 1) * m_process.size() / m_num_drain_shard;
+        for (size_t process_idx = begin; process_idx != end; ++process_idx) {
+            drain_process(m_process[process_idx]);
+        }
+    }
+
+    void ApplicationSamplerImp::drain_records(void)
+    {
+        if (m_process.empty()) {
+            return;
+        }
+        if (!m_drain_workers.empty()) {
+            {
+                std::lock_guard<std::mutex> guard(m_drain_mutex);
+                m_num_drain_busy = m_drain_workers.size();
+                ++m_drain_generation;
+            }
+            m_drain_start_cv.notify_all();
+        }
+        // The calling thread drains the first shard
+        m_drain_error[0] = nullptr;
+        try {
+            drain_shard(0);
+        }
+        catch (...) {
+            m_drain_error[0] = std::current_exception();
+        }
+        if (!m_drain_workers.empty()) {
+            std::unique_lock<std::mutex> lock(m_drain_mutex);
+            m_drain_done_cv.wait(lock, [this]() {
+                return m_num_drain_busy == 0;
+            });
+        }
+        // Report the first failure in process order
+        for (const auto &error : m_drain_error) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    void ApplicationSamplerImp::merge_records(void)
+    {
+        m_record_buffer.clear();
+        m_short_region_buffer.clear();
+        m_merge_heap.clear();
+        for (size_t process_idx = 0; process_idx != m_process.size(); ++process_idx) {
+            auto &process = m_process[process_idx];
+            std::vector<record_s> &records = drained_records(process);
+            // Update the "signal" field for all of the short region
+            // events to index into m_short_region_buffer.
+            size_t short_region_remain = process.short_regions.size();
+            for (auto record_it = records.begin();
+                 short_region_remain > 0 &&
+                 record_it != records.end();
+                 ++record_it) {
+                if (record_it->event == EVENT_SHORT_REGION) {
+                    record_it->signal += m_short_region_buffer.size();
+                    --short_region_remain;
+                }
+            }
+            m_short_region_buffer.insert(m_short_region_buffer.end(),
+                                         process.short_regions.begin(),
+                                         process.short_regions.end());
+            if (!records.empty()) {
+                m_merge_heap.push_back({process_idx, 0});
+            }
+        }
+        if (m_merge_heap.size() == 1) {
+            const std::vector<record_s> &records =
+                drained_records(m_process[m_merge_heap[0].process_idx]);
+            m_record_buffer.insert(m_record_buffer.end(), records.begin(), records.end());
+            return;
+        }
+        // The records of each process are in time order, so merge
+        // them with a heap ordered by the time of each process' next
+        // record.  Records with equal times are ordered by process.
+        auto is_after = [this](const m_merge_s &aa, const m_merge_s &bb) {
+            const record_s &record_aa = drained_records(m_process[aa.process_idx])[aa.record_idx];
+            const record_s &record_bb = drained_records(m_process[bb.process_idx])[bb.record_idx];
+            if (geopm_time_comp(&record_bb.time, &record_aa.time)) {
+                return true;
+            }
+            if (geopm_time_comp(&record_aa.time, &record_bb.time)) {
+                return false;
+            }
+            return aa.process_idx > bb.process_idx;
+        };
+        std::make_heap(m_merge_heap.begin(), m_merge_heap.end(), is_after);
+        while (!m_merge_heap.empty()) {
+            std::pop_heap(m_merge_heap.begin(), m_merge_heap.end(), is_after);
+            m_merge_s &next = m_merge_heap.back();
+            const std::vector<record_s> &records = drained_records(m_process[next.process_idx]);
+            m_record_buffer.push_back(records[next.record_idx]);
+            ++next.record_idx;
+            if (next.record_idx != records.size()) {
+                std::push_heap(m_merge_heap.begin(), m_merge_heap.end(), is_after);
+            }
+            else {
+                m_merge_heap.pop_back();
+            }
+        }
+    }
+
+    void ApplicationSamplerImp::start_drain_workers(void)
+    {
+        stop_drain_workers();
+        m_num_drain_shard = num_shard(m_process.size(), m_num_drain_thread);
+        m_drain_error.assign(m_num_drain_shard, nullptr);
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> guard(m_drain_mutex);
+            m_is_drain_stop = false;
+            generation = m_drain_generation;
+        }
+        for (int shard_idx = 1; shard_idx < m_num_drain_shard; ++shard_idx) {
+            m_drain_workers.emplace_back(&ApplicationSamplerImp::drain_worker_loop,
+                                         this, shard_idx, generation);
+        }
+    }
+
+    void ApplicationSamplerImp::stop_drain_workers(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_drain_mutex);
+            m_is_drain_stop = true;
+        }
+        m_drain_start_cv.notify_all();
+        for (auto &worker : m_drain_workers) {
+            worker.join();
+        }
+        m_drain_workers.clear();
+    }
+
+    void ApplicationSamplerImp::drain_worker_loop(int shard_idx, uint64_t generation)
+    {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_drain_mutex);
+                m_drain_start_cv.wait(lock, [this, generation]() {
+                    return m_is_drain_stop || m_drain_generation != generation;
+                });
+                if (m_is_drain_stop) {
+                    break;
+                }
+                generation = m_drain_generation;
+            }
+            std::exception_ptr error = nullptr;
+            try {
+                drain_shard(shard_idx);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> guard(m_drain_mutex);
+                m_drain_error[shard_idx] = error;
+                --m_num_drain_busy;
+            }
+            m_drain_done_cv.notify_one();
+        }
+    }
+
     void ApplicationSamplerImp::update_start(void)
     {
         bool do_update_zero = false;
@@ -236,8 +438,19 @@ namespace geopm
                 ++m_num_registered;
             }
             else if (record.event == EVENT_AFFINITY) {
-                m_client_cpu_map[record.process].insert((int)record.signal);
-                do_update_cpu = true;
+                if (record.signal >= (uint64_t)m_num_cpu) {
+                    // A client may run on CPUs that are not part of
+                    // the platform topology, e.g. after a hotplug
+#ifdef GEOPM_DEBUG
+                    std::cerr << "Warning: <geopm> ApplicationSamplerImp::update_start(): "
+                              << "Ignoring affinity record from process " << record.process
+                              << " with CPU index out of range: " << record.signal << std::endl;
+#endif
+                }
+                else {
+                    client_cpu_bitmap(record.process)[record.signal] = true;
+                    do_update_cpu = true;
+                }
             }
             else if (record.event == EVENT_OVERHEAD) {
                 m_overhead_time += geopm_field_to_signal(record.signal);
@@ -340,31 +553,72 @@ namespace geopm
         return m_status->get_progress_cpu(cpu_idx);
     }
 
-    std::map<int, ApplicationSamplerImp::m_process_s> ApplicationSamplerImp::connect_record_log(const std::vector<int> &client_pids)
+    std::vector<ApplicationSamplerImp::m_process_s> ApplicationSamplerImp::connect_record_log(const std::vector<int> &client_pids)
     {
-        std::map<int, m_process_s> result;
-        for (const auto &pid : client_pids) {
-            std::string shmem_path = shmem_path_prof("record-log", pid, geteuid());
-            std::shared_ptr<SharedMemory> record_log_shmem =
-                SharedMemory::make_unique_user(shmem_path, 0);
-            if (record_log_shmem->size() < ApplicationRecordLog::buffer_size()) {
-                throw Exception("ApplicationSamplerImp::connect(): "
-                                "Record log shared memory buffer is incorrectly sized",
-                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        // The dense client index is assigned in pid order, matching
+        // the order of a process map passed to the constructor.
+        std::vector<int> sorted_pids(client_pids);
+        std::sort(sorted_pids.begin(), sorted_pids.end());
+        std::vector<m_process_s> result(sorted_pids.size());
+        // Attach to the record logs of the clients in shards that
+        // are connected concurrently when more than one drain thread
+        // is configured.
+        int num_connect_shard = num_shard(sorted_pids.size(), m_num_drain_thread);
+        auto connect_shard = [this, &sorted_pids, &result, num_connect_shard](int shard_idx)
+        {
+            size_t begin = shard_idx * sorted_pids.size() / num_connect_shard;
+            size_t end = (shard_idx + 1) * sorted_pids.size() / num_connect_shard;
+            for (size_t client_idx = begin; client_idx != end; ++client_idx) {
+                connect_process(sorted_pids[client_idx], result[client_idx]);
             }
-            auto emplace_ret = result.emplace(pid, m_process_s {});
-            auto &process = emplace_ret.first->second;
-            if (m_is_filtered) {
-                process.filter = RecordFilter::make_unique(m_filter_name);
+        };
+        std::vector<std::future<void> > shard_future;
+        for (int shard_idx = 1; shard_idx < num_connect_shard; ++shard_idx) {
+            shard_future.push_back(std::async(std::launch::async, connect_shard, shard_idx));
+        }
+        std::exception_ptr error = nullptr;
+        try {
+            connect_shard(0);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        // Wait for every shard before reporting the first failure
+        for (auto &future : shard_future) {
+            try {
+                future.get();
+            }
+            catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
             }
-            process.record_log_shmem = record_log_shmem;
-            process.record_log = ApplicationRecordLog::make_unique(std::move(record_log_shmem));
-            process.records.reserve(ApplicationRecordLog::max_record());
-            process.short_regions.reserve(ApplicationRecordLog::max_region());
+        }
+        if (error) {
+            std::rethrow_exception(error);
         }
         return result;
     }
 
+    void ApplicationSamplerImp::connect_process(int client_pid, m_process_s &process)
+    {
+        std::string shmem_path = shmem_path_prof("record-log", client_pid, geteuid());
+        std::shared_ptr<SharedMemory> record_log_shmem =
+            SharedMemory::make_unique_user(shmem_path, 0);
+        if (record_log_shmem->size() < ApplicationRecordLog::buffer_size()) {
+            throw Exception("ApplicationSamplerImp::connect(): "
+                            "Record log shared memory buffer is incorrectly sized",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (m_is_filtered) {
+            process.filter = RecordFilter::make_unique(m_filter_name);
+        }
+        process.record_log_shmem = record_log_shmem;
+        process.record_log = ApplicationRecordLog::make_unique(std::move(record_log_shmem));
+        process.records.reserve(ApplicationRecordLog::max_record());
+        process.short_regions.reserve(ApplicationRecordLog::max_region());
+    }
+
     void ApplicationSamplerImp::connect_status(void)
     {
         std::string shmem_path = shmem_path_prof("status", getpid(), geteuid());
@@ -381,9 +635,11 @@ namespace geopm
     {
         std::fill(m_is_cpu_active.begin(), m_is_cpu_active.end(), false);
         for (const auto &client_it : m_client_cpu_map) {
-            const std::set<int> &cpu_set = client_it.second;
-            for (int cpu_idx : cpu_set) {
-                m_is_cpu_active[cpu_idx] = true;
+            const std::vector<bool> &cpu_bitmap = client_it.second;
+            for (int cpu_idx = 0; cpu_idx != m_num_cpu; ++cpu_idx) {
+                if (cpu_bitmap[cpu_idx]) {
+                    m_is_cpu_active[cpu_idx] = true;
+                }
             }
         }
         for (int cpu_idx = 0; cpu_idx != m_num_cpu; ++cpu_idx) {
@@ -407,20 +663,59 @@ namespace geopm
     {
         if (!m_status) {
             m_num_client = (int)client_pids.size();
-            GEOPM_DEBUG_ASSERT(m_process_map.empty(),
-                               "m_process_map is not empty, but we are connecting");
+            GEOPM_DEBUG_ASSERT(m_process.empty(),
+                               "m_process is not empty, but we are connecting");
             m_client_pids.insert(client_pids.begin(), client_pids.end());
             connect_status();
-            m_process_map = connect_record_log(client_pids);
+            m_process = connect_record_log(client_pids);
+            // Start the drain workers before connect_affinity() pins
+            // the calling thread to the sampler CPU so that they
+            // keep its original affinity.
+            start_drain_workers();
+            connect_affinity(client_pids);
         }
     }
 
+    void ApplicationSamplerImp::connect_affinity(const std::vector<int> &client_pids)
+    {
+        // Query the affinity of every client in one batch so that
+        // their CPUs are active from the first update rather than
+        // after each client's affinity records are read.
+        auto pid_cpu_map = m_scheduler->proc_cpusets(client_pids);
+        for (const auto &pid_it : pid_cpu_map) {
+            std::vector<bool> &cpu_bitmap = client_cpu_bitmap(pid_it.first);
+            const std::vector<bool> &pid_cpu = pid_it.second;
+            for (int cpu_idx = 0; cpu_idx != m_num_cpu && cpu_idx != (int)pid_cpu.size(); ++cpu_idx) {
+                if (pid_cpu[cpu_idx]) {
+                    cpu_bitmap[cpu_idx] = true;
+                }
+            }
+        }
+        if (!pid_cpu_map.empty()) {
+            update_cpu_active();
+        }
+    }
+
+    std::vector<bool> &ApplicationSamplerImp::client_cpu_bitmap(int client_pid)
+    {
+        std::vector<bool> &result = m_client_cpu_map[client_pid];
+        if (result.empty()) {
+            result.resize(m_num_cpu, false);
+        }
+        return result;
+    }
+
     std::set<int> ApplicationSamplerImp::client_cpu_set(int client_pid) const
     {
         std::set<int> result;
         auto client_it = m_client_cpu_map.find(client_pid);
         if (client_it != m_client_cpu_map.end()) {
-            result = client_it->second;
+            const std::vector<bool> &cpu_bitmap = client_it->second;
+            for (int cpu_idx = 0; cpu_idx != m_num_cpu; ++cpu_idx) {
+                if (cpu_bitmap[cpu_idx]) {
+                    result.insert(result.end(), cpu_idx);
+                }
+            }
         }
         return result;
     }
@@ -455,6 +750,34 @@ namespace geopm
         return result;
     }
 
+    bool ApplicationSamplerImp::wait_event(const geopm_time_s &deadline)
+    {
+        bool result = false;
+        if (m_status) {
+            result = m_status->wait_event(deadline);
+        }
+        else {
+            geopm::time_sleep_until_real(deadline);
+        }
+        if (result) {
+            ++m_num_event_step;
+        }
+        else {
+            ++m_num_period_step;
+        }
+        return result;
+    }
+
+    int ApplicationSamplerImp::num_event_step(void) const
+    {
+        return m_num_event_step;
+    }
+
+    int ApplicationSamplerImp::num_period_step(void) const
+    {
+        return m_num_period_step;
+    }
+
     int ApplicationSamplerImp::sampler_cpu(void)
     {
         int result = m_num_cpu - 1;
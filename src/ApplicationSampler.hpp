@@ -115,6 +115,26 @@ namespace geopm
             virtual bool do_shutdown(void) const = 0;
             virtual double total_time(void) const = 0;
             virtual double overhead_time(void) const = 0;
+            /// @brief Block until an application process enters a
+            ///        region or the deadline is reached.
+            ///
+            /// Called by the controller in place of sleeping when
+            /// steps are triggered by region entry.  If no
+            /// application is connected this sleeps until the
+            /// deadline.
+            ///
+            /// @param [in] deadline Absolute time to stop waiting
+            ///        measured with geopm_time_real().
+            ///
+            /// @return True if a region entry was published before
+            ///         the deadline, false otherwise.
+            virtual bool wait_event(const geopm_time_s &deadline) = 0;
+            /// @brief Number of calls to wait_event() that returned
+            ///        due to a region entry.
+            virtual int num_event_step(void) const = 0;
+            /// @brief Number of calls to wait_event() that returned
+            ///        at the deadline.
+            virtual int num_period_step(void) const = 0;
         protected:
             ApplicationSampler() = default;
         private:
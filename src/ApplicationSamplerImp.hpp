@@ -6,6 +6,11 @@
 #ifndef APPLICATIONSAMPLERIMP_HPP_INCLUDE
 #define APPLICATIONSAMPLERIMP_HPP_INCLUDE
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 #include "ApplicationSampler.hpp"
 #include "ValidateRecord.hpp"
 #include "geopm_hint.h"
@@ -29,6 +34,8 @@ namespace geopm
                 std::shared_ptr<ApplicationRecordLog> record_log;
                 std::vector<record_s> records;
                 std::vector<short_region_s> short_regions;
+                // Filtered records when a filter is used
+                std::vector<record_s> filtered;
             };
             ApplicationSamplerImp();
             ApplicationSamplerImp(std::shared_ptr<ApplicationStatus> status,
@@ -40,7 +47,24 @@ namespace geopm
                                   const std::string &profile_name,
                                   const std::map<int, std::set<int> > &client_cpu_map,
                                   std::shared_ptr<Scheduler> scheduler);
-            virtual ~ApplicationSamplerImp() = default;
+            /// @param [in] num_drain_thread Number of threads,
+            ///        including the caller of update(), that drain
+            ///        the process record logs.  One drains every
+            ///        process on the calling thread, and zero selects
+            ///        a number based on the number of processes
+            ///        connected.  The default constructor reads it
+            ///        from GEOPM_NUM_DRAIN_THREAD.
+            ApplicationSamplerImp(std::shared_ptr<ApplicationStatus> status,
+                                  const PlatformTopo &platform_topo,
+                                  const std::map<int, m_process_s> &process_map,
+                                  bool is_filtered,
+                                  const std::string &filter_name,
+                                  const std::vector<bool> &is_cpu_active,
+                                  const std::string &profile_name,
+                                  const std::map<int, std::set<int> > &client_cpu_map,
+                                  std::shared_ptr<Scheduler> scheduler,
+                                  int num_drain_thread);
+            virtual ~ApplicationSamplerImp();
             void update(const geopm_time_s &curr_time) override;
             std::vector<record_s> get_records(void) const override;
             short_region_s get_short_region(uint64_t event_signal) const override;
@@ -54,19 +78,41 @@ namespace geopm
             bool do_shutdown(void) const override;
             double total_time(void) const override;
             double overhead_time(void) const override;
+            bool wait_event(const geopm_time_s &deadline) override;
+            int num_event_step(void) const override;
+            int num_period_step(void) const override;
             int sampler_cpu(void);
         private:
-            std::map<int, m_process_s> connect_record_log(const std::vector<int> &client_pids);
+            struct m_merge_s {
+                size_t process_idx;
+                size_t record_idx;
+            };
+            static constexpr int M_MAX_THREAD = 8;
+            static constexpr int M_PROCESS_PER_THREAD = 32;
+            static int num_shard(int num_process, int num_thread);
+            std::vector<m_process_s> connect_record_log(const std::vector<int> &client_pids);
+            void connect_process(int client_pid, m_process_s &process);
             void connect_status(void);
+            void connect_affinity(const std::vector<int> &client_pids);
             void update_cpu_active(void);
+            std::vector<bool> &client_cpu_bitmap(int client_pid);
             void update_start(void);
             void update_stop(void);
+            std::vector<record_s> &drained_records(m_process_s &process);
+            void drain_process(m_process_s &process);
+            void drain_shard(int shard_idx);
+            void drain_records(void);
+            void merge_records(void);
+            void start_drain_workers(void);
+            void stop_drain_workers(void);
+            void drain_worker_loop(int shard_idx, uint64_t generation);
             std::vector<record_s> m_record_buffer;
             std::vector<short_region_s> m_short_region_buffer;
             std::shared_ptr<ApplicationStatus> m_status;
             const PlatformTopo &m_topo;
             int m_num_cpu;
-            std::map<int, m_process_s> m_process_map;
+            // Indexed by a dense client id assigned in pid order
+            std::vector<m_process_s> m_process;
             const bool m_is_filtered;
             const std::string m_filter_name;
             std::vector<std::array<double, GEOPM_NUM_REGION_HINT>> m_hint_time;
@@ -75,7 +121,8 @@ namespace geopm
             bool m_is_first_update;
             std::vector<uint64_t> m_hint_last;
             std::string m_profile_name;
-            std::map<int, std::set<int> > m_client_cpu_map;
+            // Bitmap of the CPUs each client process may run on
+            std::map<int, std::vector<bool> > m_client_cpu_map;
             std::shared_ptr<Scheduler> m_scheduler;
             std::set<int> m_client_pids;
             bool m_do_shutdown;
@@ -84,6 +131,19 @@ namespace geopm
             double m_overhead_time;
             int m_num_registered;
             int m_num_client;
+            int m_num_event_step;
+            int m_num_period_step;
+            int m_num_drain_thread;
+            int m_num_drain_shard;
+            std::vector<m_merge_s> m_merge_heap;
+            std::vector<std::thread> m_drain_workers;
+            std::mutex m_drain_mutex;
+            std::condition_variable m_drain_start_cv;
+            std::condition_variable m_drain_done_cv;
+            uint64_t m_drain_generation;
+            int m_num_drain_busy;
+            bool m_is_drain_stop;
+            std::vector<std::exception_ptr> m_drain_error;
     };
 }
 
@@ -7,6 +7,14 @@
 #include "ApplicationStatus.hpp"
 
 #include <cmath>
+#include <climits>
+#include <cerrno>
+
+#include <linux/futex.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include "geopm/SharedMemory.hpp"
 #include "geopm/Exception.hpp"
@@ -26,13 +34,27 @@ namespace geopm
 
     size_t ApplicationStatus::buffer_size(int num_cpu)
     {
-        return M_STATUS_SIZE * num_cpu;
+        // One cache line per CPU, one for the event counter, and enough
+        // cache lines for one dirty bit per CPU
+        size_t dirty_size = sizeof(uint64_t) * ((num_cpu + 63) / 64);
+        size_t num_dirty_line = (dirty_size + M_STATUS_SIZE - 1) / M_STATUS_SIZE;
+        return M_STATUS_SIZE * (num_cpu + 1 + num_dirty_line);
     }
 
     ApplicationStatusImp::ApplicationStatusImp(int num_cpu,
                                                std::shared_ptr<SharedMemory> shmem)
+        : ApplicationStatusImp(num_cpu, std::move(shmem), M_WRITE_TIMEOUT)
+    {
+
+    }
+
+    ApplicationStatusImp::ApplicationStatusImp(int num_cpu,
+                                               std::shared_ptr<SharedMemory> shmem,
+                                               double write_timeout)
         : m_num_cpu(num_cpu)
         , m_shmem(std::move(shmem))
+        , m_write_timeout(write_timeout)
+        , m_pid(getpid())
     {
         if (m_shmem == nullptr) {
             throw Exception("ApplicationStatus: shared memory pointer cannot be null",
@@ -42,11 +64,104 @@ namespace geopm
             throw Exception("ApplicationStatus: shared memory incorrectly sized",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        // Note: no lock; all members of the struct are 32-bits and will be
-        // accessed atomically by hardware.
+        // Note: no lock; each CPU entry is guarded by its own sequence
+        // counter, and changed entries are flagged in the dirty bitmap.
         m_buffer = (m_app_status_s *)m_shmem->pointer();
-        m_cache.resize(m_shmem->size());
-        update_cache();
+        m_cache.resize(m_num_cpu, {});
+        m_event = (m_event_s *)(m_buffer + m_num_cpu);
+        m_event_count_last = __atomic_load_n(&(m_event->count), __ATOMIC_SEQ_CST);
+        m_dirty = (uint64_t *)(m_event + 1);
+        m_num_dirty = (m_num_cpu + 63) / 64;
+        // Take a full snapshot without consuming the dirty bits, both
+        // the application and the controller construct this object
+        for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+            read_status(cpu_idx, m_cache[cpu_idx]);
+        }
+    }
+
+    ApplicationStatusImp::m_app_status_s &ApplicationStatusImp::write_begin(int cpu_idx)
+    {
+        m_app_status_s &status = m_buffer[cpu_idx];
+        // An odd sequence number marks an update in progress and
+        // serializes writers to the same CPU
+        uint32_t seq = __atomic_load_n(&(status.seq), __ATOMIC_RELAXED);
+        uint32_t wait_seq = seq + 1;
+        geopm_time_s wait_start = {};
+        while (true) {
+            if ((seq & 1) == 0) {
+                if (__atomic_compare_exchange_n(&(status.seq), &seq, seq + 1, true,
+                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                    break;
+                }
+                continue;
+            }
+            if (seq != wait_seq) {
+                wait_seq = seq;
+                geopm_time(&wait_start);
+            }
+            else if (geopm_time_since(&wait_start) > m_write_timeout) {
+                if (is_writer_alive(__atomic_load_n(&(status.writer), __ATOMIC_RELAXED))) {
+                    // The writer is slow, e.g. it was descheduled,
+                    // so keep waiting for it
+                    geopm_time(&wait_start);
+                }
+                else if (__atomic_compare_exchange_n(&(status.seq), &seq, seq + 2, false,
+                                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                    // The writer exited part way through an update,
+                    // take over the entry and keep the sequence
+                    // number odd until write_end()
+                    break;
+                }
+            }
+            sched_yield();
+            seq = __atomic_load_n(&(status.seq), __ATOMIC_RELAXED);
+        }
+        // The PID is only read by other writers after a timeout, so
+        // it is only stored when another process wrote the entry last
+        if (__atomic_load_n(&(status.writer), __ATOMIC_RELAXED) != m_pid) {
+            __atomic_store_n(&(status.writer), m_pid, __ATOMIC_RELAXED);
+        }
+        return status;
+    }
+
+    bool ApplicationStatusImp::is_writer_alive(int32_t writer)
+    {
+        return writer > 0 && (kill(writer, 0) == 0 || errno != ESRCH);
+    }
+
+    void ApplicationStatusImp::write_end(int cpu_idx)
+    {
+        // Sequentially consistent so that the load of the dirty bit
+        // is not ordered before the sequence number is published: a
+        // set bit that update_cache() has not yet cleared guarantees
+        // that this update is read, and most updates skip the atomic
+        // write to the bitmap word shared with 63 other CPUs.
+        __atomic_add_fetch(&(m_buffer[cpu_idx].seq), 1, __ATOMIC_SEQ_CST);
+        uint64_t *dirty = m_dirty + cpu_idx / 64;
+        uint64_t mask = 1ULL << (cpu_idx % 64);
+        if ((__atomic_load_n(dirty, __ATOMIC_SEQ_CST) & mask) == 0) {
+            __atomic_fetch_or(dirty, mask, __ATOMIC_RELEASE);
+        }
+    }
+
+    bool ApplicationStatusImp::read_status(int cpu_idx, m_app_status_s &result) const
+    {
+        const m_app_status_s &status = m_buffer[cpu_idx];
+        for (int attempt = 0; attempt < M_MAX_READ_ATTEMPT; ++attempt) {
+            uint32_t seq = __atomic_load_n(&(status.seq), __ATOMIC_SEQ_CST);
+            if ((seq & 1) == 0) {
+                m_app_status_s copy = status;
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                if (__atomic_load_n(&(status.seq), __ATOMIC_RELAXED) == seq) {
+                    result = copy;
+                    return true;
+                }
+            }
+            else {
+                sched_yield();
+            }
+        }
+        return false;
     }
 
     void ApplicationStatusImp::set_hint(int cpu_idx, uint64_t hint)
@@ -57,8 +172,9 @@ namespace geopm
         }
         geopm::check_hint(hint);
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
-        // pack hint into 32 bits for atomic write
-        m_buffer[cpu_idx].hint = (uint32_t)hint;
+        m_app_status_s &status = write_begin(cpu_idx);
+        status.hint = (uint32_t)hint;
+        write_end(cpu_idx);
     }
 
     uint64_t ApplicationStatusImp::get_hint(int cpu_idx) const
@@ -67,7 +183,7 @@ namespace geopm
             throw Exception("ApplicationStatusImp::get_hint(): invalid CPU index: " + std::to_string(cpu_idx),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        GEOPM_DEBUG_ASSERT(m_cache.size() == buffer_size(m_num_cpu),
+        GEOPM_DEBUG_ASSERT(m_cache.size() == (size_t)m_num_cpu,
                            "Memory for m_cache not sized correctly");
         uint64_t result = (uint64_t)m_cache[cpu_idx].hint;
         geopm::check_hint(result);
@@ -86,8 +202,10 @@ namespace geopm
         }
         geopm::check_hint(hint);
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
-        m_buffer[cpu_idx].hash = (uint32_t)hash;
-        m_buffer[cpu_idx].hint = (uint32_t)hint;
+        m_app_status_s &status = write_begin(cpu_idx);
+        status.hash = (uint32_t)hash;
+        status.hint = (uint32_t)hint;
+        write_end(cpu_idx);
     }
 
     uint64_t ApplicationStatusImp::get_hash(int cpu_idx) const
@@ -96,7 +214,7 @@ namespace geopm
             throw Exception("ApplicationStatusImp::get_hash(): invalid CPU index: " + std::to_string(cpu_idx),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        GEOPM_DEBUG_ASSERT(m_cache.size() == buffer_size(m_num_cpu),
+        GEOPM_DEBUG_ASSERT(m_cache.size() == (size_t)m_num_cpu,
                            "Memory for m_cache not sized correctly");
         return m_cache[cpu_idx].hash;
     }
@@ -108,8 +226,10 @@ namespace geopm
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
-        m_buffer[cpu_idx].total_work = 0;
-        m_buffer[cpu_idx].completed_work = 0;
+        m_app_status_s &status = write_begin(cpu_idx);
+        status.total_work = 0;
+        status.completed_work = 0;
+        write_end(cpu_idx);
     }
 
     void ApplicationStatusImp::set_total_work_units(int cpu_idx, int work_units)
@@ -125,7 +245,9 @@ namespace geopm
         }
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
         // total_work non-zero gates per thread use of completed_work
-        m_buffer[cpu_idx].total_work = work_units;
+        m_app_status_s &status = write_begin(cpu_idx);
+        status.total_work = work_units;
+        write_end(cpu_idx);
     }
 
     void ApplicationStatusImp::increment_work_unit(int cpu_idx)
@@ -136,8 +258,13 @@ namespace geopm
         }
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
 
-        if (m_buffer[cpu_idx].total_work != 0) {
-            ++(m_buffer[cpu_idx].completed_work);
+        // Skip the update entirely when work units are not in use
+        if (__atomic_load_n(&(m_buffer[cpu_idx].total_work), __ATOMIC_RELAXED) != 0) {
+            m_app_status_s &status = write_begin(cpu_idx);
+            if (status.total_work != 0) {
+                ++(status.completed_work);
+            }
+            write_end(cpu_idx);
         }
     }
 
@@ -147,7 +274,7 @@ namespace geopm
             throw Exception("ApplicationStatusImp::get_progress_cpu(): invalid CPU index: " + std::to_string(cpu_idx),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        GEOPM_DEBUG_ASSERT(m_cache.size() == buffer_size(m_num_cpu),
+        GEOPM_DEBUG_ASSERT(m_cache.size() == (size_t)m_num_cpu,
                            "Memory for m_cache not sized correctly");
         double result = NAN;
         int total_work = m_cache[cpu_idx].total_work;
@@ -160,8 +287,72 @@ namespace geopm
     void ApplicationStatusImp::update_cache(void)
     {
         GEOPM_DEBUG_ASSERT(m_buffer != nullptr, "m_buffer not set");
-        GEOPM_DEBUG_ASSERT(m_cache.size() == buffer_size(m_num_cpu),
+        GEOPM_DEBUG_ASSERT(m_cache.size() == (size_t)m_num_cpu,
                            "Memory for m_cache not sized correctly");
-        std::copy(m_buffer, m_buffer + m_num_cpu, m_cache.begin());
+        GEOPM_DEBUG_ASSERT(m_dirty != nullptr, "m_dirty not set");
+        // Copy only the CPUs that were written since the last update
+        for (int word_idx = 0; word_idx < m_num_dirty; ++word_idx) {
+            uint64_t dirty = __atomic_exchange_n(m_dirty + word_idx, 0, __ATOMIC_SEQ_CST);
+            while (dirty != 0) {
+                int bit = __builtin_ctzll(dirty);
+                dirty &= dirty - 1;
+                int cpu_idx = 64 * word_idx + bit;
+                if (!read_status(cpu_idx, m_cache[cpu_idx])) {
+                    // A writer is stalled mid-update: keep the old
+                    // values and try again on the next update
+                    __atomic_fetch_or(m_dirty + word_idx, 1ULL << bit, __ATOMIC_RELAXED);
+                }
+            }
+        }
+    }
+
+    void ApplicationStatusImp::post_event(void)
+    {
+        GEOPM_DEBUG_ASSERT(m_event != nullptr, "m_event not set");
+        if (__atomic_load_n(&(m_event->is_enabled), __ATOMIC_RELAXED) == 0) {
+            return;
+        }
+        __atomic_add_fetch(&(m_event->count), 1, __ATOMIC_SEQ_CST);
+        // Only make the system call if the controller is sleeping,
+        // and only once per wait
+        if (__atomic_exchange_n(&(m_event->is_waiting), 0, __ATOMIC_SEQ_CST) != 0) {
+            syscall(SYS_futex, &(m_event->count), FUTEX_WAKE, INT_MAX,
+                    nullptr, nullptr, 0);
+        }
+    }
+
+    bool ApplicationStatusImp::wait_event(const geopm_time_s &deadline)
+    {
+        GEOPM_DEBUG_ASSERT(m_event != nullptr, "m_event not set");
+        __atomic_store_n(&(m_event->is_enabled), 1, __ATOMIC_RELAXED);
+        bool result = false;
+        geopm_time_s now;
+        geopm_time_real(&now);
+        while (!result && geopm_time_comp(&now, &deadline)) {
+            __atomic_store_n(&(m_event->is_waiting), 1, __ATOMIC_SEQ_CST);
+            uint32_t count = __atomic_load_n(&(m_event->count), __ATOMIC_SEQ_CST);
+            if (count != m_event_count_last) {
+                result = true;
+            }
+            else {
+                // The kernel returns EAGAIN if the count changed
+                // after it was loaded
+                long err = syscall(SYS_futex, &(m_event->count),
+                                   FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME,
+                                   count, &(deadline.t), nullptr,
+                                   FUTEX_BITSET_MATCH_ANY);
+                if (err == -1 && errno != EAGAIN && errno != EINTR &&
+                    errno != ETIMEDOUT) {
+                    throw Exception("ApplicationStatusImp::wait_event(): futex wait failed",
+                                    errno, __FILE__, __LINE__);
+                }
+                geopm_time_real(&now);
+            }
+        }
+        __atomic_store_n(&(m_event->is_waiting), 0, __ATOMIC_SEQ_CST);
+        // Events that arrive after the deadline are handled by the
+        // periodic step
+        m_event_count_last = __atomic_load_n(&(m_event->count), __ATOMIC_SEQ_CST);
+        return result;
     }
 }
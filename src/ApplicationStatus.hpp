@@ -13,6 +13,7 @@
 #include <set>
 
 #include "geopm/Helper.hpp"
+#include "geopm_time.h"
 
 namespace geopm
 {
@@ -64,7 +65,25 @@ namespace geopm
             /// @brief Updates the local memory with the latest values from
             ///        the shared memory.  Any calls to get methods will use
             ///        these values until the cache is updated again.
+            ///        Only CPUs written since the previous update are
+            ///        copied, and the values for each CPU are
+            ///        consistent with a single write.
             virtual void update_cache(void) = 0;
+            /// @brief Called by the application after a region entry
+            ///        is published to wake a controller blocked in
+            ///        wait_event().  Has no effect until the
+            ///        controller has called wait_event() at least
+            ///        once.
+            virtual void post_event(void) = 0;
+            /// @brief Called by the controller to block until an
+            ///        application calls post_event() or the deadline
+            ///        is reached.  Returns immediately if an event
+            ///        was posted since the last call.
+            /// @param [in] deadline Absolute time to stop waiting
+            ///        measured with geopm_time_real().
+            /// @return True if an event was posted before the
+            ///         deadline, false otherwise.
+            virtual bool wait_event(const geopm_time_s &deadline) = 0;
 
             /// @brief Create an ApplicationStatus object using the
             ///        given SharedMemory.  The caller is responsible
@@ -78,7 +97,11 @@ namespace geopm
                                                                   std::shared_ptr<SharedMemory> shmem);
             /// @brief Return the required size of the shared memory
             ///        region used by the ApplicationStatus for the
-            ///        given number of CPUs.
+            ///        given number of CPUs.  This includes one
+            ///        status entry per CPU followed by the event
+            ///        counter used by post_event() and wait_event()
+            ///        and a bitmap of the CPUs updated since the last
+            ///        call to update_cache().
             /// @return Minimum buffer size required for the
             ///         SharedMemory used by ApplicationStatus.
             static size_t buffer_size(int num_cpu);
@@ -92,6 +115,13 @@ namespace geopm
         public:
             ApplicationStatusImp(int num_cpu,
                                  std::shared_ptr<SharedMemory> shmem);
+            /// @param [in] write_timeout Time in seconds that a writer
+            ///        waits for an update of the same CPU by another
+            ///        writer before checking whether that writer
+            ///        died.
+            ApplicationStatusImp(int num_cpu,
+                                 std::shared_ptr<SharedMemory> shmem,
+                                 double write_timeout);
             virtual ~ApplicationStatusImp() = default;
             void set_hint(int cpu_idx, uint64_t hint) override;
             uint64_t get_hint(int cpu_idx) const override;
@@ -102,26 +132,61 @@ namespace geopm
             void increment_work_unit(int cpu_idx) override;
             double get_progress_cpu(int cpu_idx) const override;
             void update_cache(void) override;
+            void post_event(void) override;
+            bool wait_event(const geopm_time_s &deadline) override;
         private:
-            // These fields must all be 32-bit int
+            // Each entry is a seqlock: seq is odd while a writer is
+            // updating the fields
             struct m_app_status_s
             {
+                uint32_t seq;
                 int32_t process; // can be negative, indicating unset process
                 uint32_t hint;
                 uint32_t hash;
                 uint32_t total_work;
                 uint32_t completed_work;
-                char padding[44];
+                int32_t writer; // PID of the last writer, zero if unknown
+                char padding[36];
             };
             static_assert((sizeof(ApplicationStatusImp::m_app_status_s) % geopm::hardware_destructive_interference_size) == 0,
                           "m_app_status_s not aligned to cache lines");
             static_assert(sizeof(ApplicationStatusImp::m_app_status_s) == ApplicationStatus::M_STATUS_SIZE,
                           "M_STATUS_SIZE does not match size of m_app_status_s");
+            // Futex shared by all processes, stored after the last CPU
+            struct m_event_s
+            {
+                uint32_t is_enabled;
+                uint32_t count;
+                uint32_t is_waiting;
+                char padding[52];
+            };
+            static_assert(sizeof(ApplicationStatusImp::m_event_s) == ApplicationStatus::M_STATUS_SIZE,
+                          "M_STATUS_SIZE does not match size of m_event_s");
+            static constexpr int M_MAX_READ_ATTEMPT = 1024;
+            /// @brief Default time in seconds that a writer waits for
+            ///        an update of the same CPU by another writer
+            ///        before checking whether the other writer died.
+            static constexpr double M_WRITE_TIMEOUT = 1.0;
+
+            m_app_status_s &write_begin(int cpu_idx);
+            void write_end(int cpu_idx);
+            bool read_status(int cpu_idx, m_app_status_s &result) const;
+            /// @brief Returns false only if the process that holds
+            ///        the entry is known to have exited.
+            static bool is_writer_alive(int32_t writer);
 
             int m_num_cpu;
             std::shared_ptr<SharedMemory> m_shmem;
+            const double m_write_timeout;
+            const int32_t m_pid;
             m_app_status_s *m_buffer;
             std::vector<m_app_status_s> m_cache;
+            m_event_s *m_event;
+            uint32_t m_event_count_last;
+            // Bit per CPU set by writers and cleared by update_cache(),
+            // stored after the event counter
+            uint64_t *m_dirty;
+            int m_num_dirty;
     };
 }
 
@@ -387,6 +387,8 @@ namespace geopm
         m_reporter->total_time(m_application_sampler.total_time());
         m_reporter->overhead(m_application_sampler.overhead_time(),
                              sample_delay);
+        m_reporter->step_count(m_application_sampler.num_event_step(),
+                               m_application_sampler.num_period_step());
         generate();
         m_platform_io.restore_control();
     }
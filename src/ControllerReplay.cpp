@@ -0,0 +1,783 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "ControllerReplay.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <sstream>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "geopm_time.h"
+#include "Agent.hpp"
+#include "ApplicationIO.hpp"
+#include "CombinedControl.hpp"
+#include "CombinedSignal.hpp"
+#include "Comm.hpp"
+#include "Controller.hpp"
+#include "EndpointPolicyTracer.hpp"
+#include "EndpointUser.hpp"
+#include "EpochIOGroup.hpp"
+#include "FrequencyMapAgent.hpp"
+#include "InitControl.hpp"
+#include "MonitorAgent.hpp"
+#include "PlatformIOImp.hpp"
+#include "PowerGovernorAgent.hpp"
+#include "PowerGovernorImp.hpp"
+#include "ProcessRegionAggregator.hpp"
+#include "ProfileIOGroup.hpp"
+#include "ProfileTracerImp.hpp"
+#include "ReplayApplicationSampler.hpp"
+#include "ReplayIOGroup.hpp"
+#include "Reporter.hpp"
+#include "SampleAggregatorImp.hpp"
+#include "Tracer.hpp"
+#include "TreeComm.hpp"
+#include "Waiter.hpp"
+#include "record.hpp"
+
+namespace geopm
+{
+    /// Accumulates the time spent in each stage of the controller
+    /// step.  Stage times are only recorded while the controller is
+    /// stepping so that start up and shut down are excluded.
+    class ReplayStageTimer
+    {
+        public:
+            enum m_stage_e {
+                M_STAGE_STEP,
+                M_STAGE_WALK_DOWN,
+                M_STAGE_AGENT_WAIT,
+                M_STAGE_WALK_UP,
+                M_STAGE_SAMPLER_UPDATE,
+                M_STAGE_REPORTER,
+                M_STAGE_TRACER,
+                M_STAGE_PROFILE_TRACER,
+                M_STAGE_REPLAY,
+                M_NUM_STAGE,
+            };
+
+            ReplayStageTimer()
+                : m_stats {
+                      {"step", 0, 0.0, INFINITY, 0.0},
+                      {"walk_down", 0, 0.0, INFINITY, 0.0},
+                      {"agent_wait", 0, 0.0, INFINITY, 0.0},
+                      {"walk_up", 0, 0.0, INFINITY, 0.0},
+                      {"sampler_update", 0, 0.0, INFINITY, 0.0},
+                      {"reporter", 0, 0.0, INFINITY, 0.0},
+                      {"tracer", 0, 0.0, INFINITY, 0.0},
+                      {"profile_tracer", 0, 0.0, INFINITY, 0.0},
+                      {"replay", 0, 0.0, INFINITY, 0.0},
+                  }
+                , m_step_begin({{0, 0}})
+                , m_wait_begin({{0, 0}})
+                , m_wait_end({{0, 0}})
+                , m_is_stepping(false)
+                , m_replay_step(0.0)
+                , m_replay_walk_up(0.0)
+            {
+
+            }
+
+            virtual ~ReplayStageTimer() = default;
+
+            /// Called between controller steps.  Completes the step
+            /// in progress and begins the next one unless the
+            /// controller is shutting down.
+            void step_boundary(bool is_final)
+            {
+                geopm_time_s now;
+                geopm_time(&now);
+                if (m_is_stepping) {
+                    add(M_STAGE_WALK_UP, geopm_time_diff(&m_wait_end, &now) - m_replay_walk_up);
+                    add(M_STAGE_STEP, geopm_time_diff(&m_step_begin, &now) - m_replay_step);
+                }
+                m_is_stepping = !is_final;
+                m_step_begin = now;
+                m_replay_step = 0.0;
+                m_replay_walk_up = 0.0;
+            }
+
+            void wait_begin(void)
+            {
+                geopm_time(&m_wait_begin);
+                if (m_is_stepping) {
+                    add(M_STAGE_WALK_DOWN, geopm_time_diff(&m_step_begin, &m_wait_begin));
+                }
+            }
+
+            void wait_end(void)
+            {
+                geopm_time(&m_wait_end);
+                if (m_is_stepping) {
+                    add(M_STAGE_AGENT_WAIT, geopm_time_diff(&m_wait_begin, &m_wait_end));
+                }
+            }
+
+            /// Record a stage that began at the given time and ends
+            /// now, excluding the replay time spent within it.
+            void stage(int stage, const geopm_time_s &begin, double replay_time)
+            {
+                if (m_is_stepping) {
+                    add(stage, geopm_time_since(&begin) - replay_time);
+                }
+            }
+
+            /// Record time spent writing replayed data, which is
+            /// excluded from the step.  Replayed data is only written
+            /// while walking up the tree.
+            void replay(double replay_time)
+            {
+                if (m_is_stepping) {
+                    add(M_STAGE_REPLAY, replay_time);
+                    m_replay_step += replay_time;
+                    m_replay_walk_up += replay_time;
+                }
+            }
+
+            std::vector<ControllerReplay::stage_stats_s> stats(void) const
+            {
+                return m_stats;
+            }
+
+        private:
+            void add(int stage, double duration)
+            {
+                auto &stats = m_stats[stage];
+                ++stats.count;
+                stats.total += duration;
+                stats.min = std::min(stats.min, duration);
+                stats.max = std::max(stats.max, duration);
+            }
+
+            std::vector<ControllerReplay::stage_stats_s> m_stats;
+            geopm_time_s m_step_begin;
+            geopm_time_s m_wait_begin;
+            geopm_time_s m_wait_end;
+            bool m_is_stepping;
+            double m_replay_step;
+            double m_replay_walk_up;
+    };
+
+    namespace
+    {
+        /// Waiter that either returns immediately or sleeps until
+        /// the replay reaches the recorded time of the next sample.
+        /// After reset(period) a real time replay is paced by the
+        /// given period instead of the recorded times.
+        class ReplayWaiter : public Waiter
+        {
+            public:
+                ReplayWaiter(const std::vector<double> &row_time, bool is_real_time)
+                    : m_row_time(row_time)
+                    , m_is_real_time(is_real_time)
+                    , m_period(0.0)
+                    , m_is_fixed_period(false)
+                    , m_num_wait(0)
+                    , m_time_begin({{0, 0}})
+                {
+                    if (m_row_time.size() > 1) {
+                        m_period = (m_row_time.back() - m_row_time.front()) /
+                                   (m_row_time.size() - 1);
+                    }
+                    reset();
+                }
+
+                virtual ~ReplayWaiter() = default;
+
+                void reset(void) override
+                {
+                    geopm_time_real(&m_time_begin);
+                    m_num_wait = 0;
+                }
+
+                void reset(double period) override
+                {
+                    m_period = period;
+                    m_is_fixed_period = true;
+                    reset();
+                }
+
+                void wait(void) override
+                {
+                    ++m_num_wait;
+                    if (!m_is_real_time) {
+                        return;
+                    }
+                    geopm_time_s target;
+                    if (m_is_fixed_period) {
+                        geopm_time_add(&m_time_begin, m_num_wait * m_period, &target);
+                    }
+                    else {
+                        size_t row_idx = std::min(m_num_wait, m_row_time.size() - 1);
+                        geopm_time_add(&m_time_begin, m_row_time[row_idx] - m_row_time[0], &target);
+                    }
+                    time_sleep_until_real(target);
+                }
+
+                double period(void) const override
+                {
+                    return m_period;
+                }
+
+            private:
+                const std::vector<double> m_row_time;
+                const bool m_is_real_time;
+                double m_period;
+                bool m_is_fixed_period;
+                size_t m_num_wait;
+                geopm_time_s m_time_begin;
+        };
+
+        /// ApplicationIO for the replayed processes.  The
+        /// controller checks for shutdown between every step, which
+        /// is used to mark the step boundaries.
+        class ReplayApplicationIO : public ApplicationIO
+        {
+            public:
+                ReplayApplicationIO(const ApplicationSampler &sampler,
+                                    std::shared_ptr<ReplayStageTimer> timer)
+                    : m_sampler(sampler)
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~ReplayApplicationIO() = default;
+
+                std::vector<int> connect(void) override
+                {
+                    return m_sampler.client_pids();
+                }
+
+                bool do_shutdown(void) override
+                {
+                    m_timer->step_boundary(m_sampler.do_shutdown());
+                    return false;
+                }
+
+                std::set<std::string> region_name_set(void) const override
+                {
+                    return {};
+                }
+
+            private:
+                const ApplicationSampler &m_sampler;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        class TimedApplicationSampler : public ApplicationSampler
+        {
+            public:
+                TimedApplicationSampler(ReplayApplicationSampler &sampler,
+                                        std::shared_ptr<ReplayStageTimer> timer)
+                    : m_sampler(sampler)
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~TimedApplicationSampler() = default;
+
+                void update(const geopm_time_s &curr_time) override
+                {
+                    geopm_time_s begin;
+                    geopm_time(&begin);
+                    m_sampler.update(curr_time);
+                    double replay_time = m_sampler.last_replay_time();
+                    m_timer->stage(ReplayStageTimer::M_STAGE_SAMPLER_UPDATE, begin, replay_time);
+                    m_timer->replay(replay_time);
+                }
+
+                std::vector<record_s> get_records(void) const override
+                {
+                    return m_sampler.get_records();
+                }
+
+                short_region_s get_short_region(uint64_t event_signal) const override
+                {
+                    return m_sampler.get_short_region(event_signal);
+                }
+
+                uint64_t cpu_region_hash(int cpu_idx) const override
+                {
+                    return m_sampler.cpu_region_hash(cpu_idx);
+                }
+
+                uint64_t cpu_hint(int cpu_idx) const override
+                {
+                    return m_sampler.cpu_hint(cpu_idx);
+                }
+
+                double cpu_hint_time(int cpu_idx, uint64_t hint) const override
+                {
+                    return m_sampler.cpu_hint_time(cpu_idx, hint);
+                }
+
+                double cpu_progress(int cpu_idx) const override
+                {
+                    return m_sampler.cpu_progress(cpu_idx);
+                }
+
+                void connect(const std::vector<int> &client_pids) override
+                {
+                    m_sampler.connect(client_pids);
+                }
+
+                std::vector<int> client_pids(void) const override
+                {
+                    return m_sampler.client_pids();
+                }
+
+                std::set<int> client_cpu_set(int client_pid) const override
+                {
+                    return m_sampler.client_cpu_set(client_pid);
+                }
+
+                bool do_shutdown(void) const override
+                {
+                    return m_sampler.do_shutdown();
+                }
+
+                double total_time(void) const override
+                {
+                    return m_sampler.total_time();
+                }
+
+                double overhead_time(void) const override
+                {
+                    return m_sampler.overhead_time();
+                }
+
+                bool wait_event(const geopm_time_s &deadline) override
+                {
+                    return m_sampler.wait_event(deadline);
+                }
+
+                int num_event_step(void) const override
+                {
+                    return m_sampler.num_event_step();
+                }
+
+                int num_period_step(void) const override
+                {
+                    return m_sampler.num_period_step();
+                }
+
+            private:
+                ReplayApplicationSampler &m_sampler;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        class TimedAgent : public Agent
+        {
+            public:
+                TimedAgent(std::unique_ptr<Agent> agent,
+                           std::shared_ptr<ReplayStageTimer> timer)
+                    : m_agent(std::move(agent))
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~TimedAgent() = default;
+
+                void init(int level, const std::vector<int> &fan_in, bool is_level_root) override
+                {
+                    m_agent->init(level, fan_in, is_level_root);
+                }
+
+                void validate_policy(std::vector<double> &policy) const override
+                {
+                    m_agent->validate_policy(policy);
+                }
+
+                void split_policy(const std::vector<double> &in_policy,
+                                  std::vector<std::vector<double> > &out_policy) override
+                {
+                    m_agent->split_policy(in_policy, out_policy);
+                }
+
+                bool do_send_policy(void) const override
+                {
+                    return m_agent->do_send_policy();
+                }
+
+                void aggregate_sample(const std::vector<std::vector<double> > &in_sample,
+                                      std::vector<double> &out_sample) override
+                {
+                    m_agent->aggregate_sample(in_sample, out_sample);
+                }
+
+                bool do_send_sample(void) const override
+                {
+                    return m_agent->do_send_sample();
+                }
+
+                void adjust_platform(const std::vector<double> &in_policy) override
+                {
+                    m_agent->adjust_platform(in_policy);
+                }
+
+                bool do_write_batch(void) const override
+                {
+                    return m_agent->do_write_batch();
+                }
+
+                void sample_platform(std::vector<double> &out_sample) override
+                {
+                    m_agent->sample_platform(out_sample);
+                }
+
+                void wait(void) override
+                {
+                    m_timer->wait_begin();
+                    m_agent->wait();
+                    m_timer->wait_end();
+                }
+
+                std::vector<std::pair<std::string, std::string> > report_header(void) const override
+                {
+                    return m_agent->report_header();
+                }
+
+                std::vector<std::pair<std::string, std::string> > report_host(void) const override
+                {
+                    return m_agent->report_host();
+                }
+
+                std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > report_region(void) const override
+                {
+                    return m_agent->report_region();
+                }
+
+                std::vector<std::string> trace_names(void) const override
+                {
+                    return m_agent->trace_names();
+                }
+
+                std::vector<std::function<std::string(double)> > trace_formats(void) const override
+                {
+                    return m_agent->trace_formats();
+                }
+
+                void trace_values(std::vector<double> &values) override
+                {
+                    m_agent->trace_values(values);
+                }
+
+                void enforce_policy(const std::vector<double> &policy) const override
+                {
+                    m_agent->enforce_policy(policy);
+                }
+
+            private:
+                std::unique_ptr<Agent> m_agent;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        class TimedReporter : public Reporter
+        {
+            public:
+                TimedReporter(std::unique_ptr<Reporter> reporter,
+                              std::shared_ptr<ReplayStageTimer> timer)
+                    : m_reporter(std::move(reporter))
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~TimedReporter() = default;
+
+                void init(void) override
+                {
+                    m_reporter->init();
+                }
+
+                void update(void) override
+                {
+                    geopm_time_s begin;
+                    geopm_time(&begin);
+                    m_reporter->update();
+                    m_timer->stage(ReplayStageTimer::M_STAGE_REPORTER, begin, 0.0);
+                }
+
+                void generate(const std::string &agent_name,
+                              const std::vector<std::pair<std::string, std::string> > &agent_report_header,
+                              const std::vector<std::pair<std::string, std::string> > &agent_host_report,
+                              const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report,
+                              const ApplicationIO &application_io,
+                              std::shared_ptr<Comm> comm,
+                              const TreeComm &tree_comm) override
+                {
+                    m_reporter->generate(agent_name, agent_report_header, agent_host_report,
+                                         agent_region_report, application_io, comm, tree_comm);
+                }
+
+                std::string generate(const std::string &profile_name,
+                                     const std::string &agent_name,
+                                     const std::vector<std::pair<std::string, std::string> > &agent_report_header,
+                                     const std::vector<std::pair<std::string, std::string> > &agent_host_report,
+                                     const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report) override
+                {
+                    return m_reporter->generate(profile_name, agent_name, agent_report_header,
+                                                agent_host_report, agent_region_report);
+                }
+
+                void total_time(double total) override
+                {
+                    m_reporter->total_time(total);
+                }
+
+                void overhead(double overhead_sec, double sample_delay) override
+                {
+                    m_reporter->overhead(overhead_sec, sample_delay);
+                }
+
+                void step_count(int num_event_step, int num_period_step) override
+                {
+                    m_reporter->step_count(num_event_step, num_period_step);
+                }
+
+            private:
+                std::unique_ptr<Reporter> m_reporter;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        class TimedTracer : public Tracer
+        {
+            public:
+                TimedTracer(std::unique_ptr<Tracer> tracer,
+                            std::shared_ptr<ReplayStageTimer> timer)
+                    : m_tracer(std::move(tracer))
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~TimedTracer() = default;
+
+                void columns(const std::vector<std::string> &agent_cols,
+                             const std::vector<std::function<std::string(double)> > &agent_formats) override
+                {
+                    m_tracer->columns(agent_cols, agent_formats);
+                }
+
+                void update(const std::vector<double> &agent_signals) override
+                {
+                    geopm_time_s begin;
+                    geopm_time(&begin);
+                    m_tracer->update(agent_signals);
+                    m_timer->stage(ReplayStageTimer::M_STAGE_TRACER, begin, 0.0);
+                }
+
+                void flush(void) override
+                {
+                    m_tracer->flush();
+                }
+
+            private:
+                std::unique_ptr<Tracer> m_tracer;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        class TimedProfileTracer : public ProfileTracer
+        {
+            public:
+                TimedProfileTracer(std::unique_ptr<ProfileTracer> tracer,
+                                   std::shared_ptr<ReplayStageTimer> timer)
+                    : m_tracer(std::move(tracer))
+                    , m_timer(std::move(timer))
+                {
+
+                }
+
+                virtual ~TimedProfileTracer() = default;
+
+                void update(const std::vector<record_s> &records) override
+                {
+                    geopm_time_s begin;
+                    geopm_time(&begin);
+                    m_tracer->update(records);
+                    m_timer->stage(ReplayStageTimer::M_STAGE_PROFILE_TRACER, begin, 0.0);
+                }
+
+            private:
+                std::unique_ptr<ProfileTracer> m_tracer;
+                std::shared_ptr<ReplayStageTimer> m_timer;
+        };
+
+        std::string replay_start_time(void)
+        {
+            const int buf_size = 64;
+            char time_buff[buf_size];
+            geopm_time_string(buf_size, time_buff);
+            std::string result(time_buff);
+            result.erase(std::remove(result.begin(), result.end(), '\n'), result.end());
+            return result;
+        }
+
+        std::unique_ptr<Agent> make_replay_agent(const std::string &agent_name,
+                                                 PlatformIO &platform_io,
+                                                 const PlatformTopo &topo,
+                                                 std::shared_ptr<Waiter> waiter)
+        {
+            std::unique_ptr<Agent> result;
+            // The agents are constructed directly so that they use
+            // the replayed platform rather than the PlatformIO
+            // singleton.
+            if (agent_name == MonitorAgent::plugin_name()) {
+                result = geopm::make_unique<MonitorAgent>(platform_io, topo, waiter);
+            }
+            else if (agent_name == PowerGovernorAgent::plugin_name()) {
+                result = geopm::make_unique<PowerGovernorAgent>(
+                    platform_io, geopm::make_unique<PowerGovernorImp>(platform_io, topo), waiter);
+            }
+            else if (agent_name == FrequencyMapAgent::plugin_name()) {
+                result = geopm::make_unique<FrequencyMapAgent>(platform_io, topo, waiter);
+            }
+            else {
+                throw Exception("ControllerReplay: agent not supported for replay: " + agent_name,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            return result;
+        }
+    }
+
+    ControllerReplay::ControllerReplay(const std::string &agent_name,
+                                       const std::string &trace_path,
+                                       const std::string &profile_trace_path,
+                                       const std::string &policy_path,
+                                       const std::map<std::string, double> &constant_signal,
+                                       const std::map<std::string, double> &control,
+                                       bool is_real_time,
+                                       const std::string &report_path,
+                                       const std::string &trace_out_path,
+                                       const std::string &profile_trace_out_path)
+        : ControllerReplay(agent_name, trace_path, profile_trace_path, policy_path,
+                           constant_signal, control, is_real_time, report_path,
+                           trace_out_path, profile_trace_out_path, platform_topo())
+    {
+
+    }
+
+    ControllerReplay::ControllerReplay(const std::string &agent_name,
+                                       const std::string &trace_path,
+                                       const std::string &profile_trace_path,
+                                       const std::string &policy_path,
+                                       const std::map<std::string, double> &constant_signal,
+                                       const std::map<std::string, double> &control,
+                                       bool is_real_time,
+                                       const std::string &report_path,
+                                       const std::string &trace_out_path,
+                                       const std::string &profile_trace_out_path,
+                                       const PlatformTopo &topo)
+        : m_topo(topo)
+        , m_iogroup(std::make_shared<ReplayIOGroup>(trace_path, m_topo, constant_signal, control))
+        , m_replay_sampler(geopm::make_unique<ReplayApplicationSampler>(
+              profile_trace_path, m_iogroup->row_time(), m_topo, m_iogroup->profile_name()))
+        , m_timer(std::make_shared<ReplayStageTimer>())
+        , m_sampler(geopm::make_unique<TimedApplicationSampler>(*m_replay_sampler, m_timer))
+    {
+        // IOGroups registered later take precedence, so the
+        // application signals are provided by the live IOGroups
+        // rather than the replayed trace.
+        std::list<std::shared_ptr<IOGroup> > iogroup_list {
+            m_iogroup,
+            std::make_shared<ProfileIOGroup>(m_topo, *m_sampler),
+            std::make_shared<EpochIOGroup>(m_topo, *m_sampler),
+        };
+        m_platform_io = geopm::make_unique<PlatformIOImp>(iogroup_list, m_topo);
+
+        std::string start_time = replay_start_time();
+        std::string host_name = hostname();
+        std::shared_ptr<Comm> comm = std::make_shared<NullComm>();
+        int num_policy = Agent::num_policy(agent_name);
+        int num_sample = Agent::num_sample(agent_name);
+        auto waiter = std::make_shared<ReplayWaiter>(m_iogroup->row_time(), is_real_time);
+        std::vector<std::unique_ptr<Agent> > agent;
+        agent.push_back(geopm::make_unique<TimedAgent>(
+            make_replay_agent(agent_name, *m_platform_io, m_topo, waiter), m_timer));
+        auto reporter = geopm::make_unique<ReporterImp>(
+            start_time, *m_platform_io, m_topo, 0,
+            std::make_shared<SampleAggregatorImp>(*m_platform_io),
+            std::make_shared<ProcessRegionAggregatorImp>(*m_sampler),
+            report_path, std::vector<std::pair<std::string, int> >{},
+            policy_path, false, m_iogroup->profile_name(), false);
+        auto tracer = geopm::make_unique<TracerImp>(
+            start_time, trace_out_path, host_name, !trace_out_path.empty(),
+            *m_platform_io, m_topo, std::vector<std::pair<std::string, int> >{});
+        auto profile_tracer = geopm::make_unique<ProfileTracerImp>(
+            start_time, geopm::time_zero(), 1024 * 1024, !profile_trace_out_path.empty(),
+            profile_trace_out_path, host_name, *m_sampler);
+        m_controller = geopm::make_unique<Controller>(
+            comm, *m_platform_io, agent_name, num_policy, num_sample,
+            geopm::make_unique<TreeCommImp>(comm, num_policy, num_sample),
+            *m_sampler,
+            std::make_shared<ReplayApplicationIO>(*m_sampler, m_timer),
+            geopm::make_unique<TimedReporter>(std::move(reporter), m_timer),
+            geopm::make_unique<TimedTracer>(std::move(tracer), m_timer),
+            std::unique_ptr<EndpointPolicyTracer>(nullptr),
+            std::make_shared<TimedProfileTracer>(std::move(profile_tracer), m_timer),
+            std::move(agent),
+            Agent::policy_names(agent_name),
+            policy_path,
+            !policy_path.empty(),
+            std::unique_ptr<EndpointUser>(nullptr),
+            "",
+            false,
+            std::make_shared<InitControlImp>(*m_platform_io),
+            false);
+    }
+
+    ControllerReplay::~ControllerReplay() = default;
+
+    void ControllerReplay::run(void)
+    {
+        m_controller->run();
+    }
+
+    std::vector<ControllerReplay::stage_stats_s> ControllerReplay::stage_stats(void) const
+    {
+        return m_timer->stats();
+    }
+
+    std::string ControllerReplay::stage_table(void) const
+    {
+        std::ostringstream result;
+        result << std::left << std::setw(16) << "stage"
+               << std::right << std::setw(10) << "count"
+               << std::setw(14) << "total (s)"
+               << std::setw(14) << "mean (us)"
+               << std::setw(14) << "min (us)"
+               << std::setw(14) << "max (us)" << "\n";
+        for (const auto &stats : m_timer->stats()) {
+            result << std::left << std::setw(16) << stats.name
+                   << std::right << std::setw(10) << stats.count
+                   << std::fixed << std::setprecision(6)
+                   << std::setw(14) << stats.total
+                   << std::setprecision(2);
+            if (stats.count != 0) {
+                result << std::setw(14) << 1e6 * stats.total / stats.count
+                       << std::setw(14) << 1e6 * stats.min
+                       << std::setw(14) << 1e6 * stats.max;
+            }
+            else {
+                result << std::setw(14) << "-"
+                       << std::setw(14) << "-"
+                       << std::setw(14) << "-";
+            }
+            result << "\n";
+        }
+        return result.str();
+    }
+}
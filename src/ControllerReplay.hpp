@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONTROLLERREPLAY_HPP_INCLUDE
+#define CONTROLLERREPLAY_HPP_INCLUDE
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace geopm
+{
+    class ApplicationSampler;
+    class Controller;
+    class PlatformIO;
+    class PlatformTopo;
+    class ReplayApplicationSampler;
+    class ReplayIOGroup;
+    class ReplayStageTimer;
+
+    /// @brief Drives the Controller loop with data recorded by a
+    ///        previous run in order to measure the overhead of each
+    ///        stage of the loop without hardware or an application.
+    ///
+    /// The controller trace (Tracer output) is replayed through a
+    /// ReplayIOGroup and the profile trace (ProfileTracer output) is
+    /// replayed through a ReplayApplicationSampler.  The unmodified
+    /// Controller runs one step for each row of the controller trace
+    /// with a single level tree, and the time spent in each stage of
+    /// the step is recorded:
+    ///
+    ///   - "walk_down": policy handling and Agent::adjust_platform().
+    ///   - "agent_wait": Agent::wait().
+    ///   - "walk_up": sampling, reporting and tracing.
+    ///   - "sampler_update", "reporter", "tracer", "profile_tracer":
+    ///     the parts of walk_up spent in ApplicationSampler::update(),
+    ///     Reporter::update(), Tracer::update() and
+    ///     ProfileTracer::update().
+    ///
+    /// Time spent writing the replayed data is reported as
+    /// "replay" and is excluded from the other stages.
+    class ControllerReplay
+    {
+        public:
+            struct stage_stats_s {
+                std::string name;
+                int count;
+                double total;
+                double min;
+                double max;
+            };
+            /// @param [in] agent_name Name of the agent to run.  The
+            ///        supported agents are "monitor",
+            ///        "power_governor" and "frequency_map".
+            /// @param [in] trace_path Path to the controller trace
+            ///        to replay.
+            /// @param [in] profile_trace_path Path to the profile
+            ///        trace to replay.
+            /// @param [in] policy_path Path to the policy file for
+            ///        the agent, may be empty if the agent has no
+            ///        policy.
+            /// @param [in] constant_signal Constant signals added to
+            ///        the replayed platform, see ReplayIOGroup.
+            /// @param [in] control Controls added to the replayed
+            ///        platform, see ReplayIOGroup.
+            /// @param [in] is_real_time If true the agent waits until
+            ///        the recorded time of each sample, otherwise the
+            ///        replay runs as fast as possible.
+            /// @param [in] report_path Path for the report generated
+            ///        by the replay, or empty for no report.
+            /// @param [in] trace_out_path Path for the controller
+            ///        trace generated by the replay, or empty for no
+            ///        trace.
+            /// @param [in] profile_trace_out_path Path for the profile
+            ///        trace generated by the replay, or empty for no
+            ///        profile trace.
+            ControllerReplay(const std::string &agent_name,
+                             const std::string &trace_path,
+                             const std::string &profile_trace_path,
+                             const std::string &policy_path,
+                             const std::map<std::string, double> &constant_signal,
+                             const std::map<std::string, double> &control,
+                             bool is_real_time,
+                             const std::string &report_path,
+                             const std::string &trace_out_path,
+                             const std::string &profile_trace_out_path);
+            /// @brief Constructor that replays onto the given
+            ///        platform topology rather than the topology of
+            ///        the host.
+            ///
+            /// @param [in] topo Platform topology of the replayed
+            ///        platform.  Other parameters are the same as
+            ///        the constructor above.
+            ControllerReplay(const std::string &agent_name,
+                             const std::string &trace_path,
+                             const std::string &profile_trace_path,
+                             const std::string &policy_path,
+                             const std::map<std::string, double> &constant_signal,
+                             const std::map<std::string, double> &control,
+                             bool is_real_time,
+                             const std::string &report_path,
+                             const std::string &trace_out_path,
+                             const std::string &profile_trace_out_path,
+                             const PlatformTopo &topo);
+            virtual ~ControllerReplay();
+            /// @brief Run the controller over the full trace.
+            void run(void);
+            /// @brief Timing statistics for each stage of the
+            ///        controller step, in seconds.
+            std::vector<stage_stats_s> stage_stats(void) const;
+            /// @brief Format the stage statistics as a table.
+            std::string stage_table(void) const;
+        private:
+            const PlatformTopo &m_topo;
+            std::shared_ptr<ReplayIOGroup> m_iogroup;
+            std::unique_ptr<ReplayApplicationSampler> m_replay_sampler;
+            std::shared_ptr<ReplayStageTimer> m_timer;
+            std::unique_ptr<ApplicationSampler> m_sampler;
+            std::unique_ptr<PlatformIO> m_platform_io;
+            std::unique_ptr<Controller> m_controller;
+    };
+}
+
+#endif
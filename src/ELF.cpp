@@ -15,6 +15,9 @@
 #include <cxxabi.h>
 #include <limits.h>
 #include <iostream>
+#include <algorithm>
+#include <vector>
+#include <mutex>
 
 #include "ELF.hpp"
 #include "geopm/Exception.hpp"
@@ -78,7 +81,51 @@ namespace geopm
         return result;
     }
 
+    class SymbolIndexImp : public SymbolIndex
+    {
+        public:
+            SymbolIndexImp();
+            virtual ~SymbolIndexImp() = default;
+            std::pair<size_t, std::string> symbol(const void *instruction_ptr) override;
+            std::pair<size_t, std::string> symbol(const std::string &file_path,
+                                                  size_t offset) override;
+            int num_object(void) const override;
+        private:
+            /// @brief Address sorted symbol table for one object
+            ///        file stored as parallel vectors.
+            struct m_object_s {
+                std::vector<size_t> offset;
+                std::vector<std::string> name;
+            };
+            const m_object_s &object(const std::string &file_path);
+            static void load_object(const std::string &file_path,
+                                    m_object_s &object);
+            std::map<std::string, std::unique_ptr<m_object_s> > m_object_map;
+            mutable std::mutex m_object_lock;
+    };
+
     std::pair<size_t, std::string> symbol_lookup(const void *instruction_ptr)
+    {
+        return SymbolIndex::symbol_index().symbol(instruction_ptr);
+    }
+
+    SymbolIndex &SymbolIndex::symbol_index(void)
+    {
+        static SymbolIndexImp instance;
+        return instance;
+    }
+
+    std::unique_ptr<SymbolIndex> SymbolIndex::make_unique(void)
+    {
+        return geopm::make_unique<SymbolIndexImp>();
+    }
+
+    SymbolIndexImp::SymbolIndexImp()
+    {
+
+    }
+
+    std::pair<size_t, std::string> SymbolIndexImp::symbol(const void *instruction_ptr)
     {
         std::pair<size_t, std::string> result(0, "");
         size_t target = (size_t)instruction_ptr;
@@ -116,27 +163,13 @@ namespace geopm
                         file_name = file_name_cstr;
                     }
                 }
-                // Generate the symbol map from the object file and
-                // find the target address
-                try {
-                    std::map<size_t, std::string> symbol_map(elf_symbol_map(file_name));
-                    auto symbol_it = symbol_map.upper_bound(target);
-                    if (symbol_it != symbol_map.begin()) {
-                        --symbol_it;
-                    }
-                    if (symbol_it->first <= target) {
-                        result = *symbol_it;
-                        // Add back the random base address so it can be
-                        // compared with the input.
-                        result.first += base_addr;
-                    }
-                }
-                catch (const Exception &ex) {
-                   // If the ELF read fails, just swallow the exception
-                   std::string what(ex.what());
-                   if (what.find("ELFImp") == std::string::npos) {
-                       throw ex;
-                   }
+                // Find the target address in the indexed symbol
+                // table of the object file
+                result = symbol(file_name, target);
+                if (result.second.size()) {
+                    // Add back the random base address so it can be
+                    // compared with the input.
+                    result.first += base_addr;
                 }
             }
         }
@@ -151,6 +184,95 @@ namespace geopm
         return result;
     }
 
+    std::pair<size_t, std::string> SymbolIndexImp::symbol(const std::string &file_path,
+                                                          size_t offset)
+    {
+        std::pair<size_t, std::string> result(0, "");
+        const m_object_s &obj = object(file_path);
+        // Index of first symbol located after the offset
+        auto offset_it = std::upper_bound(obj.offset.begin(), obj.offset.end(), offset);
+        if (offset_it != obj.offset.begin()) {
+            --offset_it;
+            size_t symbol_idx = offset_it - obj.offset.begin();
+            result.first = *offset_it;
+            result.second = obj.name[symbol_idx];
+        }
+        return result;
+    }
+
+    int SymbolIndexImp::num_object(void) const
+    {
+        std::lock_guard<std::mutex> guard(m_object_lock);
+        return m_object_map.size();
+    }
+
+    const SymbolIndexImp::m_object_s &SymbolIndexImp::object(const std::string &file_path)
+    {
+        // Objects are never modified after they are loaded, so the
+        // reference may be used after the lock is released.
+        {
+            std::lock_guard<std::mutex> guard(m_object_lock);
+            auto obj_it = m_object_map.find(file_path);
+            if (obj_it != m_object_map.end()) {
+                return *(obj_it->second);
+            }
+        }
+        // Read the file without holding the lock so that lookups in
+        // objects that are already loaded are not blocked.  If another
+        // thread loads the same file first, its copy is kept and this
+        // one is discarded.
+        auto obj = geopm::make_unique<m_object_s>();
+        load_object(file_path, *obj);
+        std::lock_guard<std::mutex> guard(m_object_lock);
+        auto obj_it = m_object_map.emplace(file_path, std::move(obj)).first;
+        return *(obj_it->second);
+    }
+
+    void SymbolIndexImp::load_object(const std::string &file_path,
+                                     m_object_s &object)
+    {
+        std::vector<std::pair<size_t, std::string> > table;
+        try {
+            std::shared_ptr<ELF> elf_ptr = elf(file_path);
+            do {
+                if (elf_ptr->num_symbol()) {
+                    do {
+                        table.emplace_back(elf_ptr->symbol_offset(),
+                                           elf_ptr->symbol_name());
+                    } while (elf_ptr->next_symbol());
+                }
+            } while (elf_ptr->next_section());
+        }
+        catch (const Exception &ex) {
+           // If the ELF read fails, just swallow the exception and
+           // record an empty table so the file is not read again.
+           std::string what(ex.what());
+           if (what.find("ELFImp") == std::string::npos) {
+               throw ex;
+           }
+           table.clear();
+        }
+        // When more than one symbol shares an offset, keep the last
+        // one read from the file (consistent with elf_symbol_map()).
+        std::stable_sort(table.begin(), table.end(),
+                         [](const std::pair<size_t, std::string> &aa,
+                            const std::pair<size_t, std::string> &bb)
+                         {
+                             return aa.first < bb.first;
+                         });
+        object.offset.reserve(table.size());
+        object.name.reserve(table.size());
+        for (auto &entry : table) {
+            if (object.offset.size() && object.offset.back() == entry.first) {
+                object.name.back() = std::move(entry.second);
+            }
+            else {
+                object.offset.push_back(entry.first);
+                object.name.push_back(std::move(entry.second));
+            }
+        }
+    }
+
     class ELFImp : public ELF
     {
         public:
@@ -199,7 +321,7 @@ namespace geopm
             throw Exception("ELFImp::ELFImp(): file_path invalid: " + file_path,
                             errno ? errno : GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        m_elf_handle = elf_begin(m_file_desc, ELF_C_READ, nullptr);
+        m_elf_handle = elf_begin(m_file_desc, ELF_C_READ_MMAP, nullptr);
         if (!m_elf_handle) {
             (void)close(m_file_desc);
             throw Exception("ELFImp::ELFImp(): libelf init failed on file: " + file_path,
@@ -25,6 +25,48 @@ namespace geopm
     /// @param [in] file_path Path to ELF encoded binary file.
     /// @return Map from symbol location to symbol name.
     std::map<size_t, std::string> elf_symbol_map(const std::string &file_path);
+
+    /// @brief Process wide index of ELF symbol tables used to
+    ///        resolve instruction addresses to symbol names.
+    ///
+    /// Each object file loaded into the process is opened at most
+    /// once.  The symbol table of an object is read into an address
+    /// sorted table the first time that an address within the object
+    /// must be resolved from the ELF file, and all subsequent lookups
+    /// into that object are resolved by binary search.
+    class SymbolIndex
+    {
+        public:
+            SymbolIndex() = default;
+            virtual ~SymbolIndex() = default;
+            /// @brief Look up the nearest symbol lower than an
+            ///        instruction address.
+            /// @param [in] instruction_ptr Address of an instruction
+            ///        or function.
+            /// @return Pair of symbol location and symbol name.  If
+            ///         symbol couldn't be found, location is zero and
+            ///         symbol name is empty.
+            virtual std::pair<size_t, std::string> symbol(const void *instruction_ptr) = 0;
+            /// @brief Look up the nearest symbol lower than an offset
+            ///        into an ELF file.
+            /// @param [in] file_path Path to ELF encoded binary file.
+            /// @param [in] offset Symbol offset within the file.
+            /// @return Pair of symbol offset and symbol name.  If
+            ///         symbol couldn't be found, offset is zero and
+            ///         symbol name is empty.  Symbol names are not
+            ///         demangled.
+            virtual std::pair<size_t, std::string> symbol(const std::string &file_path,
+                                                          size_t offset) = 0;
+            /// @brief Get the number of object files that have been
+            ///        indexed.
+            /// @return Number of ELF files that have been read.
+            virtual int num_object(void) const = 0;
+            /// @brief Singleton accessor for the process wide symbol
+            ///        index.
+            static SymbolIndex &symbol_index(void);
+            /// @brief Create an empty symbol index.
+            static std::unique_ptr<SymbolIndex> make_unique(void);
+    };
 }
 
 #endif
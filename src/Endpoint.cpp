@@ -7,14 +7,17 @@
 #include "EndpointImp.hpp"
 
 #include <cmath>
+#include <climits>
 #include <cstring>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <string>
 #include <fstream>
-#include <thread>
-#include <chrono>
 #include <stdexcept>
 
 #include "Environment.hpp"
@@ -31,6 +34,170 @@ namespace geopm
         return geopm::make_unique<EndpointImp>(data_path);
     }
 
+    std::vector<int> Endpoint::wait(const std::vector<Endpoint *> &endpoint,
+                                    double timeout)
+    {
+        std::vector<EndpointImp *> endpoint_imp;
+        for (const auto &ep : endpoint) {
+            auto ep_imp = dynamic_cast<EndpointImp *>(ep);
+            if (ep_imp == nullptr) {
+                throw Exception("Endpoint::" + std::string(__func__) + "(): endpoint was not created by Endpoint::make_unique()",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            endpoint_imp.push_back(ep_imp);
+        }
+        return EndpointImp::wait(endpoint_imp, timeout);
+    }
+
+    // Increment when the layout of the endpoint regions changes
+    static const uint32_t M_ENDPOINT_LAYOUT_VERSION = 2;
+
+    void endpoint_layout_init(geopm_endpoint_layout_s &layout, size_t size)
+    {
+        layout.size = size;
+        // A non-zero version marks the region as initialized
+        __atomic_store_n(&(layout.version), M_ENDPOINT_LAYOUT_VERSION, __ATOMIC_RELEASE);
+    }
+
+    void endpoint_layout_check(const geopm_endpoint_layout_s &layout, size_t size,
+                               size_t shmem_size, const std::string &shm_key,
+                               double timeout)
+    {
+        if (shmem_size < size) {
+            throw Exception("endpoint_layout_check(): shared memory region " + shm_key +
+                            " is smaller than " + std::to_string(size) + " bytes",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // The region is visible before its creator has initialized it
+        uint32_t version = __atomic_load_n(&(layout.version), __ATOMIC_ACQUIRE);
+        if (version == 0) {
+            geopm_time_s start;
+            geopm_time(&start);
+            while ((version = __atomic_load_n(&(layout.version), __ATOMIC_ACQUIRE)) == 0 &&
+                   geopm_time_since(&start) < timeout) {
+                sched_yield();
+            }
+        }
+        if (version != M_ENDPOINT_LAYOUT_VERSION || layout.size != size) {
+            throw Exception("endpoint_layout_check(): shared memory region " + shm_key +
+                            " has layout version " + std::to_string(version) +
+                            " and size " + std::to_string(layout.size) +
+                            ", expected version " + std::to_string(M_ENDPOINT_LAYOUT_VERSION) +
+                            " and size " + std::to_string(size),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void endpoint_write_begin(geopm_endpoint_sync_s &sync)
+    {
+        uint32_t seq = __atomic_load_n(&(sync.seq), __ATOMIC_RELAXED);
+        // The count may be odd if a previous writer stopped part way
+        // through an update
+        seq |= 1;
+        __atomic_store_n(&(sync.seq), seq, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+
+    void endpoint_write_end(geopm_endpoint_sync_s &sync)
+    {
+        uint32_t seq = __atomic_load_n(&(sync.seq), __ATOMIC_RELAXED);
+        __atomic_store_n(&(sync.seq), seq + 1, __ATOMIC_RELEASE);
+        endpoint_notify(sync);
+    }
+
+    void endpoint_notify(geopm_endpoint_sync_s &sync)
+    {
+        __atomic_add_fetch(&(sync.notify), 1, __ATOMIC_SEQ_CST);
+        // Only make the system call if a waiter may be sleeping
+        if (__atomic_exchange_n(&(sync.is_waiting), 0, __ATOMIC_SEQ_CST) != 0) {
+            syscall(SYS_futex, &(sync.notify), FUTEX_WAKE, INT_MAX,
+                    nullptr, nullptr, 0);
+        }
+    }
+
+    uint32_t endpoint_read_begin(geopm_endpoint_sync_s &sync)
+    {
+        uint32_t result = __atomic_load_n(&(sync.seq), __ATOMIC_ACQUIRE);
+        if (result & 1) {
+            // Do not wait forever on a writer that stopped part way
+            // through an update
+            const double timeout = 1.0;
+            geopm_time_s start;
+            geopm_time(&start);
+            while ((result = __atomic_load_n(&(sync.seq), __ATOMIC_ACQUIRE)) & 1) {
+                if (geopm_time_since(&start) > timeout) {
+                    throw Exception("endpoint_read_begin(): timed out waiting for update of endpoint shmem to complete",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                sched_yield();
+            }
+        }
+        return result;
+    }
+
+    bool endpoint_read_retry(geopm_endpoint_sync_s &sync, uint32_t seq)
+    {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        return __atomic_load_n(&(sync.seq), __ATOMIC_RELAXED) != seq;
+    }
+
+    uint32_t endpoint_wait_begin(geopm_endpoint_sync_s &sync)
+    {
+        __atomic_store_n(&(sync.is_waiting), 1, __ATOMIC_SEQ_CST);
+        return __atomic_load_n(&(sync.notify), __ATOMIC_SEQ_CST);
+    }
+
+    void endpoint_wait(const std::vector<geopm_endpoint_sync_s *> &sync,
+                       const std::vector<uint32_t> &notify,
+                       const geopm_time_s *deadline)
+    {
+        // The kernel returns EAGAIN if a count differs from the
+        // expected value
+        long err = -1;
+        errno = ENOSYS;
+        // SYS_futex_waitv comes from the C library while struct
+        // futex_waitv comes from the kernel headers, which may be
+        // older; FUTEX_WAITV_MAX is defined with the struct.
+#if defined(SYS_futex_waitv) && defined(FUTEX_WAITV_MAX)
+        if (sync.size() > 1 && sync.size() <= FUTEX_WAITV_MAX) {
+            std::vector<struct futex_waitv> waiter(sync.size());
+            for (size_t idx = 0; idx < sync.size(); ++idx) {
+                waiter[idx].val = notify[idx];
+                waiter[idx].uaddr = (uintptr_t)&(sync[idx]->notify);
+                waiter[idx].flags = FUTEX_32;
+                waiter[idx].__reserved = 0;
+            }
+            err = syscall(SYS_futex_waitv, waiter.data(), waiter.size(), 0,
+                          deadline != nullptr ? &(deadline->t) : nullptr,
+                          CLOCK_REALTIME);
+        }
+#endif
+        if (err == -1 && errno == ENOSYS && !sync.empty()) {
+            geopm_time_s wake = {};
+            const geopm_time_s *wake_ptr = deadline;
+            if (sync.size() > 1) {
+                // Without a vectored wait, wait on the first region
+                // and check the others periodically
+                const double period = 0.01;
+                geopm_time_real(&wake);
+                geopm_time_add(&wake, period, &wake);
+                if (deadline != nullptr && geopm_time_comp(deadline, &wake)) {
+                    wake = *deadline;
+                }
+                wake_ptr = &wake;
+            }
+            err = syscall(SYS_futex, &(sync[0]->notify),
+                          FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME,
+                          notify[0], wake_ptr != nullptr ? &(wake_ptr->t) : nullptr,
+                          nullptr, FUTEX_BITSET_MATCH_ANY);
+        }
+        if (err == -1 && errno != EAGAIN && errno != EINTR &&
+            errno != ETIMEDOUT) {
+            throw Exception("endpoint_wait(): futex wait failed",
+                            errno, __FILE__, __LINE__);
+        }
+    }
+
     std::string EndpointImp::shm_policy_postfix(void)
     {
         return "-policy";
@@ -41,6 +208,76 @@ namespace geopm
         return "-sample";
     }
 
+    EndpointOverflow::EndpointOverflow(const std::string &shm_key)
+        : m_shm_key(shm_key)
+        , m_generation(0)
+        , m_is_owner(false)
+    {
+
+    }
+
+    std::string EndpointOverflow::key(size_t generation) const
+    {
+        return m_shm_key + "-" + std::to_string(generation);
+    }
+
+    double *EndpointOverflow::values_write(size_t count, size_t &generation)
+    {
+        size_t size = count * sizeof(double);
+        if (!m_is_owner || m_shmem->size() < size) {
+            // Grow by powers of two so that a slowly growing number
+            // of values does not create a new region on every write
+            size_t shmem_size = 4096;
+            while (shmem_size < size) {
+                shmem_size *= 2;
+            }
+            // Skip over regions left behind by a previous writer
+            const int max_retry = 64;
+            size_t next = std::max(generation, m_generation);
+            std::unique_ptr<SharedMemory> shmem;
+            for (int retry = 0; shmem == nullptr; ++retry) {
+                ++next;
+                try {
+                    shmem = SharedMemory::make_unique_owner(key(next), shmem_size);
+                }
+                catch (const Exception &ex) {
+                    if (ex.err_value() != EEXIST || retry == max_retry) {
+                        throw;
+                    }
+                }
+            }
+            unlink();
+            m_shmem = std::move(shmem);
+            m_generation = next;
+            m_is_owner = true;
+        }
+        generation = m_generation;
+        return (double *)m_shmem->pointer();
+    }
+
+    const double *EndpointOverflow::values_read(size_t count, size_t generation)
+    {
+        if (m_shmem == nullptr || m_generation != generation) {
+            m_shmem = SharedMemory::make_unique_user(key(generation), 0);
+            m_generation = generation;
+            m_is_owner = false;
+        }
+        if (m_shmem->size() < count * sizeof(double)) {
+            throw Exception("EndpointOverflow::" + std::string(__func__) + "(): shared memory region is too small for the number of values: " + key(generation),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return (const double *)m_shmem->pointer();
+    }
+
+    void EndpointOverflow::unlink(void)
+    {
+        if (m_is_owner) {
+            m_shmem->unlink();
+        }
+        m_shmem.reset();
+        m_is_owner = false;
+    }
+
     EndpointImp::EndpointImp(const std::string &data_path)
         : EndpointImp(data_path, nullptr, nullptr, 0, 0)
     {
@@ -57,8 +294,12 @@ namespace geopm
         , m_sample_shmem(std::move(sample_shmem))
         , m_num_policy(num_policy)
         , m_num_sample(num_sample)
+        , m_is_variable_policy_size(false)
+        , m_policy_overflow(path + shm_policy_postfix())
+        , m_sample_overflow(path + shm_sample_postfix())
         , m_is_open(false)
         , m_continue_loop(true)
+        , m_sample_notify_last(0)
     {
 
     }
@@ -78,18 +319,23 @@ namespace geopm
             size_t shmem_size = sizeof(struct geopm_endpoint_sample_shmem_s);
             m_sample_shmem = SharedMemory::make_unique_owner(m_path + shm_sample_postfix(), shmem_size);
         }
-        auto lock_p = m_policy_shmem->get_scoped_lock();
         struct geopm_endpoint_policy_shmem_s *data_p = (struct geopm_endpoint_policy_shmem_s*)m_policy_shmem->pointer();
         *data_p = {};
+        endpoint_layout_init(data_p->layout, sizeof(*data_p));
 
-        auto lock_s = m_sample_shmem->get_scoped_lock();
         struct geopm_endpoint_sample_shmem_s *data_s = (struct geopm_endpoint_sample_shmem_s*)m_sample_shmem->pointer();
         *data_s = {};
+        endpoint_layout_init(data_s->layout, sizeof(*data_s));
+        m_sample_notify_last = 0;
         m_is_open = true;
     }
 
     void EndpointImp::close(void)
     {
+        // The policy overflow is written by this process, the
+        // sample overflow is removed by the controller that wrote it
+        m_policy_overflow.unlink();
+        m_sample_overflow.unlink();
         if (m_policy_shmem) {
             m_policy_shmem->unlink();
         }
@@ -102,99 +348,187 @@ namespace geopm
     }
 
     void EndpointImp::write_policy(const std::vector<double> &policy)
+    {
+        write_policy(policy.data(), policy.size());
+    }
+
+    void EndpointImp::write_policy(const double *policy, size_t num_policy)
     {
         if (!m_is_open) {
             throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        if (policy.size() != m_num_policy) {
-            throw Exception("EndpointImp::" + std::string(__func__) + "(): size of policy does not match expected.",
+        // An agent with a variable size policy reads missing
+        // values as NAN
+        if (m_is_variable_policy_size && num_policy > m_num_policy) {
+            throw Exception("EndpointImp::" + std::string(__func__) + "(): policy has " + std::to_string(num_policy) +
+                            " values, the agent accepts at most " + std::to_string(m_num_policy),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        else if (!m_is_variable_policy_size && num_policy != m_num_policy) {
+            throw Exception("EndpointImp::" + std::string(__func__) + "(): policy has " + std::to_string(num_policy) +
+                            " values, the agent requires " + std::to_string(m_num_policy),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        auto policy_lock = m_policy_shmem->get_scoped_lock();
         auto data = (struct geopm_endpoint_policy_shmem_s *)m_policy_shmem->pointer();
-        data->count = policy.size();
-        std::copy(policy.begin(), policy.end(), data->values);
+        endpoint_write_begin(data->sync);
+        double *values = data->values;
+        if (num_policy > sizeof(data->values) / sizeof(data->values[0])) {
+            values = m_policy_overflow.values_write(num_policy, data->generation);
+        }
+        else {
+            data->generation = 0;
+        }
+        data->count = num_policy;
+        std::copy(policy, policy + num_policy, values);
         geopm_time(&data->timestamp);
+        endpoint_write_end(data->sync);
     }
 
     double EndpointImp::read_sample(std::vector<double> &sample)
+    {
+        return read_sample(sample.data(), sample.size());
+    }
+
+    double EndpointImp::read_sample(double *sample, size_t num_sample)
     {
         if (!m_is_open) {
             throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        if (sample.size() != m_num_sample) {
+        if (num_sample != m_num_sample) {
             throw Exception("EndpointImp::" + std::string(__func__) + "(): output sample vector is incorrect size.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        auto lock = m_sample_shmem->get_scoped_lock();
         struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem->pointer(); // Managed by shmem subsystem.
 
-        int num_sample = data->count;
-        std::copy(data->values, data->values + data->count, sample.begin());
-        geopm_time_s ts = data->timestamp;
-        if (sample.size() != (size_t)num_sample) {
+        size_t count = 0;
+        geopm_time_s ts;
+        uint32_t seq = 0;
+        do {
+            seq = endpoint_read_begin(data->sync);
+            count = data->count;
+            size_t generation = data->generation;
+            ts = data->timestamp;
+            if (count != num_sample) {
+                continue;
+            }
+            const double *values = data->values;
+            if (generation != 0) {
+                try {
+                    values = m_sample_overflow.values_read(count, generation);
+                }
+                catch (const Exception &) {
+                    // The region may have been replaced during the read
+                    if (!endpoint_read_retry(data->sync, seq)) {
+                        throw;
+                    }
+                    continue;
+                }
+            }
+            std::copy(values, values + count, sample);
+        } while (endpoint_read_retry(data->sync, seq));
+        if (count != num_sample) {
             throw Exception("EndpointImpUser::" + std::string(__func__) + "(): Data read from shmem does not match number of samples.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         return geopm_time_since(&ts);
     }
 
-    std::string EndpointImp::get_agent(void)
+    void EndpointImp::read_attach(std::string &agent,
+                                  std::string &profile_name,
+                                  std::string &hostlist_path,
+                                  size_t &num_policy)
     {
         if (!m_is_open) {
             throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        auto lock = m_sample_shmem->get_scoped_lock();
         struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem->pointer(); // Managed by shmem subsystem.
 
-        char agent_name[GEOPM_ENDPOINT_AGENT_NAME_MAX];
-        std::copy(data->agent, data->agent + GEOPM_ENDPOINT_AGENT_NAME_MAX, agent_name);
-        std::string agent = agent_name;
+        char agent_buf[GEOPM_ENDPOINT_AGENT_NAME_MAX];
+        char profile_buf[GEOPM_ENDPOINT_PROFILE_NAME_MAX];
+        char hostlist_buf[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX];
+        uint32_t seq = 0;
+        do {
+            seq = endpoint_read_begin(data->sync);
+            std::copy(data->agent, data->agent + GEOPM_ENDPOINT_AGENT_NAME_MAX, agent_buf);
+            std::copy(data->profile_name, data->profile_name + GEOPM_ENDPOINT_PROFILE_NAME_MAX, profile_buf);
+            std::copy(data->hostlist_path, data->hostlist_path + GEOPM_ENDPOINT_HOSTLIST_PATH_MAX, hostlist_buf);
+            num_policy = data->num_policy;
+        } while (endpoint_read_retry(data->sync, seq));
+        agent_buf[GEOPM_ENDPOINT_AGENT_NAME_MAX - 1] = '\0';
+        profile_buf[GEOPM_ENDPOINT_PROFILE_NAME_MAX - 1] = '\0';
+        hostlist_buf[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX - 1] = '\0';
+        agent = agent_buf;
+        profile_name = profile_buf;
+        hostlist_path = hostlist_buf;
+    }
+
+    std::string EndpointImp::get_agent(void)
+    {
+        std::string agent;
+        std::string profile_name;
+        std::string hostlist_path;
+        size_t num_policy = 0;
+        read_attach(agent, profile_name, hostlist_path, num_policy);
         if (agent != "") {
-            m_num_policy = Agent::num_policy(agent_name);
-            m_num_sample = Agent::num_sample(agent_name);
+            // The policy size of the attached controller, which may
+            // depend on its environment
+            m_num_policy = num_policy;
+            m_num_sample = Agent::num_sample(agent);
+            m_is_variable_policy_size = Agent::is_variable_policy_size(agent);
         }
         return agent;
     }
 
-    void EndpointImp::wait_for_agent_attach(double timeout)
+    geopm_endpoint_sync_s &EndpointImp::sample_sync(void)
     {
+        return ((struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer())->sync;
+    }
+
+    void EndpointImp::wait_for_agent(bool is_attach, double timeout,
+                                     const std::string &func)
+    {
+        geopm_time_s deadline;
+        geopm_time_real(&deadline);
+        geopm_time_add(&deadline, timeout, &deadline);
         std::string agent = get_agent();
-        geopm_time_s start;
-        geopm_time(&start);
-        while (m_continue_loop && agent == "") {
+        while (m_continue_loop && (agent == "") == is_attach) {
+            // Register before checking so that an update made after
+            // the check wakes the futex wait
+            uint32_t notify = endpoint_wait_begin(sample_sync());
             agent = get_agent();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            if (timeout >= 0 && geopm_time_since(&start) >= timeout) {
-                throw Exception("EndpointImp::" + std::string(__func__) +
+            if (!m_continue_loop || (agent == "") != is_attach) {
+                break;
+            }
+            geopm_time_s now;
+            geopm_time_real(&now);
+            if (timeout >= 0 && !geopm_time_comp(&now, &deadline)) {
+                throw Exception("EndpointImp::" + func +
                                 "(): timed out waiting for controller.",
                                 GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
             }
+            endpoint_wait({&sample_sync()}, {notify}, timeout >= 0 ? &deadline : nullptr);
         }
     }
 
+    void EndpointImp::wait_for_agent_attach(double timeout)
+    {
+        wait_for_agent(true, timeout, __func__);
+    }
+
     void EndpointImp::wait_for_agent_detach(double timeout)
     {
-        std::string agent = get_agent();
-        geopm_time_s start;
-        geopm_time(&start);
-        while (m_continue_loop && agent != "") {
-            agent = get_agent();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            if (timeout >= 0 && geopm_time_since(&start) >= timeout) {
-                throw Exception("EndpointImp::" + std::string(__func__) +
-                                "(): timed out waiting for controller.",
-                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-        }
+        wait_for_agent(false, timeout, __func__);
     }
 
     void EndpointImp::stop_wait_loop(void)
     {
         m_continue_loop = false;
+        if (m_sample_shmem) {
+            endpoint_notify(sample_sync());
+        }
     }
 
     void EndpointImp::reset_wait_loop(void)
@@ -202,38 +536,60 @@ namespace geopm
         m_continue_loop = true;
     }
 
-    std::string EndpointImp::get_profile_name(void)
+    std::vector<int> EndpointImp::wait(const std::vector<EndpointImp *> &endpoint,
+                                       double timeout)
     {
-        if (!m_is_open) {
-            throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
-                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        for (const auto &ep : endpoint) {
+            if (!ep->m_is_open) {
+                throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
+                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
         }
-        auto lock = m_sample_shmem->get_scoped_lock();
-        struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem->pointer(); // Managed by shmem subsystem.
+        geopm_time_s deadline;
+        geopm_time_real(&deadline);
+        geopm_time_add(&deadline, timeout, &deadline);
+        std::vector<geopm_endpoint_sync_s *> sync(endpoint.size());
+        std::vector<uint32_t> notify(endpoint.size());
+        std::vector<int> result;
+        while (true) {
+            for (size_t ep_idx = 0; ep_idx < endpoint.size(); ++ep_idx) {
+                sync[ep_idx] = &(endpoint[ep_idx]->sample_sync());
+                notify[ep_idx] = endpoint_wait_begin(*sync[ep_idx]);
+                if (notify[ep_idx] != endpoint[ep_idx]->m_sample_notify_last) {
+                    endpoint[ep_idx]->m_sample_notify_last = notify[ep_idx];
+                    result.push_back(ep_idx);
+                }
+            }
+            geopm_time_s now;
+            geopm_time_real(&now);
+            if (!result.empty() ||
+                (timeout >= 0 && !geopm_time_comp(&now, &deadline))) {
+                break;
+            }
+            endpoint_wait(sync, notify, timeout >= 0 ? &deadline : nullptr);
+        }
+        return result;
+    }
 
-        char profile_name[GEOPM_ENDPOINT_PROFILE_NAME_MAX];
-        std::copy(data->profile_name, data->profile_name + GEOPM_ENDPOINT_PROFILE_NAME_MAX, profile_name);
-        std::string profile = profile_name;
-        return profile;
+    std::string EndpointImp::get_profile_name(void)
+    {
+        std::string agent;
+        std::string profile_name;
+        std::string hostlist_path;
+        size_t num_policy = 0;
+        read_attach(agent, profile_name, hostlist_path, num_policy);
+        return profile_name;
     }
 
     std::set<std::string> EndpointImp::get_hostnames(void)
     {
-        if (!m_is_open) {
-            throw Exception("EndpointImp::" + std::string(__func__) + "(): cannot use shmem before calling open()",
-                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-        }
-        auto lock = m_sample_shmem->get_scoped_lock();
-        struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem->pointer(); // Managed by shmem subsystem.
-
-        // check for agent
-        char agent_name[GEOPM_ENDPOINT_AGENT_NAME_MAX];
-        std::copy(data->agent, data->agent + GEOPM_ENDPOINT_AGENT_NAME_MAX, agent_name);
-        std::string agent = agent_name;
+        std::string agent;
+        std::string profile_name;
+        std::string hostlist_path;
+        size_t num_policy = 0;
+        read_attach(agent, profile_name, hostlist_path, num_policy);
         std::set<std::string> result;
         if (agent != "") {
-            char hostlist_path[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX];
-            std::copy(data->hostlist_path, data->hostlist_path + GEOPM_ENDPOINT_HOSTLIST_PATH_MAX, hostlist_path);
             std::string hostlist = read_file(hostlist_path);
             auto temp = string_split(hostlist, "\n");
             result.insert(temp.begin(), temp.end());
@@ -352,6 +708,28 @@ int geopm_endpoint_reset_wait_loop(struct geopm_endpoint_c *endpoint)
 }
 
 
+int geopm_endpoint_wait(size_t num_endpoint,
+                        struct geopm_endpoint_c **endpoint,
+                        double timeout,
+                        int *is_updated)
+{
+    int err = 0;
+    try {
+        std::vector<geopm::EndpointImp *> endpoint_imp(num_endpoint);
+        for (size_t ep_idx = 0; ep_idx < num_endpoint; ++ep_idx) {
+            endpoint_imp[ep_idx] = (geopm::EndpointImp*)endpoint[ep_idx];
+        }
+        std::fill(is_updated, is_updated + num_endpoint, 0);
+        for (auto ep_idx : geopm::EndpointImp::wait(endpoint_imp, timeout)) {
+            is_updated[ep_idx] = 1;
+        }
+    }
+    catch (...) {
+        err = geopm::exception_handler(std::current_exception(), true);
+    }
+    return err;
+}
+
 int geopm_endpoint_profile_name(struct geopm_endpoint_c *endpoint,
                                 size_t profile_name_max,
                                 char *profile_name)
@@ -416,8 +794,7 @@ int geopm_endpoint_write_policy(struct geopm_endpoint_c *endpoint,
     int err = 0;
     geopm::EndpointImp *end = (geopm::EndpointImp*)endpoint;
     try {
-        std::vector<double> policy(policy_array, policy_array + agent_num_policy);
-        end->write_policy(policy);
+        end->write_policy(policy_array, agent_num_policy);
     }
     catch (...) {
         err = geopm::exception_handler(std::current_exception(), true);
@@ -433,9 +810,7 @@ int geopm_endpoint_read_sample(struct geopm_endpoint_c *endpoint,
     int err = 0;
     geopm::EndpointImp *end = (geopm::EndpointImp*)endpoint;
     try {
-        std::vector<double> sample(agent_num_sample);
-        *sample_age_sec = end->read_sample(sample);
-        std::copy_n(sample.begin(), agent_num_sample, sample_array);
+        *sample_age_sec = end->read_sample(sample_array, agent_num_sample);
     }
     catch (...) {
         err = geopm::exception_handler(std::current_exception(), true);
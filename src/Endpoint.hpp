@@ -65,6 +65,19 @@ namespace geopm
             virtual std::set<std::string> get_hostnames(void) = 0;
             /// @brief Factory method for the Endpoint used to set the policy.
             static std::unique_ptr<Endpoint> make_unique(const std::string &data_path);
+            /// @brief Blocks until the sample or attach state of any
+            ///        of the endpoints changes or a timeout is
+            ///        reached.  An endpoint is also returned when
+            ///        stop_wait_loop() is called on it.
+            /// @param [in] endpoint Opened endpoints created by
+            ///        make_unique().
+            /// @param [in] timeout Timeout in seconds, negative to
+            ///        wait without a limit.
+            /// @return Indices into endpoint of those that changed
+            ///         since they were last returned, empty if the
+            ///         timeout was reached.
+            static std::vector<int> wait(const std::vector<Endpoint *> &endpoint,
+                                         double timeout);
     };
 }
 
@@ -9,37 +9,87 @@
 #include <pthread.h>
 #include <limits.h>
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "geopm_endpoint.h"
 #include "geopm_time.h"
 #include "Endpoint.hpp"
 
 namespace geopm
 {
+    /// @brief Synchronization state at the start of each endpoint
+    ///        shared memory region.
+    struct geopm_endpoint_sync_s {
+        /// @brief Sequence count, odd while the region is being
+        ///        written.
+        uint32_t seq;
+        /// @brief Incremented after each update, waiters block on
+        ///        this futex word.
+        uint32_t notify;
+        /// @brief Non-zero if a waiter may be blocked on notify.
+        uint32_t is_waiting;
+        uint32_t padding;
+    };
+
+    /// @brief Identifies the layout of an endpoint shared memory
+    ///        region so that a process attaching to a region written
+    ///        with a different layout fails instead of misreading it.
+    struct geopm_endpoint_layout_s {
+        /// @brief Version of the region layout.
+        uint32_t version;
+        /// @brief Size in bytes of the fixed size region.
+        uint32_t size;
+    };
+
     struct geopm_endpoint_policy_shmem_header {
+        geopm_endpoint_sync_s sync;   // 16 bytes
+        geopm_endpoint_layout_s layout;   // 8 bytes
         geopm_time_s timestamp;   // 16 bytes
         size_t count;         // 8 bytes
+        size_t generation;    // 8 bytes
         double values;        // 8 bytes
     };
 
     struct geopm_endpoint_sample_shmem_header {
+        geopm_endpoint_sync_s sync;   // 16 bytes
+        geopm_endpoint_layout_s layout;   // 8 bytes
         geopm_time_s timestamp;   // 16 bytes
         char agent[GEOPM_ENDPOINT_AGENT_NAME_MAX]; // 256 bytes
         char profile_name[GEOPM_ENDPOINT_PROFILE_NAME_MAX];   // 256 bytes
         char hostlist_path[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX];  // 512 bytes
+        size_t num_policy;        // 8 bytes
         size_t count;             // 8 bytes
+        size_t generation;        // 8 bytes
         double values;            // 8 bytes
     };
 
     struct geopm_endpoint_policy_shmem_s {
+        /// @brief Sequence lock and change notification.
+        geopm_endpoint_sync_s sync;
+        /// @brief Layout version and size, written when the
+        ///        region is created.
+        geopm_endpoint_layout_s layout;
         /// @brief Time that the memory was last updated.
         geopm_time_s timestamp;
-        /// @brief Specifies the size of the following array.
+        /// @brief Specifies the number of values.
         size_t count;
+        /// @brief Zero if the values are stored in the following
+        ///        array, otherwise the generation of the overflow
+        ///        region that holds them.
+        size_t generation;
         /// @brief Holds resource manager data.
         double values[(4096 - offsetof(struct geopm_endpoint_policy_shmem_header, values)) / sizeof(double)];
     };
 
     struct geopm_endpoint_sample_shmem_s {
+        /// @brief Sequence lock and change notification.
+        geopm_endpoint_sync_s sync;
+        /// @brief Layout version and size, written when the
+        ///        region is created.
+        geopm_endpoint_layout_s layout;
         /// @brief Time that the memory was last updated.
         geopm_time_s timestamp;
         /// @brief Holds the name of the Agent attached, if any.
@@ -50,8 +100,15 @@ namespace geopm
         /// @brief Path to a file containing the list of hostnames
         ///        in the attached job.
         char hostlist_path[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX];
-        /// @brief Specifies the size of the following array.
+        /// @brief Number of policy values accepted by the
+        ///        attached agent.
+        size_t num_policy;
+        /// @brief Specifies the number of values.
         size_t count;
+        /// @brief Zero if the values are stored in the following
+        ///        array, otherwise the generation of the overflow
+        ///        region that holds them.
+        size_t generation;
         /// @brief Holds resource manager data.
         double values[(4096 - offsetof(struct geopm_endpoint_sample_shmem_header, values)) / sizeof(double)];
     };
@@ -59,8 +116,100 @@ namespace geopm
     static_assert(sizeof(struct geopm_endpoint_policy_shmem_s) == 4096, "Alignment issue with geopm_endpoint_policy_shmem_s.");
     static_assert(sizeof(struct geopm_endpoint_sample_shmem_s) == 4096, "Alignment issue with geopm_endpoint_sample_shmem_s.");
 
+    /// @brief Record the layout of an endpoint region when it is
+    ///        created.
+    /// @param [out] layout Layout stored in the region.
+    /// @param [in] size Size of the fixed size region.
+    void endpoint_layout_init(geopm_endpoint_layout_s &layout, size_t size);
+    /// @brief Check the layout of an endpoint region when attaching
+    ///        to it.
+    /// @param [in] layout Layout stored in the region.
+    /// @param [in] size Size of the fixed size region expected by
+    ///        this process.
+    /// @param [in] shmem_size Size of the attached region.
+    /// @param [in] shm_key Key of the region for the error message.
+    /// @param [in] timeout Seconds to wait for the creator of the
+    ///        region to record its layout.
+    /// @throw geopm::Exception if the region was created with a
+    ///        different layout.
+    void endpoint_layout_check(const geopm_endpoint_layout_s &layout, size_t size,
+                               size_t shmem_size, const std::string &shm_key,
+                               double timeout);
+    /// @brief Begin an update of an endpoint region.  Readers retry
+    ///        until endpoint_write_end() is called.  There must be a
+    ///        single writer for each region.
+    void endpoint_write_begin(geopm_endpoint_sync_s &sync);
+    /// @brief Complete an update of an endpoint region and wake any
+    ///        waiters.
+    void endpoint_write_end(geopm_endpoint_sync_s &sync);
+    /// @brief Wake waiters without modifying the region.
+    void endpoint_notify(geopm_endpoint_sync_s &sync);
+    /// @brief Begin a read of an endpoint region.
+    /// @return Sequence count to pass to endpoint_read_retry().
+    uint32_t endpoint_read_begin(geopm_endpoint_sync_s &sync);
+    /// @brief Check if the data read since endpoint_read_begin() may
+    ///        be inconsistent and must be read again.
+    bool endpoint_read_retry(geopm_endpoint_sync_s &sync, uint32_t seq);
+    /// @brief Register as a waiter on an endpoint region.
+    /// @return Notification count to pass to endpoint_wait().
+    uint32_t endpoint_wait_begin(geopm_endpoint_sync_s &sync);
+    /// @brief Block until the notification count of any region
+    ///        differs from the value returned by
+    ///        endpoint_wait_begin(), or the deadline is reached.
+    ///        May return early.
+    /// @param [in] sync Regions to wait on.
+    /// @param [in] notify Notification count for each region.
+    /// @param [in] deadline Real time deadline, or nullptr to wait
+    ///        without a limit.
+    void endpoint_wait(const std::vector<geopm_endpoint_sync_s *> &sync,
+                       const std::vector<uint32_t> &notify,
+                       const geopm_time_s *deadline);
+
     class SharedMemory;
 
+    /// @brief Storage for endpoint values that do not fit in the
+    ///        fixed size shared memory region.
+    ///
+    /// The values are stored in a separate shared memory region
+    /// whose key is the key of the fixed region followed by a
+    /// generation number.  The writer creates a new generation when
+    /// more space is needed and records it in the fixed region, and
+    /// the reader maps the region again whenever the recorded
+    /// generation changes.  The writer must call methods between
+    /// endpoint_write_begin() and endpoint_write_end() on the fixed
+    /// region, and a reader must retry if values_read() throws while
+    /// the fixed region is being updated.
+    class EndpointOverflow
+    {
+        public:
+            EndpointOverflow() = delete;
+            EndpointOverflow(const std::string &shm_key);
+            virtual ~EndpointOverflow() = default;
+            /// @brief Get storage for writing values, creating a
+            ///        larger region if required.
+            /// @param [in] count Number of values to be written.
+            /// @param [in,out] generation Generation recorded in the
+            ///        fixed region, updated to the generation of the
+            ///        returned storage.
+            /// @return Pointer to storage for count values.
+            double *values_write(size_t count, size_t &generation);
+            /// @brief Get the values stored for a generation.
+            /// @param [in] count Number of values to be read.
+            /// @param [in] generation Generation recorded in the
+            ///        fixed region.
+            /// @return Pointer to count values.
+            const double *values_read(size_t count, size_t generation);
+            /// @brief Remove the region created by this writer, if
+            ///        any.
+            void unlink(void);
+        private:
+            std::string key(size_t generation) const;
+            const std::string m_shm_key;
+            size_t m_generation;
+            bool m_is_owner;
+            std::unique_ptr<SharedMemory> m_shmem;
+    };
+
     class EndpointImp : public Endpoint
     {
         public:
@@ -80,6 +229,19 @@ namespace geopm
             void close(void) override;
             void write_policy(const std::vector<double> &policy) override;
             double read_sample(std::vector<double> &sample) override;
+            void write_policy(const double *policy, size_t num_policy);
+            double read_sample(double *sample, size_t num_sample);
+            /// @brief Block until the sample or attach state of any
+            ///        of the endpoints changes or a timeout is
+            ///        reached.
+            /// @param [in] endpoint Opened endpoints to wait on.
+            /// @param [in] timeout Timeout in seconds, negative to
+            ///        wait without a limit.
+            /// @return Indices of the endpoints that changed since
+            ///         they were last returned, empty if the timeout
+            ///         was reached.
+            static std::vector<int> wait(const std::vector<EndpointImp *> &endpoint,
+                                         double timeout);
             std::string get_agent(void) override;
             void wait_for_agent_attach(double timeout) override;
             void wait_for_agent_detach(double timeout) override;
@@ -90,13 +252,24 @@ namespace geopm
             static std::string shm_policy_postfix(void);
             static std::string shm_sample_postfix(void);
         private:
+            void read_attach(std::string &agent,
+                             std::string &profile_name,
+                             std::string &hostlist_path,
+                             size_t &num_policy);
+            void wait_for_agent(bool is_attach, double timeout,
+                                const std::string &func);
+            geopm_endpoint_sync_s &sample_sync(void);
             std::string m_path;
             std::shared_ptr<SharedMemory> m_policy_shmem;
             std::shared_ptr<SharedMemory> m_sample_shmem;
             size_t m_num_policy;
             size_t m_num_sample;
+            bool m_is_variable_policy_size;
+            EndpointOverflow m_policy_overflow;
+            EndpointOverflow m_sample_overflow;
             bool m_is_open;
             volatile bool m_continue_loop;
+            uint32_t m_sample_notify_last;
     };
 }
 
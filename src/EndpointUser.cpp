@@ -30,6 +30,7 @@ namespace geopm
     EndpointUserImp::EndpointUserImp(const std::string &data_path,
                                      const std::set<std::string> &hosts)
         : EndpointUserImp(data_path, nullptr, nullptr, environment().agent(),
+                          Agent::num_policy(environment().agent()),
                           Agent::num_sample(environment().agent()),
                           environment().profile(), "", hosts)
     {
@@ -40,6 +41,7 @@ namespace geopm
                                      std::unique_ptr<SharedMemory> policy_shmem,
                                      std::unique_ptr<SharedMemory> sample_shmem,
                                      const std::string &agent_name,
+                                     int num_policy,
                                      int num_sample,
                                      const std::string &profile_name,
                                      const std::string &hostlist_path,
@@ -47,6 +49,9 @@ namespace geopm
         : m_path(data_path)
         , m_policy_shmem(std::move(policy_shmem))
         , m_sample_shmem(std::move(sample_shmem))
+        , m_policy_overflow(geopm::make_unique<EndpointOverflow>(m_path + EndpointImp::shm_policy_postfix()))
+        , m_sample_overflow(geopm::make_unique<EndpointOverflow>(m_path + EndpointImp::shm_sample_postfix()))
+        , m_num_policy(num_policy)
         , m_num_sample(num_sample)
     {
         // Attach to shared memory here and send across agent,
@@ -60,8 +65,16 @@ namespace geopm
             m_sample_shmem = SharedMemory::make_unique_user(m_path + EndpointImp::shm_sample_postfix(),
                                                             environment().timeout());
         }
-        auto lock = m_sample_shmem->get_scoped_lock();
-        auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer();
+        // The resource manager records the layout after the regions
+        // are created, and clears the sample region before it does
+        endpoint_layout_check(((struct geopm_endpoint_policy_shmem_s *)m_policy_shmem->pointer())->layout,
+                              sizeof(struct geopm_endpoint_policy_shmem_s),
+                              m_policy_shmem->size(), m_path + EndpointImp::shm_policy_postfix(),
+                              environment().timeout());
+        endpoint_layout_check(((struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer())->layout,
+                              sizeof(struct geopm_endpoint_sample_shmem_s),
+                              m_sample_shmem->size(), m_path + EndpointImp::shm_sample_postfix(),
+                              environment().timeout());
         if (agent_name.size() >= GEOPM_ENDPOINT_AGENT_NAME_MAX) {
             throw Exception("EndpointImp(): Agent name is too long for endpoint storage: " + agent_name,
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -70,13 +83,6 @@ namespace geopm
             throw Exception("EndpointImp(): Profile name is too long for endpoint storage: " + profile_name,
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        data->count = m_num_sample;
-        std::fill(data->values, data->values + m_num_sample, NAN);
-        geopm_time(&data->timestamp);
-        data->agent[GEOPM_ENDPOINT_AGENT_NAME_MAX - 1] = '\0';
-        data->profile_name[GEOPM_ENDPOINT_PROFILE_NAME_MAX - 1] = '\0';
-        strncpy(data->agent, agent_name.c_str(), GEOPM_ENDPOINT_AGENT_NAME_MAX - 1);
-        strncpy(data->profile_name, profile_name.c_str(), GEOPM_ENDPOINT_PROFILE_NAME_MAX - 1);
         /// write hostnames to file
         m_hostlist_path = hostlist_path;
         if (m_hostlist_path == "") {
@@ -95,35 +101,91 @@ namespace geopm
         for (const auto &host : hosts) {
             outfile << host << "\n";
         }
+        outfile.close();
+        auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer();
+        endpoint_write_begin(data->sync);
+        double *values = sample_values();
+        data->count = m_num_sample;
+        std::fill(values, values + m_num_sample, NAN);
+        geopm_time(&data->timestamp);
+        data->agent[GEOPM_ENDPOINT_AGENT_NAME_MAX - 1] = '\0';
+        data->profile_name[GEOPM_ENDPOINT_PROFILE_NAME_MAX - 1] = '\0';
+        strncpy(data->agent, agent_name.c_str(), GEOPM_ENDPOINT_AGENT_NAME_MAX - 1);
+        strncpy(data->profile_name, profile_name.c_str(), GEOPM_ENDPOINT_PROFILE_NAME_MAX - 1);
         data->hostlist_path[GEOPM_ENDPOINT_HOSTLIST_PATH_MAX -1] = '\0';
         strncpy(data->hostlist_path, m_hostlist_path.c_str(), GEOPM_ENDPOINT_HOSTLIST_PATH_MAX - 1);
+        data->num_policy = m_num_policy;
+        endpoint_write_end(data->sync);
     }
 
     EndpointUserImp::~EndpointUserImp()
     {
         // detach from shared memory
-        auto lock = m_sample_shmem->get_scoped_lock();
         auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer();
+        endpoint_write_begin(data->sync);
         data->agent[0] = '\0';
         data->profile_name[0] = '\0';
         data->hostlist_path[0] = '\0';
+        data->num_policy = 0;
+        if (data->generation != 0) {
+            // The overflow region is removed with this object
+            data->count = 0;
+            data->generation = 0;
+        }
+        m_sample_overflow->unlink();
+        endpoint_write_end(data->sync);
         unlink(m_hostlist_path.c_str());
     }
 
+    double *EndpointUserImp::sample_values(void)
+    {
+        auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer();
+        double *result = data->values;
+        if (m_num_sample > sizeof(data->values) / sizeof(data->values[0])) {
+            result = m_sample_overflow->values_write(m_num_sample, data->generation);
+        }
+        else {
+            data->generation = 0;
+        }
+        return result;
+    }
+
     double EndpointUserImp::read_policy(std::vector<double> &policy)
     {
-        auto lock = m_policy_shmem->get_scoped_lock();
         auto data = (struct geopm_endpoint_policy_shmem_s *) m_policy_shmem->pointer(); // Managed by shmem subsystem.
 
-        int num_policy = data->count;
-        if (policy.size() < (size_t)num_policy) {
+        size_t count = 0;
+        geopm_time_s ts;
+        uint32_t seq = 0;
+        do {
+            seq = endpoint_read_begin(data->sync);
+            count = data->count;
+            size_t generation = data->generation;
+            ts = data->timestamp;
+            if (count > policy.size()) {
+                continue;
+            }
+            const double *values = data->values;
+            if (generation != 0) {
+                try {
+                    values = m_policy_overflow->values_read(count, generation);
+                }
+                catch (const Exception &) {
+                    // The region may have been replaced during the read
+                    if (!endpoint_read_retry(data->sync, seq)) {
+                        throw;
+                    }
+                    continue;
+                }
+            }
+            std::copy(values, values + count, policy.begin());
+        } while (endpoint_read_retry(data->sync, seq));
+        if (count > policy.size()) {
             throw Exception("EndpointUserImp::" + std::string(__func__) + "(): Data read from shmem does not fit in policy vector.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         // Fill in missing policy values with NAN (default)
-        std::fill(policy.begin(), policy.end(), NAN);
-        std::copy(data->values, data->values + data->count, policy.begin());
-        geopm_time_s ts = data->timestamp;
+        std::fill(policy.begin() + count, policy.end(), NAN);
         return geopm_time_since(&ts);
     }
 
@@ -133,11 +195,13 @@ namespace geopm
             throw Exception("ShmemEndpoint::" + std::string(__func__) + "(): size of sample does not match expected.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        auto lock = m_sample_shmem->get_scoped_lock();
         auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem->pointer();
+        endpoint_write_begin(data->sync);
+        double *values = sample_values();
         data->count = sample.size();
-        std::copy(sample.begin(), sample.end(), data->values);
+        std::copy(sample.begin(), sample.end(), values);
         // also update timestamp
         geopm_time(&data->timestamp);
+        endpoint_write_end(data->sync);
     }
 }
@@ -37,6 +37,7 @@ namespace geopm
     };
 
     class SharedMemory;
+    class EndpointOverflow;
 
     class EndpointUserImp : public EndpointUser
     {
@@ -50,6 +51,7 @@ namespace geopm
                             std::unique_ptr<SharedMemory> policy_shmem,
                             std::unique_ptr<SharedMemory> sample_shmem,
                             const std::string &agent_name,
+                            int num_policy,
                             int num_sample,
                             const std::string &profile_name,
                             const std::string &hostlist_path,
@@ -58,10 +60,14 @@ namespace geopm
             double read_policy(std::vector<double> &policy) override;
             void write_sample(const std::vector<double> &sample) override;
         private:
+            double *sample_values(void);
             std::string m_path;
             std::unique_ptr<SharedMemory> m_policy_shmem;
             std::unique_ptr<SharedMemory> m_sample_shmem;
+            std::unique_ptr<EndpointOverflow> m_policy_overflow;
+            std::unique_ptr<EndpointOverflow> m_sample_overflow;
             std::string m_hostlist_path;
+            size_t m_num_policy;
             size_t m_num_sample;
     };
 }
@@ -83,7 +83,9 @@ namespace geopm
                              {"GEOPM_MAX_FAN_OUT", "16"},
                              {"GEOPM_TIMEOUT", "30"},
                              {"GEOPM_DEBUG_ATTACH", "-1"},
-                             {"GEOPM_NUM_PROC", "1"}})
+                             {"GEOPM_NUM_PROC", "1"},
+                             {"GEOPM_NUM_DRAIN_THREAD", "1"},
+                             {"GEOPM_FREQUENCY_MAP_NUM_REGION", "31"}})
         , m_default_config_path(default_config_path)
         , m_override_config_path(override_config_path)
         , m_platform_io(platform_io)
@@ -125,12 +127,15 @@ namespace geopm
                 "GEOPM_DEBUG_ATTACH",
                 "GEOPM_PROFILE",
                 "GEOPM_FREQUENCY_MAP",
+                "GEOPM_FREQUENCY_MAP_NUM_REGION",
                 "GEOPM_MAX_FAN_OUT",
                 "GEOPM_OMPT_DISABLE",
                 "GEOPM_RECORD_FILTER",
                 "GEOPM_INIT_CONTROL",
                 "GEOPM_PERIOD",
+                "GEOPM_EVENT_PERIOD",
                 "GEOPM_NUM_PROC",
+                "GEOPM_NUM_DRAIN_THREAD",
                 "GEOPM_PROGRAM_FILTER",
                 "GEOPM_CTL_LOCAL"};
     }
@@ -257,6 +262,35 @@ namespace geopm
         return result;
     }
 
+    bool EnvironmentImp::do_event_period(void) const
+    {
+        return is_set("GEOPM_EVENT_PERIOD");
+    }
+
+    double EnvironmentImp::event_period(void) const
+    {
+        double result = 0.0;
+        std::string period_str = lookup("GEOPM_EVENT_PERIOD");
+        if (period_str.size() != 0) {
+            try {
+                result = std::stod(period_str);
+            }
+            catch (const std::invalid_argument &conv_ex) {
+                throw geopm::Exception("EnvironmentImp::event_period(): GEOPM_EVENT_PERIOD environment variable could not be converted into a double: \"" + period_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            catch (const std::out_of_range &range_ex) {
+                throw geopm::Exception("EnvironmentImp::event_period(): GEOPM_EVENT_PERIOD environment variable could not be converted into a double, out of range: \"" + period_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (result < 0.0) {
+                throw geopm::Exception("EnvironmentImp::event_period(): GEOPM_EVENT_PERIOD environment variable must not be negative: \"" + period_str + "\"",
+                                       GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        return result;
+    }
+
     std::string EnvironmentImp::trace(void) const
     {
         return lookup("GEOPM_TRACE");
@@ -300,6 +334,23 @@ namespace geopm
         return lookup("GEOPM_FREQUENCY_MAP");
     }
 
+    int EnvironmentImp::frequency_map_num_region(void) const
+    {
+        int result = 0;
+        std::string num_region_str = lookup("GEOPM_FREQUENCY_MAP_NUM_REGION");
+        try {
+            result = std::stoi(num_region_str);
+        }
+        catch (const std::exception &) {
+            result = -1;
+        }
+        if (result < 0) {
+            throw Exception("EnvironmentImp::frequency_map_num_region(): GEOPM_FREQUENCY_MAP_NUM_REGION environment variable must be a non-negative integer: \"" + num_region_str + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
     std::vector<std::pair<std::string, int> > EnvironmentImp::trace_signals(void) const
     {
         return signal_parser(lookup("GEOPM_TRACE_SIGNALS"));
@@ -446,6 +497,23 @@ namespace geopm
         return std::stoi(lookup("GEOPM_NUM_PROC"));
     }
 
+    int EnvironmentImp::num_drain_thread(void) const
+    {
+        int result = 0;
+        std::string num_thread_str = lookup("GEOPM_NUM_DRAIN_THREAD");
+        try {
+            result = std::stoi(num_thread_str);
+        }
+        catch (const std::exception &) {
+            result = -1;
+        }
+        if (result < 0) {
+            throw Exception("EnvironmentImp::num_drain_thread(): GEOPM_NUM_DRAIN_THREAD environment variable must be a non-negative integer: \"" + num_thread_str + "\"",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
     bool EnvironmentImp::do_ctl_local(void) const
     {
         bool result = false;
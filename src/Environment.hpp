@@ -41,6 +41,7 @@ namespace geopm
             virtual std::string trace_endpoint_policy(void) const = 0;
             virtual std::string profile(void) const = 0;
             virtual std::string frequency_map(void) const = 0;
+            virtual int frequency_map_num_region(void) const = 0;
             virtual std::string agent(void) const = 0;
             virtual std::vector<std::pair<std::string, int> > trace_signals(void) const = 0;
             virtual std::vector<std::pair<std::string, int> > report_signals(void) const = 0;
@@ -64,7 +65,10 @@ namespace geopm
             virtual int debug_attach_process(void) const = 0;
             virtual std::string init_control(void) const = 0;
             virtual double period(double default_period) const = 0;
+            virtual bool do_event_period(void) const = 0;
+            virtual double event_period(void) const = 0;
             virtual int num_proc(void) const = 0;
+            virtual int num_drain_thread(void) const = 0;
             virtual bool do_ctl_local(void) const = 0;
             static std::map<std::string, std::string> parse_environment_file(const std::string &env_file_path);
     };
@@ -88,6 +92,7 @@ namespace geopm
             std::string trace_endpoint_policy(void) const override;
             std::string profile(void) const override;
             std::string frequency_map(void) const override;
+            int frequency_map_num_region(void) const override;
             std::string agent(void) const override;
             std::vector<std::pair<std::string, int> > trace_signals(void) const override;
             std::vector<std::pair<std::string, int> > report_signals(void) const override;
@@ -117,7 +122,10 @@ namespace geopm
             int debug_attach_process(void) const override;
             std::string init_control(void) const override;
             double period(double default_period) const override;
+            bool do_event_period(void) const override;
+            double event_period(void) const override;
             int num_proc(void) const override;
+            int num_drain_thread(void) const override;
             bool do_ctl_local(void) const override;
         protected:
             void parse_environment(void);
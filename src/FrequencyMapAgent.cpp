@@ -102,7 +102,7 @@ namespace geopm
 
     void FrequencyMapAgent::validate_policy(std::vector<double> &policy) const
     {
-        GEOPM_DEBUG_ASSERT(policy.size() == M_NUM_POLICY,
+        GEOPM_DEBUG_ASSERT(is_valid_policy_size(policy.size()),
                            "FrequencyMapAgent::" + std::string(__func__) +
                            "(): policy vector not correctly sized.");
 
@@ -180,6 +180,14 @@ namespace geopm
                            [](double x) -> bool { return std::isnan(x); });
     }
 
+    bool FrequencyMapAgent::is_valid_policy_size(size_t num_policy)
+    {
+        // Any number of (hash, frequency) pairs may follow the
+        // default frequencies
+        return num_policy >= M_POLICY_FIRST_HASH &&
+               (num_policy - M_POLICY_FIRST_HASH) % 2 == 0;
+    }
+
     void FrequencyMapAgent::update_policy(const std::vector<double> &policy)
     {
         if (is_all_nan(policy) && !m_is_real_policy) {
@@ -243,7 +251,7 @@ namespace geopm
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
         for (auto &child_policy : out_policy) {
-            if (child_policy.size() != M_NUM_POLICY) {
+            if (child_policy.size() != in_policy.size()) {
                 throw Exception("FrequencyMapAgent::" + std::string(__func__) + "(): child_policy vector not correctly sized.",
                                 GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
             }
@@ -365,9 +373,12 @@ namespace geopm
     {
 
         std::vector<std::string> names{"FREQ_CPU_DEFAULT", "FREQ_CPU_UNCORE", "FREQ_GPU_DEFAULT"};
-        names.reserve(M_NUM_POLICY);
+        // Policies with many regions are stored beyond the fixed size
+        // endpoint shared memory region
+        int num_region = environment().frequency_map_num_region();
+        names.reserve(M_POLICY_FIRST_HASH + 2 * num_region);
 
-        for (size_t i = 0; names.size() < M_NUM_POLICY; ++i) {
+        for (int i = 0; i < num_region; ++i) {
             names.emplace_back("HASH_" + std::to_string(i));
             names.emplace_back("FREQ_" + std::to_string(i));
         }
@@ -441,7 +452,7 @@ namespace geopm
 
     void FrequencyMapAgent::enforce_policy(const std::vector<double> &policy) const
     {
-        if (policy.size() != M_NUM_POLICY) {
+        if (!is_valid_policy_size(policy.size())) {
             throw Exception("FrequencyMapAgent::enforce_policy(): policy vector incorrectly sized.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
@@ -61,6 +61,7 @@ namespace geopm
             void update_policy(const std::vector<double> &policy);
             void init_platform_io(void);
             static bool is_all_nan(const std::vector<double> &vec);
+            static bool is_valid_policy_size(size_t num_policy);
 
             enum m_policy_e {
                 M_POLICY_FREQ_CPU_DEFAULT,
@@ -69,8 +70,8 @@ namespace geopm
                 M_POLICY_FIRST_HASH,
                 M_POLICY_FIRST_FREQUENCY,
                 // The remainder of policy values can be additional pairs of
-                // (hash, frequency)
-                M_NUM_POLICY = 65,
+                // (hash, frequency), the number of pairs is set by the
+                // GEOPM_FREQUENCY_MAP_NUM_REGION environment variable
             };
 
             static constexpr double M_WAIT_SEC = 0.002;
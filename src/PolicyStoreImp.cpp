@@ -145,40 +145,69 @@ namespace geopm
         }
     }
 
+    // Statements are prepared once and reused. Reset a statement and clear
+    // its bindings when leaving scope so that it is ready for the next use,
+    // even if an exception was thrown while it was executing.
+    class ScopedStatementReset
+    {
+        public:
+            ScopedStatementReset(sqlite3_stmt *statement)
+                : m_statement(statement)
+            {
+
+            }
+
+            ScopedStatementReset(const ScopedStatementReset &other) = delete;
+            ScopedStatementReset &operator=(const ScopedStatementReset &other) = delete;
+
+            virtual ~ScopedStatementReset()
+            {
+                // The return value of reset repeats the error of the most
+                // recent step, which has already been reported.
+                static_cast<void>(sqlite3_reset(m_statement));
+                static_cast<void>(sqlite3_clear_bindings(m_statement));
+            }
+        private:
+            sqlite3_stmt *m_statement;
+    };
+
     // Try to get a policy from the BestPolicies table. If none is found, an
     // empty vector is returned.
     static std::vector<double>
     get_policy_from_best_policies(sqlite3 *database,
+                                  sqlite3_stmt *statement,
                                   const std::string &agent_name,
                                   const std::string &profile_name)
     {
-        static const char SELECT_BEST_POLICY[] =
-            "SELECT offset,value "
-            "FROM BestPolicies "
-            "WHERE profile = ?1 AND agent = ?2;";
-        auto statement = make_statement(database, SELECT_BEST_POLICY);
-
-        bind_value_or_throw(statement.get(), 1, profile_name, __LINE__);
-        bind_value_or_throw(statement.get(), 2, agent_name, __LINE__);
+        ScopedStatementReset reset(statement);
+        bind_value_or_throw(statement, 1, profile_name, __LINE__);
+        bind_value_or_throw(statement, 2, agent_name, __LINE__);
 
-        return sqlite_results_to_policy_vector(database, statement.get());
+        return sqlite_results_to_policy_vector(database, statement);
     }
 
-    // Try to get an agent's policy from a given table. Return true if the
-    // policy is successfully obtained, or false if it does not exist.
-    // Exceptions are thrown for any errors.
+    // Try to get an agent's policy from the DefaultPolicies table. If none is
+    // found, an empty vector is returned. Exceptions are thrown for any
+    // errors.
     static std::vector<double> get_default(sqlite3 *database,
+                                           sqlite3_stmt *statement,
                                            const std::string &agent_name)
     {
-        static const char SELECT_default[] =
-            "SELECT offset,value "
-            "FROM DefaultPolicies "
-            "WHERE agent = ?1;";
-        auto statement = make_statement(database, SELECT_default);
+        ScopedStatementReset reset(statement);
+        bind_value_or_throw(statement, 1, agent_name, __LINE__);
 
-        bind_value_or_throw(statement.get(), 1, agent_name, __LINE__);
+        return sqlite_results_to_policy_vector(database, statement);
+    }
 
-        return sqlite_results_to_policy_vector(database, statement.get());
+    // Execute a statement that does not return rows. Throw an exception if it
+    // fails.
+    static void step_or_throw(sqlite3_stmt *statement,
+                              const std::string &context_message, int line)
+    {
+        int sqlite_ret = sqlite3_step(statement);
+        if (sqlite_ret != SQLITE_DONE) {
+            throw_sqlite_error(sqlite_ret, context_message, line);
+        }
     }
 
     // Begin a sqlite transaction. Throw an exception if it fails to begin.
@@ -209,8 +238,17 @@ namespace geopm
         }
     }
 
+    // Roll back a sqlite transaction after an error. Failures are ignored
+    // because the error that caused the rollback is being reported.
+    static void rollback_transaction(sqlite3 *database)
+    {
+        static_cast<void>(sqlite3_exec(database, "ROLLBACK TRANSACTION;",
+                                       nullptr, nullptr, nullptr));
+    }
+
     PolicyStoreImp::PolicyStoreImp(const std::string &database_path)
         : m_database(0)
+        , m_last_data_version(0)
     {
         auto ret = sqlite3_open(database_path.c_str(), &m_database);
         if (ret != SQLITE_OK) {
@@ -234,10 +272,54 @@ namespace geopm
             static_cast<void>(sqlite3_close(m_database));
             throw Exception(oss.str(), GEOPM_ERROR_DATA_STORE, __FILE__, __LINE__);
         }
+
+        try {
+            m_select_best = make_statement(m_database,
+                "SELECT offset,value "
+                "FROM BestPolicies "
+                "WHERE profile = ?1 AND agent = ?2;");
+            m_select_default = make_statement(m_database,
+                "SELECT offset,value "
+                "FROM DefaultPolicies "
+                "WHERE agent = ?1;");
+            m_delete_best = make_statement(m_database,
+                "DELETE FROM BestPolicies WHERE profile=?1 AND agent=?2;");
+            m_insert_best = make_statement(m_database,
+                "INSERT INTO BestPolicies "
+                "(profile, agent, offset, value) VALUES (?1, ?2, ?3, ?4);");
+            m_delete_default = make_statement(m_database,
+                "DELETE FROM DefaultPolicies WHERE agent=?1;");
+            m_insert_default = make_statement(m_database,
+                "INSERT INTO DefaultPolicies "
+                "(agent, offset, value) VALUES (?1, ?2, ?3);");
+            m_data_version = make_statement(m_database, "PRAGMA data_version;");
+            check_data_version();
+        }
+        catch (...) {
+            // The destructor is not called when the constructor throws;
+            // statements must be finalized before the database is closed.
+            m_select_best.reset();
+            m_select_default.reset();
+            m_delete_best.reset();
+            m_insert_best.reset();
+            m_delete_default.reset();
+            m_insert_default.reset();
+            m_data_version.reset();
+            static_cast<void>(sqlite3_close(m_database));
+            throw;
+        }
     }
 
     PolicyStoreImp::~PolicyStoreImp()
     {
+        // Close fails if any prepared statement has not been finalized
+        m_select_best.reset();
+        m_select_default.reset();
+        m_delete_best.reset();
+        m_insert_best.reset();
+        m_delete_default.reset();
+        m_insert_default.reset();
+        m_data_version.reset();
         auto ret = sqlite3_close(m_database);
         if (ret != SQLITE_OK) {
             std::cerr << "Warning: <geopm> PolicyStore: Error while closing database. "
@@ -245,12 +327,37 @@ namespace geopm
         }
     }
 
+    void PolicyStoreImp::check_data_version(void) const
+    {
+        // The data version changes when any other connection commits a
+        // change to the database. Changes made through this connection do
+        // not change it, so the setters update the cache themselves.
+        ScopedStatementReset reset(m_data_version.get());
+        int sqlite_ret = sqlite3_step(m_data_version.get());
+        if (sqlite_ret != SQLITE_ROW) {
+            throw_sqlite_error(sqlite_ret, "Error querying the data version", __LINE__);
+        }
+        int data_version = sqlite3_column_int(m_data_version.get(), 0);
+        if (data_version != m_last_data_version) {
+            m_policy_cache.clear();
+            m_last_data_version = data_version;
+        }
+    }
+
     std::vector<double> PolicyStoreImp::get_best(const std::string &agent_name,
                                                  const std::string &profile_name) const
     {
-        auto policy = get_policy_from_best_policies(m_database, agent_name, profile_name);
+        check_data_version();
+        auto cache_key = std::make_pair(agent_name, profile_name);
+        auto cache_it = m_policy_cache.find(cache_key);
+        if (cache_it != m_policy_cache.end()) {
+            return cache_it->second;
+        }
+
+        auto policy = get_policy_from_best_policies(m_database, m_select_best.get(),
+                                                    agent_name, profile_name);
         if (policy.empty()) {
-            policy = get_default(m_database, agent_name);
+            policy = get_default(m_database, m_select_default.get(), agent_name);
         }
 
         size_t policy_value_count = Agent::num_policy(agent_name);
@@ -266,6 +373,7 @@ namespace geopm
             // agent's default values.
             policy.resize(policy_value_count, NAN);
         }
+        m_policy_cache.emplace(cache_key, policy);
         return policy;
     }
 
@@ -281,38 +389,30 @@ namespace geopm
         }
 
         begin_transaction_or_throw(m_database);
-        {
-            // Remove existing policy values for this record in case the new
-            // policy does not explicitly overwrite all values.
-            auto statement = make_statement(
-                m_database, "DELETE FROM BestPolicies WHERE profile=?1 AND agent=?2;");
-
-            bind_value_or_throw(statement.get(), 1, profile_name, __LINE__);
-            bind_value_or_throw(statement.get(), 2, agent_name, __LINE__);
-
-            int sqlite_ret = sqlite3_step(statement.get());
-            if (sqlite_ret != SQLITE_DONE) {
-                throw_sqlite_error(
-                    sqlite_ret, "Error replacing an existing policy", __LINE__);
+        try {
+            {
+                // Remove existing policy values for this record in case the new
+                // policy does not explicitly overwrite all values.
+                ScopedStatementReset reset(m_delete_best.get());
+                bind_value_or_throw(m_delete_best.get(), 1, profile_name, __LINE__);
+                bind_value_or_throw(m_delete_best.get(), 2, agent_name, __LINE__);
+                step_or_throw(m_delete_best.get(), "Error replacing an existing policy", __LINE__);
             }
-        }
-        for (size_t offset = 0; offset < policy.size(); ++offset) {
-            auto statement = make_statement(
-                m_database,
-                "INSERT INTO BestPolicies "
-                "(profile, agent, offset, value) VALUES (?1, ?2, ?3, ?4);");
-
-            bind_value_or_throw(statement.get(), 1, profile_name, __LINE__);
-            bind_value_or_throw(statement.get(), 2, agent_name, __LINE__);
-            bind_value_or_throw(statement.get(), 3, static_cast<int>(offset), __LINE__);
-            bind_value_or_throw(statement.get(), 4, policy[offset], __LINE__);
-
-            int sqlite_ret = sqlite3_step(statement.get());
-            if (sqlite_ret != SQLITE_DONE) {
-                throw_sqlite_error(sqlite_ret, "Error setting the best policy", __LINE__);
+            for (size_t offset = 0; offset < policy.size(); ++offset) {
+                ScopedStatementReset reset(m_insert_best.get());
+                bind_value_or_throw(m_insert_best.get(), 1, profile_name, __LINE__);
+                bind_value_or_throw(m_insert_best.get(), 2, agent_name, __LINE__);
+                bind_value_or_throw(m_insert_best.get(), 3, static_cast<int>(offset), __LINE__);
+                bind_value_or_throw(m_insert_best.get(), 4, policy[offset], __LINE__);
+                step_or_throw(m_insert_best.get(), "Error setting the best policy", __LINE__);
             }
+            commit_transaction_or_throw(m_database);
         }
-        commit_transaction_or_throw(m_database);
+        catch (...) {
+            rollback_transaction(m_database);
+            throw;
+        }
+        m_policy_cache.erase(std::make_pair(agent_name, profile_name));
     }
 
     void PolicyStoreImp::set_default(const std::string &agent_name,
@@ -326,36 +426,35 @@ namespace geopm
         }
 
         begin_transaction_or_throw(m_database);
-        {
-            // Remove existing policy values for this record in case the new
-            // policy does not explicitly overwrite all values.
-            auto statement = make_statement(
-                m_database, "DELETE FROM DefaultPolicies WHERE agent=?1;");
-
-            bind_value_or_throw(statement.get(), 1, agent_name, __LINE__);
-
-            int sqlite_ret = sqlite3_step(statement.get());
-            if (sqlite_ret != SQLITE_DONE) {
-                throw_sqlite_error(
-                    sqlite_ret, "Error replacing an existing policy", __LINE__);
+        try {
+            {
+                // Remove existing policy values for this record in case the new
+                // policy does not explicitly overwrite all values.
+                ScopedStatementReset reset(m_delete_default.get());
+                bind_value_or_throw(m_delete_default.get(), 1, agent_name, __LINE__);
+                step_or_throw(m_delete_default.get(), "Error replacing an existing policy", __LINE__);
+            }
+            for (size_t offset = 0; offset < policy.size(); ++offset) {
+                ScopedStatementReset reset(m_insert_default.get());
+                bind_value_or_throw(m_insert_default.get(), 1, agent_name, __LINE__);
+                bind_value_or_throw(m_insert_default.get(), 2, static_cast<int>(offset), __LINE__);
+                bind_value_or_throw(m_insert_default.get(), 3, policy[offset], __LINE__);
+                step_or_throw(m_insert_default.get(), "Error setting the default policy", __LINE__);
             }
+            commit_transaction_or_throw(m_database);
         }
-        for (size_t offset = 0; offset < policy.size(); ++offset) {
-            auto statement =
-                make_statement(m_database,
-                               "INSERT INTO DefaultPolicies "
-                               "(agent, offset, value) VALUES (?1, ?2, ?3);");
-
-            bind_value_or_throw(statement.get(), 1, agent_name, __LINE__);
-            bind_value_or_throw(statement.get(), 2, static_cast<int>(offset), __LINE__);
-            bind_value_or_throw(statement.get(), 3, policy[offset], __LINE__);
-
-            int sqlite_ret = sqlite3_step(statement.get());
-            if (sqlite_ret != SQLITE_DONE) {
-                throw_sqlite_error(sqlite_ret,
-                                   "Error setting the default policy", __LINE__);
+        catch (...) {
+            rollback_transaction(m_database);
+            throw;
+        }
+        // Any cached profile of this agent may have resolved to the default
+        for (auto it = m_policy_cache.begin(); it != m_policy_cache.end();) {
+            if (it->first.first == agent_name) {
+                it = m_policy_cache.erase(it);
+            }
+            else {
+                ++it;
             }
         }
-        commit_transaction_or_throw(m_database);
     }
 }
@@ -6,18 +6,28 @@
 #ifndef POLICYSTOREIMP_HPP_INCLUDE
 #define POLICYSTOREIMP_HPP_INCLUDE
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "PolicyStore.hpp"
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace geopm
 {
     /// Manages a data store of best known policies for profiles used with
     /// agents. The data store includes records of best known policies and
     /// default policies to apply when a best run has not yet been recorded.
+    ///
+    /// The SQL statements are prepared once for the lifetime of the object.
+    /// Policies returned by get_best() are cached in memory; the cache is
+    /// dropped whenever another connection modifies the data store, as
+    /// reported by the SQLite data_version pragma.
     class PolicyStoreImp : public PolicyStore
     {
         public:
@@ -39,7 +49,22 @@ namespace geopm
             void set_default(const std::string &agent_name, const std::vector<double> &policy) override;
 
         private:
+            typedef std::unique_ptr<sqlite3_stmt, std::function<void(sqlite3_stmt *)> > UniqueStatement;
+            /// @brief Clear the policy cache if another connection has
+            ///        changed the data store since the last check.
+            void check_data_version(void) const;
+
             struct sqlite3 *m_database;
+            UniqueStatement m_select_best;
+            UniqueStatement m_select_default;
+            UniqueStatement m_delete_best;
+            UniqueStatement m_insert_best;
+            UniqueStatement m_delete_default;
+            UniqueStatement m_insert_default;
+            UniqueStatement m_data_version;
+            mutable int m_last_data_version;
+            // (agent, profile) -> policy returned by get_best()
+            mutable std::map<std::pair<std::string, std::string>, std::vector<double> > m_policy_cache;
     };
 }
 
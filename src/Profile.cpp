@@ -266,6 +266,8 @@ namespace geopm
             for (const int &cpu_idx : m_cpu_set) {
                 m_app_status->set_hash(cpu_idx, hash, hint);
             }
+            // Wake the controller if it steps on region entry
+            m_app_status->post_event();
         }
         else {
             // top level and nested entries inside a region both update hints
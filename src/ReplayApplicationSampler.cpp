@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "ReplayApplicationSampler.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "geopm/PlatformTopo.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/SharedMemory.hpp"
+#include "ApplicationRecordLog.hpp"
+#include "ApplicationSamplerImp.hpp"
+#include "ApplicationStatus.hpp"
+#include "Scheduler.hpp"
+#include "geopm_field.h"
+#include "geopm_hash.h"
+#include "geopm_hint.h"
+#include "geopm_topo.h"
+
+namespace geopm
+{
+    ReplayApplicationSampler::ReplayApplicationSampler(const std::string &profile_trace_path,
+                                                       const std::vector<double> &update_time,
+                                                       const PlatformTopo &topo,
+                                                       const std::string &profile_name)
+        : m_topo(topo)
+        , m_num_cpu(m_topo.num_domain(GEOPM_DOMAIN_CPU))
+        , m_update_time(update_time)
+        , m_profile_name(profile_name)
+        , m_time_zero(geopm::time_zero())
+        , m_record_idx(0)
+        , m_num_update(0)
+        , m_overhead_time(0.0)
+        , m_last_replay_time(0.0)
+    {
+        if (m_update_time.empty()) {
+            throw Exception("ReplayApplicationSampler: update schedule is empty",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        parse_trace(profile_trace_path);
+        assign_cpus();
+
+        std::string key_base = "/geopm-replay-" + std::to_string(getpid());
+        m_status_shmem = SharedMemory::make_unique_owner(key_base + "-status",
+                                                         ApplicationStatus::buffer_size(m_num_cpu));
+        m_status_shmem->unlink();
+        m_status = ApplicationStatus::make_unique(m_num_cpu, m_status_shmem);
+        std::map<int, ApplicationSamplerImp::m_process_s> process_map;
+        for (auto &proc_it : m_process) {
+            auto &proc = proc_it.second;
+            proc.shmem = SharedMemory::make_unique_owner(
+                key_base + "-record-log-" + std::to_string(proc_it.first),
+                ApplicationRecordLog::buffer_size());
+            proc.shmem->unlink();
+            proc.record_log = std::make_shared<ApplicationRecordLogImp>(
+                proc.shmem, proc_it.first, Scheduler::make_unique());
+            for (int cpu_idx : proc.cpu_set) {
+                m_status->set_hash(cpu_idx, GEOPM_REGION_HASH_UNMARKED, GEOPM_REGION_HINT_UNSET);
+            }
+            auto &sampler_proc = process_map[proc_it.first];
+            sampler_proc.record_log_shmem = proc.shmem;
+            sampler_proc.record_log = proc.record_log;
+            sampler_proc.records.reserve(ApplicationRecordLog::max_record());
+            sampler_proc.short_regions.reserve(ApplicationRecordLog::max_region());
+        }
+        m_sampler = geopm::make_unique<ApplicationSamplerImp>(
+            m_status, m_topo, process_map, false, "",
+            std::vector<bool>{}, m_profile_name,
+            std::map<int, std::set<int> >{}, Scheduler::make_unique());
+    }
+
+    ReplayApplicationSampler::~ReplayApplicationSampler() = default;
+
+    void ReplayApplicationSampler::parse_trace(const std::string &profile_trace_path)
+    {
+        std::ifstream trace(profile_trace_path);
+        if (!trace.good()) {
+            throw Exception("ReplayApplicationSampler: Unable to open profile trace file: " +
+                            profile_trace_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::vector<std::string> column_names;
+        int time_col = -1;
+        int process_col = -1;
+        int event_col = -1;
+        int signal_col = -1;
+        std::vector<std::pair<double, record_s> > events;
+        std::string line;
+        int line_num = 0;
+        while (std::getline(trace, line)) {
+            ++line_num;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::vector<std::string> fields = string_split(line, "|");
+            if (column_names.empty()) {
+                column_names = fields;
+                for (size_t col_idx = 0; col_idx != fields.size(); ++col_idx) {
+                    if (fields[col_idx] == "TIME") {
+                        time_col = col_idx;
+                    }
+                    else if (fields[col_idx] == "PROCESS") {
+                        process_col = col_idx;
+                    }
+                    else if (fields[col_idx] == "EVENT") {
+                        event_col = col_idx;
+                    }
+                    else if (fields[col_idx] == "SIGNAL") {
+                        signal_col = col_idx;
+                    }
+                }
+                if (time_col == -1 || process_col == -1 ||
+                    event_col == -1 || signal_col == -1) {
+                    throw Exception("ReplayApplicationSampler: Profile trace file must have TIME, PROCESS, EVENT and SIGNAL columns: " +
+                                    profile_trace_path,
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+                }
+                continue;
+            }
+            if (fields.size() != column_names.size()) {
+                throw Exception("ReplayApplicationSampler: Wrong number of fields in line " +
+                                std::to_string(line_num) + " of " + profile_trace_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            try {
+                record_s record {};
+                double time = std::stod(fields[time_col]);
+                record.process = std::stoi(fields[process_col]);
+                record.event = event_type(fields[event_col]);
+                const std::string &signal = fields[signal_col];
+                switch (record.event) {
+                    case EVENT_EPOCH_COUNT:
+                    case EVENT_AFFINITY:
+                        record.signal = std::stoull(signal, nullptr, 10);
+                        break;
+                    case EVENT_OVERHEAD:
+                        record.signal = geopm_signal_to_field(std::stod(signal));
+                        break;
+                    default:
+                        // Region hashes and profile name hashes
+                        record.signal = std::stoull(signal, nullptr, 0);
+                        break;
+                }
+                events.emplace_back(time, record);
+            }
+            catch (const std::invalid_argument &ex) {
+                throw Exception("ReplayApplicationSampler: Invalid value in line " +
+                                std::to_string(line_num) + " of " + profile_trace_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            catch (const std::out_of_range &ex) {
+                throw Exception("ReplayApplicationSampler: Value out of range in line " +
+                                std::to_string(line_num) + " of " + profile_trace_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+        }
+        // Records from different processes are interleaved by the
+        // update in which they were sampled; order them by time while
+        // keeping the order of events for each process.
+        std::stable_sort(events.begin(), events.end(),
+                         [](const std::pair<double, record_s> &aa,
+                            const std::pair<double, record_s> &bb) {
+                             return aa.first < bb.first;
+                         });
+        for (const auto &it : events) {
+            m_record_time.push_back(it.first);
+            m_record.push_back(it.second);
+            auto &proc = m_process[it.second.process];
+            if (it.second.event == EVENT_AFFINITY) {
+                int cpu_idx = it.second.signal;
+                if (cpu_idx < 0 || cpu_idx >= m_num_cpu) {
+                    throw Exception("ReplayApplicationSampler: Affinity to CPU " + std::to_string(cpu_idx) +
+                                    " does not match the platform topology",
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                proc.cpu_set.insert(cpu_idx);
+            }
+        }
+    }
+
+    void ReplayApplicationSampler::assign_cpus(void)
+    {
+        bool is_affinity_recorded = false;
+        for (const auto &proc_it : m_process) {
+            if (!proc_it.second.cpu_set.empty()) {
+                is_affinity_recorded = true;
+            }
+        }
+        if (is_affinity_recorded || m_process.empty()) {
+            return;
+        }
+        // Divide the CPUs into contiguous blocks, one per process,
+        // and report the affinity along with the first event of each
+        // process.
+        int num_proc = m_process.size();
+        int proc_idx = 0;
+        std::vector<std::pair<double, record_s> > affinity;
+        for (auto &proc_it : m_process) {
+            int cpu_begin = proc_idx * m_num_cpu / num_proc;
+            int cpu_end = (proc_idx + 1) * m_num_cpu / num_proc;
+            size_t first_idx = 0;
+            while (m_record[first_idx].process != proc_it.first) {
+                ++first_idx;
+            }
+            for (int cpu_idx = cpu_begin; cpu_idx < cpu_end; ++cpu_idx) {
+                proc_it.second.cpu_set.insert(cpu_idx);
+                record_s record = m_record[first_idx];
+                record.event = EVENT_AFFINITY;
+                record.signal = cpu_idx;
+                affinity.emplace_back(m_record_time[first_idx], record);
+            }
+            ++proc_idx;
+        }
+        std::vector<std::pair<double, record_s> > events;
+        for (size_t record_idx = 0; record_idx != m_record.size(); ++record_idx) {
+            events.emplace_back(m_record_time[record_idx], m_record[record_idx]);
+        }
+        events.insert(events.end(), affinity.begin(), affinity.end());
+        std::stable_sort(events.begin(), events.end(),
+                         [](const std::pair<double, record_s> &aa,
+                            const std::pair<double, record_s> &bb) {
+                             return aa.first < bb.first;
+                         });
+        m_record_time.clear();
+        m_record.clear();
+        for (const auto &it : events) {
+            m_record_time.push_back(it.first);
+            m_record.push_back(it.second);
+        }
+    }
+
+    geopm_time_s ReplayApplicationSampler::replay_time(double time) const
+    {
+        geopm_time_s result;
+        geopm_time_add(&m_time_zero, time, &result);
+        return result;
+    }
+
+    void ReplayApplicationSampler::replay_record(const record_s &record)
+    {
+        auto &proc = m_process.at(record.process);
+        auto &record_log = *(proc.record_log);
+        switch (record.event) {
+            case EVENT_REGION_ENTRY:
+                record_log.enter(record.signal, record.time);
+                for (int cpu_idx : proc.cpu_set) {
+                    m_status->set_hash(cpu_idx, record.signal, GEOPM_REGION_HINT_UNKNOWN);
+                }
+                break;
+            case EVENT_REGION_EXIT:
+                record_log.exit(record.signal, record.time);
+                for (int cpu_idx : proc.cpu_set) {
+                    m_status->set_hash(cpu_idx, GEOPM_REGION_HASH_UNMARKED, GEOPM_REGION_HINT_UNSET);
+                }
+                break;
+            case EVENT_SHORT_REGION:
+                record_log.enter(record.signal, record.time);
+                record_log.exit(record.signal, record.time);
+                break;
+            case EVENT_EPOCH_COUNT:
+                record_log.epoch(record.time);
+                break;
+            case EVENT_AFFINITY:
+                record_log.affinity(record.time, record.signal);
+                break;
+            case EVENT_START_PROFILE:
+                record_log.start_profile(record.time, m_profile_name);
+                break;
+            case EVENT_OVERHEAD:
+                m_overhead_time += geopm_field_to_signal(record.signal);
+                record_log.overhead(record.time, geopm_field_to_signal(record.signal));
+                break;
+            default:
+                // Stop profile events are not replayed, the end of
+                // the update schedule ends the application.
+                break;
+        }
+    }
+
+    void ReplayApplicationSampler::update(const geopm_time_s &curr_time)
+    {
+        geopm_time_s replay_begin;
+        geopm_time(&replay_begin);
+        size_t update_idx = std::min(m_num_update, m_update_time.size() - 1);
+        double update_time = m_update_time[update_idx];
+        for (; m_record_idx < m_record.size() &&
+               m_record_time[m_record_idx] <= update_time; ++m_record_idx) {
+            record_s record = m_record[m_record_idx];
+            record.time = replay_time(m_record_time[m_record_idx]);
+            replay_record(record);
+        }
+        m_last_replay_time = geopm_time_since(&replay_begin);
+        m_sampler->update(replay_time(update_time));
+        ++m_num_update;
+    }
+
+    std::vector<record_s> ReplayApplicationSampler::get_records(void) const
+    {
+        return m_sampler->get_records();
+    }
+
+    short_region_s ReplayApplicationSampler::get_short_region(uint64_t event_signal) const
+    {
+        return m_sampler->get_short_region(event_signal);
+    }
+
+    uint64_t ReplayApplicationSampler::cpu_region_hash(int cpu_idx) const
+    {
+        return m_sampler->cpu_region_hash(cpu_idx);
+    }
+
+    uint64_t ReplayApplicationSampler::cpu_hint(int cpu_idx) const
+    {
+        return m_sampler->cpu_hint(cpu_idx);
+    }
+
+    double ReplayApplicationSampler::cpu_hint_time(int cpu_idx, uint64_t hint) const
+    {
+        return m_sampler->cpu_hint_time(cpu_idx, hint);
+    }
+
+    double ReplayApplicationSampler::cpu_progress(int cpu_idx) const
+    {
+        return m_sampler->cpu_progress(cpu_idx);
+    }
+
+    void ReplayApplicationSampler::connect(const std::vector<int> &client_pids)
+    {
+        // The record logs were connected at construction
+    }
+
+    std::vector<int> ReplayApplicationSampler::client_pids(void) const
+    {
+        std::vector<int> result;
+        for (const auto &proc_it : m_process) {
+            result.push_back(proc_it.first);
+        }
+        return result;
+    }
+
+    std::set<int> ReplayApplicationSampler::client_cpu_set(int client_pid) const
+    {
+        return m_sampler->client_cpu_set(client_pid);
+    }
+
+    bool ReplayApplicationSampler::do_shutdown(void) const
+    {
+        // The controller updates once more after the shutdown is
+        // requested, which consumes the last time in the schedule.
+        return m_num_update + 1 >= m_update_time.size();
+    }
+
+    double ReplayApplicationSampler::total_time(void) const
+    {
+        return m_update_time.back();
+    }
+
+    double ReplayApplicationSampler::overhead_time(void) const
+    {
+        double result = 0.0;
+        if (!m_process.empty()) {
+            result = m_overhead_time / m_process.size();
+        }
+        return result;
+    }
+
+    bool ReplayApplicationSampler::wait_event(const geopm_time_s &deadline)
+    {
+        return m_sampler->wait_event(deadline);
+    }
+
+    int ReplayApplicationSampler::num_event_step(void) const
+    {
+        return m_sampler->num_event_step();
+    }
+
+    int ReplayApplicationSampler::num_period_step(void) const
+    {
+        return m_sampler->num_period_step();
+    }
+
+    double ReplayApplicationSampler::last_replay_time(void) const
+    {
+        return m_last_replay_time;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef REPLAYAPPLICATIONSAMPLER_HPP_INCLUDE
+#define REPLAYAPPLICATIONSAMPLER_HPP_INCLUDE
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ApplicationSampler.hpp"
+#include "geopm_time.h"
+#include "record.hpp"
+
+namespace geopm
+{
+    class ApplicationRecordLog;
+    class ApplicationSamplerImp;
+    class ApplicationStatus;
+    class PlatformTopo;
+    class SharedMemory;
+
+    /// @brief ApplicationSampler that replays the application events
+    ///        recorded in a profile trace file (the output of the
+    ///        ProfileTracer).
+    ///
+    /// The recorded events are written into a real
+    /// ApplicationRecordLog and ApplicationStatus for each process,
+    /// and are read back by a real ApplicationSamplerImp, so the
+    /// controller sees the same data path as with a live
+    /// application.  Each call to update() writes the events up to
+    /// the next time in the update schedule before updating the
+    /// sampler; the time passed to update() is ignored.  The sampler
+    /// requests shutdown once the schedule is exhausted.
+    ///
+    /// Stop profile events are not replayed: the end of the
+    /// schedule marks the end of the application.  If the trace does
+    /// not record the CPU affinity of the processes, the CPUs of the
+    /// platform are divided evenly between the processes.
+    class ReplayApplicationSampler : public ApplicationSampler
+    {
+        public:
+            /// @param [in] profile_trace_path Path to the profile
+            ///        trace file to replay.
+            /// @param [in] update_time Time of each call to update()
+            ///        in seconds relative to the start of the
+            ///        application, e.g. the TIME column of the
+            ///        controller trace.
+            /// @param [in] topo Platform topology.
+            /// @param [in] profile_name Name of the profile used for
+            ///        replayed start profile events.
+            ReplayApplicationSampler(const std::string &profile_trace_path,
+                                     const std::vector<double> &update_time,
+                                     const PlatformTopo &topo,
+                                     const std::string &profile_name);
+            virtual ~ReplayApplicationSampler();
+            void update(const geopm_time_s &curr_time) override;
+            std::vector<record_s> get_records(void) const override;
+            short_region_s get_short_region(uint64_t event_signal) const override;
+            uint64_t cpu_region_hash(int cpu_idx) const override;
+            uint64_t cpu_hint(int cpu_idx) const override;
+            double cpu_hint_time(int cpu_idx, uint64_t hint) const override;
+            double cpu_progress(int cpu_idx) const override;
+            void connect(const std::vector<int> &client_pids) override;
+            std::vector<int> client_pids(void) const override;
+            std::set<int> client_cpu_set(int client_pid) const override;
+            bool do_shutdown(void) const override;
+            double total_time(void) const override;
+            double overhead_time(void) const override;
+            bool wait_event(const geopm_time_s &deadline) override;
+            int num_event_step(void) const override;
+            int num_period_step(void) const override;
+            /// @brief Time in seconds spent by the last call to
+            ///        update() writing the replayed events, which is
+            ///        not part of the controller overhead.
+            double last_replay_time(void) const;
+        private:
+            struct m_process_s {
+                std::shared_ptr<SharedMemory> shmem;
+                std::shared_ptr<ApplicationRecordLog> record_log;
+                std::set<int> cpu_set;
+            };
+            void parse_trace(const std::string &profile_trace_path);
+            void assign_cpus(void);
+            void replay_record(const record_s &record);
+            geopm_time_s replay_time(double time) const;
+
+            const PlatformTopo &m_topo;
+            const int m_num_cpu;
+            const std::vector<double> m_update_time;
+            const std::string m_profile_name;
+            geopm_time_s m_time_zero;
+            // Recorded events ordered by time, and their time in
+            // seconds relative to the start of the application
+            std::vector<record_s> m_record;
+            std::vector<double> m_record_time;
+            size_t m_record_idx;
+            size_t m_num_update;
+            std::map<int, m_process_s> m_process;
+            std::shared_ptr<SharedMemory> m_status_shmem;
+            std::shared_ptr<ApplicationStatus> m_status;
+            std::unique_ptr<ApplicationSamplerImp> m_sampler;
+            double m_overhead_time;
+            double m_last_replay_time;
+    };
+}
+
+#endif
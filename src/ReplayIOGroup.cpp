@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "ReplayIOGroup.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+#include "geopm/PlatformTopo.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm/Exception.hpp"
+#include "geopm/Agg.hpp"
+#include "geopm_topo.h"
+
+namespace geopm
+{
+    ReplayIOGroup::ReplayIOGroup(const std::string &trace_path,
+                                 const PlatformTopo &topo,
+                                 const std::map<std::string, double> &constant_signal,
+                                 const std::map<std::string, double> &control)
+        : m_topo(topo)
+        , m_num_cpu(m_topo.num_domain(GEOPM_DOMAIN_CPU))
+        , m_constant(constant_signal)
+        , m_row_idx(-1)
+        , m_is_batch_read(false)
+    {
+        for (const auto &ctl : control) {
+            m_control[ctl.first] = std::vector<double>(m_num_cpu, ctl.second);
+        }
+        parse_trace(trace_path);
+    }
+
+    void ReplayIOGroup::parse_trace(const std::string &trace_path)
+    {
+        std::ifstream trace(trace_path);
+        if (!trace.good()) {
+            throw Exception("ReplayIOGroup: Unable to open trace file: " + trace_path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const std::string profile_key = "# profile_name: ";
+        std::vector<std::string> column_names;
+        std::string line;
+        int line_num = 0;
+        while (std::getline(trace, line)) {
+            ++line_num;
+            if (line.empty()) {
+                continue;
+            }
+            if (line[0] == '#') {
+                if (string_begins_with(line, profile_key)) {
+                    m_profile_name = line.substr(profile_key.size());
+                }
+                continue;
+            }
+            std::vector<std::string> fields = string_split(line, "|");
+            if (column_names.empty()) {
+                column_names = fields;
+                continue;
+            }
+            if (fields.size() != column_names.size()) {
+                throw Exception("ReplayIOGroup: Wrong number of fields in line " +
+                                std::to_string(line_num) + " of " + trace_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            std::vector<double> row(fields.size());
+            for (size_t col_idx = 0; col_idx != fields.size(); ++col_idx) {
+                char *end_ptr = nullptr;
+                // Hexadecimal fields (e.g. region hashes) are
+                // accepted by strtod() as well
+                row[col_idx] = std::strtod(fields[col_idx].c_str(), &end_ptr);
+                if (end_ptr == fields[col_idx].c_str() || *end_ptr != '\0') {
+                    throw Exception("ReplayIOGroup: Invalid value \"" + fields[col_idx] +
+                                    "\" in line " + std::to_string(line_num) + " of " + trace_path,
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+                }
+            }
+            m_row.push_back(std::move(row));
+        }
+        if (column_names.empty() || m_row.empty()) {
+            throw Exception("ReplayIOGroup: No samples found in trace file: " + trace_path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+
+        // Map from signal name to domain type to domain index to column
+        std::map<std::string, std::map<int, std::map<int, int> > > signal_columns;
+        for (size_t col_idx = 0; col_idx != column_names.size(); ++col_idx) {
+            add_column(column_names[col_idx], col_idx, signal_columns);
+        }
+        if (signal_columns.find("TIME") == signal_columns.end() ||
+            signal_columns.at("TIME").count(GEOPM_DOMAIN_BOARD) == 0) {
+            throw Exception("ReplayIOGroup: Trace file does not have a TIME column: " + trace_path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+
+        for (const auto &sig_it : signal_columns) {
+            // Provide the signal at the recorded domain with the most
+            // instances
+            int domain_type = GEOPM_DOMAIN_INVALID;
+            int num_domain = 0;
+            bool is_monotone = true;
+            for (const auto &domain_it : sig_it.second) {
+                int curr_num_domain = m_topo.num_domain(domain_it.first);
+                if (curr_num_domain > num_domain) {
+                    domain_type = domain_it.first;
+                    num_domain = curr_num_domain;
+                }
+                for (const auto &idx_it : domain_it.second) {
+                    bool is_constant = true;
+                    double last = NAN;
+                    for (const auto &row : m_row) {
+                        double curr = row[idx_it.second];
+                        if (std::isnan(curr)) {
+                            continue;
+                        }
+                        if (!std::isnan(last)) {
+                            if (curr < last) {
+                                is_monotone = false;
+                            }
+                            if (curr != last) {
+                                is_constant = false;
+                            }
+                        }
+                        last = curr;
+                    }
+                    if (is_constant) {
+                        is_monotone = false;
+                    }
+                }
+            }
+            m_signal_s signal {
+                domain_type,
+                is_monotone ? IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE :
+                              IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE,
+                std::vector<int>(num_domain, -1),
+                "Replayed from the trace column " + sig_it.first,
+            };
+            for (const auto &idx_it : sig_it.second.at(domain_type)) {
+                signal.column[idx_it.first] = idx_it.second;
+            }
+            if (domain_type != GEOPM_DOMAIN_BOARD) {
+                signal.description += "-" + PlatformTopo::domain_type_to_name(domain_type) + "-*";
+            }
+            m_signal.emplace(sig_it.first, std::move(signal));
+        }
+    }
+
+    void ReplayIOGroup::add_column(const std::string &column_name, int column_idx,
+                                   std::map<std::string, std::map<int, std::map<int, int> > > &signal_columns)
+    {
+        std::string signal_name = column_name;
+        int domain_type = GEOPM_DOMAIN_BOARD;
+        int domain_idx = 0;
+        // Columns for non-board domains are named NAME-DOMAIN-IDX
+        size_t idx_pos = column_name.rfind('-');
+        if (idx_pos != std::string::npos && idx_pos != 0) {
+            size_t domain_pos = column_name.rfind('-', idx_pos - 1);
+            if (domain_pos != std::string::npos) {
+                std::string domain_name = column_name.substr(domain_pos + 1, idx_pos - domain_pos - 1);
+                std::string idx_str = column_name.substr(idx_pos + 1);
+                try {
+                    int parsed_type = PlatformTopo::domain_name_to_type(domain_name);
+                    size_t num_parsed = 0;
+                    int parsed_idx = std::stoi(idx_str, &num_parsed);
+                    if (num_parsed == idx_str.size()) {
+                        signal_name = column_name.substr(0, domain_pos);
+                        domain_type = parsed_type;
+                        domain_idx = parsed_idx;
+                    }
+                }
+                catch (const std::exception &ex) {
+                    // Not a domain suffix: treat as a board signal
+                }
+            }
+        }
+        if (domain_idx < 0 || domain_idx >= m_topo.num_domain(domain_type)) {
+            throw Exception("ReplayIOGroup: Trace column " + column_name +
+                            " does not match the platform topology",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        auto &idx_map = signal_columns[signal_name][domain_type];
+        if (idx_map.find(domain_idx) != idx_map.end()) {
+            throw Exception("ReplayIOGroup: Trace column " + column_name +
+                            " appears more than once",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        idx_map[domain_idx] = column_idx;
+    }
+
+    std::set<std::string> ReplayIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal) {
+            result.insert(it.first);
+        }
+        for (const auto &it : m_constant) {
+            result.insert(it.first);
+        }
+        for (const auto &it : m_control) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> ReplayIOGroup::control_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_control) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    bool ReplayIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal.find(signal_name) != m_signal.end() ||
+               m_constant.find(signal_name) != m_constant.end() ||
+               m_control.find(signal_name) != m_control.end();
+    }
+
+    bool ReplayIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return m_control.find(control_name) != m_control.end();
+    }
+
+    int ReplayIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        if (m_constant.find(signal_name) != m_constant.end() ||
+            m_control.find(signal_name) != m_control.end()) {
+            result = GEOPM_DOMAIN_CPU;
+        }
+        else {
+            auto it = m_signal.find(signal_name);
+            if (it != m_signal.end()) {
+                result = it->second.domain_type;
+            }
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        if (is_valid_control(control_name)) {
+            result = GEOPM_DOMAIN_CPU;
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal("push_signal", signal_name, domain_type, domain_idx);
+        if (m_is_batch_read) {
+            throw Exception("ReplayIOGroup::push_signal(): cannot push signal after call to read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // Constants and controls take precedence over trace columns
+        m_batch_s batch {nullptr, nullptr, domain_idx};
+        auto const_it = m_constant.find(signal_name);
+        auto ctl_it = m_control.find(signal_name);
+        if (const_it != m_constant.end()) {
+            batch.value = &(const_it->second);
+        }
+        else if (ctl_it != m_control.end()) {
+            batch.value = &(ctl_it->second[domain_idx]);
+        }
+        else {
+            batch.signal = &(m_signal.at(signal_name));
+        }
+        int result = -1;
+        for (size_t batch_idx = 0; result == -1 && batch_idx != m_active_signal.size(); ++batch_idx) {
+            const auto &active = m_active_signal[batch_idx];
+            if (active.signal == batch.signal &&
+                active.value == batch.value &&
+                active.domain_idx == batch.domain_idx) {
+                result = batch_idx;
+            }
+        }
+        if (result == -1) {
+            result = m_active_signal.size();
+            m_active_signal.push_back(batch);
+        }
+        return result;
+    }
+
+    int ReplayIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        check_control("push_control", control_name, domain_type, domain_idx);
+        double *setting = &(m_control.at(control_name)[domain_idx]);
+        int result = -1;
+        for (size_t batch_idx = 0; result == -1 && batch_idx != m_active_control.size(); ++batch_idx) {
+            if (m_active_control[batch_idx] == setting) {
+                result = batch_idx;
+            }
+        }
+        if (result == -1) {
+            result = m_active_control.size();
+            m_active_control.push_back(setting);
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::read_batch(void)
+    {
+        if (m_row_idx + 1 < (int)m_row.size()) {
+            ++m_row_idx;
+        }
+        m_is_batch_read = true;
+    }
+
+    void ReplayIOGroup::write_batch(void)
+    {
+        // Settings are applied by adjust()
+    }
+
+    double ReplayIOGroup::sample(int batch_idx)
+    {
+        if (!m_is_batch_read) {
+            throw Exception("ReplayIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (batch_idx < 0 || (size_t)batch_idx >= m_active_signal.size()) {
+            throw Exception("ReplayIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const m_batch_s &batch = m_active_signal[batch_idx];
+        double result = NAN;
+        if (batch.value != nullptr) {
+            result = *(batch.value);
+        }
+        else {
+            result = value(*(batch.signal), batch.domain_idx);
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::adjust(int batch_idx, double setting)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_active_control.size()) {
+            throw Exception("ReplayIOGroup::adjust(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        *(m_active_control[batch_idx]) = setting;
+    }
+
+    double ReplayIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal("read_signal", signal_name, domain_type, domain_idx);
+        double result = NAN;
+        auto const_it = m_constant.find(signal_name);
+        auto ctl_it = m_control.find(signal_name);
+        if (const_it != m_constant.end()) {
+            result = const_it->second;
+        }
+        else if (ctl_it != m_control.end()) {
+            result = ctl_it->second[domain_idx];
+        }
+        else {
+            result = value(m_signal.at(signal_name), domain_idx);
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        check_control("write_control", control_name, domain_type, domain_idx);
+        m_control.at(control_name)[domain_idx] = setting;
+    }
+
+    void ReplayIOGroup::save_control(void)
+    {
+        m_control_saved = m_control;
+    }
+
+    void ReplayIOGroup::restore_control(void)
+    {
+        for (const auto &it : m_control_saved) {
+            m_control.at(it.first) = it.second;
+        }
+    }
+
+    std::function<double(const std::vector<double> &)> ReplayIOGroup::agg_function(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ReplayIOGroup::agg_function(): " + signal_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::function<double(const std::vector<double> &)> result = Agg::average;
+        if (signal_behavior(signal_name) == IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE) {
+            result = Agg::sum;
+        }
+        return result;
+    }
+
+    std::function<std::string(double)> ReplayIOGroup::format_function(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ReplayIOGroup::format_function(): " + signal_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return string_format_double;
+    }
+
+    std::string ReplayIOGroup::signal_description(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ReplayIOGroup::signal_description(): " + signal_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        std::string result;
+        if (m_constant.find(signal_name) != m_constant.end()) {
+            result = "Constant value configured for replay";
+        }
+        else if (m_control.find(signal_name) != m_control.end()) {
+            result = "Last setting of the replayed control";
+        }
+        else {
+            result = m_signal.at(signal_name).description;
+        }
+        return result;
+    }
+
+    std::string ReplayIOGroup::control_description(const std::string &control_name) const
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("ReplayIOGroup::control_description(): " + control_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return "Control accepted and discarded during replay";
+    }
+
+    int ReplayIOGroup::signal_behavior(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ReplayIOGroup::signal_behavior(): " + signal_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT;
+        if (m_control.find(signal_name) != m_control.end()) {
+            result = IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE;
+        }
+        else if (m_constant.find(signal_name) == m_constant.end()) {
+            result = m_signal.at(signal_name).behavior;
+        }
+        return result;
+    }
+
+    void ReplayIOGroup::save_control(const std::string &save_path)
+    {
+
+    }
+
+    void ReplayIOGroup::restore_control(const std::string &save_path)
+    {
+
+    }
+
+    std::string ReplayIOGroup::name(void) const
+    {
+        return plugin_name();
+    }
+
+    std::string ReplayIOGroup::plugin_name(void)
+    {
+        return "REPLAY";
+    }
+
+    int ReplayIOGroup::num_row(void) const
+    {
+        return m_row.size();
+    }
+
+    std::vector<double> ReplayIOGroup::row_time(void) const
+    {
+        std::vector<double> result;
+        result.reserve(m_row.size());
+        int column = m_signal.at("TIME").column.at(0);
+        for (const auto &row : m_row) {
+            result.push_back(row[column]);
+        }
+        return result;
+    }
+
+    std::string ReplayIOGroup::profile_name(void) const
+    {
+        return m_profile_name;
+    }
+
+    void ReplayIOGroup::check_signal(const std::string &func, const std::string &signal_name,
+                                     int domain_type, int domain_idx) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ReplayIOGroup::" + func + "(): signal_name " + signal_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != signal_domain_type(signal_name)) {
+            throw Exception("ReplayIOGroup::" + func + "(): signal " + signal_name +
+                            " not defined for domain " + std::to_string(domain_type),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_topo.num_domain(domain_type)) {
+            throw Exception("ReplayIOGroup::" + func + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void ReplayIOGroup::check_control(const std::string &func, const std::string &control_name,
+                                      int domain_type, int domain_idx) const
+    {
+        if (!is_valid_control(control_name)) {
+            throw Exception("ReplayIOGroup::" + func + "(): control_name " + control_name +
+                            " not valid for ReplayIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != GEOPM_DOMAIN_CPU) {
+            throw Exception("ReplayIOGroup::" + func + "(): control " + control_name +
+                            " not defined for domain " + std::to_string(domain_type),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_cpu) {
+            throw Exception("ReplayIOGroup::" + func + "(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    double ReplayIOGroup::value(const m_signal_s &signal, int domain_idx) const
+    {
+        double result = NAN;
+        int column = signal.column[domain_idx];
+        if (column != -1) {
+            result = m_row[m_row_idx == -1 ? 0 : m_row_idx][column];
+        }
+        return result;
+    }
+}
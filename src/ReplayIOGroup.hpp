@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef REPLAYIOGROUP_HPP_INCLUDE
+#define REPLAYIOGROUP_HPP_INCLUDE
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "geopm/IOGroup.hpp"
+
+namespace geopm
+{
+    class PlatformTopo;
+
+    /// @brief IOGroup that provides the signals recorded in a
+    ///        controller trace file (the output of the Tracer) so
+    ///        that the controller loop can be driven without
+    ///        hardware.  Each call to read_batch() advances to the
+    ///        next row of the trace; once the last row is reached it
+    ///        is repeated.
+    ///
+    /// Trace columns are named "NAME" for board signals or
+    /// "NAME-DOMAIN-IDX" for other domains.  A signal is provided at
+    /// the finest domain that appears in the trace.  Columns that
+    /// never decrease over the trace are reported as monotone and
+    /// aggregated with a sum, all others are variable and averaged.
+    ///
+    /// Signals that an agent or the Reporter reads but that are not
+    /// recorded in the trace may be given as constants, and controls
+    /// may be given as sinks.  Both are provided at the CPU domain
+    /// and are averaged over coarser domains so that every domain
+    /// reports the configured value.  A control can also be read as
+    /// a signal of the same name which returns the last setting.
+    class ReplayIOGroup : public IOGroup
+    {
+        public:
+            /// @param [in] trace_path Path to the controller trace
+            ///        file to replay.
+            /// @param [in] topo Platform topology used to validate
+            ///        the domains in the trace.
+            /// @param [in] constant_signal Map from signal name to
+            ///        the constant value reported for the signal.
+            /// @param [in] control Map from control name to the
+            ///        initial setting of the control.
+            ReplayIOGroup(const std::string &trace_path,
+                          const PlatformTopo &topo,
+                          const std::map<std::string, double> &constant_signal,
+                          const std::map<std::string, double> &control);
+            virtual ~ReplayIOGroup() = default;
+            std::set<std::string> signal_names(void) const override;
+            std::set<std::string> control_names(void) const override;
+            bool is_valid_signal(const std::string &signal_name) const override;
+            bool is_valid_control(const std::string &control_name) const override;
+            int signal_domain_type(const std::string &signal_name) const override;
+            int control_domain_type(const std::string &control_name) const override;
+            int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
+            void read_batch(void) override;
+            void write_batch(void) override;
+            double sample(int batch_idx) override;
+            void adjust(int batch_idx, double setting) override;
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override;
+            void save_control(void) override;
+            void restore_control(void) override;
+            std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override;
+            std::function<std::string(double)> format_function(const std::string &signal_name) const override;
+            std::string signal_description(const std::string &signal_name) const override;
+            std::string control_description(const std::string &control_name) const override;
+            int signal_behavior(const std::string &signal_name) const override;
+            void save_control(const std::string &save_path) override;
+            void restore_control(const std::string &save_path) override;
+            std::string name(void) const override;
+            /// @brief Number of rows recorded in the trace.
+            int num_row(void) const;
+            /// @brief Values of the TIME column for every row of the
+            ///        trace.
+            /// @return Vector with num_row() elements.
+            std::vector<double> row_time(void) const;
+            /// @brief Name of the profile recorded in the trace
+            ///        header, or empty if not recorded.
+            std::string profile_name(void) const;
+            static std::string plugin_name(void);
+        private:
+            struct m_signal_s {
+                int domain_type;
+                int behavior;
+                // Trace column for each domain index, -1 if the
+                // domain was not recorded
+                std::vector<int> column;
+                std::string description;
+            };
+            struct m_batch_s {
+                // Trace signal, or nullptr for constants and controls
+                const m_signal_s *signal;
+                // Value of a constant or control, or nullptr for
+                // trace signals
+                const double *value;
+                int domain_idx;
+            };
+            void parse_trace(const std::string &trace_path);
+            void add_column(const std::string &column_name, int column_idx,
+                            std::map<std::string, std::map<int, std::map<int, int> > > &signal_columns);
+            void check_signal(const std::string &func, const std::string &signal_name,
+                              int domain_type, int domain_idx) const;
+            void check_control(const std::string &func, const std::string &control_name,
+                               int domain_type, int domain_idx) const;
+            double value(const m_signal_s &signal, int domain_idx) const;
+
+            const PlatformTopo &m_topo;
+            int m_num_cpu;
+            std::string m_profile_name;
+            std::vector<std::vector<double> > m_row;
+            std::map<std::string, m_signal_s> m_signal;
+            std::map<std::string, double> m_constant;
+            std::map<std::string, std::vector<double> > m_control;
+            std::map<std::string, std::vector<double> > m_control_saved;
+            std::vector<m_batch_s> m_active_signal;
+            std::vector<double *> m_active_control;
+            int m_row_idx;
+            bool m_is_batch_read;
+    };
+}
+
+#endif
@@ -86,6 +86,8 @@ namespace geopm
         , m_total_time(0.0)
         , m_overhead_time(0.0)
         , m_sample_delay(0.0)
+        , m_num_event_step(0)
+        , m_num_period_step(0)
         , m_profile_name(profile_name)
         , m_do_ctl_local(do_ctl_local)
     {
@@ -149,6 +151,12 @@ namespace geopm
         m_sample_delay = sample_delay;
     }
 
+    void ReporterImp::step_count(int num_event_step, int num_period_step)
+    {
+        m_num_event_step = num_event_step;
+        m_num_period_step = num_period_step;
+    }
+
     void ReporterImp::generate(const std::string &agent_name,
                                const std::vector<std::pair<std::string, std::string> > &agent_report_header,
                                const std::vector<std::pair<std::string, std::string> > &agent_host_report,
@@ -260,8 +268,26 @@ namespace geopm
         GEOPM_DEBUG_ASSERT(region_name_set.size() == 0 ||
                            m_proc_region_agg != nullptr,
                            "ReporterImp::create_report(): region set is not empty, but region aggregator pointer is null");
+        // Hash all of the region names with one call
+        std::vector<const char *> region_name_ptr;
+        std::vector<size_t> region_name_len;
+        for (const auto &region : region_name_set) {
+            region_name_ptr.push_back(region.c_str());
+            region_name_len.push_back(region.size());
+        }
+        std::vector<uint64_t> region_hash_vec(region_name_ptr.size());
+        if (!region_name_ptr.empty()) {
+            int err = geopm_crc32_str_batch(region_name_ptr.size(), region_name_ptr.data(),
+                                            region_name_len.data(), region_hash_vec.data());
+            if (err) {
+                throw Exception("ReporterImp::create_report(): Failed to hash region names",
+                                err, __FILE__, __LINE__);
+            }
+        }
+        size_t region_idx = 0;
         for (const auto &region : region_name_set) {
-            uint64_t region_hash = geopm_crc32_str(region.c_str());
+            uint64_t region_hash = region_hash_vec[region_idx];
+            ++region_idx;
             double count = m_proc_region_agg->get_count_average(region_hash);
             if (count > 0) {
                 region_ordered.push_back({region,
@@ -353,6 +379,11 @@ namespace geopm
         }
 
         yaml_write(report, M_INDENT_TOTALS_FIELD, overhead);
+        if (m_num_event_step != 0 || m_num_period_step != 0) {
+            yaml_write(report, M_INDENT_TOTALS_FIELD,
+                       {{"geopmctl event steps", std::to_string(m_num_event_step)},
+                        {"geopmctl periodic steps", std::to_string(m_num_period_step)}});
+        }
         return report.str();
     }
 
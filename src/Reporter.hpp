@@ -76,6 +76,11 @@ namespace geopm
                                          const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report) = 0;
             virtual void total_time(double total) = 0;
             virtual void overhead(double overhead_sec, double sample_delay) = 0;
+            /// @brief Set the number of controller steps triggered by
+            ///        a region entry and by the end of the control
+            ///        period.  These are only reported if at least
+            ///        one step was counted.
+            virtual void step_count(int num_event_step, int num_period_step) = 0;
     };
 
     class PlatformIO;
@@ -119,6 +124,7 @@ namespace geopm
                                  const std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > &agent_region_report) override;
             void total_time(double total) override;
             void overhead(double overhead_sec, double sample_delay) override;
+            void step_count(int num_event_step, int num_period_step) override;
 
         private:
             /// @brief number of spaces for each indentation
@@ -197,6 +203,8 @@ namespace geopm
             double m_total_time;
             double m_overhead_time;
             double m_sample_delay;
+            int m_num_event_step;
+            int m_num_period_step;
             const std::string m_profile_name;
             bool m_do_ctl_local;
     };
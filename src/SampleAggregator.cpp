@@ -34,6 +34,7 @@ namespace geopm
         : m_platform_io(platio)
         , m_time_idx(m_platform_io.push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
         , m_is_updated(false)
+        , m_time_last(0.0)
         , m_period_duration(0.0)
         , m_period_last(0)
     {
@@ -75,123 +76,83 @@ namespace geopm
                                                int domain_type,
                                                int domain_idx)
     {
-        if (m_is_updated) {
-           throw Exception("SampleAggregatorImp::push_signal_total(): called after update()",
-                           GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-        }
-        int result = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
-        auto bad_it = m_avg_signal.find(result);
-        if (bad_it != m_avg_signal.end()) {
-           throw Exception("SampleAggregatorImp::push_signal_total(): signal already pushed for average",
-                           GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-        }
-        auto signal_it = m_sum_signal.find(result);
-        if (signal_it == m_sum_signal.end()) {
-            m_sum_signal[result] = {
-                NAN,
-                m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx),
-                GEOPM_REGION_HASH_INVALID,
-                m_platform_io.push_signal("EPOCH_COUNT", domain_type, domain_idx),
-                0,
-                SumAccumulator::make_unique(),
-                SumAccumulator::make_unique(),
-                SumAccumulator::make_unique(),
-                {},
-                {},
-           };
-        }
-        return result;
+        return push_signal_helper(signal_name, domain_type, domain_idx, true);
     }
 
     int SampleAggregatorImp::push_signal_average(const std::string &signal_name,
                                                  int domain_type,
                                                  int domain_idx)
     {
+        return push_signal_helper(signal_name, domain_type, domain_idx, false);
+    }
+
+    int SampleAggregatorImp::push_signal_helper(const std::string &signal_name,
+                                                int domain_type,
+                                                int domain_idx,
+                                                bool is_total)
+    {
+        std::string func = is_total ? "push_signal_total" : "push_signal_average";
         if (m_is_updated) {
-           throw Exception("SampleAggregatorImp::push_signal_average(): called after update()",
+           throw Exception("SampleAggregatorImp::" + func + "(): called after update()",
                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
         int result = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
-        auto bad_it = m_sum_signal.find(result);
-        if (bad_it != m_sum_signal.end()) {
-           throw Exception("SampleAggregatorImp::push_signal_average(): signal already pushed for total",
-                           GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        auto signal_it = m_signal.find(result);
+        if (signal_it != m_signal.end()) {
+            if (signal_it->second.is_total != is_total) {
+                throw Exception("SampleAggregatorImp::" + func + "(): signal already pushed for " +
+                                (is_total ? "average" : "total"),
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            return result;
         }
-        auto signal_it = m_avg_signal.find(result);
-        if (signal_it == m_avg_signal.end()) {
-            m_avg_signal[result] = {
-                NAN,
+        // Signals in the same domain share a group
+        auto domain = std::make_pair(domain_type, domain_idx);
+        auto group_it = m_domain_group.find(domain);
+        if (group_it == m_domain_group.end()) {
+            m_group.push_back({
                 m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx),
                 GEOPM_REGION_HASH_INVALID,
                 m_platform_io.push_signal("EPOCH_COUNT", domain_type, domain_idx),
-                0,
-                AvgAccumulator::make_unique(),
-                AvgAccumulator::make_unique(),
-                AvgAccumulator::make_unique(),
-                {},
-                {},
-           };
+                0, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, -1, {}, {},
+            });
+            group_it = m_domain_group.emplace(domain, m_group.size() - 1).first;
+        }
+        m_group_s &group = m_group[group_it->second];
+        int column = -1;
+        if (is_total) {
+            column = group.sum_signal_idx.size();
+            group.sum_signal_idx.push_back(result);
+            group.sum_sample_last.push_back(NAN);
+            group.sum_app.emplace_back();
+            group.sum_epoch.emplace_back();
+            group.sum_period.emplace_back();
         }
-        return result;
-    }
-
-    template<typename type>
-    typename std::map<uint64_t, std::shared_ptr<type> >::iterator
-    sample_aggregator_emplace_hash(
-        std::map<uint64_t, std::shared_ptr<type> > &hash_accum_map,
-        uint64_t hash)
-    {
-        typename std::map<uint64_t, std::shared_ptr<type> >::iterator result;
-        result = hash_accum_map.find(hash);
-        if (result == hash_accum_map.end()) {
-            auto empl_ret = hash_accum_map.emplace(hash, type::make_unique());
-            result = empl_ret.first;
+        else {
+            column = group.avg_signal_idx.size();
+            group.avg_signal_idx.push_back(result);
+            group.avg_app.emplace_back();
+            group.avg_epoch.emplace_back();
+            group.avg_period.emplace_back();
         }
+        m_signal[result] = {is_total, group_it->second, column};
         return result;
     }
 
     template <typename type>
-    void sample_aggregator_update_epoch(type &signal, int epoch_count)
+    void sample_aggregator_enter(type *accum, size_t num_accum)
     {
-        // If the epoch count has changed, call the exit/enter
-        if (epoch_count != signal.epoch_count_last) {
-            if (signal.epoch_count_last != 0) {
-                signal.epoch_accum->exit();
-            }
-            signal.epoch_accum->enter();
-            signal.epoch_count_last = epoch_count;
+        for (size_t idx = 0; idx < num_accum; ++idx) {
+            accum[idx].enter();
         }
     }
 
     template <typename type>
-    void sample_aggregator_update_hash_exit(type &signal, uint64_t hash)
+    void sample_aggregator_exit(type *accum, size_t num_accum)
     {
-        if (signal.region_hash_last != hash) {
-            // If we have exited a valid region, call exit()
-            if (signal.region_hash_last != GEOPM_REGION_HASH_UNMARKED) {
-                signal.region_accum_it->second->exit();
-            }
-        }
-    }
-
-    template <typename type>
-    void sample_aggregator_update_hash_enter(type &signal, uint64_t hash)
-    {
-        if (signal.region_hash_last != hash) {
-            // If we have entered a valid region, call enter()
-            if (hash != GEOPM_REGION_HASH_UNMARKED) {
-                signal.region_accum_it->second->enter();
-            }
-        }
-    }
-
-    template <typename type>
-    void sample_aggregator_update_period(type &signal, int period)
-    {
-        if (period != 0) {
-            signal.period_accum->exit();
+        for (size_t idx = 0; idx < num_accum; ++idx) {
+            accum[idx].exit();
         }
-        signal.period_accum->enter();
     }
 
     uint64_t SampleAggregatorImp::sample_to_hash(double sample)
@@ -216,205 +177,186 @@ namespace geopm
     {
         int result = 0;
         if (m_period_duration) {
-            double time = m_platform_io.sample(m_time_idx);
+            result = time_to_period(m_platform_io.sample(m_time_idx));
+        }
+        return result;
+    }
+
+    int SampleAggregatorImp::time_to_period(double time) const
+    {
+        int result = 0;
+        if (m_period_duration) {
             result = static_cast<int>(time / m_period_duration);
         }
         return result;
     }
 
-    void SampleAggregatorImp::update_total(void)
+    int SampleAggregatorImp::region_row(m_group_s &group, uint64_t hash)
     {
-        int period = get_period();
-        // Update all of the sum aggregators
-        for (auto &signal_it : m_sum_signal) {
-            int signal_idx = signal_it.first;
-            m_sum_signal_s &signal = signal_it.second;
-            double sample = m_platform_io.sample(signal_idx);
-            uint64_t hash = sample_to_hash(m_platform_io.sample(signal.region_hash_idx));
-            int epoch_count = m_platform_io.sample(signal.epoch_count_idx);
-            if (!m_is_updated) {
-                // On first call just initialize the signal values
-                signal.sample_last = sample;
-                signal.region_hash_last = hash;
-                signal.epoch_count_last = epoch_count;
-                signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
-            }
-            else {
-                if (std::isnan(sample)) {
-                    continue;
-                }
-                // Measure the change since the last update
-                double delta = 0;
-                if (!std::isnan(signal.sample_last)) {
-                    delta = sample - signal.sample_last;
-                }
-                // Update that application totals
-                signal.app_accum->update(delta);
-                // If we have observed our first epoch, update epoch totals
-                if (signal.epoch_count_last != 0) {
-                    signal.epoch_accum->update(delta);
-                }
-                // Update the periodic totals
-                signal.period_accum->update(delta);
-                // Update region totals
-                signal.region_accum_it->second->update(delta);
-                sample_aggregator_update_epoch(signal, epoch_count);
-                sample_aggregator_update_hash_exit(signal, hash);
-                if (signal.region_hash_last != hash) {
-                    signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
-                }
-                sample_aggregator_update_hash_enter(signal, hash);
-                if (period != m_period_last) {
-                    sample_aggregator_update_period(signal, period);
-                }
-                signal.region_hash_last = hash;
-                signal.sample_last = sample;
-            }
+        auto it = group.region_row.find(hash);
+        if (it == group.region_row.end()) {
+            it = group.region_row.emplace(hash, group.region_row.size()).first;
+            group.region_sum.resize(group.region_sum.size() + group.sum_signal_idx.size());
+            group.region_avg.resize(group.region_avg.size() + group.avg_signal_idx.size());
         }
+        return it->second;
     }
 
-    void SampleAggregatorImp::update_average(void)
+    void SampleAggregatorImp::update_group(m_group_s &group, int period, double time)
     {
-        int period = get_period();
-        // Update all of the average aggregators
-        for (auto &signal_it : m_avg_signal) {
-            int signal_idx = signal_it.first;
-            m_avg_signal_s &signal = signal_it.second;
-            double time = m_platform_io.sample(m_time_idx);
-            double sample = m_platform_io.sample(signal_idx);
-            uint64_t hash = sample_to_hash(m_platform_io.sample(signal.region_hash_idx));
-            int epoch_count = m_platform_io.sample(signal.epoch_count_idx);
-            if (!m_is_updated) {
-                // On first call just initialize the signal values
-                signal.time_last = 0.0;
-                signal.region_hash_last = hash;
-                signal.epoch_count_last = epoch_count;
-                signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
+        size_t num_sum = group.sum_signal_idx.size();
+        size_t num_avg = group.avg_signal_idx.size();
+        uint64_t hash = sample_to_hash(m_platform_io.sample(group.region_hash_idx));
+        int epoch_count = m_platform_io.sample(group.epoch_count_idx);
+        if (!m_is_updated) {
+            // On first call just initialize the signal values
+            for (size_t col = 0; col < num_sum; ++col) {
+                group.sum_sample_last[col] = m_platform_io.sample(group.sum_signal_idx[col]);
             }
-            else {
-                // Measure the time change since the last update
-                double delta = time - signal.time_last;
-                // Update that application totals
-                signal.app_accum->update(delta, sample);
-                // If we have observed our first epoch, update epoch totals
-                if (signal.epoch_count_last != 0) {
-                    signal.epoch_accum->update(delta, sample);
-                }
-                // Update the periodic totals
-                signal.period_accum->update(delta, sample);
-                // Update region totals
-                signal.region_accum_it->second->update(delta, sample);
-
-                sample_aggregator_update_epoch(signal, epoch_count);
-                sample_aggregator_update_hash_exit(signal, hash);
-                if (signal.region_hash_last != hash) {
-                    signal.region_accum_it = sample_aggregator_emplace_hash(signal.region_accum, hash);
-                }
-                sample_aggregator_update_hash_enter(signal, hash);
-                if (period != m_period_last) {
-                    sample_aggregator_update_period(signal, period);
-                }
-                signal.region_hash_last = hash;
-                signal.time_last = time;
+            group.region_hash_last = hash;
+            group.epoch_count_last = epoch_count;
+            group.region_row_last = region_row(group, hash);
+            return;
+        }
+        // If we have observed our first epoch, update epoch totals
+        bool is_epoch_started = group.epoch_count_last != 0;
+        SumAccumulatorImp *region_sum = group.region_sum.data() + group.region_row_last * num_sum;
+        for (size_t col = 0; col < num_sum; ++col) {
+            double sample = m_platform_io.sample(group.sum_signal_idx[col]);
+            if (std::isnan(sample)) {
+                continue;
             }
+            // Measure the change since the last update
+            double delta = 0;
+            if (!std::isnan(group.sum_sample_last[col])) {
+                delta = sample - group.sum_sample_last[col];
+            }
+            group.sum_app[col].update(delta);
+            if (is_epoch_started) {
+                group.sum_epoch[col].update(delta);
+            }
+            group.sum_period[col].update(delta);
+            region_sum[col].update(delta);
+            group.sum_sample_last[col] = sample;
+        }
+        // Measure the time change since the last update
+        double delta_time = time - m_time_last;
+        AvgAccumulatorImp *region_avg = group.region_avg.data() + group.region_row_last * num_avg;
+        for (size_t col = 0; col < num_avg; ++col) {
+            double sample = m_platform_io.sample(group.avg_signal_idx[col]);
+            group.avg_app[col].update(delta_time, sample);
+            if (is_epoch_started) {
+                group.avg_epoch[col].update(delta_time, sample);
+            }
+            group.avg_period[col].update(delta_time, sample);
+            region_avg[col].update(delta_time, sample);
+        }
+
+        // If the epoch count has changed, call the exit/enter
+        if (epoch_count != group.epoch_count_last) {
+            if (is_epoch_started) {
+                sample_aggregator_exit(group.sum_epoch.data(), num_sum);
+                sample_aggregator_exit(group.avg_epoch.data(), num_avg);
+            }
+            sample_aggregator_enter(group.sum_epoch.data(), num_sum);
+            sample_aggregator_enter(group.avg_epoch.data(), num_avg);
+            group.epoch_count_last = epoch_count;
+        }
+        if (hash != group.region_hash_last) {
+            // If we have exited a valid region, call exit()
+            if (group.region_hash_last != GEOPM_REGION_HASH_UNMARKED) {
+                sample_aggregator_exit(region_sum, num_sum);
+                sample_aggregator_exit(region_avg, num_avg);
+            }
+            // Adding a row may move the tables
+            group.region_row_last = region_row(group, hash);
+            // If we have entered a valid region, call enter()
+            if (hash != GEOPM_REGION_HASH_UNMARKED) {
+                sample_aggregator_enter(group.region_sum.data() + group.region_row_last * num_sum, num_sum);
+                sample_aggregator_enter(group.region_avg.data() + group.region_row_last * num_avg, num_avg);
+            }
+            group.region_hash_last = hash;
+        }
+        if (period != m_period_last) {
+            if (period != 0) {
+                sample_aggregator_exit(group.sum_period.data(), num_sum);
+                sample_aggregator_exit(group.avg_period.data(), num_avg);
+            }
+            sample_aggregator_enter(group.sum_period.data(), num_sum);
+            sample_aggregator_enter(group.avg_period.data(), num_avg);
         }
     }
 
     void SampleAggregatorImp::update(void)
     {
-        update_total();
-        update_average();
-        m_period_last = get_period();
+        double time = m_platform_io.sample(m_time_idx);
+        int period = time_to_period(time);
+        for (auto &group : m_group) {
+            update_group(group, period, time);
+        }
+        if (m_is_updated) {
+            m_time_last = time;
+        }
+        m_period_last = period;
         m_is_updated = true;
     }
 
+    const SampleAggregatorImp::m_signal_s &SampleAggregatorImp::signal(int signal_idx,
+                                                                       const std::string &func) const
+    {
+        auto it = m_signal.find(signal_idx);
+        if (it == m_signal.end()) {
+            throw Exception("SampleAggregator::" + func + "(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+
     double SampleAggregatorImp::sample_application(int signal_idx)
     {
         if (!m_is_updated) {
             return NAN;
         }
-
-        double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            result = sum_it->second.app_accum->total();
-        }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_application(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            result = avg_it->second.app_accum->average();
-        }
-        return result;
+        const m_signal_s &sig = signal(signal_idx, "sample_application");
+        const m_group_s &group = m_group[sig.group_idx];
+        return sig.is_total ? group.sum_app[sig.column].total() :
+                              group.avg_app[sig.column].average();
     }
 
     double SampleAggregatorImp::sample_epoch_helper(int signal_idx, bool is_last)
     {
+        const m_signal_s &sig = signal(signal_idx, "sample_epoch");
+        const m_group_s &group = m_group[sig.group_idx];
         double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            if (is_last) {
-                result = sum_it->second.epoch_accum->interval_total();
-            }
-            else {
-                result = sum_it->second.epoch_accum->total();
-            }
+        if (sig.is_total) {
+            const SumAccumulatorImp &accum = group.sum_epoch[sig.column];
+            result = is_last ? accum.interval_total() : accum.total();
         }
         else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_epoch(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            if (is_last) {
-                result = avg_it->second.epoch_accum->interval_average();
-            }
-            else {
-                result = avg_it->second.epoch_accum->average();
-            }
+            const AvgAccumulatorImp &accum = group.avg_epoch[sig.column];
+            result = is_last ? accum.interval_average() : accum.average();
         }
         return result;
     }
 
     double SampleAggregatorImp::sample_region_helper(int signal_idx, uint64_t region_hash, bool is_last)
     {
+        const m_signal_s &sig = signal(signal_idx, "sample_region");
+        const m_group_s &group = m_group[sig.group_idx];
+        auto row_it = group.region_row.find(region_hash);
         double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            const auto &region_accum = sum_it->second.region_accum;
-            auto region_accum_it = region_accum.find(region_hash);
-            if (region_accum_it == region_accum.end()) {
-                result = 0.0;
-            }
-            else {
-                auto accum_ptr = region_accum_it->second;
-                if (is_last) {
-                    result = accum_ptr->interval_total();
-                }
-                else {
-                    result = accum_ptr->total();
-                }
+        if (sig.is_total) {
+            result = 0.0;
+            if (row_it != group.region_row.end()) {
+                const SumAccumulatorImp &accum =
+                    group.region_sum[row_it->second * group.sum_signal_idx.size() + sig.column];
+                result = is_last ? accum.interval_total() : accum.total();
             }
         }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_region(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            const auto &region_accum = avg_it->second.region_accum;
-            auto region_accum_it = region_accum.find(region_hash);
-            if (region_accum_it != region_accum.end()) {
-                auto accum_ptr = region_accum_it->second;
-                if (is_last) {
-                    result = accum_ptr->interval_average();
-                }
-                else {
-                    result = accum_ptr->average();
-                }
-            }
+        else if (row_it != group.region_row.end()) {
+            const AvgAccumulatorImp &accum =
+                group.region_avg[row_it->second * group.avg_signal_idx.size() + sig.column];
+            result = is_last ? accum.interval_average() : accum.average();
         }
         return result;
     }
@@ -465,21 +407,10 @@ namespace geopm
         if (!m_is_updated || m_period_duration == 0.0) {
             return NAN;
         }
-
-        double result = NAN;
-        auto sum_it = m_sum_signal.find(signal_idx);
-        if (sum_it != m_sum_signal.end()) {
-            result = sum_it->second.period_accum->interval_total();
-        }
-        else {
-            auto avg_it = m_avg_signal.find(signal_idx);
-            if (avg_it == m_avg_signal.end()) {
-                throw Exception("SampleAggregator::sample_period(): Invalid signal index: signal index not pushed with push_signal_total() or push_signal_average()",
-                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
-            }
-            result = avg_it->second.period_accum->interval_average();
-        }
-        return result;
+        const m_signal_s &sig = signal(signal_idx, "sample_period");
+        const m_group_s &group = m_group[sig.group_idx];
+        return sig.is_total ? group.sum_period[sig.column].interval_total() :
+                              group.avg_period[sig.column].interval_average();
     }
 
 }
@@ -9,14 +9,14 @@
 #include <cmath>
 
 #include <map>
+#include <vector>
 
 #include "SampleAggregator.hpp"
+#include "Accumulator.hpp"
 
 namespace geopm
 {
     class PlatformIO;
-    class SumAccumulator;
-    class AvgAccumulator;
 
     class SampleAggregatorImp : public SampleAggregator
     {
@@ -43,10 +43,12 @@ namespace geopm
             double sample_period_last(int signal_idx) override;
 
         private:
-            // All of the data relating to a pushed "total" signal
-            struct m_sum_signal_s {
-                // Value of the signal from last control interval
-                double sample_last;
+            // Signals that share a domain also share the REGION_HASH
+            // and EPOCH_COUNT signals, so transitions are detected
+            // once for the group.  Accumulators are stored in columns
+            // with one column per signal: each region has one row of
+            // region_sum/region_avg.
+            struct m_group_s {
                 // PlatformIO signal index to get the region hash
                 int region_hash_idx;
                 // Value of the hash from last control interval
@@ -55,44 +57,44 @@ namespace geopm
                 int epoch_count_idx;
                 // Value of the epoch count from last control interval
                 int epoch_count_last;
-                // Accumulator for application totals (always updated)
-                std::shared_ptr<SumAccumulator> app_accum;
-                // Accumulator for epoch totals (updated after first epoch call)
-                std::shared_ptr<SumAccumulator> epoch_accum;
-                // Accumulator for periodic totals (always updated)
-                std::shared_ptr<SumAccumulator> period_accum;
-                // Map from region hash to an accumulator for that region
-                std::map<uint64_t, std::shared_ptr<SumAccumulator> > region_accum;
-                // Iterator pointing to the region_hash_last map location
-                std::map<uint64_t, std::shared_ptr<SumAccumulator> >::iterator region_accum_it;
+                // PlatformIO signal index for each "total" column
+                std::vector<int> sum_signal_idx;
+                // Value of each "total" signal from last control interval
+                std::vector<double> sum_sample_last;
+                // PlatformIO signal index for each "average" column
+                std::vector<int> avg_signal_idx;
+                // Accumulators for application totals (always updated)
+                std::vector<SumAccumulatorImp> sum_app;
+                std::vector<AvgAccumulatorImp> avg_app;
+                // Accumulators for epoch totals (updated after first epoch call)
+                std::vector<SumAccumulatorImp> sum_epoch;
+                std::vector<AvgAccumulatorImp> avg_epoch;
+                // Accumulators for periodic totals (always updated)
+                std::vector<SumAccumulatorImp> sum_period;
+                std::vector<AvgAccumulatorImp> avg_period;
+                // Map from region hash to its row in the region tables
+                std::map<uint64_t, int> region_row;
+                // Row of the region_hash_last region
+                int region_row_last;
+                // Region accumulators, row-major
+                std::vector<SumAccumulatorImp> region_sum;
+                std::vector<AvgAccumulatorImp> region_avg;
             };
 
-            // All of the data relating to each pushed "average" signal
-            struct m_avg_signal_s {
-                // Time stamp from last control interval
-                double time_last;
-                // PlatformIO signal index to get the region hash
-                int region_hash_idx;
-                // Value of the hash from last control interval
-                uint64_t region_hash_last;
-                // PlatformIO signal index to get the epoch count
-                int epoch_count_idx;
-                // Value of the epoch count from last control interval
-                int epoch_count_last;
-                // Accumulator for application totals (always updated)
-                std::shared_ptr<AvgAccumulator> app_accum;
-                // Accumulator for epoch totals (updated after first epoch call)
-                std::shared_ptr<AvgAccumulator> epoch_accum;
-                // Accumulator for periodic totals (always updated)
-                std::shared_ptr<AvgAccumulator> period_accum;
-                // Map from region hash to an accumulator for that region
-                std::map<uint64_t, std::shared_ptr<AvgAccumulator> > region_accum;
-                // Iterator pointing to the region_hash_last map location
-                std::map<uint64_t, std::shared_ptr<AvgAccumulator> >::iterator region_accum_it;
+            // Location of a pushed signal's accumulators
+            struct m_signal_s {
+                bool is_total;
+                int group_idx;
+                int column;
             };
 
-            void update_total(void);
-            void update_average(void);
+            int push_signal_helper(const std::string &signal_name,
+                                   int domain_type, int domain_idx,
+                                   bool is_total);
+            void update_group(m_group_s &group, int period, double time);
+            int region_row(m_group_s &group, uint64_t hash);
+            int time_to_period(double time) const;
+            const m_signal_s &signal(int signal_idx, const std::string &func) const;
             double sample_epoch_helper(int signal_idx, bool is_last);
             double sample_region_helper(int signal_idx, uint64_t region_hash, bool is_last);
             uint64_t sample_to_hash(double sample);
@@ -101,12 +103,14 @@ namespace geopm
             // PlatformIO signal index for time of last sample
             int m_time_idx;
             bool m_is_updated;
-            // Map from index returned by push_signal_total() to the
-            // signal structure
-            std::map<int, m_sum_signal_s> m_sum_signal;
-            // Map from index returned by push_signal_average() to the
-            // signal structure
-            std::map<int, m_avg_signal_s> m_avg_signal;
+            // Time of the last update used to weight averages
+            double m_time_last;
+            std::vector<m_group_s> m_group;
+            // Map from domain to index into m_group
+            std::map<std::pair<int, int>, int> m_domain_group;
+            // Map from index returned by push_signal_total() or
+            // push_signal_average() to the signal location
+            std::map<int, m_signal_s> m_signal;
             double m_period_duration;
             int m_period_last;
     };
@@ -6,6 +6,9 @@
 #include "config.h"
 
 #include "Scheduler.hpp"
+
+#include <errno.h>
+
 #include "geopm/Exception.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm_sched.h"
@@ -57,6 +60,41 @@ namespace geopm
         return result;
     }
 
+    std::map<int, std::vector<bool> >
+        SchedulerImp::proc_cpusets(const std::vector<int> &pid) const
+    {
+        std::map<int, std::vector<bool> > result;
+        if (pid.empty()) {
+            return result;
+        }
+        size_t cpuset_size = CPU_ALLOC_SIZE(m_num_cpu);
+        std::vector<char> cpuset(pid.size() * cpuset_size);
+        std::vector<int> pid_err(pid.size());
+        int err = geopm_sched_proc_cpuset_pids(pid.size(), pid.data(), m_num_cpu,
+                                               (cpu_set_t *)cpuset.data(), pid_err.data());
+        if (err != 0) {
+            throw Exception("geopm_sched_proc_cpuset_pids() failed",
+                            err, __FILE__, __LINE__);
+        }
+        for (size_t pid_idx = 0; pid_idx < pid.size(); ++pid_idx) {
+            if (pid_err[pid_idx] == ESRCH) {
+                continue;
+            }
+            if (pid_err[pid_idx] != 0) {
+                throw Exception("geopm_sched_proc_cpuset_pids() failed for PID " +
+                                std::to_string(pid[pid_idx]),
+                                pid_err[pid_idx], __FILE__, __LINE__);
+            }
+            const cpu_set_t *pid_cpuset = (const cpu_set_t *)(cpuset.data() + pid_idx * cpuset_size);
+            std::vector<bool> &pid_result = result[pid[pid_idx]];
+            pid_result.resize(m_num_cpu, false);
+            for (int cpu_idx = 0; cpu_idx < m_num_cpu; ++cpu_idx) {
+                pid_result[cpu_idx] = CPU_ISSET_S(cpu_idx, cpuset_size, pid_cpuset);
+            }
+        }
+        return result;
+    }
+
     std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >
         SchedulerImp::woomp(int pid) const
     {
@@ -6,8 +6,10 @@
 #ifndef SCHEDULER_HPP_INCLUDE
 #define SCHEDULER_HPP_INCLUDE
 
+#include <map>
 #include <memory>
 #include <functional>
+#include <vector>
 #include <sched.h>
 
 namespace geopm
@@ -24,6 +26,15 @@ namespace geopm
                 proc_cpuset(void) const = 0;
             virtual std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >
                 proc_cpuset(int pid) const = 0;
+            /// @brief Query the affinity of many processes at once.
+            /// @param [in] pid Linux process IDs to query.
+            /// @return Map from each process ID whose affinity could
+            ///         be determined to a bitmap of num_cpu() values
+            ///         that are true for each CPU the process may run
+            ///         on.  Processes that no longer exist are left
+            ///         out of the map.
+            virtual std::map<int, std::vector<bool> >
+                proc_cpusets(const std::vector<int> &pid) const = 0;
             virtual std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >
                 woomp(int pid) const = 0;
     };
@@ -39,6 +50,8 @@ namespace geopm
                 proc_cpuset(void) const override;
             virtual std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >
                 proc_cpuset(int pid) const override;
+            virtual std::map<int, std::vector<bool> >
+                proc_cpusets(const std::vector<int> &pid) const override;
             virtual std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >
                 woomp(int pid) const override;
         private:
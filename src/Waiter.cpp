@@ -7,17 +7,21 @@
 
 #include "Waiter.hpp"
 
-#include <time.h>
-
 #include "geopm/Exception.hpp"
 #include "geopm_time.h"
+#include "ApplicationSampler.hpp"
+#include "Environment.hpp"
 
 
 namespace geopm
 {
     std::unique_ptr<Waiter> Waiter::make_unique(double period)
     {
-        return Waiter::make_unique(period, "sleep");
+        std::string strategy = "sleep";
+        if (environment().do_event_period()) {
+            strategy = "event";
+        }
+        return Waiter::make_unique(period, strategy);
     }
 
     std::unique_ptr<Waiter> Waiter::make_unique(double period,
@@ -26,6 +30,9 @@ namespace geopm
         if (strategy == "sleep") {
             return std::make_unique<SleepWaiter>(period);
         }
+        else if (strategy == "event") {
+            return std::make_unique<EventWaiter>(period, environment().event_period());
+        }
         else {
             throw Exception("Waiter::make_unique(): Unknown strategy: " + strategy,
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -58,16 +65,7 @@ namespace geopm
             reset();
             m_is_first_time = false;
         }
-        int err = 0;
-        do {
-            err = clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME,
-                                  &(m_time_target.t), nullptr);
-        } while(err == EINTR);
-
-        if (err != 0) {
-            throw Exception("Waiter::wait(): Failed with error: ",
-                            err, __FILE__, __LINE__);
-        }
+        time_sleep_until_real(m_time_target);
         geopm_time_add(&m_time_target, m_period, &m_time_target);
     }
 
@@ -75,4 +73,66 @@ namespace geopm
     {
         return m_period;
     }
+
+    EventWaiter::EventWaiter(double period, double min_period)
+        : m_period(period)
+        , m_min_period(min_period)
+        , m_sampler(nullptr)
+        , m_time_target({{0, 0}})
+        , m_time_last({{0, 0}})
+        , m_is_first_time(true)
+    {
+
+    }
+
+    EventWaiter::EventWaiter(double period, double min_period,
+                             ApplicationSampler &sampler)
+        : EventWaiter(period, min_period)
+    {
+        m_sampler = &sampler;
+    }
+
+    void EventWaiter::reset(void)
+    {
+        geopm_time_real(&m_time_last);
+        geopm_time_add(&m_time_last, m_period, &m_time_target);
+    }
+
+    void EventWaiter::reset(double period)
+    {
+        m_period = period;
+        reset();
+    }
+
+    void EventWaiter::wait(void)
+    {
+        if (m_is_first_time) {
+            reset();
+            m_is_first_time = false;
+        }
+        if (m_sampler == nullptr) {
+            m_sampler = &(ApplicationSampler::application_sampler());
+        }
+        // Hold off until the minimum period has elapsed, or until
+        // the periodic step if that is sooner
+        geopm_time_s earliest;
+        geopm_time_add(&m_time_last, m_min_period, &earliest);
+        if (geopm_time_comp(&m_time_target, &earliest)) {
+            earliest = m_time_target;
+        }
+        time_sleep_until_real(earliest);
+        bool is_event = m_sampler->wait_event(m_time_target);
+        if (!is_event) {
+            // The sampler may return before the deadline if it is
+            // not connected to an application
+            time_sleep_until_real(m_time_target);
+            geopm_time_add(&m_time_target, m_period, &m_time_target);
+        }
+        geopm_time_real(&m_time_last);
+    }
+
+    double EventWaiter::period(void) const
+    {
+        return m_period;
+    }
 }
@@ -11,16 +11,21 @@
 
 namespace geopm
 {
+    class ApplicationSampler;
+
     /// @brief Class to support a periodic wait loop
     class Waiter
     {
         public:
-            /// @brief Create a Waiter with "sleep" strategy
+            /// @brief Create a Waiter with "event" strategy if
+            ///        GEOPM_EVENT_PERIOD is set, otherwise with
+            ///        "sleep" strategy
             /// @param [in] period Duration in seconds to wait
             static std::unique_ptr<Waiter> make_unique(double period);
             /// @brief Create a Waiter
             /// @param [in] period Duration in seconds to wait
-            /// @param [in] strategy Wait algorithm ("sleep")
+            /// @param [in] strategy Wait algorithm ("sleep" or
+            ///        "event")
             static std::unique_ptr<Waiter> make_unique(double period,
                                                        std::string strategy);
             Waiter() = default;
@@ -54,6 +59,43 @@ namespace geopm
             geopm_time_s m_time_target;
             bool m_is_first_time;
     };
+
+    /// @brief Class to support a periodic wait loop that returns
+    ///        early when an application process enters a region.
+    ///
+    /// The wait ends at the end of the period, or when a region
+    /// entry is published by the application, whichever is first.
+    /// Steps are never started more often than the minimum period,
+    /// and a step triggered by a region entry does not move the
+    /// schedule of the periodic steps.
+    class EventWaiter : public Waiter
+    {
+        public:
+            /// @param [in] period Duration in seconds to wait
+            /// @param [in] min_period Minimum duration in seconds
+            ///        between the end of two waits
+            EventWaiter(double period, double min_period);
+            /// @param [in] period Duration in seconds to wait
+            /// @param [in] min_period Minimum duration in seconds
+            ///        between the end of two waits
+            /// @param [in] sampler Source of region entry events
+            EventWaiter(double period, double min_period,
+                        ApplicationSampler &sampler);
+            virtual ~EventWaiter() = default;
+            void reset(void) override;
+            void reset(double period) override;
+            void wait(void) override;
+            double period(void) const override;
+        private:
+            double m_period;
+            double m_min_period;
+            // Resolved on first wait() so that agents may be
+            // constructed without connecting to an application
+            ApplicationSampler *m_sampler;
+            geopm_time_s m_time_target;
+            geopm_time_s m_time_last;
+            bool m_is_first_time;
+    };
 }
 
 #endif
@@ -117,6 +117,32 @@ int geopm_endpoint_stop_wait_loop(struct geopm_endpoint_c *endpoint);
  */
 int geopm_endpoint_reset_wait_loop(struct geopm_endpoint_c *endpoint);
 
+/*!
+ *  @brief Blocks until the sample or attach state of any of the
+ *         endpoints changes or the timeout is reached.  An endpoint
+ *         is also reported when geopm_endpoint_stop_wait_loop() is
+ *         called on it.
+ *
+ *  @param [in] num_endpoint Number of endpoints in the array.
+ *
+ *  @param [in] endpoint Array of objects created by call to
+ *         geopm_endpoint_create() and opened.
+ *
+ *  @param [in] timeout Timeout in seconds, negative to wait without
+ *         a limit.
+ *
+ *  @param [out] is_updated Array of length num_endpoint.  Set to 1
+ *         for each endpoint that changed since it was last reported
+ *         and 0 otherwise.  All values are 0 if the timeout is
+ *         reached.
+ *
+ *  @return Zero on success, error code on failure.
+ */
+int geopm_endpoint_wait(size_t num_endpoint,
+                        struct geopm_endpoint_c **endpoint,
+                        double timeout,
+                        int *is_updated);
+
 /*!
  *  @brief Check profile name for an attached job.
  *
@@ -184,9 +210,15 @@ int geopm_endpoint_node_name(struct geopm_endpoint_c *endpoint,
  *         geopm_endpoint_create() that has reported an attached
  *         agent.
  *
+ *  @param [in] num_policy Length of policy_array, equal to the
+ *         number of policy values accepted by the attached agent.
+ *         An agent with a variable size policy, e.g. frequency_map,
+ *         also accepts a shorter array.
+ *
  *  @param [in] policy_array Array of length returned by
  *         geopm_agent_num_policy() specifying the value of each policy
- *         parameter.
+ *         parameter.  Values missing from a shorter array are read
+ *         by an agent with a variable size policy as NAN.
  *
  *  @return Zero on success, error code on failure
  */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "ControllerReplay.hpp"
+#include "OptionParser.hpp"
+
+#include "config.h"
+
+static int main_imp(int argc, char **argv);
+
+int main(int argc, char **argv)
+{
+    int err = 0;
+    try {
+        err = main_imp(argc, argv);
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: geopmreplay: " << ex.what() << "\n\n";
+        err = ex.err_value();
+    }
+    return err;
+}
+
+/// Parse a comma-separated list of NAME=VALUE pairs
+static std::map<std::string, double> parse_value_map(const std::string &option,
+                                                     const std::string &str)
+{
+    std::map<std::string, double> result;
+    if (str.empty()) {
+        return result;
+    }
+    for (const auto &pair : geopm::string_split(str, ",")) {
+        size_t pos = pair.find('=');
+        char *end_ptr = nullptr;
+        double value = NAN;
+        if (pos != std::string::npos) {
+            value = strtod(pair.c_str() + pos + 1, &end_ptr);
+        }
+        if (pos == std::string::npos || pos == 0 ||
+            end_ptr == pair.c_str() + pos + 1 || *end_ptr != '\0') {
+            throw geopm::Exception("Invalid " + option + " value, expected NAME=VALUE: " + pair,
+                                   GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        result[pair.substr(0, pos)] = value;
+    }
+    return result;
+}
+
+static int main_imp(int argc, char **argv)
+{
+    geopm::OptionParser parser{"geopmreplay", std::cout, std::cerr, ""};
+    parser.add_option("agent", 'a', "agent", "monitor",
+                      "name of the agent to run: monitor, power_governor or frequency_map");
+    parser.add_option("trace", 't', "trace", "", "controller trace file to replay");
+    parser.add_option("profile_trace", 'f', "profile-trace", "",
+                      "profile trace file to replay");
+    parser.add_option("policy", 'p', "policy", "", "policy file for the agent");
+    parser.add_option("signal", 's', "signal", "",
+                      "constant signals missing from the trace in a comma-separated list of NAME=VALUE");
+    parser.add_option("control", 'c', "control", "",
+                      "controls required by the agent in a comma-separated list of NAME=VALUE");
+    parser.add_option("real_time", 'r', "real-time", false,
+                      "wait for the recorded time of each sample rather than running as fast as possible");
+    parser.add_option("report", 'o', "report", "", "path of the report generated by the replay");
+    parser.add_option("trace_out", 'T', "trace-out", "",
+                      "path of the controller trace generated by the replay");
+    parser.add_option("profile_trace_out", 'F', "profile-trace-out", "",
+                      "path of the profile trace generated by the replay");
+    parser.add_example_usage("-t TRACE -f PROFILE_TRACE [-a AGENT] [-p POLICY] [-r]");
+    parser.add_example_usage("-t TRACE -f PROFILE_TRACE -a power_governor -p POLICY "
+                             "-c CPU_POWER_LIMIT_CONTROL=200 "
+                             "-s CPU_POWER_MIN_AVAIL=50,CPU_POWER_MAX_AVAIL=250,CPU_POWER_LIMIT_DEFAULT=200");
+    bool early_exit = parser.parse(argc, argv);
+    if (early_exit) {
+        return 0;
+    }
+
+    int err = 0;
+    auto pos_args = parser.get_positional_args();
+    if (pos_args.size() > 0) {
+        std::cerr << "Error: The following positional argument(s) are in error:" << std::endl;
+        for (const std::string &arg : pos_args) {
+            std::cerr << arg << std::endl;
+        }
+        err = EINVAL;
+    }
+    if (!err && (parser.get_value("trace").empty() ||
+                 parser.get_value("profile_trace").empty())) {
+        std::cerr << "Error: Both the trace (-t) and the profile trace (-f) must be specified." << std::endl;
+        err = EINVAL;
+    }
+    if (!err) {
+        geopm::ControllerReplay replay(parser.get_value("agent"),
+                                       parser.get_value("trace"),
+                                       parser.get_value("profile_trace"),
+                                       parser.get_value("policy"),
+                                       parse_value_map("signal", parser.get_value("signal")),
+                                       parse_value_map("control", parser.get_value("control")),
+                                       parser.is_set("real_time"),
+                                       parser.get_value("report"),
+                                       parser.get_value("trace_out"),
+                                       parser.get_value("profile_trace_out"));
+        replay.run();
+        std::cout << replay.stage_table();
+    }
+    return err;
+}
@@ -66,6 +66,8 @@ TEST(AgentFactoryTest, static_info_governor)
     EXPECT_EQ(3, Agent::num_sample(dict));
     EXPECT_EQ(1, Agent::num_policy(agent_name));
     EXPECT_EQ(3, Agent::num_sample(agent_name));
+    EXPECT_FALSE(Agent::is_variable_policy_size(dict));
+    EXPECT_FALSE(Agent::is_variable_policy_size(agent_name));
     std::vector<std::string> exp_sample = {"POWER",
                                            "IS_CONVERGED",
                                            "POWER_AVERAGE_ENFORCED"};
@@ -86,6 +88,8 @@ TEST(AgentFactoryTest, static_info_frequency_map)
     EXPECT_EQ(0, Agent::num_sample(dict));
     EXPECT_EQ(65, Agent::num_policy(agent_name));
     EXPECT_EQ(0, Agent::num_sample(agent_name));
+    EXPECT_TRUE(Agent::is_variable_policy_size(dict));
+    EXPECT_TRUE(Agent::is_variable_policy_size(agent_name));
     std::vector<std::string> exp_sample = {};
     std::vector<std::string> exp_policy = {"FREQ_CPU_DEFAULT",
                                            "FREQ_CPU_UNCORE",
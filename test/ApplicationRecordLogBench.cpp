@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ApplicationRecordLog.hpp"
+#include "geopm/SharedMemory.hpp"
+#include "geopm_time.h"
+#include "record.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::ApplicationRecordLog;
+using geopm::SharedMemory;
+using geopm::record_s;
+using geopm::short_region_s;
+
+namespace
+{
+    struct record_log_state_s {
+        std::shared_ptr<SharedMemory> shmem;
+        std::unique_ptr<ApplicationRecordLog> record_log;
+        std::vector<record_s> records;
+        std::vector<short_region_s> short_regions;
+        geopm_time_s time;
+        int num_op;
+    };
+}
+
+GEOPM_MICRO_BENCH(ApplicationRecordLog, enter_exit)
+{
+    auto state = std::make_shared<record_log_state_s>();
+    std::string shm_key = "/geopm_micro_bench_record_log_" + std::to_string(getpid());
+    state->shmem = SharedMemory::make_unique_owner(shm_key, ApplicationRecordLog::buffer_size());
+    state->shmem->unlink();
+    state->record_log = ApplicationRecordLog::make_unique(state->shmem);
+    state->records.reserve(ApplicationRecordLog::max_record());
+    state->short_regions.reserve(ApplicationRecordLog::max_region());
+    geopm_time(&state->time);
+    state->num_op = 0;
+    const int num_hash = 16;
+    // The controller drains the log every control period; drain it
+    // well before the record buffer fills
+    const int dump_period = ApplicationRecordLog::max_record() / 4;
+    return [state, num_hash, dump_period]() {
+        uint64_t hash = 0x1000 + (state->num_op % num_hash);
+        state->record_log->enter(hash, state->time);
+        state->record_log->exit(hash, state->time);
+        ++state->num_op;
+        if (state->num_op % dump_period == 0) {
+            state->record_log->dump(state->records, state->short_regions);
+        }
+    };
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ApplicationRecordLog.hpp"
+#include "ApplicationSamplerImp.hpp"
+#include "ApplicationStatus.hpp"
+#include "Scheduler.hpp"
+#include "geopm/PlatformTopo.hpp"
+#include "geopm/SharedMemory.hpp"
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "geopm_micro_bench.hpp"
+
+using geopm::ApplicationRecordLog;
+using geopm::ApplicationSamplerImp;
+using geopm::ApplicationStatus;
+using geopm::SharedMemory;
+
+namespace
+{
+    struct sampler_state_s {
+        std::vector<std::unique_ptr<ApplicationRecordLog> > app_record_log;
+        std::unique_ptr<ApplicationSamplerImp> sampler;
+        geopm_time_s time;
+        uint64_t hash;
+    };
+
+    // One controller step with num_process application processes that
+    // each entered and exited a region since the last step
+    geopm::MicroBenchOp sampler_update(int num_process, int num_drain_thread)
+    {
+        auto state = std::make_shared<sampler_state_s>();
+        int num_cpu = geopm::platform_topo().num_domain(GEOPM_DOMAIN_CPU);
+        std::string shm_key = "/geopm_micro_bench_sampler_" + std::to_string(getpid());
+        std::shared_ptr<SharedMemory> status_shmem =
+            SharedMemory::make_unique_owner(shm_key + "_status", ApplicationStatus::buffer_size(num_cpu));
+        status_shmem->unlink();
+        std::map<int, ApplicationSamplerImp::m_process_s> process_map;
+        for (int process_idx = 0; process_idx < num_process; ++process_idx) {
+            std::shared_ptr<SharedMemory> shmem =
+                SharedMemory::make_unique_owner(shm_key + "_" + std::to_string(process_idx),
+                                                ApplicationRecordLog::buffer_size());
+            shmem->unlink();
+            state->app_record_log.push_back(ApplicationRecordLog::make_unique(shmem));
+            auto &process = process_map[process_idx];
+            process.record_log_shmem = shmem;
+            process.record_log = ApplicationRecordLog::make_unique(shmem);
+            process.records.reserve(ApplicationRecordLog::max_record());
+            process.short_regions.reserve(ApplicationRecordLog::max_region());
+        }
+        state->sampler = geopm::make_unique<ApplicationSamplerImp>(
+            ApplicationStatus::make_unique(num_cpu, status_shmem),
+            geopm::platform_topo(), process_map, false, "", std::vector<bool>{},
+            "", std::map<int, std::set<int> >{}, geopm::Scheduler::make_unique(),
+            num_drain_thread);
+        geopm_time(&state->time);
+        state->hash = 0x1000;
+        return [state]() {
+            for (auto &record_log : state->app_record_log) {
+                geopm_time_add(&state->time, 1e-6, &state->time);
+                record_log->enter(state->hash, state->time);
+                geopm_time_add(&state->time, 1e-6, &state->time);
+                record_log->exit(state->hash, state->time);
+            }
+            ++state->hash;
+            state->sampler->update(state->time);
+        };
+    }
+}
+
+GEOPM_MICRO_BENCH(ApplicationSampler, update_224_process_1_thread)
+{
+    return sampler_update(224, 1);
+}
+
+// The number of drain threads is chosen from the number of processes
+GEOPM_MICRO_BENCH(ApplicationSampler, update_224_process)
+{
+    return sampler_update(224, 0);
+}
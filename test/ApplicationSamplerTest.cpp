@@ -158,31 +158,141 @@ TEST_F(ApplicationSamplerTest, one_enter_exit_two_ranks)
 
     ASSERT_EQ(4U, result.size());
 
+    // Records from all processes are merged in time order
     EXPECT_EQ(10, result[0].time.t.tv_sec);
     EXPECT_EQ(0, result[0].time.t.tv_nsec);
     EXPECT_EQ(0, result[0].process);
     EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[0].event);
     EXPECT_EQ(region_hash, result[0].signal);
 
-    EXPECT_EQ(11, result[1].time.t.tv_sec);
-    EXPECT_EQ(0, result[1].time.t.tv_nsec);
-    EXPECT_EQ(0, result[1].process);
-    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[1].event);
+    EXPECT_EQ(10, result[1].time.t.tv_sec);
+    EXPECT_EQ(500000000, result[1].time.t.tv_nsec);
+    EXPECT_EQ(234, result[1].process);
+    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[1].event);
     EXPECT_EQ(region_hash, result[1].signal);
 
-    EXPECT_EQ(10, result[2].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[2].time.t.tv_nsec);
-    EXPECT_EQ(234, result[2].process);
-    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[2].event);
+    EXPECT_EQ(11, result[2].time.t.tv_sec);
+    EXPECT_EQ(0, result[2].time.t.tv_nsec);
+    EXPECT_EQ(0, result[2].process);
+    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[2].event);
     EXPECT_EQ(region_hash, result[2].signal);
 
     EXPECT_EQ(11, result[3].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[2].time.t.tv_nsec);
+    EXPECT_EQ(500000000, result[3].time.t.tv_nsec);
     EXPECT_EQ(234, result[3].process);
     EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[3].event);
     EXPECT_EQ(region_hash, result[3].signal);
 }
 
+TEST_F(ApplicationSamplerTest, parallel_drain)
+{
+    // Drain the two processes on separate threads
+    std::vector<bool> is_active {true, true, false, false};
+    EXPECT_CALL(*m_mock_topo, num_domain(GEOPM_DOMAIN_CPU))
+        .WillOnce(Return(m_num_cpu));
+    auto app_sampler = std::make_shared<ApplicationSamplerImp>(m_mock_status,
+                                                               *m_mock_topo,
+                                                               m_process_map,
+                                                               false,
+                                                               "",
+                                                               is_active,
+                                                               "profile_name",
+                                                               m_client_cpu_map,
+                                                               m_scheduler,
+                                                               2);
+    uint64_t region_hash = 0xabcdULL;
+    std::vector<record_s> message_buffer_0 {
+    //  time            process    event                      signal
+        {{{10, 0}},     0,         geopm::EVENT_REGION_ENTRY, region_hash},
+        {{{12, 0}},     0,         geopm::EVENT_SHORT_REGION, 0},
+        {{{12, 0}},     0,         geopm::EVENT_REGION_EXIT,  region_hash},
+    };
+    std::vector<record_s> message_buffer_1 {
+        {{{11, 0}},     234,       geopm::EVENT_SHORT_REGION, 0},
+        {{{12, 0}},     234,       geopm::EVENT_SHORT_REGION, 1},
+    };
+    std::vector<short_region_s> short_region_buffer_0 {
+        {0x1234ULL, 1, 1.0},
+    };
+    std::vector<short_region_s> short_region_buffer_1 {
+        {0x5678ULL, 2, 2.0},
+        {0x9abcULL, 3, 3.0},
+    };
+    EXPECT_CALL(*m_record_log_0, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(message_buffer_0),
+                        SetArgReferee<1>(short_region_buffer_0)));
+    EXPECT_CALL(*m_record_log_1, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(message_buffer_1),
+                        SetArgReferee<1>(short_region_buffer_1)));
+    EXPECT_CALL(*m_mock_status, update_cache());
+    EXPECT_CALL(*m_mock_status, get_hint(_))
+        .WillRepeatedly(Return(GEOPM_REGION_HINT_UNKNOWN));
+    app_sampler->update({{1, 0}});
+    std::vector<record_s> result = app_sampler->get_records();
+
+    // Time order, with equal times in process order
+    ASSERT_EQ(5U, result.size());
+    std::vector<int> expect_sec {10, 11, 12, 12, 12};
+    std::vector<int> expect_process {0, 234, 0, 0, 234};
+    std::vector<int> expect_event {geopm::EVENT_REGION_ENTRY,
+                                   geopm::EVENT_SHORT_REGION,
+                                   geopm::EVENT_SHORT_REGION,
+                                   geopm::EVENT_REGION_EXIT,
+                                   geopm::EVENT_SHORT_REGION};
+    std::vector<uint64_t> expect_signal {region_hash, 1, 0, region_hash, 2};
+    for (size_t idx = 0; idx < result.size(); ++idx) {
+        EXPECT_EQ(expect_sec[idx], result[idx].time.t.tv_sec);
+        EXPECT_EQ(expect_process[idx], result[idx].process);
+        EXPECT_EQ(expect_event[idx], result[idx].event);
+        EXPECT_EQ(expect_signal[idx], result[idx].signal);
+    }
+    EXPECT_EQ(0x1234ULL, app_sampler->get_short_region(0).hash);
+    EXPECT_EQ(0x5678ULL, app_sampler->get_short_region(1).hash);
+    EXPECT_EQ(0x9abcULL, app_sampler->get_short_region(2).hash);
+
+    // An error from the worker thread is reported to the caller
+    std::vector<record_s> message_buffer_bad {
+        {{{9, 0}},      234,       geopm::EVENT_SHORT_REGION, 0},
+    };
+    std::vector<record_s> empty_message_buffer;
+    std::vector<short_region_s> empty_short_region_buffer;
+    EXPECT_CALL(*m_record_log_0, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(empty_message_buffer),
+                        SetArgReferee<1>(empty_short_region_buffer)));
+    EXPECT_CALL(*m_record_log_1, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(message_buffer_bad),
+                        SetArgReferee<1>(short_region_buffer_0)));
+    GEOPM_EXPECT_THROW_MESSAGE(app_sampler->update({{2, 0}}),
+                               GEOPM_ERROR_INVALID,
+                               "Time value decreased");
+}
+
+TEST_F(ApplicationSamplerTest, client_cpu_set)
+{
+    EXPECT_EQ(std::set<int>({0}), m_app_sampler->client_cpu_set(0));
+    EXPECT_EQ(std::set<int>({1}), m_app_sampler->client_cpu_set(234));
+    EXPECT_EQ(std::set<int>(), m_app_sampler->client_cpu_set(5));
+}
+
+TEST_F(ApplicationSamplerTest, affinity_out_of_range)
+{
+    std::vector<record_s> message_buffer {
+    //  time            process    event                  signal
+        {{{10, 0}},     0,         geopm::EVENT_AFFINITY, (uint64_t)m_num_cpu},
+    };
+    std::vector<record_s> empty_message_buffer;
+    std::vector<short_region_s> empty_short_region_buffer;
+    EXPECT_CALL(*m_record_log_0, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(message_buffer),
+                        SetArgReferee<1>(empty_short_region_buffer)));
+    EXPECT_CALL(*m_record_log_1, dump(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(empty_message_buffer),
+                        SetArgReferee<1>(empty_short_region_buffer)));
+    // The out of range CPU is ignored with a warning
+    m_app_sampler->update({{1, 0}});
+    EXPECT_EQ(std::set<int>({0}), m_app_sampler->client_cpu_set(0));
+}
+
 TEST_F(ApplicationSamplerTest, with_epoch)
 {
     uint64_t region_hash_0 = 0xabcdULL;
@@ -225,77 +335,22 @@ TEST_F(ApplicationSamplerTest, with_epoch)
 
     ASSERT_EQ(12U, result.size());
 
-    EXPECT_EQ(10, result[0].time.t.tv_sec);
-    EXPECT_EQ(0, result[0].time.t.tv_nsec);
-    EXPECT_EQ(0, result[0].process);
-    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[0].event);
-    EXPECT_EQ(region_hash_0, result[0].signal);
-
-    EXPECT_EQ(11, result[1].time.t.tv_sec);
-    EXPECT_EQ(0, result[1].time.t.tv_nsec);
-    EXPECT_EQ(0, result[1].process);
-    EXPECT_EQ(geopm::EVENT_EPOCH_COUNT, result[1].event);
-    EXPECT_EQ(1U, result[1].signal);
-
-    EXPECT_EQ(12, result[2].time.t.tv_sec);
-    EXPECT_EQ(0, result[2].time.t.tv_nsec);
-    EXPECT_EQ(0, result[2].process);
-    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[2].event);
-    EXPECT_EQ(region_hash_0, result[2].signal);
-
-    EXPECT_EQ(13, result[3].time.t.tv_sec);
-    EXPECT_EQ(0, result[3].time.t.tv_nsec);
-    EXPECT_EQ(0, result[3].process);
-    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[3].event);
-    EXPECT_EQ(region_hash_1, result[3].signal);
-
-    EXPECT_EQ(14, result[4].time.t.tv_sec);
-    EXPECT_EQ(0, result[4].time.t.tv_nsec);
-    EXPECT_EQ(0, result[4].process);
-    EXPECT_EQ(geopm::EVENT_EPOCH_COUNT, result[4].event);
-    EXPECT_EQ(2U, result[4].signal);
-
-    EXPECT_EQ(15, result[5].time.t.tv_sec);
-    EXPECT_EQ(0, result[5].time.t.tv_nsec);
-    EXPECT_EQ(0, result[5].process);
-    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[5].event);
-    EXPECT_EQ(region_hash_1, result[5].signal);
-
-    EXPECT_EQ(10, result[6].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[6].time.t.tv_nsec);
-    EXPECT_EQ(234, result[6].process);
-    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[6].event);
-    EXPECT_EQ(region_hash_0, result[6].signal);
-
-    EXPECT_EQ(11, result[7].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[7].time.t.tv_nsec);
-    EXPECT_EQ(234, result[7].process);
-    EXPECT_EQ(geopm::EVENT_EPOCH_COUNT, result[7].event);
-    EXPECT_EQ(1U, result[7].signal);
-
-    EXPECT_EQ(12, result[8].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[8].time.t.tv_nsec);
-    EXPECT_EQ(234, result[8].process);
-    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[8].event);
-    EXPECT_EQ(region_hash_0, result[8].signal);
-
-    EXPECT_EQ(13, result[9].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[9].time.t.tv_nsec);
-    EXPECT_EQ(234, result[9].process);
-    EXPECT_EQ(geopm::EVENT_REGION_ENTRY, result[9].event);
-    EXPECT_EQ(region_hash_1, result[9].signal);
-
-    EXPECT_EQ(14, result[10].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[10].time.t.tv_nsec);
-    EXPECT_EQ(234, result[10].process);
-    EXPECT_EQ(geopm::EVENT_EPOCH_COUNT, result[10].event);
-    EXPECT_EQ(2U, result[10].signal);
-
-    EXPECT_EQ(15, result[11].time.t.tv_sec);
-    EXPECT_EQ(500000000, result[11].time.t.tv_nsec);
-    EXPECT_EQ(234, result[11].process);
-    EXPECT_EQ(geopm::EVENT_REGION_EXIT, result[11].event);
-    EXPECT_EQ(region_hash_1, result[11].signal);
+    // The records of the two processes alternate in time order
+    for (size_t idx = 0; idx < message_buffer_0.size(); ++idx) {
+        const record_s &result_0 = result[2 * idx];
+        const record_s &result_1 = result[2 * idx + 1];
+        EXPECT_EQ(10 + (int)idx, result_0.time.t.tv_sec);
+        EXPECT_EQ(0, result_0.time.t.tv_nsec);
+        EXPECT_EQ(0, result_0.process);
+        EXPECT_EQ(message_buffer_0[idx].event, result_0.event);
+        EXPECT_EQ(message_buffer_0[idx].signal, result_0.signal);
+
+        EXPECT_EQ(10 + (int)idx, result_1.time.t.tv_sec);
+        EXPECT_EQ(500000000, result_1.time.t.tv_nsec);
+        EXPECT_EQ(234, result_1.process);
+        EXPECT_EQ(message_buffer_1[idx].event, result_1.event);
+        EXPECT_EQ(message_buffer_1[idx].signal, result_1.signal);
+    }
 }
 
 TEST_F(ApplicationSamplerTest, string_conversion)
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ApplicationStatus.hpp"
+#include "geopm/SharedMemory.hpp"
+#include "geopm_hint.h"
+#include "geopm_micro_bench.hpp"
+
+using geopm::ApplicationStatus;
+using geopm::SharedMemory;
+
+namespace
+{
+    struct status_state_s {
+        std::shared_ptr<SharedMemory> shmem;
+        std::unique_ptr<ApplicationStatus> app_status;
+        std::unique_ptr<ApplicationStatus> ctl_status;
+        int num_cpu;
+        int num_update;
+        uint64_t hash;
+    };
+
+    // One controller step: the application marks num_update CPUs and
+    // the controller refreshes its cache
+    geopm::MicroBenchOp status_update_cache(int num_cpu, int num_update)
+    {
+        auto state = std::make_shared<status_state_s>();
+        std::string shm_key = "/geopm_micro_bench_status_" + std::to_string(getpid());
+        state->shmem = SharedMemory::make_unique_owner(shm_key, ApplicationStatus::buffer_size(num_cpu));
+        state->shmem->unlink();
+        state->app_status = ApplicationStatus::make_unique(num_cpu, state->shmem);
+        state->ctl_status = ApplicationStatus::make_unique(num_cpu, state->shmem);
+        state->num_cpu = num_cpu;
+        state->num_update = num_update;
+        state->hash = 0x1000;
+        return [state]() {
+            for (int update_idx = 0; update_idx < state->num_update; ++update_idx) {
+                int cpu_idx = (state->hash + update_idx) % state->num_cpu;
+                state->app_status->set_hash(cpu_idx, state->hash, GEOPM_REGION_HINT_COMPUTE);
+            }
+            ++state->hash;
+            state->ctl_status->update_cache();
+        };
+    }
+
+    struct writer_state_s {
+        std::shared_ptr<SharedMemory> shmem;
+        std::unique_ptr<ApplicationStatus> app_status;
+        std::unique_ptr<ApplicationStatus> ctl_status;
+        std::atomic<bool> is_done;
+        std::vector<std::thread> thread;
+        ~writer_state_s()
+        {
+            is_done = true;
+            for (auto &tt : thread) {
+                tt.join();
+            }
+        }
+    };
+
+    // One application thread completes a work unit on CPU 0 while
+    // num_thread - 1 other threads do the same on the next CPUs,
+    // which share a word of the dirty bitmap, and the controller
+    // refreshes its cache every 5 ms
+    geopm::MicroBenchOp status_increment_work_unit(int num_thread)
+    {
+        const int num_cpu = 256;
+        auto state = std::make_shared<writer_state_s>();
+        std::string shm_key = "/geopm_micro_bench_status_" + std::to_string(getpid());
+        state->shmem = SharedMemory::make_unique_owner(shm_key, ApplicationStatus::buffer_size(num_cpu));
+        state->shmem->unlink();
+        state->app_status = ApplicationStatus::make_unique(num_cpu, state->shmem);
+        state->ctl_status = ApplicationStatus::make_unique(num_cpu, state->shmem);
+        state->is_done = false;
+        for (int cpu_idx = 0; cpu_idx < num_thread; ++cpu_idx) {
+            state->app_status->set_total_work_units(cpu_idx, 1000000);
+        }
+        writer_state_s *state_ptr = state.get();
+        for (int cpu_idx = 1; cpu_idx < num_thread; ++cpu_idx) {
+            state->thread.emplace_back([state_ptr, cpu_idx]() {
+                while (!state_ptr->is_done) {
+                    state_ptr->app_status->increment_work_unit(cpu_idx);
+                }
+            });
+        }
+        state->thread.emplace_back([state_ptr]() {
+            while (!state_ptr->is_done) {
+                state_ptr->ctl_status->update_cache();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+        return [state]() {
+            state->app_status->increment_work_unit(0);
+        };
+    }
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, update_cache_256_cpu_4_changed)
+{
+    return status_update_cache(256, 4);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, update_cache_256_cpu_all_changed)
+{
+    return status_update_cache(256, 256);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, update_cache_1024_cpu_4_changed)
+{
+    return status_update_cache(1024, 4);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, update_cache_1024_cpu_none_changed)
+{
+    return status_update_cache(1024, 0);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, increment_work_unit_1_thread)
+{
+    return status_increment_work_unit(1);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, increment_work_unit_8_thread)
+{
+    return status_increment_work_unit(8);
+}
+
+GEOPM_MICRO_BENCH(ApplicationStatus, increment_work_unit_64_thread)
+{
+    return status_increment_work_unit(64);
+}
@@ -3,6 +3,13 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "geopm_test.hpp"
@@ -100,8 +107,12 @@ TEST_F(ApplicationStatusTest, hints)
                                GEOPM_ERROR_INVALID, "invalid CPU index");
     GEOPM_EXPECT_THROW_MESSAGE(m_status->get_hint(99),
                                GEOPM_ERROR_INVALID, "invalid CPU index");
+    // Corrupt the fields of CPU 0 after its sequence number and mark
+    // it as updated
     std::vector<uint64_t> bad_data(8, ~0ULL);
-    memcpy(m_mock_shared_memory->pointer(), bad_data.data(), 64);
+    m_status->set_hint(0, NETWORK);
+    memcpy((char *)m_mock_shared_memory->pointer() + sizeof(uint32_t),
+           bad_data.data(), 64 - sizeof(uint32_t));
     m_status->update_cache();
     GEOPM_EXPECT_THROW_MESSAGE(m_status->get_hint(0),
                                GEOPM_ERROR_INVALID, "hint out of range");
@@ -247,3 +258,137 @@ TEST_F(ApplicationStatusTest, update_cache)
     EXPECT_EQ(0.25, m_status->get_progress_cpu(0));
 
 }
+
+TEST_F(ApplicationStatusTest, stalled_writer)
+{
+    std::unique_ptr<ApplicationStatus> app_status =
+        ApplicationStatus::make_unique(M_NUM_CPU, m_mock_shared_memory);
+    app_status->set_hash(1, 0xABC, GEOPM_REGION_HINT_NETWORK);
+    app_status->set_hash(2, 0xDEF, GEOPM_REGION_HINT_COMPUTE);
+
+    // Simulate a writer that stopped part way through updating CPU 1
+    // by making its sequence number odd
+    uint32_t *seq = (uint32_t *)((char *)m_mock_shared_memory->pointer() +
+                                 geopm::hardware_destructive_interference_size);
+    ++(*seq);
+    m_status->update_cache();
+    EXPECT_EQ(GEOPM_REGION_HASH_INVALID, m_status->get_hash(1));
+    EXPECT_EQ(GEOPM_REGION_HINT_UNSET, m_status->get_hint(1));
+    EXPECT_EQ(0xDEFULL, m_status->get_hash(2));
+    EXPECT_EQ(GEOPM_REGION_HINT_COMPUTE, m_status->get_hint(2));
+
+    // The CPU is read on a later update once the write completes
+    ++(*seq);
+    m_status->update_cache();
+    EXPECT_EQ(0xABCULL, m_status->get_hash(1));
+    EXPECT_EQ(GEOPM_REGION_HINT_NETWORK, m_status->get_hint(1));
+}
+
+TEST_F(ApplicationStatusTest, dead_writer)
+{
+    // A writer that died part way through updating CPU 1 leaves its
+    // sequence number odd; the next writer takes over the entry after
+    // a timeout instead of waiting forever.  The writer PID follows
+    // the six 32-bit fields of the entry.
+    geopm::ApplicationStatusImp app_status(M_NUM_CPU, m_mock_shared_memory, 0.0);
+    char *entry = (char *)m_mock_shared_memory->pointer() +
+                  geopm::hardware_destructive_interference_size;
+    uint32_t *seq = (uint32_t *)entry;
+    int32_t *writer = (int32_t *)(entry + 6 * sizeof(uint32_t));
+
+    // The writer PID is unknown
+    ++(*seq);
+    app_status.set_hint(1, GEOPM_REGION_HINT_NETWORK);
+    EXPECT_EQ(0U, *seq % 2);
+    EXPECT_EQ(getpid(), *writer);
+    m_status->update_cache();
+    EXPECT_EQ(GEOPM_REGION_HINT_NETWORK, m_status->get_hint(1));
+
+    // The writer process has exited
+    pid_t child_pid = fork();
+    ASSERT_NE(-1, child_pid);
+    if (child_pid == 0) {
+        _exit(0);
+    }
+    ASSERT_EQ(child_pid, waitpid(child_pid, nullptr, 0));
+    ++(*seq);
+    *writer = child_pid;
+    app_status.set_hint(1, GEOPM_REGION_HINT_COMPUTE);
+    EXPECT_EQ(0U, *seq % 2);
+    m_status->update_cache();
+    EXPECT_EQ(GEOPM_REGION_HINT_COMPUTE, m_status->get_hint(1));
+
+    // A writer that is still running is not interrupted
+    ++(*seq);
+    *writer = getpid();
+    std::thread slow_writer([seq, writer]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        __atomic_store_n(writer, 0, __ATOMIC_RELAXED);
+        __atomic_add_fetch(seq, 1, __ATOMIC_RELEASE);
+    });
+    auto start = std::chrono::steady_clock::now();
+    app_status.set_hint(1, GEOPM_REGION_HINT_NETWORK);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    slow_writer.join();
+    EXPECT_LE(std::chrono::milliseconds(20), elapsed);
+    EXPECT_EQ(0U, *seq % 2);
+    m_status->update_cache();
+    EXPECT_EQ(GEOPM_REGION_HINT_NETWORK, m_status->get_hint(1));
+}
+
+TEST_F(ApplicationStatusTest, consistent_snapshot)
+{
+    GEOPM_TEST_EXTENDED("Requires multiple threads");
+    std::unique_ptr<ApplicationStatus> app_status =
+        ApplicationStatus::make_unique(M_NUM_CPU, m_mock_shared_memory);
+    std::atomic<bool> is_done(false);
+    // Each write pairs a hash with a hint derived from it
+    std::thread writer([&app_status, &is_done]() {
+        for (uint64_t hash = 1; !is_done; ++hash) {
+            uint64_t hint = (hash % 2) ? GEOPM_REGION_HINT_NETWORK : GEOPM_REGION_HINT_COMPUTE;
+            app_status->set_hash(0, hash & 0xFFFFFFFF, hint);
+        }
+    });
+    for (int iter = 0; iter < 100000; ++iter) {
+        m_status->update_cache();
+        uint64_t hash = m_status->get_hash(0);
+        if (hash != GEOPM_REGION_HASH_INVALID) {
+            uint64_t hint = (hash % 2) ? GEOPM_REGION_HINT_NETWORK : GEOPM_REGION_HINT_COMPUTE;
+            ASSERT_EQ(hint, m_status->get_hint(0));
+        }
+    }
+    is_done = true;
+    writer.join();
+}
+
+TEST_F(ApplicationStatusTest, event)
+{
+    // A second view of the same memory is used by the application
+    std::unique_ptr<ApplicationStatus> app_status =
+        ApplicationStatus::make_unique(M_NUM_CPU, m_mock_shared_memory);
+    geopm_time_s deadline;
+
+    // Events are ignored until the controller waits
+    app_status->post_event();
+    geopm_time_real(&deadline);
+    geopm_time_add(&deadline, 0.01, &deadline);
+    EXPECT_FALSE(m_status->wait_event(deadline));
+
+    app_status->post_event();
+    app_status->post_event();
+    geopm_time_real(&deadline);
+    geopm_time_add(&deadline, 1.0, &deadline);
+    geopm_time_s begin;
+    geopm_time(&begin);
+    EXPECT_TRUE(m_status->wait_event(deadline));
+    EXPECT_GT(0.5, geopm_time_since(&begin));
+
+    // Both events were consumed by the last wait
+    geopm_time_real(&deadline);
+    geopm_time_add(&deadline, 0.01, &deadline);
+    EXPECT_FALSE(m_status->wait_event(deadline));
+
+    // Events that arrive after the deadline are not reported
+    app_status->post_event();
+    EXPECT_FALSE(m_status->wait_event(deadline));
+}
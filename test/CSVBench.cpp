@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CSV.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::CSVImp;
+
+GEOPM_MICRO_BENCH(CSV, update)
+{
+    std::string path = "/tmp/geopm_micro_bench_csv_" + std::to_string(getpid());
+    // Trace files are written with a 1 MiB buffer
+    auto csv = std::shared_ptr<CSVImp>(new CSVImp(path, "bench-host", "Thu Jan 01 00:00:00 1970", 1024 * 1024),
+                                       [path](CSVImp *ptr) {
+                                           delete ptr;
+                                           unlink(path.c_str());
+                                       });
+    const int num_column = 32;
+    for (int column_idx = 0; column_idx < num_column; ++column_idx) {
+        if (column_idx % 4 == 0) {
+            csv->add_column("COLUMN_" + std::to_string(column_idx), "integer");
+        }
+        else {
+            csv->add_column("COLUMN_" + std::to_string(column_idx));
+        }
+    }
+    csv->activate();
+    auto row = std::make_shared<std::vector<double> >(num_column, 0.0);
+    return [csv, row]() {
+        for (auto &value : *row) {
+            value += 1.25;
+        }
+        csv->update(*row);
+    };
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geopm/Helper.hpp"
+#include "geopm_time.h"
+#include "ControllerReplay.hpp"
+#include "MockPlatformTopo.hpp"
+
+using geopm::ControllerReplay;
+
+class ControllerReplayTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void) override;
+        void TearDown(void) override;
+        std::unique_ptr<ControllerReplay> make_replay(bool is_real_time);
+        std::vector<double> trace_column(const std::string &column_name);
+        const std::string M_TRACE_PATH = "ControllerReplayTest.trace";
+        const std::string M_PROFILE_TRACE_PATH = "ControllerReplayTest.profile_trace";
+        const std::string M_TRACE_OUT_PATH = "ControllerReplayTest.trace_out";
+        std::string m_trace_out_path;
+        std::shared_ptr<MockPlatformTopo> m_topo;
+        std::vector<double> m_time;
+        std::vector<double> m_energy;
+        std::vector<double> m_power;
+};
+
+void ControllerReplayTest::SetUp(void)
+{
+    // 1 package, 2 cores, 4 CPUs
+    m_topo = make_topo(1, 2, 4);
+    m_time = {0.02, 0.04, 0.06, 0.08, 0.10};
+    m_energy = {100.0, 101.0, 103.0, 106.0, 110.0};
+    m_power = {50.0, 50.0, 100.0, 150.0, 200.0};
+    std::string trace =
+        "# geopm_version: 3.0.0\n"
+        "# profile_name: replay_test\n"
+        "TIME|CPU_ENERGY|DRAM_ENERGY|CPU_POWER|DRAM_POWER|CPU_FREQUENCY_STATUS|"
+        "CPU_CYCLES_THREAD|CPU_CYCLES_REFERENCE|CPU_CORE_TEMPERATURE\n";
+    for (size_t row = 0; row != m_time.size(); ++row) {
+        trace += std::to_string(m_time[row]) + "|" +
+                 std::to_string(m_energy[row]) + "|10.0|" +
+                 std::to_string(m_power[row]) + "|5.0|2e9|1e6|1e6|50\n";
+    }
+    geopm::write_file(M_TRACE_PATH, trace);
+    geopm::write_file(M_PROFILE_TRACE_PATH,
+        "TIME|PROCESS|EVENT|SIGNAL\n"
+        "0.03|1234|REGION_ENTRY|0x00000000725e8066\n"
+        "0.07|1234|REGION_EXIT|0x00000000725e8066\n");
+#ifdef GEOPM_ENABLE_MPI
+    m_trace_out_path = M_TRACE_OUT_PATH + "-" + geopm::hostname();
+#else
+    m_trace_out_path = M_TRACE_OUT_PATH;
+#endif
+}
+
+void ControllerReplayTest::TearDown(void)
+{
+    (void)unlink(M_TRACE_PATH.c_str());
+    (void)unlink(M_PROFILE_TRACE_PATH.c_str());
+    (void)unlink(m_trace_out_path.c_str());
+}
+
+std::unique_ptr<ControllerReplay> ControllerReplayTest::make_replay(bool is_real_time)
+{
+    std::map<std::string, double> constant_signal {{"CPUINFO::FREQ_STICKER", 2e9}};
+    std::map<std::string, double> control;
+    return geopm::make_unique<ControllerReplay>(
+        "monitor", M_TRACE_PATH, M_PROFILE_TRACE_PATH, "", constant_signal, control,
+        is_real_time, "", M_TRACE_OUT_PATH, "", *m_topo);
+}
+
+std::vector<double> ControllerReplayTest::trace_column(const std::string &column_name)
+{
+    std::vector<double> result;
+    std::ifstream trace(m_trace_out_path);
+    std::string line;
+    int col_idx = -1;
+    while (std::getline(trace, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::vector<std::string> fields = geopm::string_split(line, "|");
+        if (col_idx == -1) {
+            for (size_t idx = 0; idx != fields.size(); ++idx) {
+                if (fields[idx] == column_name) {
+                    col_idx = idx;
+                }
+            }
+            EXPECT_NE(-1, col_idx) << "Missing column " << column_name;
+            if (col_idx == -1) {
+                break;
+            }
+        }
+        else {
+            result.push_back(std::stod(fields.at(col_idx)));
+        }
+    }
+    return result;
+}
+
+TEST_F(ControllerReplayTest, replayed_values)
+{
+    auto replay = make_replay(false);
+    replay->run();
+    auto stage_stats = replay->stage_stats();
+    // The trace is flushed when the controller is destroyed
+    replay.reset();
+    // The controller samples each row and stops at the last row
+    // when the replayed application ends
+    EXPECT_EQ(std::vector<double>(m_energy.begin(), m_energy.end() - 1),
+              trace_column("CPU_ENERGY"));
+    EXPECT_EQ(std::vector<double>(m_power.begin(), m_power.end() - 1),
+              trace_column("CPU_POWER"));
+    // Each stage is timed once for every step between two rows
+    for (const auto &stats : stage_stats) {
+        EXPECT_EQ((int)m_time.size() - 2, stats.count) << stats.name;
+        EXPECT_LE(stats.min, stats.max) << stats.name;
+    }
+}
+
+TEST_F(ControllerReplayTest, real_time_pacing)
+{
+    geopm_time_s begin;
+    geopm_time_real(&begin);
+    auto replay = make_replay(true);
+    replay->run();
+    geopm_time_s end;
+    geopm_time_real(&end);
+    replay.reset();
+    // The replay waits for the recorded time of each row relative
+    // to the first row, up to the row where it stops
+    size_t last_row = m_time.size() - 2;
+    EXPECT_LE(m_time[last_row] - m_time[0], geopm_time_diff(&begin, &end));
+    EXPECT_EQ(std::vector<double>(m_power.begin(), m_power.end() - 1),
+              trace_column("CPU_POWER"));
+}
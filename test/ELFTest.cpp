@@ -6,10 +6,13 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <functional>
+#include <iostream>
 #include "gtest/gtest.h"
+#include "geopm_test.hpp"
 #include "ELF.hpp"
 #include "geopm/Helper.hpp"
 #include "geopm_hash.h"
+#include "geopm_time.h"
 
 class ELFTest: public :: testing :: Test
 {
@@ -76,3 +79,70 @@ TEST_F(ELFTest, symbol_lookup)
     symbol = geopm::symbol_lookup((void*)fn_off);
     EXPECT_EQ("geopm_crc32_str", symbol.second);
 }
+
+TEST_F(ELFTest, symbol_index)
+{
+    std::map<size_t, std::string> off_sym_map(geopm::elf_symbol_map(m_program_name));
+    ASSERT_LT(0ULL, off_sym_map.size());
+    std::unique_ptr<geopm::SymbolIndex> index = geopm::SymbolIndex::make_unique();
+    EXPECT_EQ(0, index->num_object());
+    for (const auto &off_sym : off_sym_map) {
+        std::pair<size_t, std::string> symbol = index->symbol(m_program_name, off_sym.first);
+        EXPECT_EQ(off_sym.first, symbol.first);
+        EXPECT_EQ(off_sym.second, symbol.second);
+        // Addresses between symbols resolve to the lower symbol
+        symbol = index->symbol(m_program_name, off_sym.first + 1);
+        auto expect_it = off_sym_map.upper_bound(off_sym.first + 1);
+        --expect_it;
+        EXPECT_EQ(expect_it->first, symbol.first);
+        EXPECT_EQ(expect_it->second, symbol.second);
+    }
+    // Each file is only read once
+    EXPECT_EQ(1, index->num_object());
+
+    // Files that cannot be parsed resolve to no symbol and are not
+    // read again
+    std::pair<size_t, std::string> empty(0, "");
+    EXPECT_EQ(empty, index->symbol("/proc/self/status", 0x1000));
+    EXPECT_EQ(empty, index->symbol("/proc/self/status", 0x2000));
+    EXPECT_EQ(2, index->num_object());
+
+    // Lookups by address agree with symbol_lookup()
+    EXPECT_EQ(geopm::symbol_lookup((void*)ELFTestFunction),
+              index->symbol((void*)ELFTestFunction));
+    EXPECT_EQ(geopm::symbol_lookup((void*)geopm_crc32_str),
+              index->symbol((void*)geopm_crc32_str));
+}
+
+TEST_F(ELFTest, symbol_index_performance)
+{
+    GEOPM_TEST_EXTENDED("Requires accurate timing");
+
+    std::map<size_t, std::string> off_sym_map(geopm::elf_symbol_map(m_program_name));
+    ASSERT_LT(0ULL, off_sym_map.size());
+    std::vector<size_t> offsets;
+    for (const auto &off_sym : off_sym_map) {
+        offsets.push_back(off_sym.first + 1);
+    }
+    // Reading the symbol table for each lookup is the behavior
+    // without an index, so only time a subset of the lookups.
+    size_t num_scan = std::min(offsets.size(), (size_t)100);
+    geopm_time_s time_0;
+    geopm_time(&time_0);
+    for (size_t idx = 0; idx < num_scan; ++idx) {
+        std::map<size_t, std::string> scan_map(geopm::elf_symbol_map(m_program_name));
+        EXPECT_NE(scan_map.end(), scan_map.upper_bound(offsets[idx]));
+    }
+    double scan_time = geopm_time_since(&time_0) / num_scan;
+
+    std::unique_ptr<geopm::SymbolIndex> index = geopm::SymbolIndex::make_unique();
+    geopm_time(&time_0);
+    for (auto offset : offsets) {
+        EXPECT_NE(0ULL, index->symbol(m_program_name, offset).second.size());
+    }
+    double index_time = geopm_time_since(&time_0) / offsets.size();
+    std::cout << "Symbols in " << m_program_name << ": " << off_sym_map.size() << "\n"
+              << "Table scan per lookup (ns): " << scan_time * 1e9 << "\n"
+              << "Index per lookup including index creation (ns): " << index_time * 1e9 << "\n";
+    EXPECT_LT(index_time, scan_time);
+}
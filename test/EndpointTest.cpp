@@ -10,9 +10,11 @@
 #include <sys/stat.h>
 #include <errno.h>
 
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <numeric>
 #include <vector>
 #include <future>
 #include <thread>
@@ -33,6 +35,7 @@
 
 using geopm::Endpoint;
 using geopm::EndpointImp;
+using geopm::EndpointOverflow;
 using geopm::EndpointUserImp;
 using geopm::SharedMemory;
 using geopm::geopm_endpoint_policy_shmem_s;
@@ -57,6 +60,7 @@ class EndpointTestIntegration : public ::testing::Test
 {
     protected:
         void TearDown();
+        bool is_shm(const std::string &key);
         const std::string m_shm_path = "/EndpointTestIntegration_data_" + std::to_string(geteuid());
 };
 
@@ -82,6 +86,16 @@ void EndpointTestIntegration::TearDown()
 {
     unlink(("/dev/shm/" + m_shm_path + "-policy").c_str());
     unlink(("/dev/shm/" + m_shm_path + "-sample").c_str());
+    for (const auto &postfix : {"-policy-", "-sample-"}) {
+        for (int generation = 1; generation <= 3; ++generation) {
+            unlink(("/dev/shm/" + m_shm_path + postfix + std::to_string(generation)).c_str());
+        }
+    }
+}
+
+bool EndpointTestIntegration::is_shm(const std::string &key)
+{
+    return access(("/dev/shm" + key).c_str(), F_OK) == 0;
 }
 
 TEST_F(EndpointTest, write_shm_policy)
@@ -161,7 +175,7 @@ TEST_F(EndpointTestIntegration, write_read_policy)
     std::shared_ptr<Endpoint> mio = std::make_shared<EndpointImp>(m_shm_path, nullptr, nullptr, values.size(), 0);
     mio->open();
     mio->write_policy(values);
-    EndpointUserImp mios(m_shm_path, nullptr, nullptr, "myagent", 0, "", "", {});
+    EndpointUserImp mios(m_shm_path, nullptr, nullptr, "myagent", values.size(), 0, "", "", {});
 
     std::vector<double> result(values.size());
     mios.read_policy(result);
@@ -184,7 +198,7 @@ TEST_F(EndpointTestIntegration, write_read_sample)
     std::string hostlist_path = "EndpointTestIntegration_hostlist";
     std::shared_ptr<Endpoint> mio = std::make_shared<EndpointImp>(m_shm_path, nullptr, nullptr, 0, values.size());
     mio->open();
-    EndpointUserImp mios(m_shm_path, nullptr, nullptr, "power_balancer",
+    EndpointUserImp mios(m_shm_path, nullptr, nullptr, "power_balancer", 0,
                            values.size(), "myprofile", hostlist_path, hosts);
     EXPECT_EQ("power_balancer", mio->get_agent());
     EXPECT_EQ("myprofile", mio->get_profile_name());
@@ -203,6 +217,132 @@ TEST_F(EndpointTestIntegration, write_read_sample)
     unlink(hostlist_path.c_str());
 }
 
+TEST_F(EndpointTestIntegration, policy_size_from_agent)
+{
+    std::string hostlist_path = "EndpointTestIntegration_hostlist";
+    EndpointImp endpoint(m_shm_path, nullptr, nullptr, 0, 0);
+    endpoint.open();
+    // The attached controller sets the size of the policy
+    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "frequency_map", 5, 0,
+                                  "myprofile", hostlist_path, {});
+    EXPECT_EQ("frequency_map", endpoint.get_agent());
+    GEOPM_EXPECT_THROW_MESSAGE(endpoint.write_policy(std::vector<double>(7, 1.0)),
+                               GEOPM_ERROR_INVALID, "policy has 7 values, the agent accepts at most 5");
+
+    // A shorter policy is padded with NAN
+    endpoint.write_policy({1.0, 2.0, 3.0});
+    std::vector<double> result(5);
+    endpoint_user.read_policy(result);
+    EXPECT_EQ(1.0, result[0]);
+    EXPECT_EQ(3.0, result[2]);
+    EXPECT_TRUE(std::isnan(result[3]));
+    EXPECT_TRUE(std::isnan(result[4]));
+    endpoint.close();
+    unlink(hostlist_path.c_str());
+}
+
+TEST_F(EndpointTestIntegration, policy_size_fixed)
+{
+    std::string hostlist_path = "EndpointTestIntegration_hostlist";
+    EndpointImp endpoint(m_shm_path, nullptr, nullptr, 0, 0);
+    endpoint.open();
+    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "power_governor", 1, 0,
+                                  "myprofile", hostlist_path, {});
+    EXPECT_EQ("power_governor", endpoint.get_agent());
+    // An agent without a variable size policy needs every value
+    GEOPM_EXPECT_THROW_MESSAGE(endpoint.write_policy(std::vector<double>{}),
+                               GEOPM_ERROR_INVALID, "policy has 0 values, the agent requires 1");
+    GEOPM_EXPECT_THROW_MESSAGE(endpoint.write_policy({100.0, 200.0}),
+                               GEOPM_ERROR_INVALID, "policy has 2 values, the agent requires 1");
+    endpoint.write_policy({100.0});
+    std::vector<double> result(1);
+    endpoint_user.read_policy(result);
+    EXPECT_EQ(100.0, result[0]);
+    endpoint.close();
+    unlink(hostlist_path.c_str());
+}
+
+TEST_F(EndpointTestIntegration, write_read_policy_overflow)
+{
+    // More values than fit in the fixed size region
+    std::vector<double> values(4000);
+    std::iota(values.begin(), values.end(), 0.0);
+    EndpointImp endpoint(m_shm_path, nullptr, nullptr, values.size(), 0);
+    endpoint.open();
+    endpoint.write_policy(values);
+    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "myagent", values.size(), 0, "", "", {});
+
+    std::vector<double> result(values.size());
+    endpoint_user.read_policy(result);
+    EXPECT_EQ(values, result);
+    EXPECT_TRUE(is_shm(m_shm_path + "-policy-1"));
+
+    values[0] = 888;
+    endpoint.write_policy(values);
+    endpoint_user.read_policy(result);
+    EXPECT_EQ(values, result);
+    endpoint.close();
+    EXPECT_FALSE(is_shm(m_shm_path + "-policy-1"));
+}
+
+TEST_F(EndpointTestIntegration, write_read_sample_overflow)
+{
+    std::vector<double> values(1000);
+    std::iota(values.begin(), values.end(), 0.0);
+    std::string hostlist_path = "EndpointTestIntegration_hostlist";
+    EndpointImp endpoint(m_shm_path, nullptr, nullptr, 0, values.size());
+    endpoint.open();
+    {
+        EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "myagent", 0,
+                                      values.size(), "", hostlist_path, {});
+        std::vector<double> result(values.size());
+        endpoint.read_sample(result);
+        EXPECT_THAT(result, testing::Each(IsNan()));
+
+        endpoint_user.write_sample(values);
+        endpoint.read_sample(result);
+        EXPECT_EQ(values, result);
+        EXPECT_TRUE(is_shm(m_shm_path + "-sample-1"));
+    }
+    // Controller removes the region when it detaches
+    EXPECT_FALSE(is_shm(m_shm_path + "-sample-1"));
+    endpoint.close();
+}
+
+TEST_F(EndpointTestIntegration, overflow_generation)
+{
+    std::string key = m_shm_path + "-policy";
+    // Region left behind by a previous writer is skipped
+    auto stale = SharedMemory::make_unique_owner(key + "-1", 4096);
+    EndpointOverflow writer(key);
+    EndpointOverflow reader(key);
+    size_t generation = 0;
+    double *values = writer.values_write(1000, generation);
+    EXPECT_EQ(2u, generation);
+    std::fill(values, values + 1000, 1.0);
+    EXPECT_EQ(1.0, reader.values_read(1000, generation)[999]);
+
+    // Fewer values reuse the region
+    writer.values_write(500, generation);
+    EXPECT_EQ(2u, generation);
+
+    // More values create the next generation and remove the last
+    values = writer.values_write(5000, generation);
+    EXPECT_EQ(3u, generation);
+    values[4999] = 2.0;
+    EXPECT_EQ(2.0, reader.values_read(5000, generation)[4999]);
+    EXPECT_FALSE(is_shm(key + "-2"));
+    GEOPM_EXPECT_THROW_MESSAGE(reader.values_read(100000, generation),
+                               GEOPM_ERROR_INVALID, "too small");
+
+    // Only the writer removes the region
+    reader.unlink();
+    EXPECT_TRUE(is_shm(key + "-3"));
+    writer.unlink();
+    EXPECT_FALSE(is_shm(key + "-3"));
+    stale->unlink();
+}
+
 TEST_F(EndpointTestIntegration, read_sample_before_data_exists)
 {
     std::vector<double> sample_values = {1, 2};
@@ -210,7 +350,7 @@ TEST_F(EndpointTestIntegration, read_sample_before_data_exists)
     std::string hostlist_path = "EndpointTestIntegration_hostlist";
     std::shared_ptr<Endpoint> endpoint = std::make_shared<EndpointImp>(m_shm_path, nullptr, nullptr, 0, sample_values.size());
     endpoint->open();
-    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "power_balancer",
+    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "power_balancer", 0,
                                   sample_values.size(), "myprofile", hostlist_path, hosts);
 
     endpoint->read_sample(sample_values);
@@ -220,6 +360,106 @@ TEST_F(EndpointTestIntegration, read_sample_before_data_exists)
     unlink(hostlist_path.c_str());
 }
 
+TEST_F(EndpointTestIntegration, wait)
+{
+    std::vector<double> sample = {1.0, 2.0};
+    std::string hostlist_path = "EndpointTestIntegration_hostlist";
+    EndpointImp endpoint_a(m_shm_path + "_a", nullptr, nullptr, 0, 0);
+    EndpointImp endpoint_b(m_shm_path + "_b", nullptr, nullptr, 0, sample.size());
+    endpoint_a.open();
+    endpoint_b.open();
+    std::vector<EndpointImp *> endpoint = {&endpoint_a, &endpoint_b};
+
+    geopm_time_s begin;
+    geopm_time(&begin);
+    EXPECT_TRUE(EndpointImp::wait(endpoint, 0.05).empty());
+    EXPECT_LE(0.05, geopm_time_since(&begin));
+
+    // Controller attach is reported once
+    auto endpoint_user = geopm::make_unique<EndpointUserImp>(
+        m_shm_path + "_b", nullptr, nullptr, "myagent", 0, sample.size(),
+        "", hostlist_path, std::set<std::string>{});
+    EXPECT_THAT(EndpointImp::wait(endpoint, 1.0), ElementsAre(1));
+    EXPECT_TRUE(EndpointImp::wait(endpoint, 0.0).empty());
+
+    // Sample update is reported through the C interface
+    endpoint_user->write_sample(sample);
+    std::vector<geopm_endpoint_c *> endpoint_c = {
+        reinterpret_cast<geopm_endpoint_c *>(&endpoint_a),
+        reinterpret_cast<geopm_endpoint_c *>(&endpoint_b)};
+    std::vector<int> is_updated(endpoint_c.size(), -1);
+    EXPECT_EQ(0, geopm_endpoint_wait(endpoint_c.size(), endpoint_c.data(),
+                                     1.0, is_updated.data()));
+    EXPECT_THAT(is_updated, ElementsAre(0, 1));
+
+    // Stopping a wait loop wakes waiters
+    endpoint_a.stop_wait_loop();
+    EXPECT_THAT(EndpointImp::wait(endpoint, 1.0), ElementsAre(0));
+
+    // Controller detach
+    endpoint_user.reset();
+    EXPECT_THAT(EndpointImp::wait(endpoint, 1.0), ElementsAre(1));
+    EXPECT_EQ("", endpoint_b.get_agent());
+
+    endpoint_a.close();
+    endpoint_b.close();
+    for (const auto &postfix : {"_a-policy", "_a-sample", "_b-policy", "_b-sample"}) {
+        unlink(("/dev/shm" + m_shm_path + postfix).c_str());
+    }
+}
+
+TEST_F(EndpointTestIntegration, wait_blocked)
+{
+    GEOPM_TEST_EXTENDED("Requires multiple threads");
+    std::vector<double> sample = {1.0};
+    std::string hostlist_path = "EndpointTestIntegration_hostlist";
+    EndpointImp endpoint(m_shm_path, nullptr, nullptr, 0, sample.size());
+    endpoint.open();
+    EndpointUserImp endpoint_user(m_shm_path, nullptr, nullptr, "myagent", 0,
+                                  sample.size(), "", hostlist_path, {});
+    EXPECT_THAT(EndpointImp::wait({&endpoint}, 1.0), ElementsAre(0));
+
+    // Waiter blocks without a timeout until the sample is written
+    auto run_thread = std::async(std::launch::async, EndpointImp::wait,
+                                 std::vector<EndpointImp *>{&endpoint}, -1.0);
+    EXPECT_EQ(std::future_status::timeout,
+              run_thread.wait_for(std::chrono::milliseconds(100)));
+    endpoint_user.write_sample(sample);
+    ASSERT_EQ(std::future_status::ready,
+              run_thread.wait_for(std::chrono::seconds(1)));
+    EXPECT_THAT(run_thread.get(), ElementsAre(0));
+    endpoint.close();
+}
+
+TEST_F(EndpointTest, seqlock)
+{
+    geopm::geopm_endpoint_sync_s sync = {};
+    uint32_t seq = geopm::endpoint_read_begin(sync);
+    EXPECT_FALSE(geopm::endpoint_read_retry(sync, seq));
+    uint32_t notify = geopm::endpoint_wait_begin(sync);
+    EXPECT_EQ(1u, sync.is_waiting);
+
+    // Reader retries if a write started after it began
+    geopm::endpoint_write_begin(sync);
+    EXPECT_TRUE(geopm::endpoint_read_retry(sync, seq));
+    geopm::endpoint_write_end(sync);
+    EXPECT_TRUE(geopm::endpoint_read_retry(sync, seq));
+    EXPECT_NE(notify, sync.notify);
+    EXPECT_EQ(0u, sync.is_waiting);
+    seq = geopm::endpoint_read_begin(sync);
+    EXPECT_EQ(0u, seq % 2);
+    EXPECT_FALSE(geopm::endpoint_read_retry(sync, seq));
+
+    // Readers do not wait forever on an incomplete write
+    geopm::endpoint_write_begin(sync);
+    GEOPM_EXPECT_THROW_MESSAGE(geopm::endpoint_read_begin(sync),
+                               GEOPM_ERROR_RUNTIME, "timed out");
+    // The next writer completes the update
+    geopm::endpoint_write_begin(sync);
+    geopm::endpoint_write_end(sync);
+    EXPECT_EQ(0u, geopm::endpoint_read_begin(sync) % 2);
+}
+
 TEST_F(EndpointTest, get_agent)
 {
     set_up_expectations();
@@ -355,7 +595,9 @@ TEST_F(EndpointTest, wait_stops_when_agent_attaches)
                                  m_timeout);
     ASSERT_TRUE(run_thread.valid());
     // simulate agent attach
+    geopm::endpoint_write_begin(data->sync);
     strncpy(data->agent, "monitor", GEOPM_ENDPOINT_AGENT_NAME_MAX);
+    geopm::endpoint_write_end(data->sync);
     // wait for less than timeout; should exit before time limit without throwing
     auto result = run_thread.wait_for(std::chrono::seconds(m_timeout - 1));
     EXPECT_NE(result, std::future_status::timeout);
@@ -402,7 +644,9 @@ TEST_F(EndpointTest, wait_stops_when_agent_detaches)
 
     ASSERT_TRUE(run_thread.valid());
     // simulate agent detach
+    geopm::endpoint_write_begin(data->sync);
     strncpy(data->agent, "", GEOPM_ENDPOINT_AGENT_NAME_MAX);
+    geopm::endpoint_write_end(data->sync);
 
     // wait for less than timeout; should exit before time limit without throwing
     auto result = run_thread.wait_for(std::chrono::seconds(m_timeout - 1));
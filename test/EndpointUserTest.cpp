@@ -3,7 +3,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <chrono>
 #include <fstream>
+#include <future>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -46,6 +49,11 @@ void EndpointUserTest::SetUp()
     m_policy_shmem_user = geopm::make_unique<MockSharedMemory>(policy_shmem_size);
     size_t sample_shmem_size = sizeof(struct geopm_endpoint_sample_shmem_s);
     m_sample_shmem_user = geopm::make_unique<MockSharedMemory>(sample_shmem_size);
+    // Regions created by the resource manager record their layout
+    geopm::endpoint_layout_init(((struct geopm_endpoint_policy_shmem_s *)m_policy_shmem_user->pointer())->layout,
+                                policy_shmem_size);
+    geopm::endpoint_layout_init(((struct geopm_endpoint_sample_shmem_s *)m_sample_shmem_user->pointer())->layout,
+                                sample_shmem_size);
 
     EXPECT_CALL(*m_policy_shmem_user, get_scoped_lock()).Times(AtLeast(0));
     EXPECT_CALL(*m_sample_shmem_user, get_scoped_lock()).Times(AtLeast(0));
@@ -79,7 +87,7 @@ TEST_F(EndpointUserTest, attach)
     struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem_user->pointer();
     std::set<std::string> hosts {"node1", "node2", "node4"};
     EndpointUserImp gp("/FAKE_PATH", std::move(m_policy_shmem_user),
-                         std::move(m_sample_shmem_user), "myagent", 0,
+                         std::move(m_sample_shmem_user), "myagent", 0, 0,
                          "myprofile", m_hostlist_file, hosts);
     EXPECT_STREQ("myagent", data->agent);
     EXPECT_STREQ("myprofile", data->profile_name);
@@ -103,7 +111,7 @@ TEST_F(EndpointUserTest, parse_shm_policy)
     memcpy(data->values, tmp, sizeof(tmp));
 
     EndpointUserImp gp("/FAKE_PATH", std::move(m_policy_shmem_user),
-                         std::move(m_sample_shmem_user), "myagent", 0,
+                         std::move(m_sample_shmem_user), "myagent", num_policy, 0,
                          "myprofile", m_hostlist_file, {});
 
     std::vector<double> result(num_policy);
@@ -117,7 +125,7 @@ TEST_F(EndpointUserTest, write_shm_sample)
     struct geopm_endpoint_sample_shmem_s *data = (struct geopm_endpoint_sample_shmem_s *) m_sample_shmem_user->pointer();
     std::vector<double> values = {777, 12.3456, 2.3e9};
     EndpointUserImp jio("/FAKE_PATH", std::move(m_policy_shmem_user), std::move(m_sample_shmem_user),
-                          "myagent", values.size(), "myprofile", m_hostlist_file, {});
+                          "myagent", 0, values.size(), "myprofile", m_hostlist_file, {});
     jio.write_sample(values);
 
     std::vector<double> test = std::vector<double>(data->values, data->values + data->count);
@@ -135,6 +143,7 @@ TEST_F(EndpointUserTest, agent_name_too_long)
                                             std::move(m_sample_shmem_user),
                                             too_long,
                                             0,
+                                            0,
                                             "myprofile",
                                             m_hostlist_file,
                                             hosts),
@@ -151,12 +160,56 @@ TEST_F(EndpointUserTest, profile_name_too_long)
                                             std::move(m_sample_shmem_user),
                                             "myagent",
                                             0,
+                                            0,
                                             too_long,
                                             m_hostlist_file,
                                             hosts),
         GEOPM_ERROR_INVALID, "Profile name is too long");
 }
 
+TEST_F(EndpointUserTest, layout_mismatch)
+{
+    auto data = (struct geopm_endpoint_policy_shmem_s *)m_policy_shmem_user->pointer();
+    data->layout.version += 1;
+    GEOPM_EXPECT_THROW_MESSAGE(
+        geopm::make_unique<EndpointUserImp>("/FAKE_PATH",
+                                            std::move(m_policy_shmem_user),
+                                            std::move(m_sample_shmem_user),
+                                            "myagent", 0, 0, "myprofile",
+                                            m_hostlist_file, std::set<std::string>{}),
+        GEOPM_ERROR_INVALID, "/FAKE_PATH-policy has layout version");
+}
+
+TEST_F(EndpointUserTest, layout_published_late)
+{
+    // The controller may attach after the resource manager creates
+    // the regions but before it records their layout
+    auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem_user->pointer();
+    data->layout = {};
+    auto publish = std::async(std::launch::async, [data]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        geopm::endpoint_layout_init(data->layout, sizeof(*data));
+    });
+    EndpointUserImp gp("/FAKE_PATH", std::move(m_policy_shmem_user),
+                       std::move(m_sample_shmem_user), "myagent", 0, 0,
+                       "myprofile", m_hostlist_file, {});
+    publish.get();
+    EXPECT_STREQ("myagent", data->agent);
+}
+
+TEST_F(EndpointUserTest, layout_size_mismatch)
+{
+    auto data = (struct geopm_endpoint_sample_shmem_s *)m_sample_shmem_user->pointer();
+    data->layout.size = 2 * sizeof(struct geopm_endpoint_sample_shmem_s);
+    GEOPM_EXPECT_THROW_MESSAGE(
+        geopm::make_unique<EndpointUserImp>("/FAKE_PATH",
+                                            std::move(m_policy_shmem_user),
+                                            std::move(m_sample_shmem_user),
+                                            "myagent", 0, 0, "myprofile",
+                                            m_hostlist_file, std::set<std::string>{}),
+        GEOPM_ERROR_INVALID, "/FAKE_PATH-sample has layout version 2 and size 8192");
+}
+
 TEST_F(EndpointUserTestIntegration, parse_shm)
 {
     std::string full_path("/dev/shm" + m_shm_path);
@@ -165,6 +218,9 @@ TEST_F(EndpointUserTestIntegration, parse_shm)
     auto smp = SharedMemory::make_unique_owner(m_shm_path + "-policy", shmem_size);
     struct geopm_endpoint_policy_shmem_s *data = (struct geopm_endpoint_policy_shmem_s *) smp->pointer();
     auto sms = SharedMemory::make_unique_owner(m_shm_path + "-sample", sizeof(struct geopm_endpoint_sample_shmem_s));
+    geopm::endpoint_layout_init(data->layout, shmem_size);
+    geopm::endpoint_layout_init(((struct geopm_endpoint_sample_shmem_s *)sms->pointer())->layout,
+                                sizeof(struct geopm_endpoint_sample_shmem_s));
 
     double tmp[] = { 1.1, 2.2, 3.3 };
     int num_policy = sizeof(tmp) / sizeof(tmp[0]);
@@ -175,7 +231,7 @@ TEST_F(EndpointUserTestIntegration, parse_shm)
     memcpy(data->values, tmp, sizeof(tmp));
     geopm_time(&data->timestamp);
 
-    EndpointUserImp gp(m_shm_path, nullptr, nullptr, "myagent", 0, "myprofile", "", {});
+    EndpointUserImp gp(m_shm_path, nullptr, nullptr, "myagent", num_policy, 0, "myprofile", "", {});
 
     std::vector<double> result(num_policy);
     double age = gp.read_policy(result);
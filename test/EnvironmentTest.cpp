@@ -490,6 +490,36 @@ TEST_F(EnvironmentTest, user_default_and_override)
     check_trace_report_signals(m_trace_signals, m_report_signals);
 }
 
+TEST_F(EnvironmentTest, frequency_map_num_region)
+{
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    EXPECT_EQ(31, m_env->frequency_map_num_region());
+
+    setenv("GEOPM_FREQUENCY_MAP_NUM_REGION", "1024", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    EXPECT_EQ(1024, m_env->frequency_map_num_region());
+
+    setenv("GEOPM_FREQUENCY_MAP_NUM_REGION", "-1", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    GEOPM_EXPECT_THROW_MESSAGE(m_env->frequency_map_num_region(),
+                               GEOPM_ERROR_INVALID, "must be a non-negative integer");
+}
+
+TEST_F(EnvironmentTest, num_drain_thread)
+{
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    EXPECT_EQ(1, m_env->num_drain_thread());
+
+    setenv("GEOPM_NUM_DRAIN_THREAD", "0", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    EXPECT_EQ(0, m_env->num_drain_thread());
+
+    setenv("GEOPM_NUM_DRAIN_THREAD", "two", 1);
+    m_env = geopm::make_unique<EnvironmentImp>("", "", &m_platform_io);
+    GEOPM_EXPECT_THROW_MESSAGE(m_env->num_drain_thread(),
+                               GEOPM_ERROR_INVALID, "must be a non-negative integer");
+}
+
 TEST_F(EnvironmentTest, invalid_ctl)
 {
     setenv("GEOPM_CTL", "program", 1);
@@ -621,6 +651,29 @@ TEST_F(EnvironmentTest, init_control_unset)
     EXPECT_EQ("", m_env->init_control());
 }
 
+TEST_F(EnvironmentTest, event_period)
+{
+    std::map<std::string, std::string> default_vars;
+    std::map<std::string, std::string> override_vars;
+
+    vars_to_json(default_vars, M_DEFAULT_PATH);
+    vars_to_json(override_vars, M_OVERRIDE_PATH);
+
+    m_env = geopm::make_unique<EnvironmentImp>(M_DEFAULT_PATH, M_OVERRIDE_PATH, &m_platform_io);
+    EXPECT_FALSE(m_env->do_event_period());
+    EXPECT_EQ(0.0, m_env->event_period());
+
+    setenv("GEOPM_EVENT_PERIOD", "0.0001", 1);
+    m_env = geopm::make_unique<EnvironmentImp>(M_DEFAULT_PATH, M_OVERRIDE_PATH, &m_platform_io);
+    EXPECT_TRUE(m_env->do_event_period());
+    EXPECT_EQ(0.0001, m_env->event_period());
+
+    setenv("GEOPM_EVENT_PERIOD", "-1", 1);
+    m_env = geopm::make_unique<EnvironmentImp>(M_DEFAULT_PATH, M_OVERRIDE_PATH, &m_platform_io);
+    GEOPM_EXPECT_THROW_MESSAGE(m_env->event_period(),
+                               GEOPM_ERROR_INVALID, "must not be negative");
+}
+
 TEST_F(EnvironmentTest, signal_parser)
 {
     std::vector<std::pair<std::string, int> >& expected_signals = m_trace_signals;
@@ -529,9 +529,33 @@ TEST_F(FrequencyMapAgentTest, enforce_policy_allnan_invalid)
 
 TEST_F(FrequencyMapAgentTest, enforce_policy_bad_size)
 {
-    const std::vector<double> bad_policy(123, 100);
     setup_gpu(m_do_gpu);
-    EXPECT_THROW(m_agent->enforce_policy(bad_policy), geopm::Exception);
+    // Too short for the default frequencies
+    EXPECT_THROW(m_agent->enforce_policy(std::vector<double>(2, 100)), geopm::Exception);
+    // Hash without a frequency
+    EXPECT_THROW(m_agent->enforce_policy(std::vector<double>(124, 100)), geopm::Exception);
+}
+
+TEST_F(FrequencyMapAgentTest, validate_policy_long)
+{
+    // A policy may hold more regions than fit in the fixed size
+    // endpoint shared memory region
+    setup_gpu(m_do_gpu);
+    const size_t num_region = 300;
+    std::vector<double> policy(HASH_0 + 2 * num_region, NAN);
+    policy[CPU_DEFAULT] = m_freq_max;
+    policy[HASH_0] = 123;
+    policy[FREQ_0] = m_freq_min;
+    policy[HASH_0 + 2 * (num_region - 1)] = 456;
+    policy[FREQ_0 + 2 * (num_region - 1)] = m_freq_min;
+    m_agent->validate_policy(policy);
+    EXPECT_EQ(456, policy[HASH_0 + 2 * (num_region - 1)]);
+
+    // The last region is checked like the first
+    policy[HASH_0 + 2 * (num_region - 1)] = 123;
+    GEOPM_EXPECT_THROW_MESSAGE(m_agent->validate_policy(policy),
+                               GEOPM_ERROR_INVALID,
+                               "policy has multiple entries for region: 123");
 }
 
 static Json get_freq_map_json_from_policy(const std::vector<double> &policy)
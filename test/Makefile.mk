@@ -2,7 +2,9 @@
 #  SPDX-License-Identifier: BSD-3-Clause
 #
 
-check_PROGRAMS += test/geopm_test
+check_PROGRAMS += test/geopm_test \
+                  test/geopm_micro_bench \
+                  # end
 
 if ENABLE_MPI
     check_PROGRAMS += test/geopm_mpi_test_api
@@ -53,8 +55,12 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/ApplicationSamplerTest.cpu_progress \
               test/gtest_links/ApplicationSamplerTest.sampler_cpu \
               test/gtest_links/ApplicationStatusTest.bad_shmem \
+              test/gtest_links/ApplicationStatusTest.consistent_snapshot \
+              test/gtest_links/ApplicationStatusTest.event \
               test/gtest_links/ApplicationStatusTest.hash \
               test/gtest_links/ApplicationStatusTest.hints \
+              test/gtest_links/ApplicationStatusTest.stalled_writer \
+              test/gtest_links/ApplicationStatusTest.dead_writer \
               test/gtest_links/ApplicationStatusTest.update_cache \
               test/gtest_links/ApplicationStatusTest.work_progress \
               test/gtest_links/ApplicationStatusTest.wrong_buffer_size \
@@ -69,6 +75,8 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/CommMPIImpTest.mpi_mem_ops \
               test/gtest_links/CommMPIImpTest.mpi_reduce \
               test/gtest_links/CommMPIImpTest.mpi_win_ops \
+              test/gtest_links/ControllerReplayTest.real_time_pacing \
+              test/gtest_links/ControllerReplayTest.replayed_values \
               test/gtest_links/ControllerTest.construct_with_file_policy_and_init_control \
               test/gtest_links/CommNullImpTest.split \
               test/gtest_links/CommNullImpTest.comm_supported \
@@ -135,6 +143,7 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/EndpointTest.get_profile_name \
               test/gtest_links/EndpointTest.write_shm_policy \
               test/gtest_links/EndpointTest.parse_shm_sample \
+              test/gtest_links/EndpointTest.seqlock \
               test/gtest_links/EndpointTest.get_agent \
               test/gtest_links/EndpointTest.stop_wait_loop \
               test/gtest_links/EndpointTest.wait_attach_timeout_0 \
@@ -145,10 +154,20 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/EndpointTestIntegration.write_shm \
               test/gtest_links/EndpointTestIntegration.write_read_policy \
               test/gtest_links/EndpointTestIntegration.write_read_sample \
+              test/gtest_links/EndpointTestIntegration.write_read_policy_overflow \
+              test/gtest_links/EndpointTestIntegration.policy_size_from_agent \
+              test/gtest_links/EndpointTestIntegration.policy_size_fixed \
+              test/gtest_links/EndpointTestIntegration.write_read_sample_overflow \
+              test/gtest_links/EndpointTestIntegration.overflow_generation \
+              test/gtest_links/EndpointTestIntegration.wait \
+              test/gtest_links/EndpointTestIntegration.wait_blocked \
               test/gtest_links/EndpointPolicyTracerTest.construct_update_destruct \
               test/gtest_links/EndpointPolicyTracerTest.format \
               test/gtest_links/EndpointUserTest.agent_name_too_long \
               test/gtest_links/EndpointUserTest.attach \
+              test/gtest_links/EndpointUserTest.layout_mismatch \
+              test/gtest_links/EndpointUserTest.layout_published_late \
+              test/gtest_links/EndpointUserTest.layout_size_mismatch \
               test/gtest_links/EndpointUserTest.parse_shm_policy \
               test/gtest_links/EndpointUserTest.profile_name_too_long \
               test/gtest_links/EndpointUserTest.write_shm_sample \
@@ -162,6 +181,8 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/EnvironmentTest.override_only \
               test/gtest_links/EnvironmentTest.default_and_override \
               test/gtest_links/EnvironmentTest.user_default_and_override \
+              test/gtest_links/EnvironmentTest.frequency_map_num_region \
+              test/gtest_links/EnvironmentTest.num_drain_thread \
               test/gtest_links/EnvironmentTest.invalid_ctl \
               test/gtest_links/EnvironmentTest.default_endpoint_user_policy \
               test/gtest_links/EnvironmentTest.default_endpoint_user_policy_override_endpoint \
@@ -171,6 +192,7 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/EnvironmentTest.record_filter_off \
               test/gtest_links/EnvironmentTest.init_control_set \
               test/gtest_links/EnvironmentTest.init_control_unset \
+              test/gtest_links/EnvironmentTest.event_period \
               test/gtest_links/EnvironmentTest.signal_parser \
               test/gtest_links/EpochIOGroupIntegrationTest.read_batch_count \
               test/gtest_links/EpochIOGroupTest.no_controls \
@@ -203,6 +225,7 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/FrequencyMapAgentTest.report_neither_map_nor_set \
               test/gtest_links/FrequencyMapAgentTest.split_policy \
               test/gtest_links/FrequencyMapAgentTest.validate_policy \
+              test/gtest_links/FrequencyMapAgentTest.validate_policy_long \
               test/gtest_links/FrequencyMapAgentTest.validate_policy_nogpu \
               test/gtest_links/FrequencyTimeBalancerTest.balance_when_current_frequencies_are_all_unlimited \
               test/gtest_links/FrequencyTimeBalancerTest.balance_when_all_frequencies_should_go_unlimited \
@@ -297,8 +320,13 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/RecordFilterTest.make_edit_distance \
               test/gtest_links/RegionHintRecommenderTest.test_json_parsing \
               test/gtest_links/RegionHintRecommenderTest.test_plumbing \
+              test/gtest_links/ReplayIOGroupTest.constant_and_control \
+              test/gtest_links/ReplayIOGroupTest.parse_error \
+              test/gtest_links/ReplayIOGroupTest.read_batch_advances_row \
+              test/gtest_links/ReplayIOGroupTest.valid_signals \
               test/gtest_links/ReporterTest.generate \
               test/gtest_links/ReporterTest.generate_conditional \
+              test/gtest_links/SampleAggregatorTest.domain_shared_region \
               test/gtest_links/SampleAggregatorTest.epoch_application_total \
               test/gtest_links/SampleAggregatorTest.sample_application \
               test/gtest_links/SampleAggregatorTest.test_sample_before_update \
@@ -373,6 +401,7 @@ GTEST_TESTS = test/gtest_links/AccumulatorTest.empty \
               test/gtest_links/TreeCommTest.send_receive \
               test/gtest_links/TRLFrequencyLimitDetectorTest.returns_single_core_limit_by_default \
               test/gtest_links/TRLFrequencyLimitDetectorTest.returns_max_observed_frequency_after_update \
+              test/gtest_links/WaiterTest.event \
               test/gtest_links/WaiterTest.invalid_strategy_name \
               test/gtest_links/WaiterTest.make_unique \
               test/gtest_links/WaiterTest.reset \
@@ -421,6 +450,7 @@ if ENABLE_BETA
                    test/gtest_links/FFNetAgentTest.validate_badsize_policy \
                    test/gtest_links/FFNetAgentTest.validate_empty_policy \
                    test/gtest_links/FFNetAgentTest.validate_good_policy\
+                   test/gtest_links/PolicyStoreImpTest.cache_invalidation \
                    test/gtest_links/PolicyStoreImpTest.self_consistent \
                    test/gtest_links/PolicyStoreImpTest.table_precedence \
                    test/gtest_links/PolicyStoreImpTest.update_policy \
@@ -436,6 +466,8 @@ endif
 if ENABLE_OMPT
     GTEST_TESTS += test/gtest_links/ELFTest.symbols_exist \
                    test/gtest_links/ELFTest.symbol_lookup \
+                   test/gtest_links/ELFTest.symbol_index \
+                   test/gtest_links/ELFTest.symbol_index_performance \
                    # end
 endif
 
@@ -472,6 +504,7 @@ test_geopm_test_SOURCES = test/AccumulatorTest.cpp \
                           test/ApplicationStatusTest.cpp \
                           test/CommMPIImpTest.cpp \
                           test/CommNullImpTest.cpp \
+                          test/ControllerReplayTest.cpp \
                           test/ControllerTest.cpp \
                           test/CSVTest.cpp \
                           test/DebugIOGroupTest.cpp \
@@ -546,6 +579,7 @@ test_geopm_test_SOURCES = test/AccumulatorTest.cpp \
                           test/ProcessRegionAggregatorTest.cpp \
                           test/RecordFilterTest.cpp \
                           test/RegionHintRecommenderTest.cpp \
+                          test/ReplayIOGroupTest.cpp \
                           test/ReporterTest.cpp \
                           test/SampleAggregatorTest.cpp \
                           test/SchedTest.cpp \
@@ -594,7 +628,8 @@ test_geopm_test_SOURCES += src/Profile.cpp \
                            src/Profile.hpp \
                            # endif
 
-test_geopm_test_LDADD = libgeopm.la \
+test_geopm_test_LDADD = libgeopmreplay.la \
+                        libgeopm.la \
                         libgmock.a \
                         libgtest.a \
                         # end
@@ -603,6 +638,28 @@ test_geopm_test_CPPFLAGS = $(AM_CPPFLAGS) -Iplugin
 test_geopm_test_CFLAGS = $(AM_CFLAGS)
 test_geopm_test_CXXFLAGS = $(AM_CXXFLAGS)
 
+# Micro benchmarks for the code that runs every control period.  They
+# report ns/op and allocations/op.  Run with "make bench" or run
+# test/geopm_micro_bench directly to pass a filter.
+test_geopm_micro_bench_SOURCES = test/geopm_micro_bench.cpp \
+                                 test/geopm_micro_bench.hpp \
+                                 test/ApplicationRecordLogBench.cpp \
+                                 test/ApplicationSamplerBench.cpp \
+                                 test/ApplicationStatusBench.cpp \
+                                 test/CSVBench.cpp \
+                                 test/PolicyStoreBench.cpp \
+                                 test/SchedulerBench.cpp \
+                                 # end
+
+test_geopm_micro_bench_LDADD = libgeopm.la
+test_geopm_micro_bench_CPPFLAGS = $(AM_CPPFLAGS)
+test_geopm_micro_bench_CXXFLAGS = $(AM_CXXFLAGS)
+
+bench: test/geopm_micro_bench
+	test/geopm_micro_bench
+
+PHONY_TARGETS += bench
+
 if ENABLE_MPI
     test_geopm_mpi_test_api_SOURCES = test/MPIInterfaceTest.cpp \
                                       test/geopm_test.cpp \
@@ -28,6 +28,9 @@ class MockApplicationSampler : public geopm::ApplicationSampler
         MOCK_METHOD(bool, do_shutdown, (), (const, override));
         MOCK_METHOD(double, total_time, (), (const, override));
         MOCK_METHOD(double, overhead_time, (), (const, override));
+        MOCK_METHOD(bool, wait_event, (const geopm_time_s &deadline), (override));
+        MOCK_METHOD(int, num_event_step, (), (const, override));
+        MOCK_METHOD(int, num_period_step, (), (const, override));
         std::vector<geopm::record_s> get_records(void) const override;
         /// Inject records to be used by next call to get_records()
         /// @todo: figure out input type for this
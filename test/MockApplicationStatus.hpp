@@ -24,6 +24,8 @@ class MockApplicationStatus : public geopm::ApplicationStatus
         MOCK_METHOD(void, increment_work_unit, (int cpu_idx), (override));
         MOCK_METHOD(double, get_progress_cpu, (int cpu_idx), (const, override));
         MOCK_METHOD(void, update_cache, (), (override));
+        MOCK_METHOD(void, post_event, (), (override));
+        MOCK_METHOD(bool, wait_event, (const geopm_time_s &deadline), (override));
 };
 
 #endif
@@ -36,6 +36,7 @@ class MockReporter : public geopm::Reporter
                     (override));
         MOCK_METHOD(void, total_time, (double total), (override));
         MOCK_METHOD(void, overhead, (double overhead_sec, double sample_delay), (override));
+        MOCK_METHOD(void, step_count, (int num_event_step, int num_period_step), (override));
 };
 
 #endif
@@ -17,6 +17,7 @@ class MockScheduler : public geopm::Scheduler
         MOCK_METHOD(int, get_cpu, (), (const, override));
         MOCK_METHOD((std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >), proc_cpuset, (), (const, override));
         MOCK_METHOD((std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >), proc_cpuset, (int pid), (const, override));
+        MOCK_METHOD((std::map<int, std::vector<bool> >), proc_cpusets, (const std::vector<int> &pid), (const, override));
         MOCK_METHOD((std::unique_ptr<cpu_set_t, std::function<void(cpu_set_t *)> >), woomp, (int pid),  (const, override));
 };
 
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PolicyStoreImp.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_micro_bench.hpp"
+
+using geopm::PolicyStoreImp;
+
+namespace
+{
+    const char *const BENCH_AGENT = "power_governor";
+    const char *const BENCH_PROFILE = "bench_profile";
+
+    struct policy_store_state_s {
+        std::string path;
+        std::vector<pid_t> reader_pid;
+        std::unique_ptr<PolicyStoreImp> reader;
+        std::unique_ptr<PolicyStoreImp> writer;
+        double setting;
+
+        ~policy_store_state_s()
+        {
+            for (auto pid : reader_pid) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+            reader.reset();
+            writer.reset();
+            unlink(path.c_str());
+        }
+    };
+
+    // Create a data store with one best policy and num_reader child
+    // processes that look it up in a loop until they are killed
+    std::shared_ptr<policy_store_state_s> policy_store_state(int num_reader)
+    {
+        auto state = std::make_shared<policy_store_state_s>();
+        state->path = "/tmp/geopm_micro_bench_policy_store_" + std::to_string(getpid()) + ".db";
+        state->setting = 150.0;
+        state->writer = geopm::make_unique<PolicyStoreImp>(state->path);
+        state->writer->set_best(BENCH_AGENT, BENCH_PROFILE, {state->setting});
+        for (int reader_idx = 0; reader_idx < num_reader; ++reader_idx) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                try {
+                    PolicyStoreImp reader(state->path);
+                    while (true) {
+                        reader.get_best(BENCH_AGENT, BENCH_PROFILE);
+                    }
+                }
+                catch (...) {
+
+                }
+                _exit(1);
+            }
+            state->reader_pid.push_back(pid);
+        }
+        state->reader = geopm::make_unique<PolicyStoreImp>(state->path);
+        return state;
+    }
+}
+
+GEOPM_MICRO_BENCH(PolicyStore, get_best)
+{
+    auto state = policy_store_state(0);
+    return [state]() {
+        state->reader->get_best(BENCH_AGENT, BENCH_PROFILE);
+    };
+}
+
+GEOPM_MICRO_BENCH(PolicyStore, get_best_4_readers)
+{
+    auto state = policy_store_state(4);
+    return [state]() {
+        state->reader->get_best(BENCH_AGENT, BENCH_PROFILE);
+    };
+}
+
+// Every lookup follows an update from another connection, so the
+// cache is invalidated and the policy is read from the data store
+GEOPM_MICRO_BENCH(PolicyStore, set_best_get_best)
+{
+    auto state = policy_store_state(0);
+    return [state]() {
+        state->setting += 1.0;
+        state->writer->set_best(BENCH_AGENT, BENCH_PROFILE, {state->setting});
+        state->reader->get_best(BENCH_AGENT, BENCH_PROFILE);
+    };
+}
@@ -5,6 +5,8 @@
 
 #include "PolicyStoreImp.hpp"
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -182,3 +184,47 @@ TEST_F(PolicyStoreImpTest, table_precedence)
     GEOPM_EXPECT_THROW_MESSAGE(policy_store.set_default("agent_without_policy", {123}),
                                GEOPM_ERROR_INVALID, "invalid policy for agent");
 }
+
+TEST_F(PolicyStoreImpTest, cache_invalidation)
+{
+    std::string database_path = "PolicyStoreImpTest.cache_invalidation." +
+                                std::to_string(getpid()) + ".db";
+    static const std::vector<double> policy1 = { 1, 2, 3 };
+    static const std::vector<double> policy2 = { 4, 5, 6 };
+    static const std::vector<double> default_policy = { 7, 8, 9 };
+    {
+        geopm::PolicyStoreImp reader(database_path);
+        geopm::PolicyStoreImp writer(database_path);
+
+        writer.set_best("agent_with_policy", "myprofile", policy1);
+        EXPECT_TRUE(PoliciesAreSame(
+            policy1, reader.get_best("agent_with_policy", "myprofile")));
+        // Repeated lookups are served from the cache
+        EXPECT_TRUE(PoliciesAreSame(
+            policy1, reader.get_best("agent_with_policy", "myprofile")));
+
+        // A change through another connection invalidates the cache
+        writer.set_best("agent_with_policy", "myprofile", policy2);
+        EXPECT_TRUE(PoliciesAreSame(
+            policy2, reader.get_best("agent_with_policy", "myprofile")));
+
+        // A change through the same connection updates the cache
+        reader.set_best("agent_with_policy", "myprofile", {});
+        reader.set_default("agent_with_policy", default_policy);
+        EXPECT_TRUE(PoliciesAreSame(
+            default_policy, reader.get_best("agent_with_policy", "myprofile")));
+        reader.set_default("agent_with_policy", policy1);
+        EXPECT_TRUE(PoliciesAreSame(
+            policy1, reader.get_best("agent_with_policy", "myprofile")));
+        EXPECT_TRUE(PoliciesAreSame(
+            policy1, writer.get_best("agent_with_policy", "myprofile")));
+
+        // A failed update is rolled back and leaves the store usable
+        GEOPM_EXPECT_THROW_MESSAGE(writer.set_best("agent_without_policy", "any", policy1),
+                                   GEOPM_ERROR_INVALID, "invalid policy for agent");
+        writer.set_best("agent_with_policy", "myprofile", policy2);
+        EXPECT_TRUE(PoliciesAreSame(
+            policy2, reader.get_best("agent_with_policy", "myprofile")));
+    }
+    unlink(database_path.c_str());
+}
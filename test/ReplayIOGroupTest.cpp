@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <unistd.h>
+
+#include <cmath>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geopm/Exception.hpp"
+#include "geopm/Helper.hpp"
+#include "geopm_test.hpp"
+#include "geopm_topo.h"
+#include "MockPlatformTopo.hpp"
+#include "ReplayIOGroup.hpp"
+
+using geopm::IOGroup;
+using geopm::ReplayIOGroup;
+
+class ReplayIOGroupTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        void TearDown(void);
+        std::string m_path = "ReplayIOGroupTest.trace";
+        std::shared_ptr<MockPlatformTopo> m_topo;
+};
+
+void ReplayIOGroupTest::SetUp(void)
+{
+    // 2 packages, 4 cores, 8 CPUs
+    m_topo = make_topo(2, 4, 8);
+    geopm::write_file(m_path,
+        "# geopm_version: 3.0.0\n"
+        "# profile_name: replay_test\n"
+        "TIME|EPOCH_COUNT|CPU_ENERGY-package-0|CPU_ENERGY-package-1|CPU_POWER|REGION_HASH\n"
+        "0.005|0|100.0|200.0|50.5|0x00000000725e8066\n"
+        "0.010|0|101.0|202.0|60.5|0x00000000725e8066\n"
+        "0.015|1|103.0|203.0|55.5|0x00000000644f9787\n");
+}
+
+void ReplayIOGroupTest::TearDown(void)
+{
+    (void)unlink(m_path.c_str());
+}
+
+TEST_F(ReplayIOGroupTest, valid_signals)
+{
+    ReplayIOGroup group(m_path, *m_topo, {}, {});
+    EXPECT_EQ("replay_test", group.profile_name());
+    EXPECT_EQ(3, group.num_row());
+    EXPECT_EQ(std::vector<double>({0.005, 0.010, 0.015}), group.row_time());
+    EXPECT_EQ(std::set<std::string>({"TIME", "EPOCH_COUNT", "CPU_ENERGY",
+                                     "CPU_POWER", "REGION_HASH"}),
+              group.signal_names());
+    EXPECT_TRUE(group.control_names().empty());
+    EXPECT_TRUE(group.is_valid_signal("CPU_ENERGY"));
+    EXPECT_FALSE(group.is_valid_signal("CPU_FREQUENCY_STATUS"));
+    EXPECT_EQ(GEOPM_DOMAIN_BOARD, group.signal_domain_type("TIME"));
+    EXPECT_EQ(GEOPM_DOMAIN_PACKAGE, group.signal_domain_type("CPU_ENERGY"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, group.signal_domain_type("CPU_FREQUENCY_STATUS"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE, group.signal_behavior("TIME"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE, group.signal_behavior("CPU_ENERGY"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE, group.signal_behavior("CPU_POWER"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE, group.signal_behavior("REGION_HASH"));
+    EXPECT_EQ(6.0, group.agg_function("CPU_ENERGY")({1.0, 5.0}));
+    EXPECT_EQ(3.0, group.agg_function("CPU_POWER")({1.0, 5.0}));
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("CPU_ENERGY", GEOPM_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not defined for domain");
+    GEOPM_EXPECT_THROW_MESSAGE(group.read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 2),
+                               GEOPM_ERROR_INVALID, "domain_idx out of range");
+}
+
+TEST_F(ReplayIOGroupTest, read_batch_advances_row)
+{
+    ReplayIOGroup group(m_path, *m_topo, {}, {});
+    int time_idx = group.push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    int energy_idx = group.push_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 1);
+    int hash_idx = group.push_signal("REGION_HASH", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_EQ(time_idx, group.push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_NE(time_idx, energy_idx);
+
+    std::vector<double> expect_time = {0.005, 0.010, 0.015, 0.015};
+    std::vector<double> expect_energy = {200.0, 202.0, 203.0, 203.0};
+    std::vector<double> expect_hash = {0x725e8066, 0x725e8066, 0x644f9787, 0x644f9787};
+    for (size_t row = 0; row != expect_time.size(); ++row) {
+        group.read_batch();
+        EXPECT_EQ(expect_time[row], group.sample(time_idx));
+        EXPECT_EQ(expect_energy[row], group.sample(energy_idx));
+        EXPECT_EQ(expect_hash[row], group.sample(hash_idx));
+    }
+    // read_signal() reports the current row
+    EXPECT_EQ(203.0, group.read_signal("CPU_ENERGY", GEOPM_DOMAIN_PACKAGE, 1));
+    GEOPM_EXPECT_THROW_MESSAGE(group.push_signal("CPU_POWER", GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "cannot push signal after call to read_batch()");
+}
+
+TEST_F(ReplayIOGroupTest, constant_and_control)
+{
+    ReplayIOGroup group(m_path, *m_topo,
+                        {{"CPU_POWER_MAX_AVAIL", 250.0}, {"CPU_POWER", 1.0}},
+                        {{"CPU_POWER_LIMIT_CONTROL", 200.0}});
+    EXPECT_TRUE(group.is_valid_signal("CPU_POWER_MAX_AVAIL"));
+    EXPECT_EQ(GEOPM_DOMAIN_CPU, group.signal_domain_type("CPU_POWER_MAX_AVAIL"));
+    EXPECT_EQ(IOGroup::M_SIGNAL_BEHAVIOR_CONSTANT,
+              group.signal_behavior("CPU_POWER_MAX_AVAIL"));
+    // Constants take precedence over the trace
+    EXPECT_EQ(1.0, group.read_signal("CPU_POWER", GEOPM_DOMAIN_CPU, 3));
+    EXPECT_EQ(250.0, group.read_signal("CPU_POWER_MAX_AVAIL", GEOPM_DOMAIN_CPU, 7));
+
+    EXPECT_EQ(std::set<std::string>({"CPU_POWER_LIMIT_CONTROL"}), group.control_names());
+    EXPECT_TRUE(group.is_valid_signal("CPU_POWER_LIMIT_CONTROL"));
+    EXPECT_EQ(GEOPM_DOMAIN_CPU, group.control_domain_type("CPU_POWER_LIMIT_CONTROL"));
+    group.save_control();
+    int ctl_idx = group.push_control("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 2);
+    int sig_idx = group.push_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 2);
+    group.adjust(ctl_idx, 150.0);
+    group.write_batch();
+    group.read_batch();
+    EXPECT_EQ(150.0, group.sample(sig_idx));
+    EXPECT_EQ(200.0, group.read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    group.write_control("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 1, 100.0);
+    EXPECT_EQ(100.0, group.read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    group.restore_control();
+    EXPECT_EQ(200.0, group.read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 1));
+    EXPECT_EQ(200.0, group.read_signal("CPU_POWER_LIMIT_CONTROL", GEOPM_DOMAIN_CPU, 2));
+}
+
+TEST_F(ReplayIOGroupTest, parse_error)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup("ReplayIOGroupTest.missing", *m_topo, {}, {}),
+                               GEOPM_ERROR_INVALID, "Unable to open trace file");
+
+    geopm::write_file(m_path, "EPOCH_COUNT|CPU_POWER\n0|1.0\n");
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup(m_path, *m_topo, {}, {}),
+                               GEOPM_ERROR_FILE_PARSE, "TIME");
+
+    geopm::write_file(m_path, "TIME|CPU_POWER\n0.1|1.0\n0.2|one\n");
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup(m_path, *m_topo, {}, {}),
+                               GEOPM_ERROR_FILE_PARSE, "one");
+
+    geopm::write_file(m_path, "TIME|CPU_POWER\n0.1|1.0|2.0\n");
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup(m_path, *m_topo, {}, {}),
+                               GEOPM_ERROR_FILE_PARSE, "Wrong number of fields");
+
+    geopm::write_file(m_path, "TIME|CPU_POWER|CPU_POWER\n0.1|1.0|2.0\n");
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup(m_path, *m_topo, {}, {}),
+                               GEOPM_ERROR_FILE_PARSE, "appears more than once");
+
+    geopm::write_file(m_path, "TIME|CPU_ENERGY-package-2\n0.1|1.0\n");
+    GEOPM_EXPECT_THROW_MESSAGE(ReplayIOGroup(m_path, *m_topo, {}, {}),
+                               GEOPM_ERROR_INVALID, "does not match the platform topology");
+}
@@ -279,11 +279,11 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
     std::vector<uint64_t> pre_epoch_regions {reg_normal, GEOPM_REGION_HASH_UNMARKED};
     int step = 0;
     for (auto region : pre_epoch_regions) {
+        // Once for the aggregator's time stamp and once for the
+        // pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step));
+            .Times(2)
+            .WillRepeatedly(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
             .WillOnce(Return(region));
         // Epoch count stays zero
@@ -307,11 +307,11 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
                                          reg_normal,
                                          GEOPM_REGION_HASH_UNMARKED};
     for (auto region : epoch_regions) {
+        // Once for the aggregator's time stamp and once for the
+        // pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step));
+            .Times(2)
+            .WillRepeatedly(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
             .WillOnce(Return(region));
         // after first epoch()
@@ -333,11 +333,11 @@ TEST_F(SampleAggregatorTest, epoch_application_total)
 
     // Run through the same three region hashes with the epoch set to two
     for (auto region : epoch_regions) {
+        // Once for the aggregator's time stamp and once for the
+        // pushed signal
         EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step))
-            .WillOnce(Return(step));
+            .Times(2)
+            .WillRepeatedly(Return(step));
         EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
             .WillOnce(Return(region));
         // This is the second epoch
@@ -379,3 +379,61 @@ TEST_F(SampleAggregatorTest, test_sample_before_update)
     EXPECT_TRUE(std::isnan(m_agg->sample_epoch_last(time_idx)));
     EXPECT_TRUE(std::isnan(m_agg->sample_period_last(time_idx)));
 }
+
+TEST_F(SampleAggregatorTest, domain_shared_region)
+{
+    uint64_t regionA = 0x4444;
+    uint64_t regionB = 0x5555;
+    const int power_idx = 20;
+    const int energy_idx = 21;
+    EXPECT_CALL(m_platio, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_CALL(m_platio, push_signal("POWER", GEOPM_DOMAIN_BOARD, 0))
+        .WillRepeatedly(Return(power_idx));
+    EXPECT_CALL(m_platio, push_signal("ENERGY", GEOPM_DOMAIN_BOARD, 0))
+        .WillRepeatedly(Return(energy_idx));
+    // Region hash and epoch count are pushed once for the domain
+    EXPECT_CALL(m_platio, push_signal("REGION_HASH", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_CALL(m_platio, signal_behavior("TIME"))
+        .WillOnce(Return(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    EXPECT_CALL(m_platio, signal_behavior("POWER"))
+        .WillOnce(Return(IOGroup::M_SIGNAL_BEHAVIOR_VARIABLE));
+    EXPECT_CALL(m_platio, signal_behavior("ENERGY"))
+        .WillOnce(Return(IOGroup::M_SIGNAL_BEHAVIOR_MONOTONE));
+    EXPECT_EQ(M_SIGNAL_TIME, m_agg->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_EQ(power_idx, m_agg->push_signal("POWER", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_EQ(energy_idx, m_agg->push_signal("ENERGY", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_EQ(energy_idx, m_agg->push_signal_total("ENERGY", GEOPM_DOMAIN_BOARD, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(m_agg->push_signal_average("ENERGY", GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "signal already pushed for total");
+
+    std::vector<double> time {0, 1, 2, 3};
+    std::vector<uint64_t> region {regionA, regionA, regionB, regionB};
+    std::vector<double> energy {0, 10, 30, 60};
+    std::vector<double> power {5, 6, 7, 8};
+    for (size_t step = 0; step < time.size(); ++step) {
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
+            .WillRepeatedly(Return(time[step]));
+        EXPECT_CALL(m_platio, sample(energy_idx))
+            .WillOnce(Return(energy[step]));
+        EXPECT_CALL(m_platio, sample(power_idx))
+            .Times(step == 0 ? 0 : 1)
+            .WillRepeatedly(Return(power[step]));
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
+            .WillOnce(Return(region[step]));
+        EXPECT_CALL(m_platio, sample(M_SIGNAL_EPOCH_COUNT))
+            .WillOnce(Return(0));
+        m_agg->update();
+    }
+
+    EXPECT_DOUBLE_EQ(2.0, m_agg->sample_region(M_SIGNAL_TIME, regionA));
+    EXPECT_DOUBLE_EQ(1.0, m_agg->sample_region(M_SIGNAL_TIME, regionB));
+    EXPECT_DOUBLE_EQ(30.0, m_agg->sample_region(energy_idx, regionA));
+    EXPECT_DOUBLE_EQ(30.0, m_agg->sample_region_last(energy_idx, regionA));
+    EXPECT_DOUBLE_EQ(30.0, m_agg->sample_region(energy_idx, regionB));
+    EXPECT_DOUBLE_EQ(6.5, m_agg->sample_region(power_idx, regionA));
+    EXPECT_DOUBLE_EQ(8.0, m_agg->sample_region(power_idx, regionB));
+    EXPECT_TRUE(std::isnan(m_agg->sample_region(power_idx, 0x9999)));
+    EXPECT_DOUBLE_EQ(0.0, m_agg->sample_region(energy_idx, 0x9999));
+    EXPECT_DOUBLE_EQ(60.0, m_agg->sample_application(energy_idx));
+    EXPECT_DOUBLE_EQ(7.0, m_agg->sample_application(power_idx));
+}
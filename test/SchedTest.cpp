@@ -5,10 +5,14 @@
 
 #include <gtest/gtest.h>
 #include <fstream>
+#include <vector>
+#include <errno.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include "geopm_sched.h"
+#include "geopm_error.h"
 
 extern "C"
 {
@@ -254,3 +258,60 @@ void SchedTest::check_cpuset(const std::string &cpus_allowed, const std::vector<
 }
 
 
+
+TEST_F(SchedTest, test_proc_cpuset_pid)
+{
+    int num_cpu = geopm_sched_num_cpu();
+    size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
+    cpu_set_t *expect = CPU_ALLOC(num_cpu);
+    cpu_set_t *actual = CPU_ALLOC(num_cpu);
+    ASSERT_TRUE(expect != NULL);
+    ASSERT_TRUE(actual != NULL);
+    CPU_ZERO_S(cpuset_size, expect);
+    int err = geopm_sched_proc_cpuset(num_cpu, expect);
+    ASSERT_EQ(0, err);
+    err = geopm_sched_proc_cpuset_pid(getpid(), num_cpu, actual);
+    ASSERT_EQ(0, err);
+    for (int i = 0; i < num_cpu; ++i) {
+        EXPECT_EQ(CPU_ISSET_S(i, cpuset_size, expect) != 0,
+                  CPU_ISSET_S(i, cpuset_size, actual) != 0);
+    }
+    CPU_FREE(actual);
+    CPU_FREE(expect);
+}
+
+TEST_F(SchedTest, test_proc_cpuset_pids)
+{
+    int num_cpu = geopm_sched_num_cpu();
+    size_t cpuset_size = CPU_ALLOC_SIZE(num_cpu);
+    cpu_set_t *expect = CPU_ALLOC(num_cpu);
+    ASSERT_TRUE(expect != NULL);
+    int err = geopm_sched_proc_cpuset_pid(getpid(), num_cpu, expect);
+    ASSERT_EQ(0, err);
+    // The largest possible PID on Linux is 2^22, so the last PID does
+    // not exist
+    std::vector<int> pid {getpid(), getppid(), getpid(), INT_MAX};
+    std::vector<char> cpuset(pid.size() * cpuset_size);
+    std::vector<int> pid_err(pid.size(), -1);
+    err = geopm_sched_proc_cpuset_pids(pid.size(), pid.data(), num_cpu,
+                                       (cpu_set_t *)cpuset.data(), pid_err.data());
+    ASSERT_EQ(0, err);
+    EXPECT_EQ(0, pid_err[0]);
+    EXPECT_EQ(0, pid_err[1]);
+    EXPECT_EQ(0, pid_err[2]);
+    EXPECT_EQ(ESRCH, pid_err[3]);
+    cpu_set_t *self_cpuset = (cpu_set_t *)cpuset.data();
+    cpu_set_t *repeat_cpuset = (cpu_set_t *)(cpuset.data() + 2 * cpuset_size);
+    cpu_set_t *missing_cpuset = (cpu_set_t *)(cpuset.data() + 3 * cpuset_size);
+    for (int i = 0; i < num_cpu; ++i) {
+        EXPECT_EQ(CPU_ISSET_S(i, cpuset_size, expect) != 0,
+                  CPU_ISSET_S(i, cpuset_size, self_cpuset) != 0);
+        EXPECT_EQ(CPU_ISSET_S(i, cpuset_size, expect) != 0,
+                  CPU_ISSET_S(i, cpuset_size, repeat_cpuset) != 0);
+        EXPECT_TRUE(CPU_ISSET_S(i, cpuset_size, missing_cpuset));
+    }
+    EXPECT_EQ(GEOPM_ERROR_INVALID,
+              geopm_sched_proc_cpuset_pids(1, nullptr, num_cpu,
+                                           (cpu_set_t *)cpuset.data(), pid_err.data()));
+    CPU_FREE(expect);
+}
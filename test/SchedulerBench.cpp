@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Scheduler.hpp"
+#include "geopm_micro_bench.hpp"
+#include "geopm_sched.h"
+
+extern "C"
+{
+    int geopm_sched_proc_cpuset_helper(int num_cpu, uint32_t *proc_cpuset, FILE *fid);
+}
+
+using geopm::Scheduler;
+
+namespace
+{
+    struct client_state_s {
+        std::vector<int> pid;
+        std::unique_ptr<Scheduler> scheduler;
+        int num_cpu;
+
+        ~client_state_s()
+        {
+            for (auto client_pid : pid) {
+                kill(client_pid, SIGKILL);
+                waitpid(client_pid, nullptr, 0);
+            }
+        }
+    };
+
+    // Fork num_client idle processes that stand in for the
+    // application processes passed to ApplicationSampler::connect()
+    std::shared_ptr<client_state_s> client_state(int num_client)
+    {
+        auto state = std::make_shared<client_state_s>();
+        state->scheduler = Scheduler::make_unique();
+        state->num_cpu = state->scheduler->num_cpu();
+        for (int client_idx = 0; client_idx < num_client; ++client_idx) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                while (true) {
+                    pause();
+                }
+            }
+            state->pid.push_back(pid);
+        }
+        return state;
+    }
+}
+
+// Parse the Cpus_allowed field of /proc/<pid>/status for each client:
+// the cost of the affinity queries at connect before they were made
+// with sched_getaffinity(2)
+GEOPM_MICRO_BENCH(Scheduler, proc_status_256_pid)
+{
+    auto state = client_state(256);
+    return [state]() {
+        std::vector<uint32_t> mask(state->num_cpu / 32 + 1);
+        for (auto pid : state->pid) {
+            std::string status_path = "/proc/" + std::to_string(pid) + "/status";
+            FILE *fid = fopen(status_path.c_str(), "r");
+            if (fid != nullptr) {
+                geopm_sched_proc_cpuset_helper(state->num_cpu, mask.data(), fid);
+                fclose(fid);
+            }
+        }
+    };
+}
+
+GEOPM_MICRO_BENCH(Scheduler, proc_cpuset_256_pid)
+{
+    auto state = client_state(256);
+    return [state]() {
+        for (auto pid : state->pid) {
+            state->scheduler->proc_cpuset(pid);
+        }
+    };
+}
+
+// The batched query made by ApplicationSampler::connect()
+GEOPM_MICRO_BENCH(Scheduler, proc_cpusets_256_pid)
+{
+    auto state = client_state(256);
+    return [state]() {
+        state->scheduler->proc_cpusets(state->pid);
+    };
+}
@@ -6,11 +6,16 @@
 #include <memory>
 
 #include "gtest/gtest.h"
+#include "gmock/gmock.h"
 #include "geopm_test.hpp"
 
 #include "Waiter.hpp"
+#include "MockApplicationSampler.hpp"
 
 using geopm::Waiter;
+using geopm::EventWaiter;
+using testing::_;
+using testing::Return;
 
 class WaiterTest : public ::testing::Test
 {
@@ -32,6 +37,8 @@ TEST_F(WaiterTest, make_unique)
     ASSERT_EQ(1.0, waiter->period());
     waiter = Waiter::make_unique(2.0, "sleep");
     ASSERT_EQ(2.0, waiter->period());
+    waiter = Waiter::make_unique(3.0, "event");
+    ASSERT_EQ(3.0, waiter->period());
 }
 
 TEST_F(WaiterTest, reset)
@@ -62,3 +69,31 @@ TEST_F(WaiterTest, wait)
         EXPECT_NEAR(m_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
     }
 }
+
+TEST_F(WaiterTest, event)
+{
+    MockApplicationSampler sampler;
+    double min_period = 0.02;
+    EventWaiter waiter(m_period, min_period, sampler);
+    geopm_time_s time_0;
+    geopm_time_s time_1;
+    // Region entries before the end of the period are held off by
+    // the minimum period
+    EXPECT_CALL(sampler, wait_event(_))
+        .WillOnce(Return(true))
+        .WillOnce(Return(true))
+        .WillOnce(Return(false));
+    waiter.reset();
+    geopm_time(&time_0);
+    waiter.wait();
+    geopm_time(&time_1);
+    EXPECT_NEAR(min_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
+    geopm_time(&time_0);
+    waiter.wait();
+    geopm_time(&time_1);
+    EXPECT_NEAR(min_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
+    // Periodic step is not moved by the earlier events
+    waiter.wait();
+    geopm_time(&time_1);
+    EXPECT_NEAR(m_period - min_period, geopm_time_diff(&time_0, &time_1), m_epsilon);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "config.h"
+
+#include "geopm_micro_bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "geopm_time.h"
+
+// Count every heap allocation made by the process so that the harness
+// can report allocations per operation.
+static std::atomic<uint64_t> g_num_alloc(0);
+
+void *operator new(size_t size)
+{
+    g_num_alloc.fetch_add(1, std::memory_order_relaxed);
+    void *result = std::malloc(size == 0 ? 1 : size);
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace geopm
+{
+    static std::vector<std::pair<std::string, std::function<MicroBenchOp(void)> > > &micro_bench_registry(void)
+    {
+        static std::vector<std::pair<std::string, std::function<MicroBenchOp(void)> > > instance;
+        return instance;
+    }
+
+    MicroBenchRegistrar::MicroBenchRegistrar(const std::string &name,
+                                             std::function<MicroBenchOp(void)> setup)
+    {
+        micro_bench_registry().emplace_back(name, std::move(setup));
+    }
+}
+
+static void usage(const char *prog)
+{
+    std::cerr << "Usage: " << prog << " [--min-time SECONDS] [FILTER ...]\n"
+              << "    Run the micro benchmarks whose name contains any FILTER\n"
+              << "    (all benchmarks if no FILTER is given).  Each benchmark\n"
+              << "    is repeated until it has run for at least SECONDS\n"
+              << "    (default 0.5).\n";
+}
+
+int main(int argc, char **argv)
+{
+    double min_time = 0.5;
+    std::vector<std::string> filter;
+    for (int arg_idx = 1; arg_idx < argc; ++arg_idx) {
+        std::string arg(argv[arg_idx]);
+        if (arg == "--help" || arg == "-h") {
+            usage(argv[0]);
+            return 0;
+        }
+        else if (arg == "--min-time" && arg_idx + 1 < argc) {
+            min_time = std::atof(argv[++arg_idx]);
+        }
+        else {
+            filter.push_back(arg);
+        }
+    }
+
+    auto registry = geopm::micro_bench_registry();
+    std::sort(registry.begin(), registry.end(),
+              [](const std::pair<std::string, std::function<geopm::MicroBenchOp(void)> > &aa,
+                 const std::pair<std::string, std::function<geopm::MicroBenchOp(void)> > &bb) {
+                  return aa.first < bb.first;
+              });
+    int err = 0;
+    std::cout << std::left << std::setw(48) << "benchmark"
+              << std::right << std::setw(14) << "ns/op"
+              << std::setw(14) << "allocs/op"
+              << std::setw(14) << "iterations" << std::endl;
+    for (const auto &bench : registry) {
+        bool is_match = filter.empty();
+        for (const auto &ff : filter) {
+            if (bench.first.find(ff) != std::string::npos) {
+                is_match = true;
+            }
+        }
+        if (!is_match) {
+            continue;
+        }
+        try {
+            geopm::MicroBenchOp op = bench.second();
+            // Warm up caches and any lazily created state
+            op();
+            uint64_t num_op = 1;
+            double elapsed = 0.0;
+            uint64_t num_alloc = 0;
+            while (true) {
+                uint64_t alloc_begin = g_num_alloc.load(std::memory_order_relaxed);
+                geopm_time_s time_begin;
+                geopm_time(&time_begin);
+                for (uint64_t op_idx = 0; op_idx < num_op; ++op_idx) {
+                    op();
+                }
+                elapsed = geopm_time_since(&time_begin);
+                num_alloc = g_num_alloc.load(std::memory_order_relaxed) - alloc_begin;
+                if (elapsed >= min_time || num_op >= (1ULL << 32)) {
+                    break;
+                }
+                // Grow the iteration count toward the target time
+                double factor = elapsed > 0.0 ? 1.2 * min_time / elapsed : 10.0;
+                factor = std::min(10.0, std::max(2.0, factor));
+                num_op = (uint64_t)(num_op * factor);
+            }
+            std::cout << std::left << std::setw(48) << bench.first
+                      << std::right << std::fixed
+                      << std::setw(14) << std::setprecision(1) << 1e9 * elapsed / num_op
+                      << std::setw(14) << std::setprecision(2) << (double)num_alloc / num_op
+                      << std::setw(14) << num_op << std::endl;
+        }
+        catch (const std::exception &ex) {
+            std::cout << std::left << std::setw(48) << bench.first
+                      << std::right << std::setw(14) << "FAILED" << std::endl;
+            std::cerr << "Error: " << bench.first << ": " << ex.what() << std::endl;
+            err = 1;
+        }
+    }
+    return err;
+}
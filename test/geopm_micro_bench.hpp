@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2015 - 2023, Intel Corporation
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef GEOPM_MICRO_BENCH_HPP_INCLUDE
+#define GEOPM_MICRO_BENCH_HPP_INCLUDE
+
+#include <functional>
+#include <string>
+
+namespace geopm
+{
+    /// @brief Operation that is timed by the micro benchmark
+    ///        harness.  The operation is called repeatedly and the
+    ///        time and number of heap allocations per call are
+    ///        reported.
+    using MicroBenchOp = std::function<void(void)>;
+
+    /// @brief Registers a micro benchmark with the harness.  Use the
+    ///        GEOPM_MICRO_BENCH() macro rather than creating these
+    ///        objects directly.
+    class MicroBenchRegistrar
+    {
+        public:
+            /// @param [in] name Name of the benchmark, reported in
+            ///        the output and matched by command line filters.
+            /// @param [in] setup Function that creates the objects
+            ///        under test and returns the operation to time.
+            ///        Work done by setup is not included in the
+            ///        measurement.
+            MicroBenchRegistrar(const std::string &name,
+                                std::function<MicroBenchOp(void)> setup);
+            virtual ~MicroBenchRegistrar() = default;
+    };
+}
+
+/// @brief Define a micro benchmark.  The body is the setup function:
+///        it constructs the objects under test and returns a
+///        MicroBenchOp that exercises one operation on them.
+#define GEOPM_MICRO_BENCH(suite_name, bench_name) \
+    static geopm::MicroBenchOp suite_name##_##bench_name##_setup(void); \
+    static geopm::MicroBenchRegistrar suite_name##_##bench_name##_registrar( \
+        #suite_name "." #bench_name, suite_name##_##bench_name##_setup); \
+    static geopm::MicroBenchOp suite_name##_##bench_name##_setup(void)
+
+#endif